@@ -0,0 +1,208 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using SharpLife.CommandSystem.Commands;
+using SharpLife.CommandSystem.Commands.VariableFilters;
+using SharpLife.Engine.Client.Networking;
+using SharpLife.FileSystem;
+using SharpLife.Networking.Shared;
+using SharpLife.Networking.Shared.Communication.Demos;
+using SharpLife.Utility.FileSystem;
+using System;
+using System.Globalization;
+using System.IO;
+
+namespace SharpLife.Engine.Client.Host
+{
+    public partial class EngineClientHost
+    {
+        private const string DemoExtension = ".dem";
+
+        private IVariable _demo_keyframe_interval;
+
+        private void RegisterDemoCommands()
+        {
+            CommandContext.RegisterCommand(new CommandInfo("record", StartRecording).WithHelpInfo("Record a demo of the current game"));
+            CommandContext.RegisterCommand(new CommandInfo("stop", StopRecording).WithHelpInfo("Stop recording a demo"));
+            CommandContext.RegisterCommand(new CommandInfo("playdemo", PlayDemo).WithHelpInfo("Play back a demo"));
+            CommandContext.RegisterCommand(new CommandInfo("demo_seek", SeekDemo).WithHelpInfo("Continue demo playback at the given time, in seconds"));
+            CommandContext.RegisterCommand(new CommandInfo("stopdemo", StopDemo).WithHelpInfo("Stop playing back a demo"));
+
+            _demo_keyframe_interval = CommandContext.RegisterVariable(new VariableInfo("demo_keyframe_interval")
+                .WithHelpInfo("Time between keyframes in recorded demos, in seconds. Shorter intervals make seeking faster but demos larger")
+                .WithValue(5.0f)
+                .WithMinMaxFilter(1, null));
+        }
+
+        private void StartRecording(ICommandArgs command)
+        {
+            if (command.Count == 0)
+            {
+                _logger.Information("usage: record <demoname>");
+                return;
+            }
+
+            if (_netClient == null || !_netClient.IsConnected || _netClient.ConnectionSetupStatus != ClientConnectionSetupStatus.Connected)
+            {
+                _logger.Information("You must be connected to a server to record a demo");
+                return;
+            }
+
+            if (_netClient.IsRecordingDemo)
+            {
+                _logger.Information("Already recording a demo");
+                return;
+            }
+
+            var fileName = Path.ChangeExtension(command[0], DemoExtension);
+
+            DemoWriter writer;
+
+            try
+            {
+                writer = new DemoWriter(FileSystem.Open(fileName, FileMode.Create, FileAccess.Write, FileSystemConstants.PathID.GameConfig));
+            }
+            catch (Exception e) when (e is IOException || e is UnauthorizedAccessException)
+            {
+                _logger.Error(e, $"Couldn't create demo \"{fileName}\"");
+                return;
+            }
+
+            _netClient.StartRecording(writer, _demo_keyframe_interval.Float);
+
+            _logger.Information($"Recording to \"{fileName}\"");
+        }
+
+        private void StopRecording(ICommandArgs command)
+        {
+            if (_netClient?.IsRecordingDemo != true)
+            {
+                _logger.Information("Not recording a demo");
+                return;
+            }
+
+            _netClient.StopRecording();
+
+            _logger.Information("Completed demo");
+        }
+
+        private void PlayDemo(ICommandArgs command)
+        {
+            if (command.Count == 0)
+            {
+                _logger.Information("usage: playdemo <demoname>");
+                return;
+            }
+
+            SetupNetworking();
+
+            if (_netClient.IsConnected)
+            {
+                _logger.Information("Disconnect from the server before playing back a demo");
+                return;
+            }
+
+            StopDemoPlayback();
+
+            var fileName = Path.ChangeExtension(command[0], DemoExtension);
+
+            DemoReader reader;
+
+            try
+            {
+                reader = new DemoReader(FileSystem.GetAbsolutePath(fileName, FileSystemConstants.PathID.GameConfig));
+            }
+            catch (Exception e) when (e is IOException || e is UnauthorizedAccessException || e is InvalidDataException)
+            {
+                _logger.Error(e, $"Couldn't open demo \"{fileName}\"");
+                return;
+            }
+
+            if (reader.ProtocolVersion != NetConstants.ProtocolVersion)
+            {
+                _logger.Information($"Demo \"{fileName}\" was recorded with protocol version {reader.ProtocolVersion}, expected {NetConstants.ProtocolVersion}");
+                reader.Dispose();
+                return;
+            }
+
+            if (reader.Keyframes.Count == 0)
+            {
+                _logger.Information($"Demo \"{fileName}\" contains no keyframes");
+                reader.Dispose();
+                return;
+            }
+
+            _logger.Information($"Playing demo \"{fileName}\"");
+
+            _netClient.StartPlayback(fileName, reader);
+        }
+
+        private void SeekDemo(ICommandArgs command)
+        {
+            if (command.Count == 0)
+            {
+                _logger.Information("usage: demo_seek <seconds>");
+                return;
+            }
+
+            if (_netClient?.IsPlayingDemo != true)
+            {
+                _logger.Information("Not playing a demo");
+                return;
+            }
+
+            if (!double.TryParse(command[0], NumberStyles.Float, CultureInfo.InvariantCulture, out var time) || time < 0)
+            {
+                _logger.Information($"Invalid time \"{command[0]}\"");
+                return;
+            }
+
+            //Keyframes set up the map from scratch
+            _game.MapShutdown();
+
+            _netClient.SeekPlayback(time);
+        }
+
+        private void StopDemo(ICommandArgs command)
+        {
+            if (_netClient?.IsPlayingDemo != true)
+            {
+                _logger.Information("Not playing a demo");
+                return;
+            }
+
+            StopDemoPlayback();
+        }
+
+        private void StopDemoPlayback()
+        {
+            if (_netClient?.IsPlayingDemo == true)
+            {
+                _netClient.StopPlayback();
+
+                _game.MapShutdown();
+            }
+        }
+
+        private void ReadDemoMessages(float deltaSeconds)
+        {
+            if (!_netClient.ReadPlaybackMessages(deltaSeconds))
+            {
+                _logger.Information("Demo playback finished");
+                StopDemoPlayback();
+            }
+        }
+    }
+}
@@ -21,7 +21,8 @@ namespace SharpLife.Engine.Client.Host
 {
     public partial class EngineClientHost :
         IMessageReceiveHandler<ServerInfo>,
-        IMessageReceiveHandler<Print>
+        IMessageReceiveHandler<Print>,
+        IMessageReceiveHandler<UserCommandAck>
     {
         public int MaxClients { get; private set; }
 
@@ -29,6 +30,7 @@ namespace SharpLife.Engine.Client.Host
         {
             receiveHandler.RegisterHandler<ServerInfo>(this);
             receiveHandler.RegisterHandler<Print>(this);
+            receiveHandler.RegisterHandler<UserCommandAck>(this);
         }
 
         public void ReceiveMessage(NetConnection connection, ServerInfo message)
@@ -49,5 +51,10 @@ namespace SharpLife.Engine.Client.Host
         {
             _logger.Information(message.MessageContents);
         }
+
+        public void ReceiveMessage(NetConnection connection, UserCommandAck message)
+        {
+            _clientNetworking.ProcessUserCommandAck(message);
+        }
     }
 }
@@ -37,6 +37,8 @@ namespace SharpLife.Engine.Client.Host
 
         private IClientNetworking _clientNetworking;
 
+        private double _nextUserCommandsTime;
+
         /// <summary>
         /// Creates the network client, using current client configuration values
         /// </summary>
@@ -57,6 +59,8 @@ namespace SharpLife.Engine.Client.Host
                     _binaryDataDescriptorSet,
                     _objectListTypeRegistry,
                     _cl_name,
+                    _rate,
+                    _engine.Loopback,
                     NetConstants.AppIdentifier,
                     _clientport.Integer,
                     _cl_resend.Float,
@@ -97,6 +101,34 @@ namespace SharpLife.Engine.Client.Host
             _game.MapLoadFinished();
         }
 
+        /// <summary>
+        /// Sends the most recent user commands to the server, at most cl_cmdrate times per second
+        /// Commands are sent unreliably, lost commands are covered by the backup commands in the next packets
+        /// </summary>
+        private void SendUserCommands()
+        {
+            if (_netClient.ConnectionSetupStatus != ClientConnectionSetupStatus.Connected)
+            {
+                return;
+            }
+
+            var currentTime = _engine.EngineTime.ElapsedTime;
+
+            if (currentTime < _nextUserCommandsTime)
+            {
+                return;
+            }
+
+            _nextUserCommandsTime = currentTime + (1.0 / _cl_cmdrate.Float);
+
+            var message = _clientNetworking.CreateUserCommands(_cl_cmdbackup.Integer);
+
+            if (message != null)
+            {
+                _netClient.Server.AddMessage(message, false);
+            }
+        }
+
         /// <summary>
         /// Connect to a server
         /// </summary>
@@ -123,6 +155,8 @@ namespace SharpLife.Engine.Client.Host
 
             SetupNetworking();
 
+            StopDemoPlayback();
+
             //TODO: initialize client state
 
             if (_netClient.IsConnected && !_netClient.IsDisconnecting)
@@ -88,6 +88,12 @@ namespace SharpLife.Engine.Client.Host
 
         private readonly IVariable _cl_name;
 
+        private readonly IVariable _rate;
+
+        private readonly IVariable _cl_cmdrate;
+
+        private readonly IVariable _cl_cmdbackup;
+
         public EngineClientHost(IEngine engine, ILogger logger)
         {
             _engine = engine ?? throw new ArgumentNullException(nameof(engine));
@@ -111,6 +117,8 @@ namespace SharpLife.Engine.Client.Host
             CommandContext.RegisterCommand(new CommandInfo("connect", Connect).WithHelpInfo("Connect to a server"));
             CommandContext.RegisterCommand(new CommandInfo("disconnect", Disconnect).WithHelpInfo("Disconnect from a server"));
 
+            RegisterDemoCommands();
+
             _clientport = CommandContext.RegisterVariable(new VariableInfo("clientport")
                 .WithHelpInfo("Client port to use for connections")
                 .WithValue(NetConstants.DefaultClientPort)
@@ -138,9 +146,28 @@ namespace SharpLife.Engine.Client.Host
                     }
                 }));
 
-            //TODO: add change handler to send update to server if connected
             _cl_name = CommandContext.RegisterVariable(new VariableInfo("name")
-                .WithHelpInfo("Your name as seen by other players"));
+                .WithHelpInfo("Your name as seen by other players")
+                .WithChangeHandler(OnUserInfoChanged));
+
+            _rate = CommandContext.RegisterVariable(new VariableInfo("rate")
+                .WithHelpInfo("Maximum number of bytes per second to receive from the server")
+                .WithValue(NetConstants.DefaultRate)
+                .WithMinMaxFilter(1000, 100000)
+                .WithEngineFlags(EngineCommandFlags.Archive)
+                .WithChangeHandler(OnUserInfoChanged));
+
+            _cl_cmdrate = CommandContext.RegisterVariable(new VariableInfo("cl_cmdrate")
+                .WithHelpInfo("Maximum number of packets with user commands to send to the server per second")
+                .WithValue(60)
+                .WithMinMaxFilter(10, 100)
+                .WithEngineFlags(EngineCommandFlags.Archive));
+
+            _cl_cmdbackup = CommandContext.RegisterVariable(new VariableInfo("cl_cmdbackup")
+                .WithHelpInfo("Number of previously sent user commands to send again in every packet, so lost packets don't lose commands")
+                .WithValue(2)
+                .WithMinMaxFilter(0, 8, true)
+                .WithEngineFlags(EngineCommandFlags.Archive));
 
             _clientModels = new ClientModels(_engine.ModelManager);
 
@@ -200,6 +227,14 @@ namespace SharpLife.Engine.Client.Host
             _engine.CommandSystem.DestroyContext(CommandContext);
         }
 
+        private void OnUserInfoChanged(ref VariableChangeEvent @event)
+        {
+            if (@event.Different)
+            {
+                _netClient?.SendUserInfo();
+            }
+        }
+
         private void WriteConfigFile()
         {
             var configFileName = $"cfg/config{FileExtensionUtils.AsExtension(Framework.Extension.CFG)}";
@@ -244,6 +279,11 @@ namespace SharpLife.Engine.Client.Host
                 //Always read packets, even if not connected to process disconnects fully
                 _netClient.ReadPackets();
                 _netClient.RunFrame();
+
+                if (_netClient.IsPlayingDemo)
+                {
+                    ReadDemoMessages(deltaSeconds);
+                }
             }
 
             _game.Update(deltaSeconds);
@@ -251,6 +291,8 @@ namespace SharpLife.Engine.Client.Host
             //Only send messages if we're still actively connected, once we start disconnecting all user messages should be stopped
             if (_netClient != null && _netClient.IsConnected && !_netClient.IsDisconnecting)
             {
+                SendUserCommands();
+
                 _netClient.SendServerMessages(_netClient.Server);
             }
         }
@@ -22,6 +22,8 @@ using SharpLife.Engine.Client.Servers;
 using SharpLife.Engine.Shared.Events;
 using SharpLife.Networking.Shared;
 using SharpLife.Networking.Shared.Communication.BinaryData;
+using SharpLife.Networking.Shared.Communication.Demos;
+using SharpLife.Networking.Shared.Communication.Loopback;
 using SharpLife.Networking.Shared.Communication.Messages;
 using SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData;
 using SharpLife.Networking.Shared.Communication.NetworkObjectLists.Reception;
@@ -32,6 +34,8 @@ using SharpLife.Networking.Shared.Messages.NetworkObjectLists;
 using SharpLife.Networking.Shared.Messages.NetworkStringLists;
 using SharpLife.Networking.Shared.Messages.Server;
 using System;
+using System.Collections.Generic;
+using System.IO;
 using System.Net;
 
 namespace SharpLife.Engine.Client.Networking
@@ -43,9 +47,11 @@ namespace SharpLife.Engine.Client.Networking
         IMessageReceiveHandler<ConnectAcknowledgement>,
         IMessageReceiveHandler<BinaryMetaData>,
         IMessageReceiveHandler<NetworkStringListFullUpdate>,
+        IMessageReceiveHandler<NetworkStringListFullUpdateChunk>,
         IMessageReceiveHandler<NetworkStringListUpdate>,
         IMessageReceiveHandler<NetworkStringListFullUpdatesComplete>,
         IMessageReceiveHandler<NetworkObjectListFrameListUpdate>,
+        IMessageReceiveHandler<NetworkObjectListObjectMetaDataHash>,
         IMessageReceiveHandler<NetworkObjectListObjectMetaDataList>,
         IMessageReceiveHandler<NetworkObjectListListMetaDataList>
     {
@@ -63,6 +69,10 @@ namespace SharpLife.Engine.Client.Networking
 
         public bool IsDisconnecting { get; private set; }
 
+        public bool IsRecordingDemo => _demoRecorder != null;
+
+        public bool IsPlayingDemo => _demoPlayback != null;
+
         private readonly ILogger _logger;
 
         private readonly EngineClientHost _clientHost;
@@ -79,10 +89,34 @@ namespace SharpLife.Engine.Client.Networking
 
         private readonly IVariable _cl_name;
 
+        private readonly IVariable _rate;
+
+        private readonly LoopbackChannel _loopback;
+
         private readonly NetClient _client;
 
+        /// <summary>
+        /// Always kept up to date so recording can start at any time
+        /// </summary>
+        private readonly DemoSignOnState _signOnState = new DemoSignOnState();
+
+        private DemoRecorder _demoRecorder;
+
+        private DemoReader _demoPlayback;
+
+        private double _demoTime;
+
+        /// <summary>
+        /// Set when the demo contains data that can't be read, playback can't continue past it
+        /// </summary>
+        private bool _demoCorrupt;
+
+        private readonly List<IMessage> _demoMessages = new List<IMessage>();
+
         protected override NetPeer Peer => _client;
 
+        protected override MessagesReceiveHandler ReceiveHandler => _receiveHandler;
+
         public ClientServer Server { get; private set; }
 
         public bool TraceMessageLogging
@@ -120,6 +154,8 @@ namespace SharpLife.Engine.Client.Networking
         /// <param name="binaryDataDescriptorSet"></param>
         /// <param name="objectListTypeRegistry"></param>
         /// <param name="cl_name"></param>
+        /// <param name="rate"></param>
+        /// <param name="loopback">Channel to use when connecting to a listen server in this process. Optional</param>
         /// <param name="appIdentifier">App identifier to use for networking. Must match the identifier given to servers</param>
         /// <param name="port">Port to use</param>
         /// <param name="resendHandshakeInterval"></param>
@@ -132,6 +168,8 @@ namespace SharpLife.Engine.Client.Networking
             BinaryDataReceptionDescriptorSet binaryDataDescriptorSet,
             TypeRegistry objectListTypeRegistry,
             IVariable cl_name,
+            IVariable rate,
+            LoopbackChannel loopback,
             string appIdentifier,
             int port,
             float resendHandshakeInterval,
@@ -146,14 +184,18 @@ namespace SharpLife.Engine.Client.Networking
             _objectListTypeRegistry = objectListTypeRegistry ?? throw new ArgumentNullException(nameof(objectListTypeRegistry));
 
             _cl_name = cl_name ?? throw new ArgumentNullException(nameof(cl_name));
+            _rate = rate ?? throw new ArgumentNullException(nameof(rate));
+            _loopback = loopback;
 
             //Register our handlers
             _receiveHandler.RegisterHandler<ConnectAcknowledgement>(this);
             _receiveHandler.RegisterHandler<BinaryMetaData>(this);
             _receiveHandler.RegisterHandler<NetworkStringListFullUpdate>(this);
+            _receiveHandler.RegisterHandler<NetworkStringListFullUpdateChunk>(this);
             _receiveHandler.RegisterHandler<NetworkStringListUpdate>(this);
             _receiveHandler.RegisterHandler<NetworkStringListFullUpdatesComplete>(this);
             _receiveHandler.RegisterHandler<NetworkObjectListFrameListUpdate>(this);
+            _receiveHandler.RegisterHandler<NetworkObjectListObjectMetaDataHash>(this);
             _receiveHandler.RegisterHandler<NetworkObjectListObjectMetaDataList>(this);
             _receiveHandler.RegisterHandler<NetworkObjectListListMetaDataList>(this);
 
@@ -190,6 +232,8 @@ namespace SharpLife.Engine.Client.Networking
                 OnFullyDisconnected?.Invoke();
                 OnFullyDisconnected = null;
             }
+
+            _demoRecorder?.Flush(_clientHost.Time.ElapsedTime);
         }
 
         public void Connect(string address)
@@ -220,8 +264,10 @@ namespace SharpLife.Engine.Client.Networking
 
             _clientHost.EventSystem.DispatchEvent(EngineEvents.ClientStartConnect);
 
+            var isLocal = address == NetAddresses.Local;
+
             //Told to connect to listen server, translate address
-            if (address == NetAddresses.Local)
+            if (isLocal)
             {
                 address = NetConstants.LocalHost;
             }
@@ -250,10 +296,15 @@ namespace SharpLife.Engine.Client.Networking
             //Send protocol version first so compatibility is known
             message.WriteVariableUInt32(NetConstants.ProtocolVersion);
 
-            var userInfo = new ClientUserInfo
+            var userInfo = CreateUserInfo();
+
+            //Let our own listen server know that it can send messages to us directly
+            if (isLocal && _loopback != null)
             {
-                Name = _cl_name.String
-            };
+                _loopback.Clear();
+
+                userInfo.LoopbackId = _loopback.Id;
+            }
 
             using (var stream = new NetBufferStream(message))
             {
@@ -281,6 +332,9 @@ namespace SharpLife.Engine.Client.Networking
         /// <param name="byeMessage"></param>
         public void Disconnect(string byeMessage)
         {
+            StopRecording();
+            StopPlayback();
+
             //Don't disconnect if not connected or if already disconnecting
             if (IsConnected && !IsDisconnecting)
             {
@@ -308,10 +362,6 @@ namespace SharpLife.Engine.Client.Networking
                     //TODO: implement
                     break;
 
-                case NetIncomingMessageType.Data:
-                    HandleData(message);
-                    break;
-
                 case NetIncomingMessageType.VerboseDebugMessage:
                     _logger.Verbose(message.ReadString());
                     break;
@@ -359,6 +409,9 @@ namespace SharpLife.Engine.Client.Networking
 
                         Server = null;
 
+                        StopRecording();
+                        _signOnState.Clear();
+
                         IsDisconnecting = false;
                         _doFullDisconnectCallback = true;
 
@@ -367,14 +420,245 @@ namespace SharpLife.Engine.Client.Networking
             }
         }
 
-        private void HandleData(NetIncomingMessage message)
+        protected override void HandleMessages(NetConnection sender, IReadOnlyList<IMessage> messages)
         {
             if (ConnectionSetupStatus == ClientConnectionSetupStatus.NotConnected)
             {
                 return;
             }
 
-            _receiveHandler.ReadMessages(message.SenderConnection, message);
+            for (var i = 0; i < messages.Count; ++i)
+            {
+                RecordMessage(messages[i]);
+            }
+
+            _receiveHandler.DispatchMessages(sender, messages);
+        }
+
+        private void RecordMessage(IMessage message)
+        {
+            _signOnState.Add(message);
+            _demoRecorder?.Record(message);
+        }
+
+        protected override void ReadLoopbackMessages()
+        {
+            if (_loopback == null)
+            {
+                return;
+            }
+
+            while (_loopback.TryReceiveOnClient(out var message))
+            {
+                //Discard messages that are still queued from a previous connection
+                if (ConnectionSetupStatus == ClientConnectionSetupStatus.NotConnected || Server == null)
+                {
+                    continue;
+                }
+
+                //The server only uses the loopback channel if it accepted us as its local client, so respond the same way
+                Server.Loopback = _loopback;
+
+                RecordMessage(message);
+
+                _receiveHandler.DispatchMessage(Server.Connection, message);
+            }
+        }
+
+        /// <summary>
+        /// Starts recording all messages received from the server
+        /// </summary>
+        /// <param name="writer">Writer to write the demo to. The client takes ownership of it</param>
+        /// <param name="keyframeInterval">Minimum amount of time between keyframes, in seconds</param>
+        public void StartRecording(DemoWriter writer, double keyframeInterval)
+        {
+            if (writer == null)
+            {
+                throw new ArgumentNullException(nameof(writer));
+            }
+
+            if (ConnectionSetupStatus != ClientConnectionSetupStatus.Connected || IsPlayingDemo)
+            {
+                throw new InvalidOperationException("Can only record demos while connected to a server");
+            }
+
+            if (IsRecordingDemo)
+            {
+                throw new InvalidOperationException("Already recording a demo");
+            }
+
+            _demoRecorder = new DemoRecorder(
+                writer,
+                _objectListTypeRegistry,
+                _signOnState,
+                () => _objectListReceiver?.SerializeFrameLists() ?? new List<NetworkObjectListFrameListUpdate>(),
+                keyframeInterval);
+        }
+
+        public void StopRecording()
+        {
+            if (_demoRecorder != null)
+            {
+                _demoRecorder.Flush(_clientHost.Time.ElapsedTime);
+                _demoRecorder.Dispose();
+                _demoRecorder = null;
+            }
+        }
+
+        /// <summary>
+        /// Starts playing back a demo
+        /// Messages from the demo are handled as though they were received from a server
+        /// Playback starts at the first keyframe
+        /// </summary>
+        /// <param name="name">Name of the demo</param>
+        /// <param name="reader">Demo to play back. Must have at least one keyframe. The client takes ownership of it</param>
+        public void StartPlayback(string name, DemoReader reader)
+        {
+            if (name == null)
+            {
+                throw new ArgumentNullException(nameof(name));
+            }
+
+            if (reader == null)
+            {
+                throw new ArgumentNullException(nameof(reader));
+            }
+
+            if (IsConnected || IsPlayingDemo)
+            {
+                throw new InvalidOperationException("Cannot play back a demo while connected to a server");
+            }
+
+            if (reader.Keyframes.Count == 0)
+            {
+                throw new ArgumentException("Demo has no keyframes", nameof(reader));
+            }
+
+            _demoPlayback = reader;
+
+            ConnectionSetupStatus = ClientConnectionSetupStatus.Connected;
+
+            Server = new ClientServer(_sendMappings, name, null);
+
+            SeekPlayback(0);
+        }
+
+        /// <summary>
+        /// Continues playback at the given time
+        /// Restores the state at the closest keyframe before the given time, then handles all messages up to that time
+        /// </summary>
+        /// <param name="time">Time since the first keyframe, in seconds</param>
+        public void SeekPlayback(double time)
+        {
+            if (_demoPlayback == null)
+            {
+                throw new InvalidOperationException("Not playing a demo");
+            }
+
+            time += _demoPlayback.Keyframes[0].Time;
+
+            var keyframe = _demoPlayback.Keyframes[Math.Max(0, _demoPlayback.FindKeyframe(time))];
+
+            _demoPlayback.Seek(keyframe);
+
+            _demoCorrupt = false;
+
+            //Contains everything needed to set up the map, followed by the state of all objects
+            if (!PlayDemoChunk())
+            {
+                return;
+            }
+
+            _demoTime = keyframe.Time;
+
+            ReadPlaybackMessages(Math.Max(0, time - keyframe.Time));
+        }
+
+        /// <summary>
+        /// Handles all demo messages up to the current playback time
+        /// </summary>
+        /// <param name="deltaTime">Time since the last call</param>
+        /// <returns>Whether there are more messages to play back</returns>
+        public bool ReadPlaybackMessages(double deltaTime)
+        {
+            if (_demoPlayback == null)
+            {
+                throw new InvalidOperationException("Not playing a demo");
+            }
+
+            _demoTime += deltaTime;
+
+            while (!_demoCorrupt && _demoPlayback.TryPeekChunk(out var type, out var time))
+            {
+                if (time > _demoTime)
+                {
+                    return true;
+                }
+
+                //Keyframes are only needed when seeking
+                if (type == DemoChunkType.Keyframe)
+                {
+                    try
+                    {
+                        _demoPlayback.SkipChunk();
+                    }
+                    catch (InvalidDataException e)
+                    {
+                        OnDemoCorrupt(e);
+                    }
+
+                    continue;
+                }
+
+                PlayDemoChunk();
+            }
+
+            return false;
+        }
+
+        /// <summary>
+        /// Reads the next demo chunk and handles its messages
+        /// </summary>
+        /// <returns>Whether the chunk could be read</returns>
+        private bool PlayDemoChunk()
+        {
+            _demoMessages.Clear();
+
+            try
+            {
+                _demoPlayback.ReadChunk(_demoMessages);
+
+                _receiveHandler.DispatchMessages(null, _demoMessages);
+            }
+            catch (Exception e) when (e is InvalidDataException || e is InvalidProtocolBufferException)
+            {
+                OnDemoCorrupt(e);
+                return false;
+            }
+
+            return true;
+        }
+
+        private void OnDemoCorrupt(Exception e)
+        {
+            _logger.Error(e, "Demo contains invalid data, ending playback");
+
+            _demoMessages.Clear();
+            _demoCorrupt = true;
+        }
+
+        public void StopPlayback()
+        {
+            if (_demoPlayback != null)
+            {
+                _demoPlayback.Dispose();
+                _demoPlayback = null;
+
+                _demoMessages.Clear();
+
+                ConnectionSetupStatus = ClientConnectionSetupStatus.NotConnected;
+                Server = null;
+            }
         }
 
         /// <summary>
@@ -388,14 +672,23 @@ namespace SharpLife.Engine.Client.Networking
                 throw new ArgumentNullException(nameof(server));
             }
 
-            if (server.HasPendingMessages())
+            if (server.HasPendingMessages(true))
             {
                 var reliable = CreatePacket();
 
-                server.WriteMessages(reliable);
+                server.WriteMessages(reliable, true);
 
                 SendPacket(reliable, server.Connection, NetDeliveryMethod.ReliableOrdered);
             }
+
+            if (server.HasPendingMessages(false))
+            {
+                var unreliable = CreatePacket();
+
+                server.WriteMessages(unreliable, false);
+
+                SendPacket(unreliable, server.Connection, NetDeliveryMethod.UnreliableSequenced);
+            }
         }
 
         /// <summary>
@@ -419,9 +712,32 @@ namespace SharpLife.Engine.Client.Networking
             _objectListReceiver = new NetworkObjectListReceiver(_objectListTypeRegistry, 8, _objectListReceiverListener);
         }
 
+        private ClientUserInfo CreateUserInfo()
+        {
+            return new ClientUserInfo
+            {
+                Name = _cl_name.String,
+                Rate = (uint)_rate.Integer
+            };
+        }
+
+        /// <summary>
+        /// Sends the current user info to the server so changes take effect without reconnecting
+        /// Does nothing if not connected to a server
+        /// </summary>
+        public void SendUserInfo()
+        {
+            if (ConnectionSetupStatus != ClientConnectionSetupStatus.Connected || IsPlayingDemo)
+            {
+                return;
+            }
+
+            Server.AddMessage(CreateUserInfo(), true);
+        }
+
         internal void RequestResources()
         {
-            Server.AddMessage(new SendResources());
+            Server.AddMessage(new SendResources(), true);
         }
 
         public void ReceiveMessage(NetConnection connection, ConnectAcknowledgement message)
@@ -453,7 +769,7 @@ namespace SharpLife.Engine.Client.Networking
 
             var newConnection = new NewConnection();
 
-            Server.AddMessage(newConnection);
+            Server.AddMessage(newConnection, true);
         }
 
         public void ReceiveMessage(NetConnection connection, BinaryMetaData message)
@@ -479,6 +795,25 @@ namespace SharpLife.Engine.Client.Networking
             RequestResources();
         }
 
+        public void ReceiveMessage(NetConnection connection, NetworkStringListFullUpdateChunk message)
+        {
+            try
+            {
+                if (!_stringListReceiver.ProcessFullUpdateChunk(message))
+                {
+                    return;
+                }
+            }
+            catch (InvalidOperationException e)
+            {
+                _logger.Error(e, "An error occurred while processing a string list full update");
+                _clientHost.Disconnect(true);
+                return;
+            }
+
+            RequestResources();
+        }
+
         public void ReceiveMessage(NetConnection connection, NetworkStringListUpdate message)
         {
             _stringListReceiver.ProcessUpdate(message);
@@ -491,8 +826,25 @@ namespace SharpLife.Engine.Client.Networking
 
         public void ReceiveMessage(NetConnection connection, NetworkObjectListFrameListUpdate message)
         {
-            _objectListReceiver.DeserializeFrameList(message);
-            _objectListReceiver.ApplyCurrentFrame();
+            if (_objectListReceiver.DeserializeFrameList(message))
+            {
+                _objectListReceiver.ApplyCurrentFrame();
+
+                //Lets the server delta encode against this frame list
+                Server.AddMessage(new NetworkObjectListFrameListAck { Sequence = message.Sequence }, false);
+            }
+        }
+
+        public void ReceiveMessage(NetConnection connection, NetworkObjectListObjectMetaDataHash message)
+        {
+            if (_objectListTypeRegistry.TryUseCachedMetaData(message.Hash))
+            {
+                RequestResources();
+            }
+            else
+            {
+                Server.AddMessage(new NetworkObjectListObjectMetaDataRequest(), true);
+            }
         }
 
         public void ReceiveMessage(NetConnection connection, NetworkObjectListObjectMetaDataList message)
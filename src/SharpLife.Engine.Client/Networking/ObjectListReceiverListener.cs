@@ -19,11 +19,11 @@ namespace SharpLife.Engine.Client.Networking
             _listeners.Add(id, listener);
         }
 
-        public void OnBeginProcessList(INetworkObjectList networkObjectList)
+        public void OnBeginProcessList(INetworkObjectList networkObjectList, double serverTime)
         {
             if (_listeners.TryGetValue(networkObjectList.Id, out var listener))
             {
-                listener.OnBeginProcessList(networkObjectList);
+                listener.OnBeginProcessList(networkObjectList, serverTime);
             }
         }
 
@@ -15,6 +15,7 @@
 
 using Google.Protobuf;
 using Lidgren.Network;
+using SharpLife.Networking.Shared.Communication.Loopback;
 using SharpLife.Networking.Shared.Communication.Messages;
 using System;
 using System.Net;
@@ -32,6 +33,10 @@ namespace SharpLife.Engine.Client.Servers
         /// </summary>
         public string Name { get; }
 
+        /// <summary>
+        /// Connection to the server
+        /// Null when playing back a demo, messages sent to the server are discarded
+        /// </summary>
         public NetConnection Connection { get; }
 
         /// <summary>
@@ -39,34 +44,58 @@ namespace SharpLife.Engine.Client.Servers
         /// </summary>
         public IPEndPoint TrueAddress { get; set; } = new IPEndPoint(IPAddress.None, 0);
 
-        private readonly PendingMessages _pendingMessages;
+        /// <summary>
+        /// If this is a listen server running in this process, the channel to send messages through instead of the connection
+        /// </summary>
+        public LoopbackChannel Loopback { get; set; }
+
+        private readonly PendingMessages _reliableMessages;
+
+        private readonly PendingMessages _unreliableMessages;
 
         public ClientServer(SendMappings sendMappings, string name, NetConnection connection)
         {
+            if (sendMappings == null)
+            {
+                throw new ArgumentNullException(nameof(sendMappings));
+            }
+
             Name = name ?? throw new ArgumentNullException(nameof(name));
-            Connection = connection ?? throw new ArgumentNullException(nameof(connection));
+            Connection = connection;
 
-            _pendingMessages = new PendingMessages(sendMappings ?? throw new ArgumentNullException(nameof(sendMappings)));
+            _reliableMessages = new PendingMessages(sendMappings);
+            _unreliableMessages = new PendingMessages(sendMappings);
         }
 
-        private PendingMessages GetMessages()
+        private PendingMessages GetMessages(bool reliable)
         {
-            return _pendingMessages;
+            return reliable ? _reliableMessages : _unreliableMessages;
         }
 
-        public bool HasPendingMessages()
+        public bool HasPendingMessages(bool reliable)
         {
-            return GetMessages().MessageCount > 0;
+            return GetMessages(reliable).MessageCount > 0;
         }
 
-        public void AddMessage(IMessage message)
+        public void AddMessage(IMessage message, bool reliable)
         {
             if (message == null)
             {
                 throw new ArgumentNullException(nameof(message));
             }
 
-            GetMessages().Add(message);
+            if (Connection == null)
+            {
+                return;
+            }
+
+            if (Loopback != null)
+            {
+                Loopback.SendToServer(message);
+                return;
+            }
+
+            GetMessages(reliable).Add(message);
         }
 
         /// <summary>
@@ -74,14 +103,14 @@ namespace SharpLife.Engine.Client.Servers
         /// </summary>
         /// <param name="message"></param>
         /// <param name="reliable"></param>
-        public void WriteMessages(NetOutgoingMessage message)
+        public void WriteMessages(NetOutgoingMessage message, bool reliable)
         {
             if (message == null)
             {
                 throw new ArgumentNullException(nameof(message));
             }
 
-            GetMessages().Write(message);
+            GetMessages(reliable).Write(message);
         }
     }
 }
@@ -15,9 +15,15 @@
 
 using Google.Protobuf;
 using Lidgren.Network;
+using SharpLife.Engine.Server.Networking;
+using SharpLife.Networking.Shared;
+using SharpLife.Networking.Shared.Communication.Demos;
+using SharpLife.Networking.Shared.Communication.Loopback;
 using SharpLife.Networking.Shared.Communication.Messages;
 using SharpLife.Networking.Shared.Communication.NetworkObjectLists;
+using SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData;
 using SharpLife.Networking.Shared.Communication.NetworkObjectLists.Transmission;
+using SharpLife.Networking.Shared.Messages.NetworkStringLists;
 using SharpLife.Utility;
 using System;
 using System.Collections.Generic;
@@ -36,6 +42,8 @@ namespace SharpLife.Engine.Server.Clients
 
         private readonly ITime _engineTime;
 
+        private readonly IServerNetworkListener _networkListener;
+
         public IPEndPoint RemoteEndPoint => Connection?.RemoteEndPoint;
 
         /// <summary>
@@ -53,6 +61,12 @@ namespace SharpLife.Engine.Server.Clients
         /// </summary>
         public bool IsFakeClient { get; }
 
+        /// <summary>
+        /// If this is the local client of a listen server, the channel that messages are sent through instead of the connection
+        /// Messages sent this way are not serialized or subject to the rate limit
+        /// </summary>
+        public LoopbackChannel Loopback { get; }
+
         public bool Connected { get; set; }
 
         public double ConnectionStarted { get; set; }
@@ -81,24 +95,70 @@ namespace SharpLife.Engine.Server.Clients
         /// </summary>
         public int NextStringListToSend { get; set; } = -1;
 
-        private readonly PendingMessages _reliableMessages;
+        /// <summary>
+        /// Chunks of the string list full update that is being sent, null if none is being sent
+        /// </summary>
+        private IReadOnlyList<NetworkStringListFullUpdateChunk> _stringListChunks;
+
+        private int _nextStringListChunk;
+
+        /// <summary>
+        /// Whether a string list full update is still being sent
+        /// </summary>
+        public bool SendingStringListChunks => _stringListChunks != null;
+
+        private readonly MessageScheduler _reliableMessages;
 
         private readonly PendingMessages _unreliableMessages;
 
         public INetworkFrameListTransmitter FrameListTransmitter { get; }
 
+        /// <summary>
+        /// Always kept up to date so recording can start at any time
+        /// </summary>
+        private readonly DemoSignOnState _signOnState = new DemoSignOnState();
+
+        private DemoRecorder _demoRecorder;
+
+        public bool IsRecordingDemo => _demoRecorder != null;
+
+        private int MaxPacketSize => Connection.CurrentMTU - NetConstants.PacketHeaderReserve;
+
         private readonly float _objectListMessageInterval = 0.1f;
 
         public float NextObjectListMessageTime { get; private set; }
 
         //Send frames when the client is fully connected and when updates should be sent
-        public bool CanTransmit => SetupStage == ServerClientSetupStage.Connected && NextObjectListMessageTime <= _engineTime.ElapsedTime;
+        //Frames can reference strings that haven't been sent yet, so the client is choked until they have
+        //Frames are sent unreliably but still count towards the rate, the client is also choked until the rate allows more data
+        public bool CanTransmit => SetupStage == ServerClientSetupStage.Connected
+            && NextObjectListMessageTime <= _engineTime.ElapsedTime
+            && !_reliableMessages.HasPendingMessages(MessagePriority.StringLists)
+            && _reliableMessages.HasBudget(_engineTime.ElapsedTime);
+
+        /// <summary>
+        /// Maximum number of bytes to send to this client per second
+        /// 0 if there is no limit
+        /// </summary>
+        public int Rate
+        {
+            get => _reliableMessages?.Rate ?? 0;
+            set
+            {
+                if (_reliableMessages != null)
+                {
+                    _reliableMessages.Rate = value;
+                }
+            }
+        }
 
         private ServerClient(
             SendMappings sendMappings,
             NetConnection connection,
             ITime engineTime,
+            IServerNetworkListener networkListener,
             NetworkObjectListTransmitter objectListTransmitter,
+            LoopbackChannel loopback,
             int index,
             int userId,
             string name)
@@ -107,6 +167,7 @@ namespace SharpLife.Engine.Server.Clients
             Connection = connection ?? throw new ArgumentNullException(nameof(connection));
 
             _engineTime = engineTime ?? throw new ArgumentNullException(nameof(engineTime));
+            _networkListener = networkListener ?? throw new ArgumentNullException(nameof(networkListener));
 
             if (objectListTransmitter == null)
             {
@@ -115,11 +176,13 @@ namespace SharpLife.Engine.Server.Clients
 
             FrameListTransmitter = objectListTransmitter.CreateTransmitter(this);
 
+            Loopback = loopback;
+
             Index = index;
             UserId = userId;
             Name = name ?? throw new ArgumentNullException(nameof(name));
 
-            _reliableMessages = new PendingMessages(_sendMappings);
+            _reliableMessages = new MessageScheduler(_sendMappings);
             _unreliableMessages = new PendingMessages(_sendMappings);
         }
 
@@ -141,12 +204,59 @@ namespace SharpLife.Engine.Server.Clients
             SendMappings sendMappings,
             NetConnection connection,
             ITime engineTime,
+            IServerNetworkListener networkListener,
             NetworkObjectListTransmitter objectListTransmitter,
+            LoopbackChannel loopback,
             int index,
             int userId,
             string name)
         {
-            return new ServerClient(sendMappings, connection, engineTime, objectListTransmitter, index, userId, name);
+            return new ServerClient(sendMappings, connection, engineTime, networkListener, objectListTransmitter, loopback, index, userId, name);
+        }
+
+        /// <summary>
+        /// Begins sending a compressed string list full update
+        /// The chunks are sent over multiple frames by <see cref="SendStringListChunks"/>
+        /// </summary>
+        /// <param name="chunks"></param>
+        public void BeginStringListFullUpdate(IReadOnlyList<NetworkStringListFullUpdateChunk> chunks)
+        {
+            _stringListChunks = chunks ?? throw new ArgumentNullException(nameof(chunks));
+            _nextStringListChunk = 0;
+        }
+
+        /// <summary>
+        /// Adds the next string list full update chunks to the reliable messages
+        /// No more chunks are added than the rate allows to be sent right now, so large lists don't flood the connection
+        /// </summary>
+        /// <param name="maxChunks"></param>
+        public void SendStringListChunks(int maxChunks)
+        {
+            //Wait until the previous chunks have been sent if the rate limit is holding them back
+            if (_stringListChunks == null || _reliableMessages.HasPendingMessages(MessagePriority.StringLists))
+            {
+                return;
+            }
+
+            if (!IsFakeClient && Loopback == null)
+            {
+                var budget = _reliableMessages.GetAvailableBudget(_engineTime.ElapsedTime, MaxPacketSize);
+
+                //Always send at least one chunk to guarantee progress
+                maxChunks = Math.Max(1, Math.Min(maxChunks, budget / NetConstants.StringListChunkSize));
+            }
+
+            var lastChunk = Math.Min(_stringListChunks.Count, _nextStringListChunk + maxChunks);
+
+            for (; _nextStringListChunk < lastChunk; ++_nextStringListChunk)
+            {
+                AddMessage(_stringListChunks[_nextStringListChunk], MessagePriority.StringLists);
+            }
+
+            if (_nextStringListChunk >= _stringListChunks.Count)
+            {
+                _stringListChunks = null;
+            }
         }
 
         /// <summary>
@@ -161,17 +271,57 @@ namespace SharpLife.Engine.Server.Clients
             return new ServerClient(index, userId, name);
         }
 
-        private PendingMessages GetMessages(bool reliable)
+        public bool HasPendingMessages(bool reliable)
         {
-            return reliable ? _reliableMessages : _unreliableMessages;
+            if (reliable)
+            {
+                return _reliableMessages.MessageCount > 0;
+            }
+
+            return _unreliableMessages.MessageCount > 0;
         }
 
-        public bool HasPendingMessages(bool reliable)
+        /// <summary>
+        /// Adds a message to send
+        /// Reliable messages added this way are control messages
+        /// </summary>
+        /// <param name="message"></param>
+        /// <param name="reliable"></param>
+        public void AddMessage(IMessage message, bool reliable)
         {
-            return GetMessages(reliable).MessageCount > 0;
+            if (reliable)
+            {
+                AddMessage(message, MessagePriority.Control);
+                return;
+            }
+
+            if (IsFakeClient)
+            {
+                return;
+            }
+
+            if (message == null)
+            {
+                throw new ArgumentNullException(nameof(message));
+            }
+
+            RecordMessage(message);
+
+            if (Loopback != null)
+            {
+                Loopback.SendToClient(message);
+                return;
+            }
+
+            _unreliableMessages.Add(message);
         }
 
-        public void AddMessage(IMessage message, bool reliable)
+        /// <summary>
+        /// Adds a reliable message to send with the given priority
+        /// </summary>
+        /// <param name="message"></param>
+        /// <param name="priority"></param>
+        public void AddMessage(IMessage message, MessagePriority priority)
         {
             if (IsFakeClient)
             {
@@ -183,7 +333,65 @@ namespace SharpLife.Engine.Server.Clients
                 throw new ArgumentNullException(nameof(message));
             }
 
-            GetMessages(reliable).Add(message);
+            RecordMessage(message);
+
+            if (Loopback != null)
+            {
+                Loopback.SendToClient(message);
+                return;
+            }
+
+            _reliableMessages.Add(message, priority);
+        }
+
+        private void RecordMessage(IMessage message)
+        {
+            _signOnState.Add(message);
+            _demoRecorder?.Record(message);
+        }
+
+        /// <summary>
+        /// Starts recording all messages sent to this client
+        /// </summary>
+        /// <param name="writer">Writer to write the demo to. The client takes ownership of it</param>
+        /// <param name="typeRegistry">Type registry used to transmit objects to this client</param>
+        /// <param name="keyframeInterval">Minimum amount of time between keyframes, in seconds</param>
+        public void StartRecording(DemoWriter writer, TypeRegistry typeRegistry, double keyframeInterval)
+        {
+            if (writer == null)
+            {
+                throw new ArgumentNullException(nameof(writer));
+            }
+
+            if (IsFakeClient)
+            {
+                throw new InvalidOperationException("Cannot record demos for fake clients");
+            }
+
+            if (IsRecordingDemo)
+            {
+                throw new InvalidOperationException("Already recording a demo");
+            }
+
+            _demoRecorder = new DemoRecorder(writer, typeRegistry, _signOnState, FrameListTransmitter.SerializeFullFrameLists, keyframeInterval);
+        }
+
+        public void StopRecording()
+        {
+            if (_demoRecorder != null)
+            {
+                _demoRecorder.Flush(_engineTime.ElapsedTime);
+                _demoRecorder.Dispose();
+                _demoRecorder = null;
+            }
+        }
+
+        /// <summary>
+        /// Writes the messages added since the last call to the demo being recorded, if any
+        /// </summary>
+        public void FlushDemo()
+        {
+            _demoRecorder?.Flush(_engineTime.ElapsedTime);
         }
 
         public void AddMessages(IEnumerable<IMessage> messages, bool reliable)
@@ -198,27 +406,49 @@ namespace SharpLife.Engine.Server.Clients
                 throw new ArgumentNullException(nameof(messages));
             }
 
-            GetMessages(reliable).AddRange(messages);
+            foreach (var message in messages)
+            {
+                AddMessage(message, reliable);
+            }
+        }
+
+        /// <summary>
+        /// Sends as many reliable messages as this client's rate allows
+        /// </summary>
+        /// <param name="peer"></param>
+        public void SendReliableMessages(NetworkPeer peer)
+        {
+            _reliableMessages.Send(peer, Connection, _engineTime.ElapsedTime, MaxPacketSize);
         }
 
         /// <summary>
-        /// Writes all pending messages to the outgoing message
+        /// Writes all pending unreliable messages to the outgoing message
         /// </summary>
         /// <param name="message"></param>
-        /// <param name="reliable"></param>
-        public void WriteMessages(NetOutgoingMessage message, bool reliable)
+        public void WriteUnreliableMessages(NetOutgoingMessage message)
         {
             if (message == null)
             {
                 throw new ArgumentNullException(nameof(message));
             }
 
-            GetMessages(reliable).Write(message);
+            _unreliableMessages.Write(message);
         }
 
         public void SendObjectListFrames()
         {
-            AddMessage(FrameListTransmitter.SerializeCurrentFrameList(), true);
+            var frameList = FrameListTransmitter.SerializeCurrentFrameList();
+
+            //Lets the client interpolate between frames
+            frameList.ServerTime = _engineTime.ElapsedTime;
+
+            //Frames are delta encoded against the last frame list the client acknowledged, so lost frames don't have to be resent
+            AddMessage(frameList, false);
+
+            if (Loopback == null)
+            {
+                _reliableMessages.ConsumeBudget(frameList.CalculateSize(), _engineTime.ElapsedTime, MaxPacketSize);
+            }
 
             //TODO: let user define message interval
             NextObjectListMessageTime = (float)(_engineTime.ElapsedTime + _objectListMessageInterval);
@@ -226,6 +456,7 @@ namespace SharpLife.Engine.Server.Clients
 
         public void OnBeginProcessList(INetworkObjectList networkObjectList)
         {
+            _networkListener.BeginFilterNetworkObjects(Index, networkObjectList);
         }
 
         public void OnEndProcessList(INetworkObjectList networkObjectList)
@@ -234,7 +465,7 @@ namespace SharpLife.Engine.Server.Clients
 
         public bool FilterNetworkObject(INetworkObjectList networkObjectList, INetworkObject networkObject)
         {
-            return true;
+            return _networkListener.FilterNetworkObject(Index, networkObjectList, networkObject);
         }
     }
 }
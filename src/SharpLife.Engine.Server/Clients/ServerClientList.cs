@@ -38,6 +38,11 @@ namespace SharpLife.Engine.Server.Clients
         /// </summary>
         public int Count { get; private set; }
 
+        /// <summary>
+        /// Incremented whenever a client is added or removed
+        /// </summary>
+        public int ChangeCount { get; private set; }
+
         private readonly IVariable _maxPlayers;
 
         public ServerClientList(int maxClients, IVariable maxPlayers)
@@ -88,6 +93,7 @@ namespace SharpLife.Engine.Server.Clients
             _clients[slot] = client;
 
             ++Count;
+            ++ChangeCount;
         }
 
         public void RemoveClient(ServerClient client)
@@ -112,6 +118,7 @@ namespace SharpLife.Engine.Server.Clients
             _clients[index] = null;
 
             --Count;
+            ++ChangeCount;
         }
 
         public ServerClient FindClientByEndPoint(IPEndPoint endPoint, bool throwOnNotFound = true)
@@ -0,0 +1,131 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using SharpLife.CommandSystem.Commands;
+using SharpLife.CommandSystem.Commands.VariableFilters;
+using SharpLife.Engine.Server.Clients;
+using SharpLife.FileSystem;
+using SharpLife.Networking.Shared.Communication.Demos;
+using SharpLife.Utility.FileSystem;
+using System;
+using System.IO;
+
+namespace SharpLife.Engine.Server.Host
+{
+    public partial class EngineServerHost
+    {
+        private const string DemoExtension = ".dem";
+
+        private IVariable _sv_demo_keyframe_interval;
+
+        private void RegisterDemoCommands()
+        {
+            CommandContext.RegisterCommand(new CommandInfo("sv_demo_record", StartDemoRecording)
+                .WithHelpInfo("Records a demo of everything sent to a client"));
+
+            CommandContext.RegisterCommand(new CommandInfo("sv_demo_stop", StopDemoRecording)
+                .WithHelpInfo("Stops recording a demo of a client"));
+
+            _sv_demo_keyframe_interval = CommandContext.RegisterVariable(new VariableInfo("sv_demo_keyframe_interval")
+                .WithHelpInfo("Time between keyframes in demos recorded on the server, in seconds. Shorter intervals make seeking faster but demos larger")
+                .WithValue(5.0f)
+                .WithMinMaxFilter(1, null));
+        }
+
+        /// <summary>
+        /// Finds a client by slot index given as a command argument
+        /// </summary>
+        /// <param name="argument"></param>
+        private ServerClient FindDemoClient(string argument)
+        {
+            if (_netServer == null || !int.TryParse(argument, out var index))
+            {
+                return null;
+            }
+
+            foreach (var client in _netServer.ClientList)
+            {
+                if (client.Index == index)
+                {
+                    return client;
+                }
+            }
+
+            return null;
+        }
+
+        private void StartDemoRecording(ICommandArgs command)
+        {
+            if (command.Count < 2)
+            {
+                _logger.Information("usage: sv_demo_record <client slot> <demoname>");
+                return;
+            }
+
+            var client = FindDemoClient(command[0]);
+
+            if (client == null || client.IsFakeClient)
+            {
+                _logger.Information($"No client in slot {command[0]}");
+                return;
+            }
+
+            if (client.IsRecordingDemo)
+            {
+                _logger.Information($"Already recording a demo of {client.Name}");
+                return;
+            }
+
+            var fileName = Path.ChangeExtension(command[1], DemoExtension);
+
+            DemoWriter writer;
+
+            try
+            {
+                writer = new DemoWriter(FileSystem.Open(fileName, FileMode.Create, FileAccess.Write, FileSystemConstants.PathID.GameConfig));
+            }
+            catch (Exception e) when (e is IOException || e is UnauthorizedAccessException)
+            {
+                _logger.Error(e, $"Couldn't create demo \"{fileName}\"");
+                return;
+            }
+
+            client.StartRecording(writer, _objectListTypeRegistry, _sv_demo_keyframe_interval.Float);
+
+            _logger.Information($"Recording {client.Name} to \"{fileName}\"");
+        }
+
+        private void StopDemoRecording(ICommandArgs command)
+        {
+            if (command.Count == 0)
+            {
+                _logger.Information("usage: sv_demo_stop <client slot>");
+                return;
+            }
+
+            var client = FindDemoClient(command[0]);
+
+            if (client?.IsRecordingDemo != true)
+            {
+                _logger.Information($"Not recording a demo of the client in slot {command[0]}");
+                return;
+            }
+
+            client.StopRecording();
+
+            _logger.Information($"Completed demo of {client.Name}");
+        }
+    }
+}
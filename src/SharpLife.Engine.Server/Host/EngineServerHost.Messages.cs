@@ -24,11 +24,13 @@ using SharpLife.Networking.Shared.Messages.Server;
 namespace SharpLife.Engine.Server.Host
 {
     public partial class EngineServerHost :
-        IMessageReceiveHandler<NewConnection>
+        IMessageReceiveHandler<NewConnection>,
+        IMessageReceiveHandler<UserCommands>
     {
         private void RegisterMessageHandlers(MessagesReceiveHandler receiveHandler)
         {
             receiveHandler.RegisterHandler<NewConnection>(this);
+            receiveHandler.RegisterHandler<UserCommands>(this);
         }
 
         public void ReceiveMessage(NetConnection connection, NewConnection message)
@@ -41,12 +43,48 @@ namespace SharpLife.Engine.Server.Host
 
                 client.ConnectionStarted = _engine.EngineTime.ElapsedTime;
 
+                _serverNetworking.ResetClient(client.Index);
+
                 //TODO: send custom user messages
 
                 SendServerInfo(client);
             }
         }
 
+        public void ReceiveMessage(NetConnection connection, UserCommands message)
+        {
+            var client = _netServer.ClientList.FindClientByEndPoint(connection.RemoteEndPoint);
+
+            //Commands sent before the client finished connecting to the current map may be from a previous map
+            if (client.SetupStage != ServerClientSetupStage.Connected)
+            {
+                return;
+            }
+
+            _serverNetworking.ReceiveUserCommands(client.Index, message);
+        }
+
+        /// <summary>
+        /// Tells clients which of their commands have been run by the game
+        /// </summary>
+        private void SendUserCommandAcks()
+        {
+            foreach (var client in _netServer.ClientList)
+            {
+                if (client.SetupStage != ServerClientSetupStage.Connected)
+                {
+                    continue;
+                }
+
+                var message = _serverNetworking.CreateUserCommandAck(client.Index);
+
+                if (message != null)
+                {
+                    client.AddMessage(message, false);
+                }
+            }
+        }
+
         private void SendServerInfo(ServerClient client)
         {
             //TODO: add developer cvar
@@ -54,7 +92,7 @@ namespace SharpLife.Engine.Server.Host
             const int buildNumber = 0;
             client.AddMessage(new Print { MessageContents = $"{(char)2}\nBUILD {buildNumber} SERVER (0 CRC)\nServer # {_spawnCount}" }, true);
 
-            var gameServerInfo = _serverNetworking.CreateGameInfoMessage();
+            var gameServerInfo = _serverNetworking.CreateGameInfoMessage(client.Index);
 
             client.AddMessage(new ServerInfo
             {
@@ -63,7 +101,7 @@ namespace SharpLife.Engine.Server.Host
                 ClientDllMd5 = ByteString.Empty, //TODO: define
                 MaxClients = (uint)_maxPlayers.Integer,
                 GameName = _engine.GameDirectory,
-                HostName = "", //TODO: define cvar
+                HostName = _hostname.String,
                 GameInfo = gameServerInfo.ToByteString(),
             }, true);
 
@@ -13,14 +13,21 @@
 *
 ****/
 
+using SharpLife.CommandSystem.Commands;
 using SharpLife.Engine.Server.Networking;
 using SharpLife.Engine.Shared.API.Game.Server;
+using SharpLife.FileSystem;
 using SharpLife.Networking.Shared;
 using SharpLife.Networking.Shared.Communication.BinaryData;
+using SharpLife.Networking.Shared.Communication.Capture;
 using SharpLife.Networking.Shared.Communication.Messages;
+using SharpLife.Networking.Shared.Communication.NetworkObjectLists;
 using SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData;
 using SharpLife.Networking.Shared.Communication.NetworkObjectLists.Transmission;
 using SharpLife.Networking.Shared.Communication.NetworkStringLists;
+using SharpLife.Utility.FileSystem;
+using System;
+using System.IO;
 
 namespace SharpLife.Engine.Server.Host
 {
@@ -34,6 +41,8 @@ namespace SharpLife.Engine.Server.Host
 
         private IServerNetworking _serverNetworking;
 
+        private TrafficCaptureWriter _trafficCapture;
+
         private void CreateNetworkServer()
         {
             if (_netServer == null)
@@ -64,18 +73,140 @@ namespace SharpLife.Engine.Server.Host
                     _objectListTypeRegistry,
                     _engine.EngineTime,
                     _maxPlayers,
+                    _sv_minrate,
+                    _sv_maxrate,
+                    _engine.Loopback,
+                    _queryResponder,
                     NetConstants.AppIdentifier,
                     ipAddress,
                     NetConstants.MaxClients,
                     _sv_timeout.Float
                     );
 
+                //Capturing may have been started before the server was created
+                _netServer.Capture = _trafficCapture;
+
                 _netServer.Start();
             }
 
             _netServer.OnNewMapStarted();
         }
 
+        private void StartTrafficCapture(ICommandArgs command)
+        {
+            if (command.Count == 0)
+            {
+                _logger.Information("usage: net_sv_capture <filename>");
+                return;
+            }
+
+            StopTrafficCapture();
+
+            var fileName = command[0];
+
+            try
+            {
+                var stream = FileSystem.Open(fileName, FileMode.Create, FileAccess.Write, FileSystemConstants.PathID.GameConfig);
+
+                _trafficCapture = new TrafficCaptureWriter(stream, true);
+            }
+            catch (Exception e) when (e is IOException || e is UnauthorizedAccessException)
+            {
+                _logger.Error(e, $"Couldn't create traffic capture \"{fileName}\"");
+                return;
+            }
+
+            if (_netServer != null)
+            {
+                _netServer.Capture = _trafficCapture;
+            }
+
+            _logger.Information($"Recording network traffic to \"{fileName}\"");
+        }
+
+        private void StopTrafficCapture(ICommandArgs command)
+        {
+            StopTrafficCapture();
+        }
+
+        private void StopTrafficCapture()
+        {
+            if (_trafficCapture == null)
+            {
+                return;
+            }
+
+            if (_netServer != null)
+            {
+                _netServer.Capture = null;
+            }
+
+            _trafficCapture.Dispose();
+            _trafficCapture = null;
+
+            _logger.Information("Stopped recording network traffic");
+        }
+
+        /// <summary>
+        /// Builds a registry of the networked types that the game registers
+        /// </summary>
+        private TypeRegistry BuildObjectListTypeRegistry()
+        {
+            var objectListTypeRegistryBuilder = new TypeRegistryBuilder();
+
+            _serverNetworking.RegisterObjectListTypes(objectListTypeRegistryBuilder);
+
+            return objectListTypeRegistryBuilder.BuildRegistry();
+        }
+
+        /// <summary>
+        /// Replays a capture using this server's networked types
+        /// Can be run on a dedicated server without loading a map
+        /// The replay uses its own registry, since replaying metadata would change the mappings that connected clients rely on
+        /// </summary>
+        /// <param name="command"></param>
+        private void BenchmarkTrafficCapture(ICommandArgs command)
+        {
+            if (command.Count == 0)
+            {
+                _logger.Information("usage: net_sv_capture_benchmark <filename>");
+                return;
+            }
+
+            var fileName = command[0];
+
+            TrafficBenchmarkResults results;
+
+            try
+            {
+                using (var reader = new TrafficCaptureReader(FileSystem.OpenRead(fileName, FileSystemConstants.PathID.GameConfig)))
+                {
+                    results = new TrafficBenchmark(BuildObjectListTypeRegistry()).Run(reader);
+                }
+            }
+            catch (Exception e) when (e is IOException || e is InvalidDataException || e is InvalidOperationException)
+            {
+                _logger.Error(e, $"Couldn't replay traffic capture \"{fileName}\"");
+                return;
+            }
+
+            _logger.Information($"Replayed \"{fileName}\": {results.Connections} connections over {results.Duration:F2} seconds");
+            _logger.Information($"Server to client: {results.ServerToClientPackets} packets, {results.ServerToClientBytes} bytes");
+            _logger.Information($"Client to server: {results.ClientToServerPackets} packets, {results.ClientToServerBytes} bytes");
+            _logger.Information($"Frame lists: {results.FrameLists} replayed, {results.SkippedFrameLists} skipped, {results.FrameListBytes} bytes captured ({results.FrameListBytesPerTick:F1} bytes/tick), {results.ReencodedFrameListBytes} bytes re-encoded");
+
+            LogBenchmarkCounter("Message decode", results.MessageDecode);
+            _logger.Information($"{results.Messages} messages, maximum of {results.MaxMessagesDecodedPerSecond:F0} messages decoded per second on the network thread");
+            LogBenchmarkCounter("Message encode", results.MessageEncode);
+            LogBenchmarkCounter("Frame list decode", results.FrameListDecode);
+            LogBenchmarkCounter("Frame list encode", results.FrameListEncode);
+        }
+
+        private void LogBenchmarkCounter(string name, TrafficBenchmarkCounter counter)
+        {
+            _logger.Information($"{name}: {counter.Count} times, {counter.AverageNanoseconds:F0} ns, {counter.AverageAllocatedBytes:F0} bytes allocated on average");
+        }
+
         private void RegisterNetworkBinaryData(IBinaryDataSetBuilder dataSetBuilder)
         {
             NetMessages.RegisterEngineBinaryDataTypes(dataSetBuilder);
@@ -94,5 +225,20 @@ namespace SharpLife.Engine.Server.Host
         {
             _serverNetworking.CreateNetworkObjectLists(networkObjectListBuilder);
         }
+
+        public void BeginFilterNetworkObjects(int clientIndex, INetworkObjectList networkObjectList)
+        {
+            _serverNetworking.BeginFilterNetworkObjects(clientIndex, networkObjectList);
+        }
+
+        public bool FilterNetworkObject(int clientIndex, INetworkObjectList networkObjectList, INetworkObject networkObject)
+        {
+            return _serverNetworking.FilterNetworkObject(clientIndex, networkObjectList, networkObject);
+        }
+
+        public void ClientDisconnected(int clientIndex)
+        {
+            _serverNetworking.ClientDisconnected(clientIndex);
+        }
     }
 }
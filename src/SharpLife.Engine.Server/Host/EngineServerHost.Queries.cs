@@ -0,0 +1,154 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using SharpLife.CommandSystem.Commands;
+using SharpLife.CommandSystem.Commands.VariableFilters;
+using SharpLife.Networking.Shared.Communication.Queries;
+using System.Collections.Generic;
+
+namespace SharpLife.Engine.Server.Host
+{
+    public partial class EngineServerHost
+    {
+        /// <summary>
+        /// Responses are rebuilt at least this often so player connection times stay up to date, in seconds
+        /// </summary>
+        private const double QueryResponseRefreshInterval = 5;
+
+        private readonly QueryResponder _queryResponder = new QueryResponder();
+
+        private readonly List<QueryPlayer> _queryPlayers = new List<QueryPlayer>();
+
+        private IVariable _hostname;
+
+        private string _mapName;
+
+        private bool _queryResponsesChanged;
+
+        private int _queryClientListChangeCount;
+
+        private double _nextQueryResponseUpdateTime;
+
+        private void RegisterQueryCommands()
+        {
+            _hostname = CommandContext.RegisterVariable(new VariableInfo("hostname")
+                .WithHelpInfo("Name of the server as shown in server queries")
+                .WithValue("SharpLife Server")
+                .WithChangeHandler((ref VariableChangeEvent _) => _queryResponsesChanged = true));
+
+            var sv_query_rate = CommandContext.RegisterVariable(new VariableInfo("sv_query_rate")
+                .WithHelpInfo("Maximum number of queries per second to answer for a single address. 0 for no limit")
+                .WithValue(5)
+                .WithMinMaxFilter(0, null)
+                .WithChangeHandler((ref VariableChangeEvent @event) => _queryResponder.RateLimiter.AddressRate = @event.Integer));
+
+            var sv_query_maxrate = CommandContext.RegisterVariable(new VariableInfo("sv_query_maxrate")
+                .WithHelpInfo("Maximum number of queries per second to answer in total. 0 for no limit")
+                .WithValue(1000)
+                .WithMinMaxFilter(0, null)
+                .WithChangeHandler((ref VariableChangeEvent @event) => _queryResponder.RateLimiter.GlobalRate = @event.Integer));
+
+            _queryResponder.RateLimiter.AddressRate = sv_query_rate.Integer;
+            _queryResponder.RateLimiter.GlobalRate = sv_query_maxrate.Integer;
+
+            CommandContext.RegisterCommand(new CommandInfo("net_sv_query_benchmark", BenchmarkQueries)
+                .WithHelpInfo("Runs simulated query traffic through the query responder and reports its cost. Arguments: [queries] [queries per second] [spoofed fraction]"));
+        }
+
+        private byte[] CreateQueryInfoResponse()
+        {
+            return QueryProtocol.CreateInfoResponse(
+                _hostname.String,
+                _mapName ?? string.Empty,
+                _engine.GameDirectory,
+                _netServer?.ClientList.Count ?? 0,
+                _maxPlayers.Integer);
+        }
+
+        private byte[] CreateQueryPlayersResponse()
+        {
+            _queryPlayers.Clear();
+
+            if (_netServer != null)
+            {
+                var currentTime = _engine.EngineTime.ElapsedTime;
+
+                foreach (var client in _netServer.ClientList)
+                {
+                    _queryPlayers.Add(new QueryPlayer
+                    {
+                        Name = client.Name,
+                        ConnectedTime = client.ConnectionStarted > 0 ? (float)(currentTime - client.ConnectionStarted) : 0
+                    });
+                }
+            }
+
+            return QueryProtocol.CreatePlayersResponse(_queryPlayers);
+        }
+
+        /// <summary>
+        /// Rebuilds the query responses if anything in them has changed
+        /// </summary>
+        private void UpdateQueryResponses()
+        {
+            var currentTime = _engine.EngineTime.ElapsedTime;
+
+            if (!_queryResponsesChanged
+                && _queryClientListChangeCount == _netServer.ClientList.ChangeCount
+                && currentTime < _nextQueryResponseUpdateTime)
+            {
+                return;
+            }
+
+            _queryResponsesChanged = false;
+            _queryClientListChangeCount = _netServer.ClientList.ChangeCount;
+            _nextQueryResponseUpdateTime = currentTime + QueryResponseRefreshInterval;
+
+            _queryResponder.SetResponses(CreateQueryInfoResponse(), CreateQueryPlayersResponse());
+        }
+
+        private void BenchmarkQueries(ICommandArgs command)
+        {
+            var queryCount = 1000000;
+            var queriesPerSecond = 10000.0;
+            var spoofedFraction = 0.5;
+
+            if ((command.Count > 0 && !int.TryParse(command[0], out queryCount))
+                || (command.Count > 1 && !double.TryParse(command[1], out queriesPerSecond))
+                || (command.Count > 2 && !double.TryParse(command[2], out spoofedFraction))
+                || queryCount < 0 || queriesPerSecond <= 0)
+            {
+                _logger.Information("usage: net_sv_query_benchmark [queries] [queries per second] [spoofed fraction]");
+                return;
+            }
+
+            var rateLimiter = _queryResponder.RateLimiter;
+
+            //Enough senders that the per address limit isn't what's being measured
+            var senderCount = (int)(queriesPerSecond / 2) + 1;
+
+            var results = new QueryBenchmark(CreateQueryInfoResponse(), CreateQueryPlayersResponse(), rateLimiter.AddressRate, rateLimiter.GlobalRate)
+                .Run(queryCount, senderCount, queriesPerSecond, spoofedFraction);
+
+            _logger.Information($"Handled {results.Queries} queries from {senderCount} senders at {queriesPerSecond} queries per second, {spoofedFraction:P0} spoofed");
+            _logger.Information($"{results.Answered} answered, {results.Challenged} challenged, {results.RateLimited} rate limited, {results.Ignored} ignored");
+            _logger.Information($"{results.RequestBytes} bytes received, {results.ResponseBytes} bytes sent, spoofed amplification {results.SpoofedAmplification:F2}");
+
+            LogBenchmarkCounter("Query handling", results.Handling);
+
+            _logger.Information($"Maximum of {results.MaxQueriesPerSecond:F0} queries per second on the network thread");
+        }
+    }
+}
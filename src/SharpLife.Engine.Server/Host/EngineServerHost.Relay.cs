@@ -0,0 +1,143 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using SharpLife.CommandSystem.Commands;
+using SharpLife.CommandSystem.Commands.VariableFilters;
+using SharpLife.Engine.Server.Relay;
+using SharpLife.Networking.Shared;
+using SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData;
+using System;
+using System.Net;
+
+namespace SharpLife.Engine.Server.Host
+{
+    public partial class EngineServerHost
+    {
+        private const string RelayName = "Relay";
+
+        private IVariable _relay_port;
+
+        private IVariable _relay_delay;
+
+        private IVariable _relay_maxspectators;
+
+        private RelayServer _relay;
+
+        private void RegisterRelayCommands()
+        {
+            CommandContext.RegisterCommand(new CommandInfo("relay_start", StartRelay)
+                .WithHelpInfo("Connects to a game server and relays it to spectators"));
+
+            CommandContext.RegisterCommand(new CommandInfo("relay_stop", StopRelay)
+                .WithHelpInfo("Stops relaying and disconnects all spectators"));
+
+            _relay_port = CommandContext.RegisterVariable(new VariableInfo("relay_port")
+                .WithHelpInfo("The port that spectators connect to")
+                .WithValue(NetConstants.DefaultRelayPort));
+
+            _relay_delay = CommandContext.RegisterVariable(new VariableInfo("relay_delay")
+                .WithHelpInfo("Time that spectators lag behind the game, in seconds")
+                .WithValue(10.0f)
+                .WithMinMaxFilter(0, 30));
+
+            _relay_maxspectators = CommandContext.RegisterVariable(new VariableInfo("relay_maxspectators")
+                .WithHelpInfo("The maximum number of spectators that can connect to the relay")
+                .WithValue(NetConstants.DefaultRelaySpectators)
+                .WithMinMaxFilter(0, NetConstants.MaxRelaySpectators));
+        }
+
+        private void StartRelay(ICommandArgs command)
+        {
+            if (command.Count == 0)
+            {
+                _logger.Information("usage: relay_start <address>");
+                return;
+            }
+
+            if (_relay != null)
+            {
+                _logger.Information("Already relaying a game server");
+                return;
+            }
+
+            IPEndPoint gameServer;
+            IPEndPoint relayAddress;
+
+            try
+            {
+                gameServer = NetUtilities.StringToIPAddress(command[0], NetConstants.DefaultServerPort);
+                relayAddress = NetUtilities.StringToIPAddress(_ipname.String, _relay_port.Integer);
+            }
+            catch (Exception e)
+            {
+                if (e is FormatException || e is ArgumentOutOfRangeException)
+                {
+                    _logger.Information($"Unable to resolve {command[0]}");
+                    return;
+                }
+
+                throw;
+            }
+
+            //The relay has its own mapping of the game server's types
+            var typeRegistryBuilder = new TypeRegistryBuilder();
+
+            _serverNetworking.RegisterObjectListTypes(typeRegistryBuilder);
+
+            _relay = new RelayServer(
+                _logger,
+                _engine.EngineTime,
+                _relay_delay,
+                _relay_maxspectators,
+                typeRegistryBuilder.BuildRegistry(),
+                NetConstants.AppIdentifier,
+                relayAddress,
+                _sv_timeout.Float);
+
+            _relay.Start(gameServer, RelayName);
+
+            _logger.Information($"Relaying {gameServer} on port {relayAddress.Port}");
+        }
+
+        private void StopRelay(ICommandArgs command)
+        {
+            StopRelay(NetMessages.ServerShutdownMessage);
+        }
+
+        private void StopRelay(string reason)
+        {
+            if (_relay != null)
+            {
+                _relay.Stop(reason);
+                _relay = null;
+            }
+        }
+
+        private void RunRelayFrame()
+        {
+            if (_relay == null)
+            {
+                return;
+            }
+
+            _relay.RunFrame();
+
+            if (!_relay.IsActive)
+            {
+                StopRelay(NetMessages.ServerShutdownMessage);
+            }
+        }
+    }
+}
@@ -73,6 +73,9 @@ namespace SharpLife.Engine.Server.Host
 
         private readonly IVariable _maxPlayers;
 
+        private readonly IVariable _sv_minrate;
+        private readonly IVariable _sv_maxrate;
+
         private int _spawnCount = 0;
 
         public EngineServerHost(IEngine engine, ILogger logger, IBridge gameBridge)
@@ -110,6 +113,18 @@ namespace SharpLife.Engine.Server.Host
                     }
                 }));
 
+            //TODO: mark as server cvar
+            _sv_minrate = CommandContext.RegisterVariable(new VariableInfo("sv_minrate")
+                .WithHelpInfo("Minimum number of bytes per second that clients can receive. 0 for no minimum")
+                .WithValue(0)
+                .WithMinMaxFilter(0, null));
+
+            //TODO: mark as server cvar
+            _sv_maxrate = CommandContext.RegisterVariable(new VariableInfo("sv_maxrate")
+                .WithHelpInfo("Maximum number of bytes per second that clients can receive. 0 for no limit")
+                .WithValue(0)
+                .WithMinMaxFilter(0, null));
+
             _maxPlayers = CommandContext.RegisterVariable(new VariableInfo("maxplayers")
                 .WithHelpInfo("The maximum number of players that can connect to this server")
                 .WithValue(_engine.IsDedicatedServer ? 6 : NetConstants.MinClients)
@@ -125,6 +140,21 @@ namespace SharpLife.Engine.Server.Host
                 .WithNumberFilter()
                 .WithMinMaxFilter(NetConstants.MinClients, NetConstants.MaxClients));
 
+            CommandContext.RegisterCommand(new CommandInfo("net_sv_capture", StartTrafficCapture)
+                .WithHelpInfo("Records all network traffic sent and received by the server to a file. Traffic to the local client of a listen server is not recorded"));
+
+            CommandContext.RegisterCommand(new CommandInfo("net_sv_capture_stop", StopTrafficCapture)
+                .WithHelpInfo("Stops recording network traffic"));
+
+            CommandContext.RegisterCommand(new CommandInfo("net_sv_capture_benchmark", BenchmarkTrafficCapture)
+                .WithHelpInfo("Replays a network traffic capture and reports its size and the cost of decoding and encoding it"));
+
+            RegisterDemoCommands();
+
+            RegisterRelayCommands();
+
+            RegisterQueryCommands();
+
             if (_engine.CommandLine.TryGetValue("-port", out var portValue))
             {
                 _hostport.String = portValue;
@@ -139,11 +169,7 @@ namespace SharpLife.Engine.Server.Host
 
             LoadGameServer(gameBridge);
 
-            var objectListTypeRegistryBuilder = new TypeRegistryBuilder();
-
-            _serverNetworking.RegisterObjectListTypes(objectListTypeRegistryBuilder);
-
-            _objectListTypeRegistry = objectListTypeRegistryBuilder.BuildRegistry();
+            _objectListTypeRegistry = BuildObjectListTypeRegistry();
 
             var dataSetBuilder = new BinaryDataSetBuilder();
 
@@ -191,6 +217,10 @@ namespace SharpLife.Engine.Server.Host
 
             _game.Shutdown();
 
+            StopTrafficCapture();
+
+            StopRelay(NetMessages.ServerShutdownMessage);
+
             //Always shut down the networking system, even if we weren't active
             _netServer?.Shutdown(NetMessages.ServerShutdownMessage);
 
@@ -220,6 +250,9 @@ namespace SharpLife.Engine.Server.Host
 
             ++_spawnCount;
 
+            _mapName = mapName;
+            _queryResponsesChanged = true;
+
             //TODO: clear custom data if size exceeds maximum
 
             //TODO: allocate client memory
@@ -277,6 +310,9 @@ namespace SharpLife.Engine.Server.Host
 
                 Active = false;
 
+                //Don't answer queries while there is no map
+                _queryResponder.SetResponses(null, null);
+
                 foreach (var client in _netServer.ClientList)
                 {
                     _netServer.DropClient(client, NetMessages.ServerShutdownMessage);
@@ -289,6 +325,9 @@ namespace SharpLife.Engine.Server.Host
             //Always process packets so we can handle disconnection properly after listen server shutdown
             _netServer?.ReadPackets();
 
+            //Relays don't need a map to be loaded
+            RunRelayFrame();
+
             if (!Active)
             {
                 return;
@@ -296,7 +335,11 @@ namespace SharpLife.Engine.Server.Host
 
             _game.RunFrame();
 
+            SendUserCommandAcks();
+
             _netServer.RunFrame();
+
+            UpdateQueryResponses();
         }
 
         public bool IsMapValid(string mapName)
@@ -13,6 +13,7 @@
 *
 ****/
 
+using SharpLife.Networking.Shared.Communication.NetworkObjectLists;
 using SharpLife.Networking.Shared.Communication.NetworkObjectLists.Transmission;
 using SharpLife.Networking.Shared.Communication.NetworkStringLists;
 
@@ -23,5 +24,26 @@ namespace SharpLife.Engine.Server.Networking
         void CreateNetworkStringLists(INetworkStringListsBuilder networkStringListBuilder);
 
         void CreateNetworkObjectLists(INetworkObjectListTransmitterBuilder networkObjectListBuilder);
+
+        /// <summary>
+        /// Invoked before the objects in a list are filtered for transmission to a client
+        /// </summary>
+        /// <param name="clientIndex"></param>
+        /// <param name="networkObjectList"></param>
+        void BeginFilterNetworkObjects(int clientIndex, INetworkObjectList networkObjectList);
+
+        /// <summary>
+        /// Returns whether a network object should be sent to a client
+        /// </summary>
+        /// <param name="clientIndex"></param>
+        /// <param name="networkObjectList"></param>
+        /// <param name="networkObject"></param>
+        bool FilterNetworkObject(int clientIndex, INetworkObjectList networkObjectList, INetworkObject networkObject);
+
+        /// <summary>
+        /// Invoked when a client has disconnected, before its slot is freed
+        /// </summary>
+        /// <param name="clientIndex"></param>
+        void ClientDisconnected(int clientIndex);
     }
 }
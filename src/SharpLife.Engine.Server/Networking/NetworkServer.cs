@@ -13,6 +13,7 @@
 *
 ****/
 
+using Google.Protobuf;
 using Lidgren.Network;
 using Serilog;
 using SharpLife.CommandSystem.Commands;
@@ -20,21 +21,28 @@ using SharpLife.Engine.Server.Clients;
 using SharpLife.Engine.Server.Host;
 using SharpLife.Networking.Shared;
 using SharpLife.Networking.Shared.Communication.BinaryData;
+using SharpLife.Networking.Shared.Communication.Loopback;
 using SharpLife.Networking.Shared.Communication.Messages;
 using SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData;
 using SharpLife.Networking.Shared.Communication.NetworkObjectLists.Transmission;
 using SharpLife.Networking.Shared.Communication.NetworkStringLists;
+using SharpLife.Networking.Shared.Communication.Queries;
 using SharpLife.Networking.Shared.Messages.Client;
+using SharpLife.Networking.Shared.Messages.NetworkObjectLists;
 using SharpLife.Networking.Shared.Messages.NetworkStringLists;
 using SharpLife.Networking.Shared.Messages.Server;
 using SharpLife.Utility;
 using System;
+using System.Collections.Generic;
 using System.Net;
 
 namespace SharpLife.Engine.Server.Networking
 {
     internal sealed class NetworkServer : NetworkPeer,
-        IMessageReceiveHandler<SendResources>
+        IMessageReceiveHandler<SendResources>,
+        IMessageReceiveHandler<NetworkObjectListFrameListAck>,
+        IMessageReceiveHandler<NetworkObjectListObjectMetaDataRequest>,
+        IMessageReceiveHandler<ClientUserInfo>
     {
         private readonly ILogger _logger;
 
@@ -42,6 +50,13 @@ namespace SharpLife.Engine.Server.Networking
 
         private readonly IServerNetworkListener _listener;
 
+        private readonly IVariable _minRate;
+        private readonly IVariable _maxRate;
+
+        private readonly LoopbackChannel _loopback;
+
+        private readonly QueryResponder _queryResponder;
+
         private readonly SendMappings _sendMappings;
 
         private readonly MessagesReceiveHandler _receiveHandler;
@@ -58,6 +73,8 @@ namespace SharpLife.Engine.Server.Networking
 
         protected override NetPeer Peer => _server;
 
+        protected override MessagesReceiveHandler ReceiveHandler => _receiveHandler;
+
         public bool IsRunning => _server.Status == NetPeerStatus.Running;
 
         public ServerClientList ClientList { get; }
@@ -85,6 +102,10 @@ namespace SharpLife.Engine.Server.Networking
         /// <param name="objectListTypeRegistry"></param>
         /// <param name="engineTime"></param>
         /// <param name="maxPlayers"></param>
+        /// <param name="minRate"></param>
+        /// <param name="maxRate"></param>
+        /// <param name="loopback">Channel to use for the local client of a listen server. Optional</param>
+        /// <param name="queryResponder">Answers server queries on the network thread</param>
         /// <param name="appIdentifier"></param>
         /// <param name="ipAddress"></param>
         /// <param name="maxClients"></param>
@@ -98,6 +119,10 @@ namespace SharpLife.Engine.Server.Networking
             TypeRegistry objectListTypeRegistry,
             ITime engineTime,
             IVariable maxPlayers,
+            IVariable minRate,
+            IVariable maxRate,
+            LoopbackChannel loopback,
+            QueryResponder queryResponder,
             string appIdentifier,
             IPEndPoint ipAddress,
             int maxClients,
@@ -120,8 +145,18 @@ namespace SharpLife.Engine.Server.Networking
 
             ClientList = new ServerClientList(NetConstants.MaxClients, maxPlayers);
 
+            _minRate = minRate ?? throw new ArgumentNullException(nameof(minRate));
+            _maxRate = maxRate ?? throw new ArgumentNullException(nameof(maxRate));
+
+            _loopback = loopback;
+
+            _queryResponder = queryResponder ?? throw new ArgumentNullException(nameof(queryResponder));
+
             //Register our handlers
             _receiveHandler.RegisterHandler<SendResources>(this);
+            _receiveHandler.RegisterHandler<NetworkObjectListFrameListAck>(this);
+            _receiveHandler.RegisterHandler<NetworkObjectListObjectMetaDataRequest>(this);
+            _receiveHandler.RegisterHandler<ClientUserInfo>(this);
 
             var config = new NetPeerConfiguration(appIdentifier)
             {
@@ -142,6 +177,7 @@ namespace SharpLife.Engine.Server.Networking
             };
 
             config.EnableMessageType(NetIncomingMessageType.ConnectionApproval);
+            config.EnableMessageType(NetIncomingMessageType.UnconnectedData);
 
             _server = new NetServer(config);
         }
@@ -162,17 +198,13 @@ namespace SharpLife.Engine.Server.Networking
 
                 case NetIncomingMessageType.UnconnectedData:
                     //TODO: implement
-                    //RCON or query
+                    //RCON, queries are handled on the network thread
                     break;
 
                 case NetIncomingMessageType.ConnectionApproval:
                     HandleConnectionApproval(message);
                     break;
 
-                case NetIncomingMessageType.Data:
-                    HandleData(message);
-                    break;
-
                 case NetIncomingMessageType.VerboseDebugMessage:
                     _logger.Verbose(message.ReadString());
                     break;
@@ -191,6 +223,22 @@ namespace SharpLife.Engine.Server.Networking
             }
         }
 
+        protected override bool HandleUnconnectedPacket(NetIncomingMessage message)
+        {
+            var result = _queryResponder.HandleRequest(message.SenderEndPoint, message.Data, message.LengthBytes, NetTime.Now, out var response, out var responseLength);
+
+            if (response != null)
+            {
+                var packet = _server.CreateMessage(responseLength);
+
+                packet.Write(response, 0, responseLength);
+
+                _server.SendUnconnectedMessage(packet, message.SenderEndPoint);
+            }
+
+            return result != QueryResult.NotAQuery;
+        }
+
         private void HandleStatusChanged(NetIncomingMessage message)
         {
             var status = (NetConnectionStatus)message.ReadByte();
@@ -253,6 +301,8 @@ namespace SharpLife.Engine.Server.Networking
                         break;
 
                     case NetConnectionStatus.Disconnected:
+                        client.StopRecording();
+                        _listener.ClientDisconnected(client.Index);
                         ClientList.RemoveClient(client);
                         break;
                 }
@@ -311,7 +361,20 @@ namespace SharpLife.Engine.Server.Networking
                     name = "unnamed";
                 }
 
-                var client = ServerClient.CreateClient(_sendMappings, message.SenderConnection, _engineTime, _objectListTransmitter, slot, _nextUserId++, name);
+                //The local client of a listen server proves that it's running in this process by sending the loopback channel id
+                LoopbackChannel loopback = null;
+
+                if (_loopback != null && userInfo.LoopbackId != 0 && userInfo.LoopbackId == _loopback.Id)
+                {
+                    loopback = _loopback;
+
+                    //Don't let messages meant for a previous connection through
+                    loopback.Clear();
+                }
+
+                var client = ServerClient.CreateClient(_sendMappings, message.SenderConnection, _engineTime, _listener, _objectListTransmitter, loopback, slot, _nextUserId++, name);
+
+                client.Rate = ClampRate((int)Math.Min(userInfo.Rate, int.MaxValue));
 
                 ClientList.AddClientToSlot(client);
 
@@ -323,7 +386,32 @@ namespace SharpLife.Engine.Server.Networking
             _logger.Verbose("Client approved");
         }
 
-        private void HandleData(NetIncomingMessage message)
+        /// <summary>
+        /// Clamps a client's requested rate to the server's limits
+        /// </summary>
+        /// <param name="rate"></param>
+        private int ClampRate(int rate)
+        {
+            //Clients that don't specify a rate get the default
+            if (rate <= 0)
+            {
+                rate = NetConstants.DefaultRate;
+            }
+
+            if (_minRate.Integer > 0)
+            {
+                rate = Math.Max(rate, _minRate.Integer);
+            }
+
+            if (_maxRate.Integer > 0)
+            {
+                rate = Math.Min(rate, _maxRate.Integer);
+            }
+
+            return rate;
+        }
+
+        protected override void HandleMessages(NetConnection sender, IReadOnlyList<IMessage> messages)
         {
             //Don't process data when inactive
             if (!_serverHost.Active)
@@ -331,7 +419,37 @@ namespace SharpLife.Engine.Server.Networking
                 return;
             }
 
-            _receiveHandler.ReadMessages(message.SenderConnection, message);
+            _receiveHandler.DispatchMessages(sender, messages);
+        }
+
+        protected override void ReadLoopbackMessages()
+        {
+            if (_loopback == null)
+            {
+                return;
+            }
+
+            ServerClient localClient = null;
+
+            foreach (var client in ClientList)
+            {
+                if (client.Loopback != null && client.Connected)
+                {
+                    localClient = client;
+                    break;
+                }
+            }
+
+            while (_loopback.TryReceiveOnServer(out var message))
+            {
+                //Don't process data when inactive
+                if (!_serverHost.Active || localClient == null)
+                {
+                    continue;
+                }
+
+                _receiveHandler.DispatchMessage(localClient.Connection, message);
+            }
         }
 
         public ServerClient FindClient(IPEndPoint endPoint)
@@ -381,20 +499,18 @@ namespace SharpLife.Engine.Server.Networking
                 throw new ArgumentNullException(nameof(client));
             }
 
+            client.FlushDemo();
+
             if (client.HasPendingMessages(true))
             {
-                var reliable = CreatePacket();
-
-                client.WriteMessages(reliable, true);
-
-                SendPacket(reliable, client.Connection, NetDeliveryMethod.ReliableOrdered);
+                client.SendReliableMessages(this);
             }
 
             if (client.HasPendingMessages(false))
             {
                 var unreliable = CreatePacket();
 
-                client.WriteMessages(unreliable, false);
+                client.WriteUnreliableMessages(unreliable);
 
                 SendPacket(unreliable, client.Connection, NetDeliveryMethod.UnreliableSequenced);
             }
@@ -418,6 +534,7 @@ namespace SharpLife.Engine.Server.Networking
 
             if (!client.IsFakeClient)
             {
+                client.StopRecording();
                 client.Connection.Disconnect(reason);
                 _objectListTransmitter.DestroyTransmitter(client.FrameListTransmitter);
             }
@@ -432,9 +549,18 @@ namespace SharpLife.Engine.Server.Networking
 
             if (client.NextStringListToSend < _stringListTransmitter.Count)
             {
-                var update = _stringListTransmitter.CreateFullUpdate(client.NextStringListToSend);
+                if (client.Loopback != null)
+                {
+                    //Compressing the list is pointless if it isn't sent over the network
+                    client.AddMessage(_stringListTransmitter.CreateFullUpdate(client.NextStringListToSend), MessagePriority.StringLists);
+                }
+                else
+                {
+                    //The compressed update is shared between all clients, so reconnecting clients only cost the bandwidth needed to send it
+                    client.BeginStringListFullUpdate(_stringListTransmitter.GetFullUpdateChunks(client.NextStringListToSend));
 
-                client.AddMessage(update, true);
+                    client.SendStringListChunks(NetConstants.MaxStringListChunksPerFrame);
+                }
 
                 client.LastStringListFullUpdate = client.NextStringListToSend;
 
@@ -464,10 +590,17 @@ namespace SharpLife.Engine.Server.Networking
                 {
                     var lastIdWeCanUpdate = client.LastStringListFullUpdate;
 
-                    if (client.SetupStage == ServerClientSetupStage.SendingStringLists
-                        && client.NextStringListToSend != -1)
+                    if (client.SetupStage == ServerClientSetupStage.SendingStringLists)
                     {
-                        SendStringListFullUpdate(client);
+                        if (client.SendingStringListChunks)
+                        {
+                            //Send the rest of the list before any updates made to it in this frame
+                            client.SendStringListChunks(NetConstants.MaxStringListChunksPerFrame);
+                        }
+                        else if (client.NextStringListToSend != -1)
+                        {
+                            SendStringListFullUpdate(client);
+                        }
                     }
 
                     foreach (var update in updates)
@@ -477,7 +610,7 @@ namespace SharpLife.Engine.Server.Networking
                         //we don't send the data since anything this update sends is already part of the full update
                         if ((int)update.ListId <= lastIdWeCanUpdate)
                         {
-                            client.AddMessage(update, true);
+                            client.AddMessage(update, MessagePriority.StringLists);
                         }
                     }
                 }
@@ -530,6 +663,51 @@ namespace SharpLife.Engine.Server.Networking
             ContinueSetup(client);
         }
 
+        public void ReceiveMessage(NetConnection connection, NetworkObjectListFrameListAck message)
+        {
+            var client = ClientList.FindClientByEndPoint(connection.RemoteEndPoint);
+
+            client.FrameListTransmitter.AcknowledgeFrameList(message.Sequence);
+        }
+
+        /// <summary>
+        /// The client doesn't have the object metadata with the hash we sent, send the full list
+        /// </summary>
+        /// <param name="connection"></param>
+        /// <param name="message"></param>
+        public void ReceiveMessage(NetConnection connection, NetworkObjectListObjectMetaDataRequest message)
+        {
+            var client = ClientList.FindClientByEndPoint(connection.RemoteEndPoint);
+
+            if (client.SetupStage != ServerClientSetupStage.SendingObjectListTypeMetaData)
+            {
+                _logger.Error($"Client requested object metadata while in invalid state {client.SetupStage}");
+                return;
+            }
+
+            client.AddMessage(_objectListTransmitter.TypeRegistry.Serialize(), true);
+        }
+
+        /// <summary>
+        /// The client changed its user info while connected
+        /// </summary>
+        /// <param name="connection"></param>
+        /// <param name="message"></param>
+        public void ReceiveMessage(NetConnection connection, ClientUserInfo message)
+        {
+            var client = ClientList.FindClientByEndPoint(connection.RemoteEndPoint);
+
+            //Keep the current name if the new one can't be used
+            if (!string.IsNullOrWhiteSpace(message.Name))
+            {
+                client.Name = message.Name;
+            }
+
+            client.Rate = ClampRate((int)Math.Min(message.Rate, int.MaxValue));
+
+            _logger.Verbose($"Client {client.Name} changed user info, rate is now {client.Rate}");
+        }
+
         /// <summary>
         /// Continue setting up the client
         /// </summary>
@@ -567,7 +745,11 @@ namespace SharpLife.Engine.Server.Networking
 
                             client.SetupStage = ServerClientSetupStage.SendingObjectListTypeMetaData;
 
-                            client.AddMessage(_objectListTransmitter.TypeRegistry.Serialize(), true);
+                            //The metadata is the same for every client, so clients that have it cached don't need it again
+                            client.AddMessage(new NetworkObjectListObjectMetaDataHash
+                            {
+                                Hash = _objectListTransmitter.TypeRegistry.MetaDataHash
+                            }, true);
                         }
 
                         break;
@@ -0,0 +1,42 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using Google.Protobuf;
+using SharpLife.Networking.Shared.Messages.NetworkObjectLists;
+
+namespace SharpLife.Engine.Server.Relay
+{
+    internal interface IRelayUpstreamListener
+    {
+        /// <summary>
+        /// Invoked for every message received from the game server other than frame lists and connection control messages
+        /// </summary>
+        /// <param name="message"></param>
+        void OnMessageReceived(IMessage message);
+
+        /// <summary>
+        /// Invoked when a frame list is received from the game server
+        /// </summary>
+        /// <param name="frameList"></param>
+        /// <returns>Whether the frame list was decoded and should be acknowledged</returns>
+        bool OnFrameListReceived(NetworkObjectListFrameListUpdate frameList);
+
+        /// <summary>
+        /// Invoked when the connection to the game server has been lost
+        /// </summary>
+        /// <param name="reason"></param>
+        void OnDisconnected(string reason);
+    }
+}
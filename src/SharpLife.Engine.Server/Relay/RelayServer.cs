@@ -0,0 +1,518 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using Google.Protobuf;
+using Lidgren.Network;
+using Serilog;
+using SharpLife.CommandSystem.Commands;
+using SharpLife.Networking.Shared;
+using SharpLife.Networking.Shared.Communication.Demos;
+using SharpLife.Networking.Shared.Communication.Messages;
+using SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData;
+using SharpLife.Networking.Shared.Communication.Relay;
+using SharpLife.Networking.Shared.Messages.Client;
+using SharpLife.Networking.Shared.Messages.NetworkObjectLists;
+using SharpLife.Networking.Shared.Messages.Server;
+using SharpLife.Utility;
+using System;
+using System.Collections.Generic;
+using System.Net;
+
+namespace SharpLife.Engine.Server.Relay
+{
+    /// <summary>
+    /// Connects to a game server as a client and passes everything it receives on to any number of spectators
+    /// Frame lists are decoded once and encoded again per baseline, so the game server only pays for a single client
+    /// Everything is held back for a configurable delay before spectators receive it
+    /// </summary>
+    internal sealed class RelayServer : NetworkPeer,
+        IRelayUpstreamListener,
+        IMessageReceiveHandler<NewConnection>,
+        IMessageReceiveHandler<SendResources>,
+        IMessageReceiveHandler<NetworkObjectListFrameListAck>,
+        IMessageReceiveHandler<NetworkObjectListObjectMetaDataRequest>,
+        IMessageReceiveHandler<ClientUserInfo>
+    {
+        /// <summary>
+        /// Number of frame lists to keep
+        /// Covers the maximum delay at the default update rate, plus the time spectators need to acknowledge them
+        /// </summary>
+        private const int MaxFrameLists = 512;
+
+        private struct DelayedMessage
+        {
+            public double time;
+
+            public IMessage message;
+
+            /// <summary>
+            /// For frame lists, the map that the frame list belongs to
+            /// </summary>
+            public int mapCount;
+        }
+
+        private readonly ILogger _logger;
+
+        private readonly ITime _engineTime;
+
+        private readonly IVariable _delay;
+
+        private readonly IVariable _maxSpectators;
+
+        private readonly TypeRegistry _typeRegistry;
+
+        private readonly SendMappings _sendMappings = new SendMappings(NetMessages.ServerToClientMessages);
+
+        private readonly MessagesReceiveHandler _receiveHandler;
+
+        private readonly RelayUpstream _upstream;
+
+        private readonly RelayFrameListCache _frameListCache;
+
+        private readonly NetServer _server;
+
+        private readonly Queue<DelayedMessage> _delayedMessages = new Queue<DelayedMessage>();
+
+        /// <summary>
+        /// Messages that spectators need to set up the current map
+        /// </summary>
+        private readonly DemoSignOnState _signOnState = new DemoSignOnState();
+
+        private readonly Dictionary<NetConnection, RelaySpectator> _spectators = new Dictionary<NetConnection, RelaySpectator>();
+
+        private int _nextUserId = 1;
+
+        /// <summary>
+        /// Number of maps that frame lists have been received for
+        /// Frame lists of the previous map are skipped if the cache was already reset for the next one
+        /// </summary>
+        private int _receivedMapCount;
+
+        private int _broadcastMapCount;
+
+        /// <summary>
+        /// Sequence of the newest frame list that spectators can receive
+        /// </summary>
+        private uint _broadcastSequence;
+
+        /// <summary>
+        /// Whether spectators have been sent the object metadata for the current map
+        /// </summary>
+        private bool _objectMetaDataForwarded;
+
+        protected override NetPeer Peer => _server;
+
+        protected override MessagesReceiveHandler ReceiveHandler => _receiveHandler;
+
+        /// <summary>
+        /// Whether the relay is still connected to the game server
+        /// </summary>
+        public bool IsActive { get; private set; }
+
+        public int SpectatorCount => _spectators.Count;
+
+        public RelayServer(ILogger logger,
+            ITime engineTime,
+            IVariable delay,
+            IVariable maxSpectators,
+            TypeRegistry typeRegistry,
+            string appIdentifier,
+            IPEndPoint ipAddress,
+            float connectionTimeout)
+        {
+            _logger = logger ?? throw new ArgumentNullException(nameof(logger));
+            _engineTime = engineTime ?? throw new ArgumentNullException(nameof(engineTime));
+            _delay = delay ?? throw new ArgumentNullException(nameof(delay));
+            _maxSpectators = maxSpectators ?? throw new ArgumentNullException(nameof(maxSpectators));
+            _typeRegistry = typeRegistry ?? throw new ArgumentNullException(nameof(typeRegistry));
+
+            if (ipAddress == null)
+            {
+                throw new ArgumentNullException(nameof(ipAddress));
+            }
+
+            _receiveHandler = new MessagesReceiveHandler(logger, NetMessages.ClientToServerMessages, false);
+
+            _receiveHandler.RegisterHandler<NewConnection>(this);
+            _receiveHandler.RegisterHandler<SendResources>(this);
+            _receiveHandler.RegisterHandler<NetworkObjectListFrameListAck>(this);
+            _receiveHandler.RegisterHandler<NetworkObjectListObjectMetaDataRequest>(this);
+            _receiveHandler.RegisterHandler<ClientUserInfo>(this);
+
+            _upstream = new RelayUpstream(logger, this, typeRegistry, appIdentifier, connectionTimeout);
+
+            _frameListCache = new RelayFrameListCache(typeRegistry, MaxFrameLists);
+
+            var config = new NetPeerConfiguration(appIdentifier)
+            {
+                AcceptIncomingConnections = true,
+
+                //We don't use these since our data must be FIFO ordered
+                SuppressUnreliableUnorderedAcks = true,
+
+                //relay_maxspectators is checked during approval, this only needs to cover its largest value
+                MaximumConnections = NetConstants.MaxRelaySpectators,
+
+                MaximumHandshakeAttempts = NetConstants.MaxHandshakeAttempts,
+
+                LocalAddress = ipAddress.Address,
+
+                Port = ipAddress.Port,
+
+                ConnectionTimeout = connectionTimeout,
+            };
+
+            config.EnableMessageType(NetIncomingMessageType.ConnectionApproval);
+
+            _server = new NetServer(config);
+        }
+
+        /// <summary>
+        /// Starts accepting spectators and connects to the game server
+        /// </summary>
+        /// <param name="gameServer"></param>
+        /// <param name="name">Name to show on the game server</param>
+        public void Start(IPEndPoint gameServer, string name)
+        {
+            Start();
+            _upstream.Start();
+
+            _upstream.Connect(gameServer, name);
+
+            IsActive = true;
+        }
+
+        public void Stop(string reason)
+        {
+            IsActive = false;
+
+            _upstream.Disconnect(reason);
+            _upstream.FlushOutgoingPackets();
+            _upstream.Shutdown(reason);
+
+            Shutdown(reason);
+
+            _spectators.Clear();
+            _delayedMessages.Clear();
+            _signOnState.Clear();
+        }
+
+        public void RunFrame()
+        {
+            _upstream.ReadPackets();
+
+            ReadPackets();
+
+            ReleaseDelayedMessages();
+
+            var currentTime = _engineTime.ElapsedTime;
+
+            foreach (var spectator in _spectators.Values)
+            {
+                if (_broadcastSequence != 0
+                    && _broadcastMapCount == _receivedMapCount
+                    && spectator.SentSequence != _broadcastSequence
+                    && spectator.CanTransmit(currentTime))
+                {
+                    var frameList = _frameListCache.GetFrameList(_broadcastSequence, spectator.AcknowledgedSequence);
+
+                    if (frameList != null)
+                    {
+                        spectator.AddFrameList(frameList, currentTime);
+                    }
+                }
+
+                spectator.SendMessages(this, currentTime);
+            }
+
+            FlushOutgoingPackets();
+
+            _upstream.SendMessages();
+        }
+
+        private void ReleaseDelayedMessages()
+        {
+            var releaseTime = _engineTime.ElapsedTime - _delay.Float;
+
+            while (_delayedMessages.Count > 0 && _delayedMessages.Peek().time <= releaseTime)
+            {
+                var delayed = _delayedMessages.Dequeue();
+
+                if (delayed.message is NetworkObjectListFrameListUpdate frameList)
+                {
+                    _broadcastSequence = frameList.Sequence;
+                    _broadcastMapCount = delayed.mapCount;
+                    continue;
+                }
+
+                var message = delayed.message;
+
+                switch (message)
+                {
+                    case ServerInfo _:
+                        _objectMetaDataForwarded = false;
+                        _broadcastSequence = 0;
+                        break;
+
+                    //Spectators always get the full metadata so they have it before they receive the first frame list
+                    case NetworkObjectListObjectMetaDataHash hash:
+                        message = _typeRegistry.FindMetaData(hash.Hash);
+                        break;
+
+                    case NetworkObjectListObjectMetaDataList _:
+                        message = _objectMetaDataForwarded ? null : message;
+                        break;
+
+                    case NetworkObjectListListMetaDataList _:
+                        foreach (var spectator in _spectators.Values)
+                        {
+                            spectator.ResetFrameLists();
+                        }
+
+                        break;
+                }
+
+                if (message == null)
+                {
+                    continue;
+                }
+
+                if (message is NetworkObjectListObjectMetaDataList)
+                {
+                    _objectMetaDataForwarded = true;
+                }
+
+                _signOnState.Add(message);
+
+                foreach (var spectator in _spectators.Values)
+                {
+                    if (spectator.Connected)
+                    {
+                        //Everything goes through the same queue so it arrives in the order it was received
+                        spectator.AddMessage(message, MessagePriority.StringLists);
+                    }
+                }
+            }
+        }
+
+        public void OnMessageReceived(IMessage message)
+        {
+            if (message is NetworkObjectListListMetaDataList listMetaData)
+            {
+                //Frame lists that follow belong to the new map
+                _frameListCache.DeserializeListMetaData(listMetaData);
+                ++_receivedMapCount;
+            }
+
+            _delayedMessages.Enqueue(new DelayedMessage
+            {
+                time = _engineTime.ElapsedTime,
+                message = message
+            });
+        }
+
+        public bool OnFrameListReceived(NetworkObjectListFrameListUpdate frameList)
+        {
+            //Decoded right away so the game server can delta encode against it
+            if (!_frameListCache.AddFrameList(frameList))
+            {
+                return false;
+            }
+
+            _delayedMessages.Enqueue(new DelayedMessage
+            {
+                time = _engineTime.ElapsedTime,
+                message = frameList,
+                mapCount = _receivedMapCount
+            });
+
+            return true;
+        }
+
+        public void OnDisconnected(string reason)
+        {
+            _logger.Information($"Relay disconnected from game server: {reason}");
+
+            IsActive = false;
+
+            foreach (var spectator in _spectators.Values)
+            {
+                spectator.Connection.Disconnect(reason);
+            }
+        }
+
+        protected override void HandlePacket(NetIncomingMessage message)
+        {
+            switch (message.MessageType)
+            {
+                case NetIncomingMessageType.StatusChanged:
+                    HandleStatusChanged(message);
+                    break;
+
+                case NetIncomingMessageType.ConnectionApproval:
+                    HandleConnectionApproval(message);
+                    break;
+
+                case NetIncomingMessageType.VerboseDebugMessage:
+                    _logger.Verbose(message.ReadString());
+                    break;
+
+                case NetIncomingMessageType.DebugMessage:
+                    _logger.Debug(message.ReadString());
+                    break;
+
+                case NetIncomingMessageType.WarningMessage:
+                    _logger.Warning(message.ReadString());
+                    break;
+
+                case NetIncomingMessageType.ErrorMessage:
+                    _logger.Error(message.ReadString());
+                    break;
+            }
+        }
+
+        private void HandleStatusChanged(NetIncomingMessage message)
+        {
+            var status = (NetConnectionStatus)message.ReadByte();
+
+            _logger.Verbose($"Spectator status changed: {status}");
+
+            if (!_spectators.TryGetValue(message.SenderConnection, out var spectator))
+            {
+                return;
+            }
+
+            switch (status)
+            {
+                case NetConnectionStatus.Connected:
+                    {
+                        spectator.Connected = true;
+
+                        var endPoint = spectator.Connection.RemoteEndPoint;
+
+                        spectator.AddMessage(new ConnectAcknowledgement
+                        {
+                            UserId = spectator.UserId,
+                            IsSecure = false,
+                            BuildNumber = 0,
+                            TrueAddress = endPoint.Address == IPAddress.Loopback ? NetConstants.Loopback : endPoint.ToString()
+                        }, MessagePriority.Control);
+
+                        //The spectator's setup requests are ignored, everything it needs is sent right away
+                        foreach (var signOnMessage in _signOnState.Messages)
+                        {
+                            spectator.AddMessage(signOnMessage, MessagePriority.StringLists);
+                        }
+
+                        _logger.Information($"Spectator {spectator.Name} connected to relay");
+                        break;
+                    }
+
+                case NetConnectionStatus.Disconnecting:
+                    spectator.Connected = false;
+                    break;
+
+                case NetConnectionStatus.Disconnected:
+                    _spectators.Remove(message.SenderConnection);
+                    break;
+            }
+        }
+
+        private void HandleConnectionApproval(NetIncomingMessage message)
+        {
+            if (!IsActive)
+            {
+                message.SenderConnection.Deny(NetMessages.ServerClientDeniedInactive);
+                return;
+            }
+
+            if (_spectators.Count >= _maxSpectators.Integer)
+            {
+                message.SenderConnection.Deny(NetMessages.ServerClientDeniedNoFreeSlots);
+                return;
+            }
+
+            var protocolVersion = message.ReadVariableUInt32();
+
+            if (protocolVersion < NetConstants.ProtocolVersion)
+            {
+                message.SenderConnection.Deny(NetMessages.ServerClientDeniedProtocolVersionOlder);
+                return;
+            }
+            else if (protocolVersion > NetConstants.ProtocolVersion)
+            {
+                message.SenderConnection.Deny(NetMessages.ServerClientDeniedProtocolVersionNewer);
+                return;
+            }
+
+            using (var stream = new NetBufferStream(message))
+            {
+                var userInfo = ClientUserInfo.Parser.ParseDelimitedFrom(stream);
+
+                var name = userInfo.Name;
+
+                if (string.IsNullOrWhiteSpace(name))
+                {
+                    name = "unnamed";
+                }
+
+                var spectator = new RelaySpectator(_sendMappings, message.SenderConnection, _nextUserId++, name)
+                {
+                    Rate = userInfo.Rate > 0 ? (int)Math.Min(userInfo.Rate, int.MaxValue) : NetConstants.DefaultRate
+                };
+
+                _spectators.Add(message.SenderConnection, spectator);
+
+                message.SenderConnection.Approve();
+            }
+        }
+
+        protected override void HandleMessages(NetConnection sender, IReadOnlyList<IMessage> messages)
+        {
+            if (!_spectators.ContainsKey(sender))
+            {
+                return;
+            }
+
+            _receiveHandler.DispatchMessages(sender, messages);
+        }
+
+        public void ReceiveMessage(NetConnection connection, NewConnection message)
+        {
+            //Setup messages were already sent when the spectator connected
+        }
+
+        public void ReceiveMessage(NetConnection connection, SendResources message)
+        {
+            //Setup messages were already sent when the spectator connected
+        }
+
+        public void ReceiveMessage(NetConnection connection, NetworkObjectListFrameListAck message)
+        {
+            _spectators[connection].AcknowledgeFrameList(message.Sequence);
+        }
+
+        public void ReceiveMessage(NetConnection connection, NetworkObjectListObjectMetaDataRequest message)
+        {
+            //Spectators are always sent the full metadata
+        }
+
+        public void ReceiveMessage(NetConnection connection, ClientUserInfo message)
+        {
+            //Spectator names aren't shown anywhere, only the rate matters
+            _spectators[connection].Rate = message.Rate > 0 ? (int)Math.Min(message.Rate, int.MaxValue) : NetConstants.DefaultRate;
+        }
+    }
+}
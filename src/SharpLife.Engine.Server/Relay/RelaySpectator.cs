@@ -0,0 +1,168 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using Google.Protobuf;
+using Lidgren.Network;
+using SharpLife.Networking.Shared;
+using SharpLife.Networking.Shared.Communication.Messages;
+using SharpLife.Networking.Shared.Messages.NetworkObjectLists;
+using System;
+
+namespace SharpLife.Engine.Server.Relay
+{
+    /// <summary>
+    /// A spectator watching a game through a relay
+    /// Spectators only receive messages, the relay doesn't run any game logic for them
+    /// </summary>
+    internal sealed class RelaySpectator
+    {
+        private readonly MessageScheduler _reliableMessages;
+
+        private readonly PendingMessages _unreliableMessages;
+
+        public NetConnection Connection { get; }
+
+        public int UserId { get; }
+
+        public string Name { get; }
+
+        public bool Connected { get; set; }
+
+        /// <summary>
+        /// Sequence of the newest frame list the spectator has acknowledged
+        /// 0 if none have been acknowledged
+        /// </summary>
+        public uint AcknowledgedSequence { get; private set; }
+
+        /// <summary>
+        /// Sequence of the last frame list sent to the spectator
+        /// </summary>
+        public uint SentSequence { get; private set; }
+
+        private int MaxPacketSize => Connection.CurrentMTU - NetConstants.PacketHeaderReserve;
+
+        /// <summary>
+        /// Maximum number of bytes to send to this spectator per second
+        /// 0 if there is no limit
+        /// </summary>
+        public int Rate
+        {
+            get => _reliableMessages.Rate;
+            set => _reliableMessages.Rate = value;
+        }
+
+        public RelaySpectator(SendMappings sendMappings, NetConnection connection, int userId, string name)
+        {
+            if (sendMappings == null)
+            {
+                throw new ArgumentNullException(nameof(sendMappings));
+            }
+
+            Connection = connection ?? throw new ArgumentNullException(nameof(connection));
+            UserId = userId;
+            Name = name ?? throw new ArgumentNullException(nameof(name));
+
+            _reliableMessages = new MessageScheduler(sendMappings);
+            _unreliableMessages = new PendingMessages(sendMappings);
+        }
+
+        /// <summary>
+        /// Whether a frame list can be sent
+        /// Frames can reference strings that haven't been sent yet, so the spectator is choked until they have
+        /// </summary>
+        /// <param name="currentTime"></param>
+        public bool CanTransmit(double currentTime)
+        {
+            //The first frame list must be acknowledged before deltas against it can be sent
+            return Connected
+                && (SentSequence == 0 || AcknowledgedSequence != 0)
+                && !_reliableMessages.HasPendingMessages(MessagePriority.StringLists)
+                && _reliableMessages.HasBudget(currentTime);
+        }
+
+        public void AddMessage(IMessage message, MessagePriority priority)
+        {
+            _reliableMessages.Add(message, priority);
+        }
+
+        /// <summary>
+        /// Adds a frame list to send
+        /// </summary>
+        /// <param name="frameList"></param>
+        /// <param name="currentTime"></param>
+        public void AddFrameList(NetworkObjectListFrameListUpdate frameList, double currentTime)
+        {
+            if (frameList == null)
+            {
+                throw new ArgumentNullException(nameof(frameList));
+            }
+
+            if (AcknowledgedSequence == 0)
+            {
+                //Sent after the setup messages so the spectator has everything it needs to decode it
+                _reliableMessages.Add(frameList, MessagePriority.StringLists);
+            }
+            else
+            {
+                _unreliableMessages.Add(frameList);
+
+                _reliableMessages.ConsumeBudget(frameList.CalculateSize(), currentTime, MaxPacketSize);
+            }
+
+            SentSequence = frameList.Sequence;
+        }
+
+        /// <summary>
+        /// Forgets all frame lists sent to the spectator
+        /// Must be called when a new map starts since sequences start over
+        /// </summary>
+        public void ResetFrameLists()
+        {
+            AcknowledgedSequence = 0;
+            SentSequence = 0;
+        }
+
+        public void AcknowledgeFrameList(uint sequence)
+        {
+            //Acknowledgements can arrive out of order
+            if (sequence > AcknowledgedSequence && sequence <= SentSequence)
+            {
+                AcknowledgedSequence = sequence;
+            }
+        }
+
+        /// <summary>
+        /// Sends pending messages
+        /// </summary>
+        /// <param name="peer"></param>
+        /// <param name="currentTime"></param>
+        public void SendMessages(NetworkPeer peer, double currentTime)
+        {
+            if (_reliableMessages.MessageCount > 0)
+            {
+                _reliableMessages.Send(peer, Connection, currentTime, MaxPacketSize);
+            }
+
+            if (_unreliableMessages.MessageCount > 0)
+            {
+                var packet = peer.CreatePacket();
+
+                _unreliableMessages.Write(packet);
+
+                peer.SendPacket(packet, Connection, NetDeliveryMethod.UnreliableSequenced);
+            }
+        }
+    }
+}
@@ -0,0 +1,285 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using Google.Protobuf;
+using Lidgren.Network;
+using Serilog;
+using SharpLife.Networking.Shared;
+using SharpLife.Networking.Shared.Communication.Messages;
+using SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData;
+using SharpLife.Networking.Shared.Messages.BinaryData;
+using SharpLife.Networking.Shared.Messages.Client;
+using SharpLife.Networking.Shared.Messages.NetworkObjectLists;
+using SharpLife.Networking.Shared.Messages.NetworkStringLists;
+using SharpLife.Networking.Shared.Messages.Server;
+using System;
+using System.Collections.Generic;
+using System.Net;
+
+namespace SharpLife.Engine.Server.Relay
+{
+    /// <summary>
+    /// Connection from a relay to the game server it relays
+    /// Goes through the same setup as a regular client, but doesn't process anything beyond what the relay needs
+    /// </summary>
+    internal sealed class RelayUpstream : NetworkPeer
+    {
+        /// <summary>
+        /// Rate requested from the game server
+        /// Everything the server sends has to reach the relay, so this is as high as the server allows
+        /// </summary>
+        private const uint RequestedRate = 100000;
+
+        private readonly ILogger _logger;
+
+        private readonly IRelayUpstreamListener _listener;
+
+        private readonly TypeRegistry _typeRegistry;
+
+        private readonly MessagesReceiveHandler _receiveHandler;
+
+        private readonly PendingMessages _reliableMessages;
+
+        private readonly PendingMessages _unreliableMessages;
+
+        private readonly NetClient _client;
+
+        private NetConnection _connection;
+
+        protected override NetPeer Peer => _client;
+
+        protected override MessagesReceiveHandler ReceiveHandler => _receiveHandler;
+
+        public bool IsConnected => _connection != null;
+
+        public RelayUpstream(ILogger logger, IRelayUpstreamListener listener, TypeRegistry typeRegistry, string appIdentifier, float connectionTimeout)
+        {
+            _logger = logger ?? throw new ArgumentNullException(nameof(logger));
+            _listener = listener ?? throw new ArgumentNullException(nameof(listener));
+            _typeRegistry = typeRegistry ?? throw new ArgumentNullException(nameof(typeRegistry));
+
+            //Messages are only parsed, they are handled here instead of being dispatched
+            _receiveHandler = new MessagesReceiveHandler(logger, NetMessages.ServerToClientMessages, false);
+
+            var sendMappings = new SendMappings(NetMessages.ClientToServerMessages);
+
+            _reliableMessages = new PendingMessages(sendMappings);
+            _unreliableMessages = new PendingMessages(sendMappings);
+
+            var config = new NetPeerConfiguration(appIdentifier)
+            {
+                AcceptIncomingConnections = false,
+
+                //We don't use these since our data must be FIFO ordered
+                SuppressUnreliableUnorderedAcks = true,
+
+                MaximumConnections = 1,
+
+                MaximumHandshakeAttempts = NetConstants.MaxHandshakeAttempts,
+
+                ConnectionTimeout = connectionTimeout,
+            };
+
+            _client = new NetClient(config);
+        }
+
+        /// <summary>
+        /// Connects to the game server
+        /// </summary>
+        /// <param name="address"></param>
+        /// <param name="name">Name to show on the game server</param>
+        public void Connect(IPEndPoint address, string name)
+        {
+            if (address == null)
+            {
+                throw new ArgumentNullException(nameof(address));
+            }
+
+            if (name == null)
+            {
+                throw new ArgumentNullException(nameof(name));
+            }
+
+            var message = _client.CreateMessage();
+
+            //Send protocol version first so compatibility is known
+            message.WriteVariableUInt32(NetConstants.ProtocolVersion);
+
+            var userInfo = new ClientUserInfo
+            {
+                Name = name,
+                Rate = RequestedRate
+            };
+
+            using (var stream = new NetBufferStream(message))
+            {
+                userInfo.WriteDelimitedTo(stream);
+            }
+
+            _connection = _client.Connect(address, message);
+        }
+
+        public void Disconnect(string byeMessage)
+        {
+            _connection?.Disconnect(byeMessage);
+        }
+
+        protected override void HandlePacket(NetIncomingMessage message)
+        {
+            switch (message.MessageType)
+            {
+                case NetIncomingMessageType.StatusChanged:
+                    {
+                        var status = (NetConnectionStatus)message.ReadByte();
+
+                        string reason = message.ReadString();
+
+                        _logger.Verbose($"Relay upstream status changed: {status} {reason}");
+
+                        if (status == NetConnectionStatus.Disconnected && _connection != null)
+                        {
+                            _connection = null;
+                            _listener.OnDisconnected(reason);
+                        }
+
+                        break;
+                    }
+
+                case NetIncomingMessageType.VerboseDebugMessage:
+                    _logger.Verbose(message.ReadString());
+                    break;
+
+                case NetIncomingMessageType.DebugMessage:
+                    _logger.Debug(message.ReadString());
+                    break;
+
+                case NetIncomingMessageType.WarningMessage:
+                    _logger.Warning(message.ReadString());
+                    break;
+
+                case NetIncomingMessageType.ErrorMessage:
+                    _logger.Error(message.ReadString());
+                    break;
+            }
+        }
+
+        protected override void HandleMessages(NetConnection sender, IReadOnlyList<IMessage> messages)
+        {
+            if (_connection == null)
+            {
+                return;
+            }
+
+            for (var i = 0; i < messages.Count; ++i)
+            {
+                HandleMessage(messages[i]);
+            }
+        }
+
+        /// <summary>
+        /// Follows the same setup steps as the client, everything else is passed on to the relay
+        /// </summary>
+        /// <param name="message"></param>
+        private void HandleMessage(IMessage message)
+        {
+            switch (message)
+            {
+                case ConnectAcknowledgement _:
+                    //Spectators get their own acknowledgement from the relay
+                    _reliableMessages.Add(new NewConnection());
+                    return;
+
+                case NetworkObjectListFrameListUpdate frameList:
+                    if (_listener.OnFrameListReceived(frameList))
+                    {
+                        _unreliableMessages.Add(new NetworkObjectListFrameListAck { Sequence = frameList.Sequence });
+                    }
+
+                    return;
+
+                case NetworkObjectListObjectMetaDataHash hash:
+                    if (_typeRegistry.TryUseCachedMetaData(hash.Hash))
+                    {
+                        RequestResources();
+                    }
+                    else
+                    {
+                        _reliableMessages.Add(new NetworkObjectListObjectMetaDataRequest());
+                    }
+
+                    break;
+
+                case NetworkObjectListObjectMetaDataList metaData:
+                    _typeRegistry.Deserialize(metaData);
+                    RequestResources();
+                    break;
+
+                case ServerInfo _:
+                case BinaryMetaData _:
+                case NetworkStringListFullUpdate _:
+                case NetworkObjectListListMetaDataList _:
+                    RequestResources();
+                    break;
+
+                case NetworkStringListFullUpdateChunk chunk:
+                    //Only the last chunk completes the list
+                    if (chunk.Offset + chunk.Data.Length >= chunk.TotalSize)
+                    {
+                        RequestResources();
+                    }
+
+                    break;
+            }
+
+            _listener.OnMessageReceived(message);
+        }
+
+        private void RequestResources()
+        {
+            _reliableMessages.Add(new SendResources());
+        }
+
+        /// <summary>
+        /// Sends all pending messages to the game server
+        /// </summary>
+        public void SendMessages()
+        {
+            if (_connection == null)
+            {
+                return;
+            }
+
+            if (_reliableMessages.MessageCount > 0)
+            {
+                var reliable = CreatePacket();
+
+                _reliableMessages.Write(reliable);
+
+                SendPacket(reliable, _connection, NetDeliveryMethod.ReliableOrdered);
+            }
+
+            if (_unreliableMessages.MessageCount > 0)
+            {
+                var unreliable = CreatePacket();
+
+                _unreliableMessages.Write(unreliable);
+
+                SendPacket(unreliable, _connection, NetDeliveryMethod.UnreliableSequenced);
+            }
+
+            FlushOutgoingPackets();
+        }
+    }
+}
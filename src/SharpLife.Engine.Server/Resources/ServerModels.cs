@@ -21,6 +21,7 @@ using SharpLife.Networking.Shared.Communication.NetworkStringLists;
 using SharpLife.Networking.Shared.Messages.Server;
 using SharpLife.Networking.Shared.Precaching;
 using System;
+using System.Collections.Generic;
 
 namespace SharpLife.Engine.Server.Resources
 {
@@ -84,6 +85,44 @@ namespace SharpLife.Engine.Server.Resources
             return _modelManager[platformModelName];
         }
 
+        public void LoadModels(IReadOnlyList<string> modelNames)
+        {
+            if (modelNames == null)
+            {
+                throw new ArgumentNullException(nameof(modelNames));
+            }
+
+            if (_models == null)
+            {
+                throw new InvalidOperationException("Cannot load models; network string list not created yet");
+            }
+
+            var networkModelNames = new List<string>(modelNames.Count);
+
+            foreach (var modelName in modelNames)
+            {
+                if (modelName == null)
+                {
+                    throw new ArgumentException("Model names cannot be null", nameof(modelNames));
+                }
+
+                var networkModelName = NetUtilities.ConvertToNetworkPath(modelName);
+
+                if (_models.IndexOf(networkModelName) == -1)
+                {
+                    _modelManager.Load(NetUtilities.ConvertToPlatformPath(modelName));
+
+                    networkModelNames.Add(networkModelName);
+                }
+            }
+
+            //All models loaded by the server are required by default
+            _models.AddRange(networkModelNames, _ => new ModelPrecacheData
+            {
+                Flags = (uint)ModelPrecacheFlags.Required
+            });
+        }
+
         public IModel GetModel(in ModelIndex index)
         {
             if (index.Valid)
@@ -16,6 +16,8 @@
 using Google.Protobuf;
 using SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData;
 using SharpLife.Networking.Shared.Communication.NetworkObjectLists.Reception;
+using SharpLife.Networking.Shared.Messages.Client;
+using SharpLife.Networking.Shared.Messages.Server;
 
 namespace SharpLife.Engine.Shared.API.Game.Client
 {
@@ -26,5 +28,14 @@ namespace SharpLife.Engine.Shared.API.Game.Client
         void RegisterObjectListTypes(TypeRegistryBuilder typeRegistryBuilder);
 
         void CreateNetworkObjectLists(INetworkObjectListReceiverBuilder networkObjectListBuilder);
+
+        /// <summary>
+        /// Creates a message containing the commands created since the last message
+        /// </summary>
+        /// <param name="backupCount">Number of previously sent commands to send again, in case the packets they were in were lost</param>
+        /// <returns>The message to send, or null if no commands have been created since the last message</returns>
+        UserCommands CreateUserCommands(int backupCount);
+
+        void ProcessUserCommandAck(UserCommandAck message);
     }
 }
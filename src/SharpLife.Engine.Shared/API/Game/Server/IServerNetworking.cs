@@ -14,8 +14,11 @@
 ****/
 
 using Google.Protobuf;
+using SharpLife.Networking.Shared.Communication.NetworkObjectLists;
 using SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData;
 using SharpLife.Networking.Shared.Communication.NetworkObjectLists.Transmission;
+using SharpLife.Networking.Shared.Messages.Client;
+using SharpLife.Networking.Shared.Messages.Server;
 
 namespace SharpLife.Engine.Shared.API.Game.Server
 {
@@ -24,11 +27,55 @@ namespace SharpLife.Engine.Shared.API.Game.Server
         /// <summary>
         /// Create the game info message to send to a client
         /// </summary>
+        /// <param name="clientIndex"></param>
         /// <returns></returns>
-        IMessage CreateGameInfoMessage();
+        IMessage CreateGameInfoMessage(int clientIndex);
 
         void RegisterObjectListTypes(TypeRegistryBuilder typeRegistryBuilder);
 
         void CreateNetworkObjectLists(INetworkObjectListTransmitterBuilder networkObjectListBuilder);
+
+        /// <summary>
+        /// Invoked before the objects in a list are filtered for transmission to a client
+        /// </summary>
+        /// <param name="clientIndex"></param>
+        /// <param name="networkObjectList"></param>
+        void BeginFilterNetworkObjects(int clientIndex, INetworkObjectList networkObjectList);
+
+        /// <summary>
+        /// Returns whether a network object should be sent to a client
+        /// </summary>
+        /// <param name="clientIndex"></param>
+        /// <param name="networkObjectList"></param>
+        /// <param name="networkObject"></param>
+        bool FilterNetworkObject(int clientIndex, INetworkObjectList networkObjectList, INetworkObject networkObject);
+
+        /// <summary>
+        /// Invoked when a client starts connecting to the current map
+        /// Anything kept for the client from a previous connection or map should be discarded
+        /// </summary>
+        /// <param name="clientIndex"></param>
+        void ResetClient(int clientIndex);
+
+        /// <summary>
+        /// Invoked when a client has disconnected from the server
+        /// </summary>
+        /// <param name="clientIndex"></param>
+        void ClientDisconnected(int clientIndex);
+
+        /// <summary>
+        /// Invoked when a fully connected client sends its most recent commands
+        /// Commands should be queued and run during the next frame
+        /// </summary>
+        /// <param name="clientIndex"></param>
+        /// <param name="message"></param>
+        void ReceiveUserCommands(int clientIndex, UserCommands message);
+
+        /// <summary>
+        /// Creates a message telling a client which of its commands have been run
+        /// </summary>
+        /// <param name="clientIndex"></param>
+        /// <returns>The message to send, or null if no commands have been run since the last message</returns>
+        UserCommandAck CreateUserCommandAck(int clientIndex);
     }
 }
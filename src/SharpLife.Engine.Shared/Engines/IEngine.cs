@@ -19,6 +19,7 @@ using SharpLife.Engine.Shared.Logging;
 using SharpLife.Engine.Shared.UI;
 using SharpLife.FileSystem;
 using SharpLife.Models;
+using SharpLife.Networking.Shared.Communication.Loopback;
 using SharpLife.Utility;
 using SharpLife.Utility.Events;
 using System;
@@ -88,6 +89,12 @@ namespace SharpLife.Engine.Shared.Engines
         /// </summary>
         bool IsServerActive { get; }
 
+        /// <summary>
+        /// Channel used by a listen server to communicate with its local client
+        /// Null if the engine can't host listen servers
+        /// </summary>
+        LoopbackChannel Loopback { get; }
+
         /// <summary>
         /// Gets the log text writer used to forward logs to the console
         /// </summary>
@@ -34,6 +34,7 @@ using SharpLife.Engine.Shared.UI;
 using SharpLife.FileSystem;
 using SharpLife.Models;
 using SharpLife.Networking.Shared;
+using SharpLife.Networking.Shared.Communication.Loopback;
 using SharpLife.Utility;
 using SharpLife.Utility.Events;
 using SharpLife.Utility.FileSystem;
@@ -92,6 +93,8 @@ namespace SharpLife.Engine.Engines
 
         public bool IsServerActive => _server?.Active == true;
 
+        public LoopbackChannel Loopback { get; private set; }
+
         public ForwardingTextWriter LogTextWriter { get; } = new ForwardingTextWriter();
 
         private HostType _hostType;
@@ -323,6 +326,9 @@ namespace SharpLife.Engine.Engines
 
             if (hostType == HostType.Client)
             {
+                //Clients can host listen servers
+                Loopback = new LoopbackChannel();
+
                 _client = new EngineClientHost(this, Logger);
             }
 
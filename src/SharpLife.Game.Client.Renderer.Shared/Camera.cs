@@ -88,6 +88,12 @@ namespace SharpLife.Game.Client.Renderer.Shared
         public float Yaw { get => _yaw; set { _yaw = value; UpdateViewMatrix(); } }
         public float Pitch { get => _pitch; set { _pitch = value; UpdateViewMatrix(); } }
 
+        /// <summary>
+        /// Whether the keyboard moves the camera
+        /// Disabled while the camera is attached to the local player
+        /// </summary>
+        public bool FreeMovement { get; set; } = true;
+
         //GoldSource's coordinate system points Z up, X forward, and Y left
         //See https://developer.valvesoftware.com/wiki/Coordinates
         //Need to scale X so inputs produce the correct results,
@@ -131,7 +137,7 @@ namespace SharpLife.Game.Client.Renderer.Shared
                 motionDir += -Vector3.UnitZ;
             }
 
-            if (motionDir != Vector3.Zero)
+            if (FreeMovement && motionDir != Vector3.Zero)
             {
                 var lookRotation = RotationMatrix;
                 motionDir = Vector3.Transform(motionDir, lookRotation);
@@ -20,7 +20,9 @@ using SharpLife.Engine.Shared.API.Engine.Client;
 using SharpLife.Engine.Shared.API.Game.Client;
 using SharpLife.Engine.Shared.API.Game.Shared;
 using SharpLife.Game.Client.Entities;
+using SharpLife.Game.Client.Input;
 using SharpLife.Game.Client.Networking;
+using SharpLife.Game.Client.Prediction;
 using SharpLife.Game.Client.Renderer;
 using SharpLife.Game.Client.Renderer.Shared;
 using SharpLife.Game.Client.Renderer.Shared.Models;
@@ -29,6 +31,7 @@ using SharpLife.Game.Shared.Bridge;
 using SharpLife.Game.Shared.Maps;
 using SharpLife.Game.Shared.Models;
 using SharpLife.Game.Shared.Models.BSP;
+using SharpLife.Game.Shared.Physics;
 using SharpLife.Models;
 using SharpLife.Networking.Shared;
 using System;
@@ -51,6 +54,13 @@ namespace SharpLife.Game.Client.API
 
         private ClientEntities _entities;
 
+        private ClientInput _input;
+
+        /// <summary>
+        /// Time that hasn't been added to a user command yet, in milliseconds
+        /// </summary>
+        private double _commandTime;
+
         /// <summary>
         /// Gets the current map info instance
         /// Don't cache this, it gets recreated every map
@@ -58,10 +68,20 @@ namespace SharpLife.Game.Client.API
         /// </summary>
         public IMapInfo MapInfo { get; private set; }
 
+        /// <summary>
+        /// Predicts the local player's movement
+        /// </summary>
+        public ClientPrediction Prediction { get; private set; }
+
         public BridgeDataReceiver BridgeDataReceiver { get; } = new BridgeDataReceiver();
 
         public string CachedMapName { get; set; }
 
+        /// <summary>
+        /// Entity index of the local player
+        /// </summary>
+        public int LocalPlayerIndex { get; set; }
+
         public void Initialize(IServiceCollection serviceCollection)
         {
             if (serviceCollection == null)
@@ -112,6 +132,10 @@ namespace SharpLife.Game.Client.API
             _engine.GameWindow.Resized += _renderer.WindowResized;
 
             _entities.Startup(_renderer);
+
+            Prediction = new ClientPrediction(_logger, _engine.CommandContext);
+
+            _input = new ClientInput(_engine.UserInterface.WindowManager.InputSystem, _engine.CommandContext);
         }
 
         public void Shutdown()
@@ -140,6 +164,10 @@ namespace SharpLife.Game.Client.API
             _renderer.LoadModels(MapInfo.Model, _engine.ModelManager);
 
             _entities.MapLoadBegin();
+
+            Prediction.MapLoadBegin(new WorldMovementTracer(bspWorldModel));
+
+            _commandTime = 0;
         }
 
         public void MapLoadFinished()
@@ -151,6 +179,8 @@ namespace SharpLife.Game.Client.API
         {
             _entities.MapShutdown();
 
+            Prediction.MapShutdown();
+
             _renderer.ClearBSP();
 
             MapInfo = null;
@@ -158,11 +188,76 @@ namespace SharpLife.Game.Client.API
 
         public void Update(float deltaSeconds)
         {
+            CreateUserCommand(deltaSeconds);
+
+            UpdateLocalPlayer();
+
             _renderer.Update(deltaSeconds);
 
             _clientUI.Update(deltaSeconds, _renderer.Scene);
         }
 
+        /// <summary>
+        /// Creates a user command for the time that has passed since the last one and predicts its result
+        /// Fractions of milliseconds are carried over to the next command so the duration of all commands adds up to the time that has passed
+        /// </summary>
+        /// <param name="deltaSeconds"></param>
+        private void CreateUserCommand(float deltaSeconds)
+        {
+            if (MapInfo == null)
+            {
+                return;
+            }
+
+            _commandTime += deltaSeconds * 1000.0;
+
+            if (_commandTime < 1)
+            {
+                return;
+            }
+
+            var msec = (byte)Math.Min(_commandTime, byte.MaxValue);
+
+            //Time that doesn't fit in a single command is dropped, the server wouldn't let the client use it all at once anyway
+            _commandTime = msec == byte.MaxValue ? 0 : _commandTime - msec;
+
+            var command = new UserCommand
+            {
+                Msec = msec
+            };
+
+            _input.FillCommand(ref command, _renderer.Scene.Camera);
+
+            Prediction.AddCommand(ref command);
+        }
+
+        /// <summary>
+        /// Places the local player and the view at the predicted position
+        /// Until the server has sent the player's state the camera moves freely, which is also how relay spectators view the game
+        /// </summary>
+        private void UpdateLocalPlayer()
+        {
+            var camera = _renderer.Scene.Camera;
+
+            if (MapInfo != null && Prediction.HasServerState)
+            {
+                ref readonly var state = ref Prediction.PredictedState;
+
+                _entities.PredictedPlayerIndex = LocalPlayerIndex;
+                _entities.PredictedPlayerOrigin = state.Origin;
+
+                camera.FreeMovement = false;
+                //Ducking isn't supported by player movement yet
+                camera.Position = state.Origin + PhysicsConstants.Hull1.ViewOffset;
+            }
+            else
+            {
+                _entities.PredictedPlayerIndex = 0;
+
+                camera.FreeMovement = true;
+            }
+        }
+
         public void Draw()
         {
             _clientUI.Draw(_renderer.Scene);
@@ -13,6 +13,7 @@
 *
 ****/
 
+using SharpLife.Game.Client.Entities.Interpolation;
 using SharpLife.Game.Client.Renderer.Shared;
 using SharpLife.Game.Client.Renderer.Shared.Models;
 using SharpLife.Game.Client.Renderer.Shared.Models.MDL;
@@ -61,6 +62,26 @@ namespace SharpLife.Game.Client.Entities.Animation
         [Networked]
         public int RenderFXLightMultiplier { get; set; }
 
+        /// <summary>
+        /// Frame that the entity is rendered with
+        /// </summary>
+        public float RenderFrame { get; set; }
+
+        protected override void GetInterpolationSample(ref InterpolationSample sample)
+        {
+            base.GetInterpolationSample(ref sample);
+
+            sample.Frame = Frame;
+        }
+
+        protected override void ApplyInterpolationSample(in InterpolationSample sample)
+        {
+            base.ApplyInterpolationSample(sample);
+
+            //Animations that advance on their own are computed from the last time the frame was set, only manually set frames need interpolating
+            RenderFrame = FrameRate == 0 ? sample.Frame : Frame;
+        }
+
         public override void Render(IModelRenderer modelRenderer, IViewState viewState)
         {
             if (Model is StudioModel studioModel)
@@ -72,7 +93,7 @@ namespace SharpLife.Game.Client.Entities.Animation
                     CurrentTime = Context.Time.ElapsedTime,
                     Sequence = Sequence,
                     LastTime = LastTime,
-                    Frame = Frame,
+                    Frame = RenderFrame,
                     FrameRate = FrameRate,
                     Body = Body,
                     Skin = Skin,
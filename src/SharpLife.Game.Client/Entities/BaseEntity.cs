@@ -13,6 +13,7 @@
 *
 ****/
 
+using SharpLife.Game.Client.Entities.Interpolation;
 using SharpLife.Game.Client.Renderer.Shared;
 using SharpLife.Game.Client.Renderer.Shared.Models;
 using SharpLife.Game.Client.Renderer.Shared.Models.BSP;
@@ -50,9 +51,29 @@ namespace SharpLife.Game.Client.Entities
             set => _origin = value;
         }
 
+        /// <summary>
+        /// Received states used to interpolate this entity
+        /// Null if this entity is not networked
+        /// </summary>
+        public InterpolationHistory InterpolationHistory { get; }
+
+        /// <summary>
+        /// Origin that the entity is rendered at
+        /// </summary>
+        public Vector3 RenderOrigin { get; set; }
+
+        /// <summary>
+        /// Angles that the entity is rendered with
+        /// </summary>
+        public Vector3 RenderAngles { get; set; }
+
         protected BaseEntity(bool networked)
             : base(networked)
         {
+            if (networked)
+            {
+                InterpolationHistory = new InterpolationHistory();
+            }
         }
 
         //Always call base first when overriding these
@@ -66,6 +87,75 @@ namespace SharpLife.Game.Client.Entities
             //Nothing
         }
 
+        /// <summary>
+        /// Stores the current networked state in a sample
+        /// </summary>
+        /// <param name="sample"></param>
+        protected virtual void GetInterpolationSample(ref InterpolationSample sample)
+        {
+            sample.Origin = Origin;
+            sample.Angles = Angles;
+        }
+
+        /// <summary>
+        /// Applies an interpolated state
+        /// </summary>
+        /// <param name="sample"></param>
+        protected virtual void ApplyInterpolationSample(in InterpolationSample sample)
+        {
+            RenderOrigin = sample.Origin;
+            RenderAngles = sample.Angles;
+        }
+
+        /// <summary>
+        /// Adds the state received in the frame at the given server time to the interpolation history
+        /// Entities flagged with <see cref="EffectsFlags.NoInterpolation"/> discard their history and snap to the new state
+        /// </summary>
+        /// <param name="serverTime"></param>
+        /// <param name="previousFrameTime"></param>
+        public void AddInterpolationSample(double serverTime, double previousFrameTime)
+        {
+            if (InterpolationHistory == null)
+            {
+                return;
+            }
+
+            var sample = new InterpolationSample
+            {
+                Time = serverTime
+            };
+
+            GetInterpolationSample(ref sample);
+
+            if ((Effects & EffectsFlags.NoInterpolation) != 0)
+            {
+                InterpolationHistory.Clear();
+            }
+
+            InterpolationHistory.Add(sample, previousFrameTime);
+        }
+
+        /// <summary>
+        /// Updates the render state for the given time
+        /// Entities that have no interpolation history are rendered with their current state
+        /// </summary>
+        /// <param name="interpolation"></param>
+        public void Interpolate(ClientInterpolation interpolation)
+        {
+            if (InterpolationHistory?.Interpolate(interpolation.RenderTime, interpolation.MaxExtrapolationTime, out var sample) == true)
+            {
+                ApplyInterpolationSample(sample);
+            }
+            else
+            {
+                var current = new InterpolationSample();
+
+                GetInterpolationSample(ref current);
+
+                ApplyInterpolationSample(current);
+            }
+        }
+
         protected int CalculateFXBlend(IViewState viewState, int renderAmount)
         {
             //Offset is random based on entity index
@@ -213,8 +303,8 @@ namespace SharpLife.Game.Client.Entities
             {
                 Index = (uint)Handle.Id,
 
-                Origin = Origin,
-                Angles = Angles,
+                Origin = RenderOrigin,
+                Angles = RenderAngles,
                 Scale = new Vector3(scale),
 
                 RenderFX = RenderFX,
@@ -16,6 +16,7 @@
 using SharpLife.Engine.Shared.API.Engine.Client;
 using SharpLife.Engine.Shared.API.Engine.Shared;
 using SharpLife.Game.Client.Entities.EntityList;
+using SharpLife.Game.Client.Entities.Interpolation;
 using SharpLife.Game.Client.Renderer.Shared;
 using SharpLife.Game.Client.Renderer.Shared.Models;
 using SharpLife.Game.Shared;
@@ -26,6 +27,7 @@ using SharpLife.Networking.Shared.Communication.NetworkObjectLists.Reception;
 using SharpLife.Utility;
 using System;
 using System.Linq;
+using System.Numerics;
 using System.Reflection;
 
 namespace SharpLife.Game.Client.Entities
@@ -48,6 +50,21 @@ namespace SharpLife.Game.Client.Entities
 
         public EntityContext Context { get; private set; }
 
+        public ClientInterpolation Interpolation { get; private set; }
+
+        /// <summary>
+        /// Entity index of the local player if its movement is predicted, 0 otherwise
+        /// The predicted player is drawn at its predicted origin instead of being interpolated
+        /// </summary>
+        public int PredictedPlayerIndex { get; set; }
+
+        public Vector3 PredictedPlayerOrigin { get; set; }
+
+        /// <summary>
+        /// Server time of the frame that is being processed
+        /// </summary>
+        private double _frameServerTime;
+
         public ClientEntities(IClientEngine clientEngine, ITime engineTime, IEngineModels engineModels)
         {
             _clientEngine = clientEngine ?? throw new ArgumentNullException(nameof(clientEngine));
@@ -59,6 +76,8 @@ namespace SharpLife.Game.Client.Entities
         {
             _renderer = renderer ?? throw new ArgumentNullException(nameof(renderer));
 
+            Interpolation = new ClientInterpolation(_engineTime, _clientEngine.CommandContext);
+
             EntityDictionary.AddTypesFromAssembly<BaseEntity>(typeof(ClientEntities).Assembly);
         }
 
@@ -99,6 +118,8 @@ namespace SharpLife.Game.Client.Entities
             _entityList = new ClientEntityList(EntityDictionary, _clientEngine.MaxClients, this);
 
             Context = new EntityContext(_clientEngine, _engineTime, _engineModels, _renderer, _entityList);
+
+            Interpolation.Reset();
         }
 
         public void MapShutdown()
@@ -118,8 +139,11 @@ namespace SharpLife.Game.Client.Entities
             return entity;
         }
 
-        public void OnBeginProcessList(INetworkObjectList networkObjectList)
+        public void OnBeginProcessList(INetworkObjectList networkObjectList, double serverTime)
         {
+            _frameServerTime = serverTime;
+
+            Interpolation.OnFrameReceived(serverTime);
         }
 
         public void OnEndProcessList(INetworkObjectList networkObjectList)
@@ -164,6 +188,16 @@ namespace SharpLife.Game.Client.Entities
             var entity = (BaseEntity)networkObject.Instance;
 
             entity.OnEndUpdate();
+
+            if (!IsPredictedPlayer(entity))
+            {
+                entity.AddInterpolationSample(_frameServerTime, Interpolation.PreviousFrameTime);
+            }
+        }
+
+        private bool IsPredictedPlayer(BaseEntity entity)
+        {
+            return PredictedPlayerIndex != 0 && entity.Handle.Id == PredictedPlayerIndex;
         }
 
         public void RenderEntities(IModelRenderer modelRenderer, IViewState viewState)
@@ -173,6 +207,16 @@ namespace SharpLife.Game.Client.Entities
             {
                 foreach (var entity in _entityList)
                 {
+                    if (IsPredictedPlayer(entity))
+                    {
+                        entity.RenderOrigin = PredictedPlayerOrigin;
+                        entity.RenderAngles = entity.Angles;
+                    }
+                    else
+                    {
+                        entity.Interpolate(Interpolation);
+                    }
+
                     if (entity is IRenderableEntity renderable)
                     {
                         renderable.Render(modelRenderer, viewState);
@@ -0,0 +1,132 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using SharpLife.CommandSystem;
+using SharpLife.CommandSystem.Commands;
+using SharpLife.CommandSystem.Commands.VariableFilters;
+using SharpLife.Utility;
+using System;
+
+namespace SharpLife.Game.Client.Entities.Interpolation
+{
+    /// <summary>
+    /// Keeps track of the server clock and determines the time that entities are rendered at
+    /// Entities are rendered slightly in the past so there are usually two received states to interpolate between
+    /// </summary>
+    public sealed class ClientInterpolation
+    {
+        /// <summary>
+        /// If the estimated server clock is off by more than this, it is reset instead of adjusted gradually
+        /// </summary>
+        private const double MaxClockError = 1.0;
+
+        /// <summary>
+        /// Fraction of the clock error that is corrected every time a frame is received
+        /// </summary>
+        private const double ClockAdjustRate = 0.1;
+
+        private readonly ITime _engineTime;
+
+        private readonly IVariable _cl_interp;
+
+        private readonly IVariable _cl_extrapolate_max;
+
+        private bool _hasServerClock;
+
+        private double _serverTimeOffset;
+
+        /// <summary>
+        /// Server time of the most recently received frame
+        /// </summary>
+        public double LatestFrameTime { get; private set; }
+
+        /// <summary>
+        /// Server time of the frame received before <see cref="LatestFrameTime"/>
+        /// </summary>
+        public double PreviousFrameTime { get; private set; }
+
+        /// <summary>
+        /// Server time that entities should be rendered at
+        /// </summary>
+        public double RenderTime => _engineTime.ElapsedTime + _serverTimeOffset - _cl_interp.Float;
+
+        /// <summary>
+        /// Maximum amount of time to extrapolate entity states when no new states have been received
+        /// </summary>
+        public double MaxExtrapolationTime => _cl_extrapolate_max.Float;
+
+        public ClientInterpolation(ITime engineTime, ICommandContext commandContext)
+        {
+            _engineTime = engineTime ?? throw new ArgumentNullException(nameof(engineTime));
+
+            if (commandContext == null)
+            {
+                throw new ArgumentNullException(nameof(commandContext));
+            }
+
+            _cl_interp = commandContext.RegisterVariable(
+                new VariableInfo("cl_interp")
+                .WithHelpInfo("How far in the past entities are rendered, in seconds. Should be at least two times the interval between updates from the server")
+                .WithValue(0.1f)
+                .WithMinMaxFilter(0, 1));
+
+            _cl_extrapolate_max = commandContext.RegisterVariable(
+                new VariableInfo("cl_extrapolate_max")
+                .WithHelpInfo("Maximum amount of time to continue moving entities past their last received state, in seconds")
+                .WithValue(0.25f)
+                .WithMinMaxFilter(0, 1));
+        }
+
+        /// <summary>
+        /// Resets the server clock
+        /// </summary>
+        public void Reset()
+        {
+            _hasServerClock = false;
+            _serverTimeOffset = 0;
+            LatestFrameTime = 0;
+            PreviousFrameTime = 0;
+        }
+
+        /// <summary>
+        /// Updates the server clock when a frame is received
+        /// </summary>
+        /// <param name="serverTime"></param>
+        public void OnFrameReceived(double serverTime)
+        {
+            //Multiple lists in the same frame list share the same time
+            if (serverTime == LatestFrameTime)
+            {
+                return;
+            }
+
+            var offset = serverTime - _engineTime.ElapsedTime;
+
+            if (!_hasServerClock || Math.Abs(offset - _serverTimeOffset) > MaxClockError)
+            {
+                _hasServerClock = true;
+                _serverTimeOffset = offset;
+            }
+            else
+            {
+                //Smooth out jitter in packet arrival times
+                _serverTimeOffset += (offset - _serverTimeOffset) * ClockAdjustRate;
+            }
+
+            PreviousFrameTime = LatestFrameTime;
+            LatestFrameTime = serverTime;
+        }
+    }
+}
@@ -0,0 +1,169 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using SharpLife.Utility.Collections.Generic;
+using System;
+using System.Numerics;
+
+namespace SharpLife.Game.Client.Entities.Interpolation
+{
+    /// <summary>
+    /// Short history of received states for a single entity
+    /// Storage is allocated once, new samples overwrite the oldest ones
+    /// </summary>
+    public sealed class InterpolationHistory
+    {
+        /// <summary>
+        /// Number of samples to keep
+        /// Must cover the interpolation delay at the lowest update rate that should still look smooth
+        /// </summary>
+        public const int MaxSamples = 16;
+
+        /// <summary>
+        /// Entities that move faster than this between two samples are assumed to have teleported, in units per second
+        /// Faster than the default sv_maxvelocity allows in any direction, so fast moving entities are still interpolated
+        /// </summary>
+        public const double TeleportSpeed = 4000;
+
+        private readonly CircularBuffer<InterpolationSample> _samples = new CircularBuffer<InterpolationSample>(MaxSamples);
+
+        public int Count => _samples.Count;
+
+        /// <summary>
+        /// Adds a sample
+        /// If the entity wasn't updated in the previous frame, its last state is repeated at that frame's time first
+        /// Otherwise an entity that has been standing still would slowly slide towards its new state instead of moving when it did
+        /// Samples older than the newest sample are dropped
+        /// If the entity teleported, the history is cleared so it doesn't slide across the map to its new position
+        /// </summary>
+        /// <param name="sample"></param>
+        /// <param name="previousFrameTime">Server time of the previous frame</param>
+        public void Add(in InterpolationSample sample, double previousFrameTime)
+        {
+            if (!_samples.IsEmpty)
+            {
+                var last = _samples.Current;
+
+                //Duplicate frame, use the latest state for it
+                if (sample.Time == last.Time)
+                {
+                    _samples[_samples.Count - 1] = sample;
+                    return;
+                }
+
+                //Out of order frame, older than the state that is already being interpolated towards
+                if (sample.Time < last.Time)
+                {
+                    return;
+                }
+
+                if (Vector3.Distance(last.Origin, sample.Origin) > TeleportSpeed * (sample.Time - last.Time))
+                {
+                    _samples.Clear();
+                }
+                else if (last.Time < previousFrameTime && previousFrameTime < sample.Time)
+                {
+                    last.Time = previousFrameTime;
+                    _samples.Add(last);
+                }
+            }
+
+            _samples.Add(sample);
+        }
+
+        public void Clear()
+        {
+            _samples.Clear();
+        }
+
+        /// <summary>
+        /// Gets the state at the given time
+        /// </summary>
+        /// <param name="time">Server time to get the state for</param>
+        /// <param name="maxExtrapolationTime">Maximum amount of time to extrapolate past the newest sample</param>
+        /// <param name="result"></param>
+        /// <returns>Whether there were any samples to get the state from</returns>
+        public bool Interpolate(double time, double maxExtrapolationTime, out InterpolationSample result)
+        {
+            if (_samples.IsEmpty)
+            {
+                result = default;
+                return false;
+            }
+
+            //Before the oldest sample or only one sample, nothing to interpolate from
+            if (_samples.Count == 1 || time <= _samples[0].Time)
+            {
+                result = _samples[0];
+                return true;
+            }
+
+            //Search backwards since the render time is usually close to the newest samples
+            for (var i = _samples.Count - 1; i > 0; --i)
+            {
+                var from = _samples[i - 1];
+
+                if (from.Time <= time)
+                {
+                    var to = _samples[i];
+
+                    if (time > to.Time)
+                    {
+                        //Newer than the newest sample, extrapolate using the last two samples
+                        time = Math.Min(time, to.Time + maxExtrapolationTime);
+                    }
+
+                    Lerp(from, to, (float)((time - from.Time) / (to.Time - from.Time)), out result);
+                    return true;
+                }
+            }
+
+            result = _samples[0];
+            return true;
+        }
+
+        private static void Lerp(in InterpolationSample from, in InterpolationSample to, float fraction, out InterpolationSample result)
+        {
+            result.Time = from.Time + ((to.Time - from.Time) * fraction);
+            result.Origin = Vector3.Lerp(from.Origin, to.Origin, fraction);
+            result.Angles = new Vector3(
+                LerpAngle(from.Angles.X, to.Angles.X, fraction),
+                LerpAngle(from.Angles.Y, to.Angles.Y, fraction),
+                LerpAngle(from.Angles.Z, to.Angles.Z, fraction));
+
+            //Looping animations wrap around to the start, don't play them backwards
+            result.Frame = to.Frame >= from.Frame ? from.Frame + ((to.Frame - from.Frame) * fraction) : to.Frame;
+        }
+
+        /// <summary>
+        /// Interpolates between angles in degrees along the shortest path
+        /// </summary>
+        private static float LerpAngle(float from, float to, float fraction)
+        {
+            var delta = (to - from) % 360;
+
+            if (delta > 180)
+            {
+                delta -= 360;
+            }
+            else if (delta < -180)
+            {
+                delta += 360;
+            }
+
+            return from + (delta * fraction);
+        }
+    }
+}
@@ -0,0 +1,33 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using System.Numerics;
+
+namespace SharpLife.Game.Client.Entities.Interpolation
+{
+    /// <summary>
+    /// The interpolated state of an entity at a point in server time
+    /// </summary>
+    public struct InterpolationSample
+    {
+        public double Time;
+
+        public Vector3 Origin;
+
+        public Vector3 Angles;
+
+        public float Frame;
+    }
+}
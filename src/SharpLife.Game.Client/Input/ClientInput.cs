@@ -0,0 +1,143 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using ImGuiNET;
+using SDL2;
+using SharpLife.CommandSystem;
+using SharpLife.CommandSystem.Commands;
+using SharpLife.CommandSystem.Commands.VariableFilters;
+using SharpLife.Game.Client.Renderer.Shared;
+using SharpLife.Game.Shared.Physics;
+using SharpLife.Input;
+using SharpLife.Utility.Mathematics;
+using System;
+using System.Numerics;
+
+namespace SharpLife.Game.Client.Input
+{
+    /// <summary>
+    /// Turns the state of the keyboard and the view into user commands
+    /// Uses the same keys as the free camera, which doesn't move while the local player is being controlled
+    /// </summary>
+    public sealed class ClientInput
+    {
+        private readonly IInputSystem _inputSystem;
+
+        private readonly IVariable _cl_forwardspeed;
+
+        private readonly IVariable _cl_backspeed;
+
+        private readonly IVariable _cl_sidespeed;
+
+        private readonly IVariable _cl_upspeed;
+
+        public ClientInput(IInputSystem inputSystem, ICommandContext commandContext)
+        {
+            _inputSystem = inputSystem ?? throw new ArgumentNullException(nameof(inputSystem));
+
+            if (commandContext == null)
+            {
+                throw new ArgumentNullException(nameof(commandContext));
+            }
+
+            _cl_forwardspeed = commandContext.RegisterVariable(
+                new VariableInfo("cl_forwardspeed")
+                .WithHelpInfo("Speed to move forward at, in units per second")
+                .WithValue(400.0f)
+                .WithMinMaxFilter(0, null));
+
+            _cl_backspeed = commandContext.RegisterVariable(
+                new VariableInfo("cl_backspeed")
+                .WithHelpInfo("Speed to move backward at, in units per second")
+                .WithValue(400.0f)
+                .WithMinMaxFilter(0, null));
+
+            _cl_sidespeed = commandContext.RegisterVariable(
+                new VariableInfo("cl_sidespeed")
+                .WithHelpInfo("Speed to move sideways at, in units per second")
+                .WithValue(400.0f)
+                .WithMinMaxFilter(0, null));
+
+            _cl_upspeed = commandContext.RegisterVariable(
+                new VariableInfo("cl_upspeed")
+                .WithHelpInfo("Speed to move up and down at while swimming or flying, in units per second")
+                .WithValue(320.0f)
+                .WithMinMaxFilter(0, null));
+        }
+
+        /// <summary>
+        /// Fills in the view angles, movement and buttons of a command
+        /// </summary>
+        /// <param name="command"></param>
+        /// <param name="camera">Camera that the player is looking through</param>
+        public void FillCommand(ref UserCommand command, Camera camera)
+        {
+            if (camera == null)
+            {
+                throw new ArgumentNullException(nameof(camera));
+            }
+
+            //The camera uses radians and turns the opposite way around the vertical axis
+            command.ViewAngles = new Vector3(MathUtils.ToDegrees(camera.Pitch), -MathUtils.ToDegrees(camera.Yaw), 0);
+
+            //Don't move while typing into the user interface
+            if (ImGui.GetIO().WantCaptureKeyboard)
+            {
+                return;
+            }
+
+            var snapshot = _inputSystem.Snapshot;
+
+            if (snapshot.IsKeyDown(SDL.SDL_Keycode.SDLK_UP))
+            {
+                command.ForwardMove += _cl_forwardspeed.Float;
+                command.Buttons |= InputButtons.Forward;
+            }
+
+            if (snapshot.IsKeyDown(SDL.SDL_Keycode.SDLK_DOWN))
+            {
+                command.ForwardMove -= _cl_backspeed.Float;
+                command.Buttons |= InputButtons.Back;
+            }
+
+            if (snapshot.IsKeyDown(SDL.SDL_Keycode.SDLK_RIGHT))
+            {
+                command.SideMove += _cl_sidespeed.Float;
+                command.Buttons |= InputButtons.MoveRight;
+            }
+
+            if (snapshot.IsKeyDown(SDL.SDL_Keycode.SDLK_LEFT))
+            {
+                command.SideMove -= _cl_sidespeed.Float;
+                command.Buttons |= InputButtons.MoveLeft;
+            }
+
+            if (snapshot.IsKeyDown(SDL.SDL_Keycode.SDLK_PAGEUP))
+            {
+                command.UpMove += _cl_upspeed.Float;
+            }
+
+            if (snapshot.IsKeyDown(SDL.SDL_Keycode.SDLK_PAGEDOWN))
+            {
+                command.UpMove -= _cl_upspeed.Float;
+            }
+
+            if (snapshot.IsKeyDown(SDL.SDL_Keycode.SDLK_SPACE))
+            {
+                command.Buttons |= InputButtons.Jump;
+            }
+        }
+    }
+}
@@ -20,8 +20,11 @@ using SharpLife.Game.Client.API;
 using SharpLife.Game.Client.Entities;
 using SharpLife.Game.Shared.Networking;
 using SharpLife.Game.Shared.Networking.Messages.Server;
+using SharpLife.Game.Shared.Physics;
 using SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData;
 using SharpLife.Networking.Shared.Communication.NetworkObjectLists.Reception;
+using SharpLife.Networking.Shared.Messages.Client;
+using SharpLife.Networking.Shared.Messages.Server;
 using System;
 
 namespace SharpLife.Game.Client.Networking
@@ -32,6 +35,15 @@ namespace SharpLife.Game.Client.Networking
         private readonly GameClient _gameClient;
         private readonly ClientEntities _entities;
 
+        private readonly UserCommandSerializer _commandSerializer = new UserCommandSerializer();
+
+        private readonly UserCommand[] _commands = new UserCommand[UserCommandSerializer.MaxCommandsPerMessage];
+
+        /// <summary>
+        /// Sequence number of the oldest command that hasn't been sent yet
+        /// </summary>
+        private uint _nextSequenceToSend;
+
         public ClientNetworking(IEngineModels engineModels, GameClient gameClient, ClientEntities entities)
         {
             _engineModels = engineModels ?? throw new ArgumentNullException(nameof(engineModels));
@@ -45,6 +57,9 @@ namespace SharpLife.Game.Client.Networking
 
             //Cache off the name so we can look it up later
             _gameClient.CachedMapName = message.MapFileName;
+
+            //Entity 0 is the world, players come after it
+            _gameClient.LocalPlayerIndex = (int)message.ClientIndex + 1;
         }
 
         public void RegisterObjectListTypes(TypeRegistryBuilder typeRegistryBuilder)
@@ -58,5 +73,41 @@ namespace SharpLife.Game.Client.Networking
         {
             _entities.CreateNetworkObjectLists(networkObjectListBuilder);
         }
+
+        public UserCommands CreateUserCommands(int backupCount)
+        {
+            var prediction = _gameClient.Prediction;
+
+            var newCount = (int)(prediction.NextSequence - _nextSequenceToSend);
+
+            //Sequence numbers restart every map, so if the last sent command isn't one of the pending commands all of them are new
+            if (newCount < 0 || newCount > prediction.PendingCommandCount)
+            {
+                newCount = prediction.PendingCommandCount;
+            }
+
+            if (newCount == 0)
+            {
+                return null;
+            }
+
+            var count = prediction.CopyNewestCommands(_commands, newCount + Math.Max(0, backupCount));
+
+            _nextSequenceToSend = prediction.NextSequence;
+
+            return new UserCommands
+            {
+                Sequence = prediction.NextSequence - 1,
+                Count = (uint)count,
+                Commands = _commandSerializer.SerializeCommands(_commands, count)
+            };
+        }
+
+        public void ProcessUserCommandAck(UserCommandAck message)
+        {
+            _commandSerializer.DeserializeState(message.PlayerState, out var state);
+
+            _gameClient.Prediction.OnServerState(message.Sequence, state);
+        }
     }
 }
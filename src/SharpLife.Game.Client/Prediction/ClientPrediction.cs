@@ -0,0 +1,298 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using Serilog;
+using SharpLife.CommandSystem;
+using SharpLife.CommandSystem.Commands;
+using SharpLife.CommandSystem.Commands.VariableFilters;
+using SharpLife.Game.Shared.Physics;
+using System;
+using System.Numerics;
+
+namespace SharpLife.Game.Client.Prediction
+{
+    /// <summary>
+    /// Predicts the movement of the local player by running commands immediately instead of waiting for the server
+    /// Commands are kept until the server acknowledges them
+    /// If the server's result differs from the prediction, the remaining commands are replayed on top of the server's state
+    /// </summary>
+    public sealed class ClientPrediction
+    {
+        /// <summary>
+        /// Maximum number of commands that can be waiting for acknowledgement
+        /// Commands older than this are dropped, which causes a correction when the server catches up
+        /// </summary>
+        public const int MaxCommands = 64;
+
+        /// <summary>
+        /// Differences in position smaller than this are not corrected
+        /// </summary>
+        private const float ErrorTolerance = 0.03125f;
+
+        /// <summary>
+        /// Fraction of the difference between the latest and average error that is added to the average
+        /// </summary>
+        private const float ErrorSmoothingRate = 0.1f;
+
+        private struct PredictedCommand
+        {
+            public UserCommand command;
+
+            /// <summary>
+            /// State after running the command
+            /// </summary>
+            public PlayerMovementState result;
+        }
+
+        private readonly PredictedCommand[] _commands = new PredictedCommand[MaxCommands];
+
+        private readonly ILogger _logger;
+
+        private readonly IVariable _cl_predict;
+
+        private readonly IVariable _cl_showprediction;
+
+        private IMovementTracer _tracer;
+
+        /// <summary>
+        /// Sequence number of the oldest command that the server hasn't acknowledged yet
+        /// </summary>
+        private uint _firstSequence;
+
+        private uint _nextSequence;
+
+        private bool _hasServerState;
+
+        private PlayerMovementState _predictedState;
+
+        public MovementSettings Settings { get; set; } = MovementSettings.Default;
+
+        /// <summary>
+        /// State of the local player after running all commands
+        /// </summary>
+        public ref readonly PlayerMovementState PredictedState => ref _predictedState;
+
+        /// <summary>
+        /// Whether the server has sent the local player's state
+        /// If not, <see cref="PredictedState"/> is not the player's actual state
+        /// </summary>
+        public bool HasServerState => _hasServerState;
+
+        public int PendingCommandCount => (int)(_nextSequence - _firstSequence);
+
+        /// <summary>
+        /// Sequence number that the next command will be assigned
+        /// </summary>
+        public uint NextSequence => _nextSequence;
+
+        /// <summary>
+        /// Distance between the predicted and actual position for the most recently acknowledged command
+        /// </summary>
+        public float LastError { get; private set; }
+
+        /// <summary>
+        /// Smoothed average of <see cref="LastError"/>
+        /// </summary>
+        public float AverageError { get; private set; }
+
+        /// <summary>
+        /// Number of times the prediction was wrong and commands had to be replayed
+        /// </summary>
+        public int CorrectionCount { get; private set; }
+
+        private bool IsPredicting => _tracer != null && _cl_predict.Boolean;
+
+        public ClientPrediction(ILogger logger, ICommandContext commandContext)
+        {
+            _logger = logger ?? throw new ArgumentNullException(nameof(logger));
+
+            if (commandContext == null)
+            {
+                throw new ArgumentNullException(nameof(commandContext));
+            }
+
+            _cl_predict = commandContext.RegisterVariable(
+                new VariableInfo("cl_predict")
+                .WithHelpInfo("Whether to predict the movement of the local player")
+                .WithValue(true)
+                .WithBooleanFilter());
+
+            _cl_showprediction = commandContext.RegisterVariable(
+                new VariableInfo("cl_showprediction")
+                .WithHelpInfo("Whether to log prediction errors when the prediction is corrected")
+                .WithValue(false)
+                .WithBooleanFilter());
+
+            commandContext.RegisterCommand(new CommandInfo("cl_prediction_stats", _ =>
+            {
+                _logger.Information($"Prediction error: {LastError:F3} last, {AverageError:F3} average, {CorrectionCount} corrections, {PendingCommandCount} pending commands");
+            })
+            .WithHelpInfo("Logs how accurate the prediction of the local player's movement is"));
+        }
+
+        public void MapLoadBegin(IMovementTracer tracer)
+        {
+            _tracer = tracer ?? throw new ArgumentNullException(nameof(tracer));
+
+            Reset();
+        }
+
+        public void MapShutdown()
+        {
+            _tracer = null;
+
+            Reset();
+        }
+
+        public void Reset()
+        {
+            _firstSequence = 0;
+            _nextSequence = 0;
+            _hasServerState = false;
+            _predictedState = default;
+
+            LastError = 0;
+            AverageError = 0;
+            CorrectionCount = 0;
+        }
+
+        /// <summary>
+        /// Adds a new command and predicts its result
+        /// </summary>
+        /// <param name="command">Command to add. The sequence number is assigned by this method</param>
+        public void AddCommand(ref UserCommand command)
+        {
+            command.Sequence = _nextSequence;
+
+            if (PendingCommandCount >= MaxCommands)
+            {
+                ++_firstSequence;
+            }
+
+            //Nothing to predict from until the server has sent the player's state
+            if (_hasServerState && IsPredicting)
+            {
+                PlayerMovement.Simulate(ref _predictedState, command, Settings, _tracer);
+            }
+
+            _commands[_nextSequence % MaxCommands] = new PredictedCommand
+            {
+                command = command,
+                result = _predictedState
+            };
+
+            ++_nextSequence;
+        }
+
+        /// <summary>
+        /// Copies the newest commands that the server hasn't acknowledged yet
+        /// </summary>
+        /// <param name="commands">Receives the commands from oldest to newest</param>
+        /// <param name="maxCount">Maximum number of commands to copy</param>
+        /// <returns>Number of commands copied</returns>
+        public int CopyNewestCommands(UserCommand[] commands, int maxCount)
+        {
+            if (commands == null)
+            {
+                throw new ArgumentNullException(nameof(commands));
+            }
+
+            if (maxCount < 0)
+            {
+                throw new ArgumentOutOfRangeException(nameof(maxCount));
+            }
+
+            var count = Math.Min(Math.Min(maxCount, commands.Length), PendingCommandCount);
+
+            var sequence = _nextSequence - (uint)count;
+
+            for (var i = 0; i < count; ++i, ++sequence)
+            {
+                commands[i] = _commands[sequence % MaxCommands].command;
+            }
+
+            return count;
+        }
+
+        /// <summary>
+        /// Reconciles the prediction with the state received from the server
+        /// </summary>
+        /// <param name="acknowledgedSequence">Sequence number of the last command the server ran to produce this state</param>
+        /// <param name="serverState"></param>
+        public void OnServerState(uint acknowledgedSequence, in PlayerMovementState serverState)
+        {
+            //Older than a state that has already been received
+            if (_hasServerState && (int)(acknowledgedSequence - _firstSequence) < 0)
+            {
+                return;
+            }
+
+            //The server has run commands this client no longer knows about, nothing to reconcile
+            if ((int)(acknowledgedSequence - _nextSequence) >= 0)
+            {
+                _firstSequence = _nextSequence = acknowledgedSequence + 1;
+                _predictedState = serverState;
+                _hasServerState = true;
+                return;
+            }
+
+            var needsReplay = true;
+
+            if (_hasServerState && IsPredicting)
+            {
+                ref readonly var predicted = ref _commands[acknowledgedSequence % MaxCommands].result;
+
+                LastError = Vector3.Distance(predicted.Origin, serverState.Origin);
+                AverageError += (LastError - AverageError) * ErrorSmoothingRate;
+
+                needsReplay = LastError > ErrorTolerance
+                    || Vector3.Distance(predicted.Velocity, serverState.Velocity) > ErrorTolerance
+                    || predicted.OnGround != serverState.OnGround;
+
+                if (needsReplay)
+                {
+                    ++CorrectionCount;
+
+                    if (_cl_showprediction.Boolean)
+                    {
+                        _logger.Information($"Prediction corrected for command {acknowledgedSequence}: error {LastError:F3}, average {AverageError:F3}, {CorrectionCount} corrections");
+                    }
+                }
+            }
+
+            _firstSequence = acknowledgedSequence + 1;
+            _hasServerState = true;
+
+            if (!needsReplay)
+            {
+                return;
+            }
+
+            _predictedState = serverState;
+
+            for (var sequence = _firstSequence; sequence != _nextSequence; ++sequence)
+            {
+                ref var entry = ref _commands[sequence % MaxCommands];
+
+                if (IsPredicting)
+                {
+                    PlayerMovement.Simulate(ref _predictedState, entry.command, Settings, _tracer);
+                }
+
+                entry.result = _predictedState;
+            }
+        }
+    }
+}
@@ -15,21 +15,28 @@
 
 using Microsoft.Extensions.DependencyInjection;
 using Serilog;
+using SharpLife.CommandSystem;
+using SharpLife.CommandSystem.Commands;
+using SharpLife.CommandSystem.Commands.VariableFilters;
 using SharpLife.Engine.Shared;
 using SharpLife.Engine.Shared.API.Engine.Server;
 using SharpLife.Engine.Shared.API.Game.Server;
 using SharpLife.Engine.Shared.API.Game.Shared;
 using SharpLife.Engine.Shared.Events;
 using SharpLife.Game.Server.Entities;
+using SharpLife.Game.Server.Navigation;
 using SharpLife.Game.Server.Networking;
 using SharpLife.Game.Server.Physics;
 using SharpLife.Game.Shared.Bridge;
 using SharpLife.Game.Shared.Maps;
 using SharpLife.Game.Shared.Models;
 using SharpLife.Game.Shared.Models.BSP;
+using SharpLife.Game.Shared.Physics;
 using SharpLife.Models;
+using SharpLife.Models.BSP;
 using SharpLife.Models.BSP.FileFormat;
 using SharpLife.Utility;
+using SharpLife.Utility.FileSystem;
 using System;
 using System.Collections.Generic;
 using System.Diagnostics;
@@ -64,6 +71,15 @@ namespace SharpLife.Game.Server.API
 
         private GameMovement _movement;
 
+        /// <summary>
+        /// Used to run player movement for user commands
+        /// </summary>
+        private WorldMovementTracer _movementTracer;
+
+        private IVariable _sv_navmesh;
+
+        private IVariable _sv_maxcmdsperframe;
+
         private bool _active;
 
         /// <summary>
@@ -74,6 +90,18 @@ namespace SharpLife.Game.Server.API
 
         public IGameBridge GameBridge { get; set; }
 
+        /// <summary>
+        /// Gets the navigation mesh pathfinder for the current map
+        /// Null if navigation meshes are disabled or no map is loaded
+        /// </summary>
+        public NavPathfinder Navigation { get; private set; }
+
+        /// <summary>
+        /// Gets the potentially visible set data for the current map
+        /// Null if no map is loaded
+        /// </summary>
+        public BSPVisibility Visibility { get; private set; }
+
         public void Initialize(IServiceCollection serviceCollection)
         {
             serviceCollection.AddSingleton(this);
@@ -111,6 +139,19 @@ namespace SharpLife.Game.Server.API
             _entities = serviceProvider.GetRequiredService<ServerEntities>();
 
             _entities.Startup();
+
+            //TODO: mark as server cvar
+            _sv_navmesh = _engine.CommandContext.RegisterVariable(
+                new VariableInfo("sv_navmesh")
+                .WithHelpInfo("If non-zero, a navigation mesh is loaded from the map's cache file or generated when a map is loaded")
+                .WithValue(true)
+                .WithBooleanFilter());
+
+            _sv_maxcmdsperframe = _engine.CommandContext.RegisterVariable(
+                new VariableInfo("sv_maxcmdsperframe")
+                .WithHelpInfo("Maximum number of user commands to run for each client every frame. Commands beyond this are run in later frames")
+                .WithValue(16)
+                .WithMinMaxFilter(1, ClientCommandQueue.MaxQueuedCommands, true));
         }
 
         public void Shutdown()
@@ -183,10 +224,9 @@ namespace SharpLife.Game.Server.API
             MapInfo = new MapInfo(mapName, MapInfo?.Name, bspWorldModel);
 
             //Load world sub models
-            foreach (var i in Enumerable.Range(1, bspWorldModel.BSPFile.Models.Count - 1))
-            {
-                _engineModels.LoadModel($"{Framework.BSPModelNamePrefix}{i}");
-            }
+            _engineModels.LoadModels(Enumerable.Range(1, bspWorldModel.BSPFile.Models.Count - 1)
+                .Select(i => $"{Framework.BSPModelNamePrefix}{i}")
+                .ToList());
 
             //Load the fallback model now to ensure that BSP indices are matched up
             _engineModels.LoadFallbackModel();
@@ -200,13 +240,70 @@ namespace SharpLife.Game.Server.API
         {
             _entities.CreateEntityList();
 
-            _physics = new GamePhysics(_logger, _engine.EngineTime, _gameTime, _entities, _entities.EntityList, MapInfo.Model, _engine.CommandContext);
+            Visibility = new BSPVisibility(MapInfo.Model.BSPFile);
+
+            _physics = new GamePhysics(_logger, _engine.EngineTime, _gameTime, _entities, _entities.EntityList, MapInfo.Model, Visibility, _engine.CommandContext);
 
             _movement = new GameMovement(_logger, _engine.EngineTime, _gameTime, _engine.Clients, _entities, _entities.EntityList, _random, _physics, _engine.CommandContext);
 
+            _movementTracer = new WorldMovementTracer(MapInfo.Model);
+
+            Navigation = _sv_navmesh.Boolean ? new NavPathfinder(LoadNavigationMesh()) : null;
+
             _entities.MapLoadBegin(_gameTime, MapInfo, _physics, MapInfo.Model.BSPFile.Entities, loadGame);
         }
 
+        /// <summary>
+        /// Loads the navigation mesh for the current map from its cache file, or builds and caches it if there is no valid cache
+        /// </summary>
+        /// <returns></returns>
+        private NavMesh LoadNavigationMesh()
+        {
+            var navFileName = NavMeshFile.GetFileName(GameBridge.ModelUtils.FormatMapFileName(MapInfo.Name));
+
+            if (_engine.FileSystem.Exists(navFileName))
+            {
+                try
+                {
+                    using (var stream = _engine.FileSystem.Open(navFileName, FileMode.Open, FileAccess.Read, FileShare.Read))
+                    {
+                        var cachedMesh = NavMeshFile.Read(stream, MapInfo.Model.CRC);
+
+                        if (cachedMesh != null)
+                        {
+                            return cachedMesh;
+                        }
+                    }
+                }
+                catch (Exception e) when (e is IOException || e is InvalidDataException)
+                {
+                    _logger.Warning(e, $"Couldn't read navigation mesh {navFileName}");
+                }
+
+                _logger.Information($"Navigation mesh {navFileName} is out of date, rebuilding");
+            }
+
+            var stopwatch = Stopwatch.StartNew();
+
+            var mesh = new NavMeshBuilder().Build(MapInfo.Model);
+
+            _logger.Information($"Built navigation mesh with {mesh.Nodes.Count} nodes in {stopwatch.Elapsed.TotalSeconds:F2} seconds");
+
+            try
+            {
+                using (var stream = _engine.FileSystem.Open(navFileName, FileMode.Create, FileAccess.Write, FileShare.None, FileSystemConstants.PathID.Game))
+                {
+                    NavMeshFile.Write(stream, mesh, MapInfo.Model.CRC);
+                }
+            }
+            catch (Exception e) when (e is IOException || e is UnauthorizedAccessException)
+            {
+                _logger.Warning(e, $"Couldn't write navigation mesh {navFileName}");
+            }
+
+            return mesh;
+        }
+
         public void MapLoadFinished()
         {
 
@@ -240,11 +337,16 @@ namespace SharpLife.Game.Server.API
 
             _active = false;
 
+            _networking.Deactivate();
+
             _entities.Deactivate();
 
             //Reset these so the memory referenced by them can be reclaimed
             _movement = null;
+            _movementTracer = null;
             _physics = null;
+            Navigation = null;
+            Visibility = null;
         }
 
         private void InternalRunFrame(double frameTime)
@@ -258,6 +360,8 @@ namespace SharpLife.Game.Server.API
 
         public void RunFrame()
         {
+            _networking.RunUserCommands(_engine.EngineTime.FrameTime, _sv_maxcmdsperframe.Integer, _movementTracer);
+
             InternalRunFrame(_engine.EngineTime.FrameTime);
         }
     }
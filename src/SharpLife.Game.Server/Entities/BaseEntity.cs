@@ -399,6 +399,16 @@ namespace SharpLife.Game.Server.Entities
             _touchFunction?.Invoke(other);
         }
 
+        /// <summary>
+        /// Called on a trigger when an entity that was touching it has moved out of it
+        /// Only called when trigger touches are deferred
+        /// </summary>
+        /// <param name="other">Entity that stopped touching this trigger</param>
+        public virtual void EndTouch(BaseEntity other)
+        {
+            //Nothing
+        }
+
         public virtual void Blocked(BaseEntity other)
         {
             _blockedFunction?.Invoke(other);
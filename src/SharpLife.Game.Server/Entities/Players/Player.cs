@@ -0,0 +1,45 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using SharpLife.Game.Shared.Entities;
+using SharpLife.Game.Shared.Entities.MetaData;
+using SharpLife.Game.Shared.Physics;
+
+namespace SharpLife.Game.Server.Entities.Players
+{
+    /// <summary>
+    /// The entity controlled by a client
+    /// Always uses the entity index after the client's index
+    /// </summary>
+    [LinkEntityToClass("player")]
+    [Networkable(UseBaseType = true)]
+    public class Player : NetworkedEntity
+    {
+        public override bool IsPlayer => true;
+
+        protected override void Spawn()
+        {
+            //Moved by the client's commands, not by entity physics
+            MoveType = MoveType.Walk;
+
+            //TODO: make solid once player movement can trace against entities
+            Solid = Solid.Not;
+
+            //Ducking isn't supported by player movement yet
+            SetSize(PhysicsConstants.Hull1.ClipMins, PhysicsConstants.Hull1.ClipMaxs);
+            ViewOffset = PhysicsConstants.Hull1.ViewOffset;
+        }
+    }
+}
@@ -18,6 +18,7 @@ using SharpLife.Engine.Shared.API.Engine.Server;
 using SharpLife.Engine.Shared.API.Engine.Shared;
 using SharpLife.Game.Server.API;
 using SharpLife.Game.Server.Entities.EntityList;
+using SharpLife.Game.Server.Entities.Players;
 using SharpLife.Game.Server.Physics;
 using SharpLife.Game.Shared;
 using SharpLife.Game.Shared.Entities.EntityList;
@@ -30,6 +31,7 @@ using SharpLife.Utility;
 using SharpLife.Utility.Text;
 using System;
 using System.Collections.Generic;
+using System.Numerics;
 using System.Reflection;
 
 namespace SharpLife.Game.Server.Entities
@@ -185,6 +187,47 @@ namespace SharpLife.Game.Server.Entities
             //Nothing
         }
 
+        /// <summary>
+        /// Creates the player entity for a client at a spawn point
+        /// </summary>
+        /// <param name="clientIndex"></param>
+        public Player CreatePlayer(int clientIndex)
+        {
+            var metaData = EntityDictionary.FindEntityMetaData("player") ?? throw new NoSuchEntityClassException("player");
+
+            var player = (Player)EntityList.CreateEntity(metaData, clientIndex + 1);
+
+            var spawnPoint = FindSpawnPoint();
+
+            if (spawnPoint != null)
+            {
+                //Raise the player a little so they don't start out stuck in the floor
+                player.Origin = spawnPoint.Origin + new Vector3(0, 0, 1);
+                player.Angles = spawnPoint.Angles;
+            }
+            else
+            {
+                _logger.Warning("No info_player_start on this map, spawning player at the world origin");
+            }
+
+            player.Initialize();
+
+            return player;
+        }
+
+        private PlayerStart FindSpawnPoint()
+        {
+            foreach (var entity in EntityList)
+            {
+                if (entity is PlayerStart spawnPoint)
+                {
+                    return spawnPoint;
+                }
+            }
+
+            return null;
+        }
+
         private void LoadEntities(string entityData)
         {
             var keyvalues = KeyValuesParser.ParseAll(entityData);
@@ -0,0 +1,198 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using System;
+using System.Collections.Generic;
+using System.Numerics;
+
+namespace SharpLife.Game.Server.Navigation
+{
+    /// <summary>
+    /// Navigation mesh made up of walkable cells laid out on a 2D grid
+    /// Each grid column can contain multiple cells at different heights
+    /// Instances are immutable and can be queried from any thread
+    /// </summary>
+    public sealed class NavMesh
+    {
+        private readonly NavNode[] _nodes;
+
+        private readonly int[] _links;
+
+        /// <summary>
+        /// Index of the first node in each column, followed by the total node count
+        /// </summary>
+        private readonly int[] _columnFirstNodes;
+
+        /// <summary>
+        /// Center of the first column
+        /// </summary>
+        public Vector2 GridOrigin { get; }
+
+        public float CellSize { get; }
+
+        /// <summary>
+        /// Number of columns on the X axis
+        /// </summary>
+        public int Columns { get; }
+
+        /// <summary>
+        /// Number of columns on the Y axis
+        /// </summary>
+        public int Rows { get; }
+
+        /// <summary>
+        /// Maximum height difference between a point and a node for the point to be considered inside the node
+        /// </summary>
+        public float StepSize { get; }
+
+        public IReadOnlyList<NavNode> Nodes => _nodes;
+
+        /// <summary>
+        /// Target node indices for all node links
+        /// </summary>
+        public IReadOnlyList<int> Links => _links;
+
+        internal IReadOnlyList<int> ColumnFirstNodes => _columnFirstNodes;
+
+        public NavMesh(in Vector2 gridOrigin, float cellSize, int columns, int rows, float stepSize, NavNode[] nodes, int[] links, int[] columnFirstNodes)
+        {
+            if (cellSize <= 0)
+            {
+                throw new ArgumentOutOfRangeException(nameof(cellSize));
+            }
+
+            if (columns < 0)
+            {
+                throw new ArgumentOutOfRangeException(nameof(columns));
+            }
+
+            if (rows < 0)
+            {
+                throw new ArgumentOutOfRangeException(nameof(rows));
+            }
+
+            _nodes = nodes ?? throw new ArgumentNullException(nameof(nodes));
+            _links = links ?? throw new ArgumentNullException(nameof(links));
+            _columnFirstNodes = columnFirstNodes ?? throw new ArgumentNullException(nameof(columnFirstNodes));
+
+            if (_columnFirstNodes.Length != (columns * rows) + 1)
+            {
+                throw new ArgumentException("Column node index list does not match the grid size", nameof(columnFirstNodes));
+            }
+
+            GridOrigin = gridOrigin;
+            CellSize = cellSize;
+            Columns = columns;
+            Rows = rows;
+            StepSize = stepSize;
+        }
+
+        /// <summary>
+        /// Gets the indices of the nodes that the given node links to
+        /// </summary>
+        /// <param name="node"></param>
+        /// <returns></returns>
+        public ReadOnlySpan<int> GetLinks(int node)
+        {
+            ref readonly var navNode = ref _nodes[node];
+
+            return new ReadOnlySpan<int>(_links, navNode.FirstLink, navNode.LinkCount);
+        }
+
+        /// <summary>
+        /// Finds the node that contains the given point
+        /// If the point is not inside any node, the closest node in the surrounding columns is returned
+        /// </summary>
+        /// <param name="point"></param>
+        /// <returns>The node index, or -1 if no node is near the point</returns>
+        public int FindNearestNode(in Vector3 point)
+        {
+            var column = (int)Math.Round((point.X - GridOrigin.X) / CellSize);
+            var row = (int)Math.Round((point.Y - GridOrigin.Y) / CellSize);
+
+            //Prefer the highest cell below the point in its own column
+            var best = FindNodeInColumn(column, row, point);
+
+            if (best != -1)
+            {
+                return best;
+            }
+
+            var bestDistance = float.MaxValue;
+
+            for (var y = row - 1; y <= row + 1; ++y)
+            {
+                for (var x = column - 1; x <= column + 1; ++x)
+                {
+                    if (!GetColumnRange(x, y, out var first, out var last))
+                    {
+                        continue;
+                    }
+
+                    for (var i = first; i < last; ++i)
+                    {
+                        var distance = Vector3.DistanceSquared(_nodes[i].Origin, point);
+
+                        if (distance < bestDistance)
+                        {
+                            bestDistance = distance;
+                            best = i;
+                        }
+                    }
+                }
+            }
+
+            return best;
+        }
+
+        private int FindNodeInColumn(int column, int row, in Vector3 point)
+        {
+            if (!GetColumnRange(column, row, out var first, out var last))
+            {
+                return -1;
+            }
+
+            var best = -1;
+
+            //Nodes in a column are sorted from top to bottom
+            for (var i = first; i < last; ++i)
+            {
+                if (_nodes[i].Origin.Z <= point.Z + StepSize)
+                {
+                    best = i;
+                    break;
+                }
+            }
+
+            return best;
+        }
+
+        private bool GetColumnRange(int column, int row, out int first, out int last)
+        {
+            if (column < 0 || column >= Columns || row < 0 || row >= Rows)
+            {
+                first = last = 0;
+                return false;
+            }
+
+            var index = (row * Columns) + column;
+
+            first = _columnFirstNodes[index];
+            last = _columnFirstNodes[index + 1];
+
+            return first != last;
+        }
+    }
+}
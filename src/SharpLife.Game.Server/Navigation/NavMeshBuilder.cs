@@ -0,0 +1,273 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using SharpLife.Game.Shared.Models.BSP;
+using SharpLife.Game.Shared.Physics;
+using SharpLife.Models.BSP.FileFormat;
+using System;
+using System.Collections.Generic;
+using System.Numerics;
+using System.Threading.Tasks;
+
+namespace SharpLife.Game.Server.Navigation
+{
+    /// <summary>
+    /// Builds navigation meshes by sampling the hull 1 (standing player sized) clip hull of a map
+    /// Every grid column is scanned from top to bottom to find floors, and cells are linked to cells in neighboring columns
+    /// that can be reached by walking, stepping up or dropping down
+    /// </summary>
+    public sealed class NavMeshBuilder
+    {
+        private static readonly (int X, int Y)[] NeighborOffsets = new (int, int)[]
+        {
+            (1, 0),
+            (-1, 0),
+            (0, 1),
+            (0, -1),
+            (1, 1),
+            (1, -1),
+            (-1, 1),
+            (-1, -1)
+        };
+
+        /// <summary>
+        /// Size of a cell on the X and Y axes
+        /// </summary>
+        public float CellSize { get; set; } = 32;
+
+        /// <summary>
+        /// Distance between samples when scanning columns
+        /// Must be smaller than the height of hull 1 so no solid areas are skipped
+        /// </summary>
+        public float SampleHeight { get; set; } = 16;
+
+        /// <summary>
+        /// Precision that floor heights are refined to
+        /// </summary>
+        public float FloorPrecision { get; set; } = 0.5f;
+
+        /// <summary>
+        /// Maximum height that can be stepped up
+        /// </summary>
+        public float StepSize { get; set; } = 18;
+
+        /// <summary>
+        /// Maximum height that can be dropped down
+        /// Drops are one way links
+        /// </summary>
+        public float MaxDropHeight { get; set; } = 64;
+
+        /// <summary>
+        /// Builds a navigation mesh for the given world model
+        /// Columns are processed in parallel
+        /// </summary>
+        /// <param name="worldModel"></param>
+        /// <returns></returns>
+        public NavMesh Build(BSPModel worldModel)
+        {
+            if (worldModel == null)
+            {
+                throw new ArgumentNullException(nameof(worldModel));
+            }
+
+            var hull = worldModel.Hulls[1];
+
+            var mins = worldModel.Mins;
+            var maxs = worldModel.Maxs;
+
+            var columns = Math.Max(0, (int)Math.Ceiling((maxs.X - mins.X) / CellSize));
+            var rows = Math.Max(0, (int)Math.Ceiling((maxs.Y - mins.Y) / CellSize));
+
+            var gridOrigin = new Vector2(mins.X + (CellSize / 2), mins.Y + (CellSize / 2));
+
+            var floors = new List<float>[columns * rows];
+
+            Parallel.For(0, rows, row =>
+            {
+                for (var column = 0; column < columns; ++column)
+                {
+                    floors[(row * columns) + column] = FindFloors(
+                        hull,
+                        gridOrigin.X + (column * CellSize),
+                        gridOrigin.Y + (row * CellSize),
+                        mins.Z, maxs.Z);
+                }
+            });
+
+            var columnFirstNodes = new int[floors.Length + 1];
+            var origins = new List<Vector3>();
+
+            for (var i = 0; i < floors.Length; ++i)
+            {
+                columnFirstNodes[i] = origins.Count;
+
+                var row = i / columns;
+                var column = i % columns;
+
+                foreach (var z in floors[i])
+                {
+                    origins.Add(new Vector3(gridOrigin.X + (column * CellSize), gridOrigin.Y + (row * CellSize), z));
+                }
+            }
+
+            columnFirstNodes[floors.Length] = origins.Count;
+
+            var nodeLinks = new List<int>[origins.Count];
+
+            Parallel.For(0, rows, row =>
+            {
+                for (var column = 0; column < columns; ++column)
+                {
+                    var index = (row * columns) + column;
+
+                    for (var node = columnFirstNodes[index]; node < columnFirstNodes[index + 1]; ++node)
+                    {
+                        nodeLinks[node] = FindLinks(hull, origins, columnFirstNodes, columns, rows, column, row, node);
+                    }
+                }
+            });
+
+            var nodes = new NavNode[origins.Count];
+            var links = new List<int>();
+
+            for (var i = 0; i < nodes.Length; ++i)
+            {
+                nodes[i] = new NavNode(origins[i], links.Count, nodeLinks[i].Count);
+                links.AddRange(nodeLinks[i]);
+            }
+
+            return new NavMesh(gridOrigin, CellSize, columns, rows, StepSize, nodes, links.ToArray(), columnFirstNodes);
+        }
+
+        private static bool IsOpen(Hull hull, Vector3 point)
+        {
+            var contents = HullTracer.HullPointContents(hull, hull.FirstClipNode, ref point);
+
+            return contents != Contents.Solid && contents != Contents.Sky;
+        }
+
+        /// <summary>
+        /// Finds all floors in a column, sorted from top to bottom
+        /// </summary>
+        private List<float> FindFloors(Hull hull, float x, float y, float minZ, float maxZ)
+        {
+            var floors = new List<float>();
+
+            var wasOpen = IsOpen(hull, new Vector3(x, y, maxZ));
+
+            for (var z = maxZ - SampleHeight; z >= minZ; z -= SampleHeight)
+            {
+                var isOpen = IsOpen(hull, new Vector3(x, y, z));
+
+                if (wasOpen && !isOpen)
+                {
+                    //Refine the floor height, the highest sample is open and the lowest is solid
+                    var open = z + SampleHeight;
+                    var solid = z;
+
+                    while (open - solid > FloorPrecision)
+                    {
+                        var middle = (open + solid) / 2;
+
+                        if (IsOpen(hull, new Vector3(x, y, middle)))
+                        {
+                            open = middle;
+                        }
+                        else
+                        {
+                            solid = middle;
+                        }
+                    }
+
+                    floors.Add(open);
+                }
+
+                wasOpen = isOpen;
+            }
+
+            return floors;
+        }
+
+        private List<int> FindLinks(Hull hull, List<Vector3> origins, int[] columnFirstNodes, int columns, int rows, int column, int row, int node)
+        {
+            var links = new List<int>();
+
+            var origin = origins[node];
+
+            foreach (var (offsetX, offsetY) in NeighborOffsets)
+            {
+                var x = column + offsetX;
+                var y = row + offsetY;
+
+                if (x < 0 || x >= columns || y < 0 || y >= rows)
+                {
+                    continue;
+                }
+
+                var index = (y * columns) + x;
+
+                for (var other = columnFirstNodes[index]; other < columnFirstNodes[index + 1]; ++other)
+                {
+                    if (CanMove(hull, origin, origins[other]))
+                    {
+                        links.Add(other);
+                    }
+                }
+            }
+
+            return links;
+        }
+
+        private bool CanMove(Hull hull, in Vector3 start, in Vector3 end)
+        {
+            var heightDelta = end.Z - start.Z;
+
+            if (heightDelta > StepSize || heightDelta < -MaxDropHeight)
+            {
+                return false;
+            }
+
+            //Move across at the highest of the two heights so steps and ledges don't block the move
+            var top = Math.Max(start.Z, end.Z) + 1;
+
+            for (var fraction = 0.25f; fraction < 1; fraction += 0.25f)
+            {
+                var point = Vector3.Lerp(start, end, fraction);
+
+                point.Z = top;
+
+                if (!IsOpen(hull, point))
+                {
+                    return false;
+                }
+            }
+
+            //Walking and stepping requires there to be ground between the cells, dropping down does not
+            if (heightDelta >= -StepSize)
+            {
+                var middle = Vector3.Lerp(start, end, 0.5f);
+
+                middle.Z = Math.Min(start.Z, end.Z) - StepSize;
+
+                if (IsOpen(hull, middle))
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+    }
+}
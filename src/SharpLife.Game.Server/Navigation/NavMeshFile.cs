@@ -0,0 +1,232 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using System;
+using System.IO;
+using System.Numerics;
+using System.Text;
+
+namespace SharpLife.Game.Server.Navigation
+{
+    /// <summary>
+    /// Reads and writes cached navigation meshes
+    /// Cache files are stored next to the map and are tied to the CRC of the map they were built for
+    /// </summary>
+    public static class NavMeshFile
+    {
+        public const string FileExtension = ".nav";
+
+        /// <summary>
+        /// SLNV
+        /// </summary>
+        public const int Identifier = ('V' << 24) + ('N' << 16) + ('L' << 8) + 'S';
+
+        /// <summary>
+        /// Increment this whenever the file format or the builder's output changes
+        /// </summary>
+        public const int Version = 1;
+
+        /// <summary>
+        /// Size of a node on disk: origin, first link and link count
+        /// </summary>
+        private const int NodeSize = (3 * sizeof(float)) + (2 * sizeof(int));
+
+        /// <summary>
+        /// Gets the name of the cache file for the given map file
+        /// </summary>
+        /// <param name="mapFileName"></param>
+        /// <returns></returns>
+        public static string GetFileName(string mapFileName)
+        {
+            if (mapFileName == null)
+            {
+                throw new ArgumentNullException(nameof(mapFileName));
+            }
+
+            return Path.ChangeExtension(mapFileName, FileExtension);
+        }
+
+        public static void Write(Stream stream, NavMesh mesh, uint mapCRC)
+        {
+            if (stream == null)
+            {
+                throw new ArgumentNullException(nameof(stream));
+            }
+
+            if (mesh == null)
+            {
+                throw new ArgumentNullException(nameof(mesh));
+            }
+
+            using (var writer = new BinaryWriter(stream, Encoding.UTF8, true))
+            {
+                writer.Write(Identifier);
+                writer.Write(Version);
+                writer.Write(mapCRC);
+
+                writer.Write(mesh.GridOrigin.X);
+                writer.Write(mesh.GridOrigin.Y);
+                writer.Write(mesh.CellSize);
+                writer.Write(mesh.Columns);
+                writer.Write(mesh.Rows);
+                writer.Write(mesh.StepSize);
+
+                foreach (var first in mesh.ColumnFirstNodes)
+                {
+                    writer.Write(first);
+                }
+
+                writer.Write(mesh.Nodes.Count);
+
+                foreach (var node in mesh.Nodes)
+                {
+                    writer.Write(node.Origin.X);
+                    writer.Write(node.Origin.Y);
+                    writer.Write(node.Origin.Z);
+                    writer.Write(node.FirstLink);
+                    writer.Write(node.LinkCount);
+                }
+
+                writer.Write(mesh.Links.Count);
+
+                foreach (var link in mesh.Links)
+                {
+                    writer.Write(link);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Reads a navigation mesh from a stream
+        /// </summary>
+        /// <param name="stream"></param>
+        /// <param name="mapCRC"></param>
+        /// <returns>The mesh, or null if the file is not a navigation mesh, has a different version or was built for a different map</returns>
+        /// <exception cref="EndOfStreamException">If the file is truncated</exception>
+        /// <exception cref="InvalidDataException">If the file contents are invalid</exception>
+        public static NavMesh Read(Stream stream, uint mapCRC)
+        {
+            if (stream == null)
+            {
+                throw new ArgumentNullException(nameof(stream));
+            }
+
+            using (var reader = new BinaryReader(stream, Encoding.UTF8, true))
+            {
+                if (reader.ReadInt32() != Identifier
+                    || reader.ReadInt32() != Version
+                    || reader.ReadUInt32() != mapCRC)
+                {
+                    return null;
+                }
+
+                var gridOrigin = new Vector2(reader.ReadSingle(), reader.ReadSingle());
+                var cellSize = reader.ReadSingle();
+                var columns = reader.ReadInt32();
+                var rows = reader.ReadInt32();
+                var stepSize = reader.ReadSingle();
+
+                if (cellSize <= 0 || columns < 0 || rows < 0)
+                {
+                    throw new InvalidDataException("Navigation mesh has an invalid grid");
+                }
+
+                //Check the cell count against the file size before allocating anything for it
+                var cellCount = (long)columns * rows;
+
+                if (cellCount >= int.MaxValue || cellCount + 1 > GetRemainingElements(stream, sizeof(int)))
+                {
+                    throw new InvalidDataException($"Navigation mesh grid size {columns} x {rows} is larger than the file");
+                }
+
+                var columnFirstNodes = new int[cellCount + 1];
+
+                for (var i = 0; i < columnFirstNodes.Length; ++i)
+                {
+                    columnFirstNodes[i] = reader.ReadInt32();
+                }
+
+                var nodes = new NavNode[ReadCount(reader, NodeSize)];
+
+                for (var i = 0; i < nodes.Length; ++i)
+                {
+                    var origin = new Vector3(reader.ReadSingle(), reader.ReadSingle(), reader.ReadSingle());
+
+                    nodes[i] = new NavNode(origin, reader.ReadInt32(), reader.ReadInt32());
+                }
+
+                var links = new int[ReadCount(reader, sizeof(int))];
+
+                for (var i = 0; i < links.Length; ++i)
+                {
+                    links[i] = reader.ReadInt32();
+
+                    if (links[i] < 0 || links[i] >= nodes.Length)
+                    {
+                        throw new InvalidDataException("Navigation mesh link references a non-existent node");
+                    }
+                }
+
+                foreach (var node in nodes)
+                {
+                    if (node.FirstLink < 0 || node.LinkCount < 0 || node.FirstLink + node.LinkCount > links.Length)
+                    {
+                        throw new InvalidDataException("Navigation mesh node has an invalid link range");
+                    }
+                }
+
+                foreach (var first in columnFirstNodes)
+                {
+                    if (first < 0 || first > nodes.Length)
+                    {
+                        throw new InvalidDataException("Navigation mesh column references a non-existent node");
+                    }
+                }
+
+                return new NavMesh(gridOrigin, cellSize, columns, rows, stepSize, nodes, links, columnFirstNodes);
+            }
+        }
+
+        /// <summary>
+        /// Gets the maximum number of elements of the given size that the rest of the stream can contain
+        /// </summary>
+        private static long GetRemainingElements(Stream stream, int elementSize)
+        {
+            if (!stream.CanSeek)
+            {
+                return long.MaxValue;
+            }
+
+            return Math.Max(0, stream.Length - stream.Position) / elementSize;
+        }
+
+        private static int ReadCount(BinaryReader reader, int elementSize)
+        {
+            var count = reader.ReadInt32();
+
+            if (count < 0)
+            {
+                throw new InvalidDataException("Navigation mesh has a negative element count");
+            }
+
+            if (count > GetRemainingElements(reader.BaseStream, elementSize))
+            {
+                throw new InvalidDataException($"Navigation mesh element count {count} is larger than the file");
+            }
+
+            return count;
+        }
+    }
+}
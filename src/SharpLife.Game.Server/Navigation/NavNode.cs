@@ -0,0 +1,45 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using System.Numerics;
+
+namespace SharpLife.Game.Server.Navigation
+{
+    /// <summary>
+    /// A single walkable cell in a navigation mesh
+    /// The cell is a square of <see cref="NavMesh.CellSize"/> units centered on <see cref="Origin"/>
+    /// </summary>
+    public readonly struct NavNode
+    {
+        /// <summary>
+        /// Origin of a standing hull 1 entity in this cell
+        /// </summary>
+        public readonly Vector3 Origin;
+
+        /// <summary>
+        /// Index of the first link in <see cref="NavMesh.Links"/>
+        /// </summary>
+        public readonly int FirstLink;
+
+        public readonly int LinkCount;
+
+        public NavNode(in Vector3 origin, int firstLink, int linkCount)
+        {
+            Origin = origin;
+            FirstLink = firstLink;
+            LinkCount = linkCount;
+        }
+    }
+}
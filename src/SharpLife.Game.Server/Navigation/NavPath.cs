@@ -0,0 +1,51 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using System;
+using System.Collections.Generic;
+using System.Numerics;
+
+namespace SharpLife.Game.Server.Navigation
+{
+    /// <summary>
+    /// A path through a navigation mesh
+    /// Paths are shared between callers through the path cache and must not be modified
+    /// </summary>
+    public sealed class NavPath
+    {
+        /// <summary>
+        /// Indices of the nodes along the path, from start to end
+        /// </summary>
+        public IReadOnlyList<int> Nodes { get; }
+
+        /// <summary>
+        /// Origins of the nodes along the path, from start to end
+        /// Callers should steer towards their actual goal once the last point has been reached
+        /// </summary>
+        public IReadOnlyList<Vector3> Points { get; }
+
+        /// <summary>
+        /// Total length of the path
+        /// </summary>
+        public float Length { get; }
+
+        public NavPath(IReadOnlyList<int> nodes, IReadOnlyList<Vector3> points, float length)
+        {
+            Nodes = nodes ?? throw new ArgumentNullException(nameof(nodes));
+            Points = points ?? throw new ArgumentNullException(nameof(points));
+            Length = length;
+        }
+    }
+}
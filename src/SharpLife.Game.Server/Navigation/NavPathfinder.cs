@@ -0,0 +1,331 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using System.Numerics;
+using System.Threading.Tasks;
+
+namespace SharpLife.Game.Server.Navigation
+{
+    /// <summary>
+    /// Finds paths through a navigation mesh using A*
+    /// Queries can be run from any thread, results are cached by start and end node
+    /// </summary>
+    public sealed class NavPathfinder
+    {
+        public const int DefaultMaxCachedPaths = 1024;
+
+        /// <summary>
+        /// Per-query search data, reused between queries to avoid allocating per-node arrays every time
+        /// </summary>
+        private sealed class SearchState
+        {
+            public readonly float[] Costs;
+
+            public readonly int[] Parents;
+
+            /// <summary>
+            /// Search generation that each node was last visited in
+            /// Avoids having to clear the other arrays between searches
+            /// </summary>
+            public readonly int[] Generations;
+
+            public readonly bool[] Closed;
+
+            public readonly List<(int Node, float Score)> OpenHeap = new List<(int Node, float Score)>();
+
+            public int Generation;
+
+            public SearchState(int nodeCount)
+            {
+                Costs = new float[nodeCount];
+                Parents = new int[nodeCount];
+                Generations = new int[nodeCount];
+                Closed = new bool[nodeCount];
+            }
+
+            public void Visit(int node)
+            {
+                if (Generations[node] != Generation)
+                {
+                    Generations[node] = Generation;
+                    Costs[node] = float.MaxValue;
+                    Parents[node] = -1;
+                    Closed[node] = false;
+                }
+            }
+
+            public void Push(int node, float score)
+            {
+                OpenHeap.Add((node, score));
+
+                var index = OpenHeap.Count - 1;
+
+                while (index > 0)
+                {
+                    var parent = (index - 1) / 2;
+
+                    if (OpenHeap[parent].Score <= OpenHeap[index].Score)
+                    {
+                        break;
+                    }
+
+                    Swap(parent, index);
+                    index = parent;
+                }
+            }
+
+            public int Pop()
+            {
+                var result = OpenHeap[0].Node;
+
+                var last = OpenHeap.Count - 1;
+
+                OpenHeap[0] = OpenHeap[last];
+                OpenHeap.RemoveAt(last);
+
+                var index = 0;
+
+                while (true)
+                {
+                    var left = (index * 2) + 1;
+                    var right = left + 1;
+                    var smallest = index;
+
+                    if (left < OpenHeap.Count && OpenHeap[left].Score < OpenHeap[smallest].Score)
+                    {
+                        smallest = left;
+                    }
+
+                    if (right < OpenHeap.Count && OpenHeap[right].Score < OpenHeap[smallest].Score)
+                    {
+                        smallest = right;
+                    }
+
+                    if (smallest == index)
+                    {
+                        break;
+                    }
+
+                    Swap(smallest, index);
+                    index = smallest;
+                }
+
+                return result;
+            }
+
+            private void Swap(int first, int second)
+            {
+                var temp = OpenHeap[first];
+                OpenHeap[first] = OpenHeap[second];
+                OpenHeap[second] = temp;
+            }
+        }
+
+        private readonly ConcurrentDictionary<(int Start, int End), NavPath> _pathCache = new ConcurrentDictionary<(int Start, int End), NavPath>();
+
+        private readonly ConcurrentBag<SearchState> _searchStates = new ConcurrentBag<SearchState>();
+
+        public NavMesh Mesh { get; }
+
+        /// <summary>
+        /// Maximum number of paths to cache
+        /// The cache is cleared when it fills up
+        /// </summary>
+        public int MaxCachedPaths { get; }
+
+        public NavPathfinder(NavMesh mesh, int maxCachedPaths = DefaultMaxCachedPaths)
+        {
+            Mesh = mesh ?? throw new ArgumentNullException(nameof(mesh));
+
+            if (maxCachedPaths < 0)
+            {
+                throw new ArgumentOutOfRangeException(nameof(maxCachedPaths));
+            }
+
+            MaxCachedPaths = maxCachedPaths;
+        }
+
+        /// <summary>
+        /// Finds a path between the nodes nearest to the given points
+        /// </summary>
+        /// <param name="start"></param>
+        /// <param name="end"></param>
+        /// <returns>The path, or null if either point is not near the mesh or there is no path between them</returns>
+        public NavPath FindPath(in Vector3 start, in Vector3 end)
+        {
+            var startNode = Mesh.FindNearestNode(start);
+            var endNode = Mesh.FindNearestNode(end);
+
+            if (startNode == -1 || endNode == -1)
+            {
+                return null;
+            }
+
+            return FindPath(startNode, endNode);
+        }
+
+        /// <summary>
+        /// Finds a path between two nodes
+        /// </summary>
+        /// <param name="startNode"></param>
+        /// <param name="endNode"></param>
+        /// <returns>The path, or null if there is no path between them</returns>
+        public NavPath FindPath(int startNode, int endNode)
+        {
+            if (startNode < 0 || startNode >= Mesh.Nodes.Count)
+            {
+                throw new ArgumentOutOfRangeException(nameof(startNode));
+            }
+
+            if (endNode < 0 || endNode >= Mesh.Nodes.Count)
+            {
+                throw new ArgumentOutOfRangeException(nameof(endNode));
+            }
+
+            var key = (startNode, endNode);
+
+            if (_pathCache.TryGetValue(key, out var path))
+            {
+                return path;
+            }
+
+            if (!_searchStates.TryTake(out var state))
+            {
+                state = new SearchState(Mesh.Nodes.Count);
+            }
+
+            try
+            {
+                path = Search(state, startNode, endNode);
+            }
+            finally
+            {
+                _searchStates.Add(state);
+            }
+
+            if (MaxCachedPaths > 0)
+            {
+                if (_pathCache.Count >= MaxCachedPaths)
+                {
+                    _pathCache.Clear();
+                }
+
+                _pathCache[key] = path;
+            }
+
+            return path;
+        }
+
+        /// <summary>
+        /// Finds a path on a worker thread
+        /// <see cref="FindPath(in Vector3, in Vector3)"/>
+        /// </summary>
+        /// <param name="start"></param>
+        /// <param name="end"></param>
+        /// <returns></returns>
+        public Task<NavPath> FindPathAsync(Vector3 start, Vector3 end)
+        {
+            return Task.Run(() => FindPath(start, end));
+        }
+
+        /// <summary>
+        /// Removes all cached paths
+        /// </summary>
+        public void ClearCache()
+        {
+            _pathCache.Clear();
+        }
+
+        private NavPath Search(SearchState state, int startNode, int endNode)
+        {
+            var nodes = Mesh.Nodes;
+            var goal = nodes[endNode].Origin;
+
+            ++state.Generation;
+            state.OpenHeap.Clear();
+
+            state.Visit(startNode);
+            state.Costs[startNode] = 0;
+            state.Push(startNode, Vector3.Distance(nodes[startNode].Origin, goal));
+
+            while (state.OpenHeap.Count > 0)
+            {
+                var current = state.Pop();
+
+                if (state.Closed[current])
+                {
+                    //Stale heap entry for a node whose cost was lowered after it was pushed
+                    continue;
+                }
+
+                if (current == endNode)
+                {
+                    return BuildPath(state, endNode);
+                }
+
+                state.Closed[current] = true;
+
+                var origin = nodes[current].Origin;
+
+                foreach (var neighbor in Mesh.GetLinks(current))
+                {
+                    state.Visit(neighbor);
+
+                    if (state.Closed[neighbor])
+                    {
+                        continue;
+                    }
+
+                    var neighborOrigin = nodes[neighbor].Origin;
+
+                    var cost = state.Costs[current] + Vector3.Distance(origin, neighborOrigin);
+
+                    if (cost < state.Costs[neighbor])
+                    {
+                        state.Costs[neighbor] = cost;
+                        state.Parents[neighbor] = current;
+                        state.Push(neighbor, cost + Vector3.Distance(neighborOrigin, goal));
+                    }
+                }
+            }
+
+            return null;
+        }
+
+        private NavPath BuildPath(SearchState state, int endNode)
+        {
+            var pathNodes = new List<int>();
+
+            for (var node = endNode; node != -1; node = state.Parents[node])
+            {
+                pathNodes.Add(node);
+            }
+
+            pathNodes.Reverse();
+
+            var points = new Vector3[pathNodes.Count];
+
+            for (var i = 0; i < points.Length; ++i)
+            {
+                points[i] = Mesh.Nodes[pathNodes[i]].Origin;
+            }
+
+            return new NavPath(pathNodes, points, state.Costs[endNode]);
+        }
+    }
+}
@@ -0,0 +1,198 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using SharpLife.Game.Shared.Physics;
+using System;
+using System.Numerics;
+
+namespace SharpLife.Game.Server.Networking
+{
+    /// <summary>
+    /// Commands received from a single client that are waiting to be run
+    /// Clients send every command more than once, so commands that have already been received are ignored
+    /// Commands can only use as much time as has actually passed, which keeps clients from speeding up their movement by sending more commands
+    /// </summary>
+    internal sealed class ClientCommandQueue
+    {
+        /// <summary>
+        /// Maximum number of commands that can be waiting to be run
+        /// Commands received while the queue is full are dropped
+        /// </summary>
+        public const int MaxQueuedCommands = 64;
+
+        /// <summary>
+        /// Maximum amount of unused time that can accumulate, in milliseconds
+        /// Lets clients catch up after lag spikes without letting them save up time to move faster later
+        /// </summary>
+        public const double MaxTimeBudget = 250;
+
+        private readonly UserCommand[] _commands = new UserCommand[MaxQueuedCommands];
+
+        private int _head;
+
+        private int _count;
+
+        private bool _hasReceivedCommands;
+
+        private uint _lastReceivedSequence;
+
+        /// <summary>
+        /// Time that commands can still use, in milliseconds
+        /// </summary>
+        private double _timeBudget;
+
+        private PlayerMovementState _state;
+
+        /// <summary>
+        /// State of the player after running the last command
+        /// </summary>
+        public ref readonly PlayerMovementState State => ref _state;
+
+        /// <summary>
+        /// Sequence number of the last command that was run
+        /// </summary>
+        public uint LastRunSequence { get; private set; }
+
+        /// <summary>
+        /// View angles of the last command that was run
+        /// </summary>
+        public Vector3 ViewAngles { get; private set; }
+
+        /// <summary>
+        /// Whether any commands have been run since the client connected
+        /// If not, <see cref="State"/> is not the player's actual state
+        /// </summary>
+        public bool HasRunCommands { get; private set; }
+
+        /// <summary>
+        /// Whether any commands have been run since the client was last told about them
+        /// </summary>
+        public bool NeedsAcknowledgement { get; set; }
+
+        public int Count => _count;
+
+        /// <summary>
+        /// Number of commands that were dropped because the queue was full or because they were invalid
+        /// </summary>
+        public int DroppedCommandCount { get; private set; }
+
+        public void Reset()
+        {
+            _head = 0;
+            _count = 0;
+            _hasReceivedCommands = false;
+            _lastReceivedSequence = 0;
+            _timeBudget = 0;
+            _state = default;
+
+            LastRunSequence = 0;
+            ViewAngles = Vector3.Zero;
+            HasRunCommands = false;
+            NeedsAcknowledgement = false;
+            DroppedCommandCount = 0;
+        }
+
+        /// <summary>
+        /// Replaces the player's state, used when the player is spawned
+        /// The new state is sent to the client along with the next acknowledgement
+        /// </summary>
+        /// <param name="state"></param>
+        public void SetState(in PlayerMovementState state)
+        {
+            _state = state;
+        }
+
+        private static bool IsValid(float value)
+        {
+            return !float.IsNaN(value) && !float.IsInfinity(value);
+        }
+
+        private static bool IsValid(in UserCommand command)
+        {
+            return IsValid(command.ViewAngles.X)
+                && IsValid(command.ViewAngles.Y)
+                && IsValid(command.ViewAngles.Z)
+                && IsValid(command.ForwardMove)
+                && IsValid(command.SideMove)
+                && IsValid(command.UpMove);
+        }
+
+        /// <summary>
+        /// Adds a received command to the end of the queue
+        /// </summary>
+        /// <param name="command"></param>
+        public void Add(in UserCommand command)
+        {
+            //Already received in an earlier packet
+            if (_hasReceivedCommands && (int)(command.Sequence - _lastReceivedSequence) <= 0)
+            {
+                return;
+            }
+
+            _hasReceivedCommands = true;
+            _lastReceivedSequence = command.Sequence;
+
+            if (_count >= MaxQueuedCommands || !IsValid(command))
+            {
+                ++DroppedCommandCount;
+                return;
+            }
+
+            _commands[(_head + _count) % MaxQueuedCommands] = command;
+            ++_count;
+        }
+
+        /// <summary>
+        /// Runs queued commands in order
+        /// </summary>
+        /// <param name="frameTime">Time that has passed since the last call, in seconds</param>
+        /// <param name="maxCommands">Maximum number of commands to run</param>
+        /// <param name="settings"></param>
+        /// <param name="tracer"></param>
+        /// <returns>Number of commands that were run</returns>
+        public int Run(double frameTime, int maxCommands, in MovementSettings settings, IMovementTracer tracer)
+        {
+            _timeBudget = Math.Min(_timeBudget + (frameTime * 1000.0), MaxTimeBudget);
+
+            var commandsRun = 0;
+
+            while (_count > 0 && commandsRun < maxCommands)
+            {
+                ref readonly var command = ref _commands[_head];
+
+                //Wait until enough time has passed
+                if (command.Msec > _timeBudget)
+                {
+                    break;
+                }
+
+                _timeBudget -= command.Msec;
+
+                PlayerMovement.Simulate(ref _state, command, settings, tracer);
+
+                LastRunSequence = command.Sequence;
+                ViewAngles = command.ViewAngles;
+                HasRunCommands = true;
+                NeedsAcknowledgement = true;
+
+                _head = (_head + 1) % MaxQueuedCommands;
+                --_count;
+                ++commandsRun;
+            }
+
+            return commandsRun;
+        }
+    }
+}
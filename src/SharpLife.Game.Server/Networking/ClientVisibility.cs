@@ -0,0 +1,81 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using SharpLife.Models.BSP;
+using System;
+using System.Collections.Generic;
+using System.Numerics;
+
+namespace SharpLife.Game.Server.Networking
+{
+    /// <summary>
+    /// Tracks the origins that a client is viewing the world from and the fat PVS built from them
+    /// If a client has no view origins then no objects are culled for it
+    /// </summary>
+    public sealed class ClientVisibility
+    {
+        /// <summary>
+        /// Leafs within this distance of a view origin are added to the PVS
+        /// Avoids objects popping in when the origin is close to a leaf boundary
+        /// </summary>
+        public const float FatPVSRadius = 8;
+
+        private readonly List<Vector3> _viewOrigins = new List<Vector3>();
+
+        private ulong[] _pvs = Array.Empty<ulong>();
+
+        public IReadOnlyList<Vector3> ViewOrigins => _viewOrigins;
+
+        public bool HasViewOrigins => _viewOrigins.Count > 0;
+
+        /// <summary>
+        /// Adds an origin to view the world from
+        /// Multiple origins can be added for cameras, portals and the like
+        /// </summary>
+        /// <param name="origin"></param>
+        public void AddViewOrigin(in Vector3 origin)
+        {
+            _viewOrigins.Add(origin);
+        }
+
+        public void ClearViewOrigins()
+        {
+            _viewOrigins.Clear();
+        }
+
+        /// <summary>
+        /// Builds the fat PVS for all view origins
+        /// </summary>
+        /// <param name="visibility"></param>
+        internal ulong[] BuildPVS(BSPVisibility visibility)
+        {
+            if (_pvs.Length != visibility.RowLength)
+            {
+                _pvs = new ulong[visibility.RowLength];
+            }
+            else
+            {
+                Array.Clear(_pvs, 0, _pvs.Length);
+            }
+
+            foreach (var origin in _viewOrigins)
+            {
+                visibility.AddToFatPVS(origin, FatPVSRadius, _pvs);
+            }
+
+            return _pvs;
+        }
+    }
+}
@@ -18,12 +18,20 @@ using SharpLife.Engine.Shared.API.Engine.Shared;
 using SharpLife.Engine.Shared.API.Game.Server;
 using SharpLife.Game.Server.API;
 using SharpLife.Game.Server.Entities;
+using SharpLife.Game.Server.Entities.Players;
+using SharpLife.Game.Shared.Entities;
 using SharpLife.Game.Shared.Networking;
 using SharpLife.Game.Shared.Networking.Messages.Server;
+using SharpLife.Game.Shared.Physics;
+using SharpLife.Models.BSP;
 using SharpLife.Networking.Shared;
+using SharpLife.Networking.Shared.Communication.NetworkObjectLists;
 using SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData;
 using SharpLife.Networking.Shared.Communication.NetworkObjectLists.Transmission;
+using SharpLife.Networking.Shared.Messages.Client;
+using SharpLife.Networking.Shared.Messages.Server;
 using System;
+using System.Numerics;
 
 namespace SharpLife.Game.Server.Networking
 {
@@ -33,17 +41,57 @@ namespace SharpLife.Game.Server.Networking
         private readonly GameServer _gameServer;
         private readonly ServerEntities _entities;
 
+        private readonly ClientVisibility[] _clientVisibility = new ClientVisibility[NetConstants.MaxClients];
+
+        private readonly ClientCommandQueue[] _clientCommands = new ClientCommandQueue[NetConstants.MaxClients];
+
+        /// <summary>
+        /// Player entity of each client, or null if the client hasn't spawned yet
+        /// </summary>
+        private readonly Player[] _players = new Player[NetConstants.MaxClients];
+
+        private readonly UserCommandSerializer _commandSerializer = new UserCommandSerializer();
+
+        private readonly UserCommand[] _receivedCommands = new UserCommand[UserCommandSerializer.MaxCommandsPerMessage];
+
+        /// <summary>
+        /// PVS of the client whose objects are currently being filtered
+        /// </summary>
+        private ulong[] _filterPVS;
+
+        private bool _cullObjects;
+
         public ServerNetworking(IEngineModels engineModels, GameServer gameServer, ServerEntities entities)
         {
             _engineModels = engineModels ?? throw new ArgumentNullException(nameof(engineModels));
             _gameServer = gameServer ?? throw new ArgumentNullException(nameof(gameServer));
             _entities = entities ?? throw new ArgumentNullException(nameof(entities));
+
+            for (var i = 0; i < _clientVisibility.Length; ++i)
+            {
+                _clientVisibility[i] = new ClientVisibility();
+            }
+
+            for (var i = 0; i < _clientCommands.Length; ++i)
+            {
+                _clientCommands[i] = new ClientCommandQueue();
+            }
         }
 
-        public IMessage CreateGameInfoMessage()
+        /// <summary>
+        /// Gets the visibility state used to cull network objects for a client
+        /// </summary>
+        /// <param name="clientIndex"></param>
+        public ClientVisibility GetClientVisibility(int clientIndex)
+        {
+            return _clientVisibility[clientIndex];
+        }
+
+        public IMessage CreateGameInfoMessage(int clientIndex)
         {
             return new GameServerInfo
             {
+                ClientIndex = (uint)clientIndex,
                 //In case the file format/directory ever changes, use the full file name
                 MapFileName = NetUtilities.ConvertToNetworkPath(_gameServer.MapInfo.Model.Name),
                 MapCrc = _gameServer.MapInfo.Model.CRC,
@@ -62,5 +110,208 @@ namespace SharpLife.Game.Server.Networking
         {
             _entities.CreateNetworkObjectLists(networkObjectListBuilder);
         }
+
+        public void BeginFilterNetworkObjects(int clientIndex, INetworkObjectList networkObjectList)
+        {
+            var clientVisibility = _clientVisibility[clientIndex];
+
+            var visibility = _gameServer.Visibility;
+
+            _cullObjects = visibility != null && clientVisibility.HasViewOrigins;
+
+            if (_cullObjects)
+            {
+                _filterPVS = clientVisibility.BuildPVS(visibility);
+            }
+        }
+
+        public bool FilterNetworkObject(int clientIndex, INetworkObjectList networkObjectList, INetworkObject networkObject)
+        {
+            if (!_cullObjects
+                || !(networkObject.Instance is BaseEntity entity)
+                || ReferenceEquals(entity, _entities.World)
+                || ReferenceEquals(entity, _players[clientIndex]))
+            {
+                return true;
+            }
+
+            var physicsState = entity.PhysicsState;
+
+            if (physicsState.LeafCount == 0)
+            {
+                //Not linked into the world, can't be culled
+                if (physicsState.HeadNode == -1)
+                {
+                    return true;
+                }
+
+                //Touches too many leafs to track, check if any leaf under the top node is visible
+                return _gameServer.Visibility.IsNodeVisible(_filterPVS, physicsState.HeadNode);
+            }
+
+            for (var i = 0; i < physicsState.LeafCount; ++i)
+            {
+                if (BSPVisibility.IsLeafVisible(_filterPVS, physicsState.GetLeafNumber(i)))
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        public void ResetClient(int clientIndex)
+        {
+            DestroyPlayer(clientIndex);
+
+            _clientCommands[clientIndex].Reset();
+            _clientVisibility[clientIndex].ClearViewOrigins();
+        }
+
+        public void ClientDisconnected(int clientIndex)
+        {
+            ResetClient(clientIndex);
+        }
+
+        /// <summary>
+        /// Forgets about the player entities of the current map, which are destroyed along with the other entities
+        /// </summary>
+        public void Deactivate()
+        {
+            Array.Clear(_players, 0, _players.Length);
+        }
+
+        private void DestroyPlayer(int clientIndex)
+        {
+            var player = _players[clientIndex];
+
+            if (player != null)
+            {
+                _players[clientIndex] = null;
+
+                _entities.EntityList.DestroyEntity(player);
+            }
+        }
+
+        public void ReceiveUserCommands(int clientIndex, UserCommands message)
+        {
+            if (message.Count > UserCommandSerializer.MaxCommandsPerMessage)
+            {
+                return;
+            }
+
+            var count = (int)message.Count;
+
+            try
+            {
+                _commandSerializer.DeserializeCommands(message.Commands, count, message.Sequence, _receivedCommands);
+            }
+            catch (Exception e) when (e is InvalidOperationException || e is InvalidProtocolBufferException)
+            {
+                //Malformed message, ignore it
+                return;
+            }
+
+            var queue = _clientCommands[clientIndex];
+
+            for (var i = 0; i < count; ++i)
+            {
+                queue.Add(_receivedCommands[i]);
+            }
+        }
+
+        /// <summary>
+        /// Runs the commands that clients have sent since the last frame
+        /// Clients are given a player entity when their first commands arrive
+        /// Relays never send commands, so they stay bodiless spectators
+        /// </summary>
+        /// <param name="frameTime">Time since the last frame, in seconds</param>
+        /// <param name="maxCommandsPerClient">Maximum number of commands to run for each client</param>
+        /// <param name="tracer"></param>
+        public void RunUserCommands(double frameTime, int maxCommandsPerClient, IMovementTracer tracer)
+        {
+            for (var i = 0; i < _clientCommands.Length; ++i)
+            {
+                var queue = _clientCommands[i];
+
+                var player = _players[i];
+
+                if (player == null)
+                {
+                    if (queue.Count == 0)
+                    {
+                        continue;
+                    }
+
+                    player = _players[i] = _entities.CreatePlayer(i);
+
+                    queue.SetState(new PlayerMovementState
+                    {
+                        Origin = player.Origin
+                    });
+                }
+
+                if (queue.Run(frameTime, maxCommandsPerClient, MovementSettings.Default, tracer) > 0)
+                {
+                    UpdatePlayer(player, queue);
+                }
+
+                UpdateViewOrigins(_clientVisibility[i], player);
+            }
+        }
+
+        /// <summary>
+        /// Moves the player entity to the state that the client's commands have produced
+        /// </summary>
+        private static void UpdatePlayer(Player player, ClientCommandQueue queue)
+        {
+            ref readonly var state = ref queue.State;
+
+            player.Origin = state.Origin;
+            player.Velocity = state.Velocity;
+
+            if (state.OnGround)
+            {
+                player.Flags |= EntityFlags.OnGround;
+            }
+            else
+            {
+                player.Flags &= ~EntityFlags.OnGround;
+            }
+
+            player.ViewAngle = queue.ViewAngles;
+
+            //The body only turns around the vertical axis
+            player.Angles = new Vector3(0, queue.ViewAngles.Y, 0);
+        }
+
+        /// <summary>
+        /// Views the world from the eyes of the client's player entity
+        /// Clients without a player entity have no view origins, so nothing is culled for them
+        /// </summary>
+        private static void UpdateViewOrigins(ClientVisibility visibility, Player player)
+        {
+            visibility.ClearViewOrigins();
+
+            visibility.AddViewOrigin(player.Origin + player.ViewOffset);
+        }
+
+        public UserCommandAck CreateUserCommandAck(int clientIndex)
+        {
+            var queue = _clientCommands[clientIndex];
+
+            if (!queue.NeedsAcknowledgement)
+            {
+                return null;
+            }
+
+            queue.NeedsAcknowledgement = false;
+
+            return new UserCommandAck
+            {
+                Sequence = queue.LastRunSequence,
+                PlayerState = _commandSerializer.SerializeState(queue.State)
+            };
+        }
     }
 }
@@ -264,6 +264,21 @@ namespace SharpLife.Game.Server.Physics
         }
 
         private int FlyMove(BaseEntity ent, float time, ref Trace? steptrace)
+        {
+            //Touch functions can cause other entities to move, so each nested move needs its own query
+            var query = _sweptMoveQueries.Count > 0 ? _sweptMoveQueries.Pop() : new SweptMoveQuery();
+
+            try
+            {
+                return FlyMove(ent, time, ref steptrace, query);
+            }
+            finally
+            {
+                _sweptMoveQueries.Push(query);
+            }
+        }
+
+        private int FlyMove(BaseEntity ent, float time, ref Trace? steptrace, SweptMoveQuery query)
         {
             var monsterClip = (ent.Flags & EntityFlags.MonsterClip) != 0;
 
@@ -278,6 +293,15 @@ namespace SharpLife.Game.Server.Physics
 
             var planes = new Vector3[MaxPlanes];
 
+            if (ent.Velocity != Vector3.Zero)
+            {
+                //Moves can't go further than the current speed allows, so gather the entities in that area once for all iterations
+                //If the velocity increases the query gathers them again as needed
+                var reach = new Vector3((ent.Velocity.Length() * time) + 1.0f);
+
+                _physics.BeginSweptMove(query, ent.Origin + ent.Mins - reach, ent.Origin + ent.Maxs + reach, TraceType.None, ent, false, monsterClip);
+            }
+
             for (int iteration = 0; iteration < 4; ++iteration)
             {
                 if (ent.Velocity == Vector3.Zero)
@@ -287,7 +311,7 @@ namespace SharpLife.Game.Server.Physics
 
                 var end = ent.Origin + (ent.Velocity * moveTime);
 
-                var trace = _physics.Move(ref ent.RefOrigin, ent.Mins, ent.Maxs, end, TraceType.None, ent, false, monsterClip);
+                var trace = _physics.Move(query, ref ent.RefOrigin, ent.Mins, ent.Maxs, end);
 
                 if (trace.AllSolid)
                 {
@@ -297,13 +321,19 @@ namespace SharpLife.Game.Server.Physics
 
                 if (trace.Fraction > 0)
                 {
-                    var test = _physics.Move(ref trace.EndPosition, ent.Mins, ent.Maxs, trace.EndPosition, TraceType.None, ent, false, monsterClip);
+                    var test = _physics.Move(query, ref trace.EndPosition, ent.Mins, ent.Maxs, trace.EndPosition);
 
                     if (!test.AllSolid)
                     {
                         planeCount = 0;
 
+                        var linkGeneration = _physics.LinkGeneration;
+
                         ent.Origin = trace.EndPosition;
+
+                        //Relinking the moving entity doesn't change what it can collide with
+                        _physics.RevalidateSweptMove(query, linkGeneration);
+
                         original_velocity = ent.Velocity;
                     }
                 }
@@ -359,11 +389,11 @@ namespace SharpLife.Game.Server.Physics
                     if (planes[0].Z <= 0.7)
                     {
                         var maxs = ((1.0f - ent.Friction) * _sv_bounce.Float) + 1.0f;
-                        ClipVelocity(ref original_velocity, ref planes[0], out new_velocity, maxs);
+                        MovementUtils.ClipVelocity(ref original_velocity, ref planes[0], out new_velocity, maxs);
                     }
                     else
                     {
-                        ClipVelocity(ref original_velocity, ref planes[0], out new_velocity, 1.0f);
+                        MovementUtils.ClipVelocity(ref original_velocity, ref planes[0], out new_velocity, 1.0f);
                     }
 
                     ent.Velocity = new_velocity;
@@ -375,7 +405,7 @@ namespace SharpLife.Game.Server.Physics
 
                     for (index = 0; index < planeCount; ++index)
                     {
-                        ClipVelocity(ref original_velocity, ref planes[index], out new_velocity, 1.0f);
+                        MovementUtils.ClipVelocity(ref original_velocity, ref planes[index], out new_velocity, 1.0f);
 
                         int index2;
 
@@ -616,7 +646,7 @@ namespace SharpLife.Game.Server.Physics
                         vecc = 1.0f;
                     }
 
-                    ClipVelocity(ref ent.RefVelocity, ref trace.Plane.Normal, out ent.RefVelocity, vecc);
+                    MovementUtils.ClipVelocity(ref ent.RefVelocity, ref trace.Plane.Normal, out ent.RefVelocity, vecc);
 
                     if (trace.Plane.Normal.Z > 0.7)
                     {
@@ -653,100 +683,210 @@ namespace SharpLife.Game.Server.Physics
             }
         }
 
+        /// <summary>
+        /// Returns whether a sleeping entity has been disturbed and needs to be simulated again
+        /// </summary>
+        /// <param name="ent"></param>
+        /// <returns></returns>
+        private bool ShouldWake(BaseEntity ent)
+        {
+            if (!_sv_sleep.Boolean)
+            {
+                return true;
+            }
+
+            //Moved or pushed through the entity API
+            if (ent.RefOrigin != ent.PhysicsState.SleepOrigin
+                || ent.RefVelocity != Vector3.Zero
+                || ent.RefBaseVelocity != Vector3.Zero)
+            {
+                return true;
+            }
+
+            if ((ent.Flags & EntityFlags.OnGround) == 0
+                || (ent.MoveType != MoveType.Toss && ent.MoveType != MoveType.Bounce))
+            {
+                return true;
+            }
+
+            var groundEntity = _entityList.GetEntity(ent.GroundEntity);
+
+            //Ground was removed or can move the entity
+            if (groundEntity == null
+                || (groundEntity.Flags & EntityFlags.Conveyor) != 0
+                || groundEntity.RefVelocity != Vector3.Zero
+                || groundEntity.AngularVelocity != Vector3.Zero)
+            {
+                return true;
+            }
+
+            return false;
+        }
+
+        /// <summary>
+        /// Puts an entity to sleep if it has been at rest on the ground for long enough
+        /// </summary>
+        /// <param name="ent"></param>
+        private void CheckSleep(BaseEntity ent)
+        {
+            if ((ent.MoveType != MoveType.Toss && ent.MoveType != MoveType.Bounce)
+                || (ent.Flags & EntityFlags.OnGround) == 0
+                || ent.WaterLevel != WaterLevel.Dry)
+            {
+                ent.PhysicsState.IdleFrames = 0;
+                return;
+            }
+
+            var sleepSpeed = _sv_sleepspeed.Float;
+
+            if (ent.RefVelocity.LengthSquared() >= sleepSpeed * sleepSpeed
+                || ent.RefBaseVelocity.LengthSquared() >= sleepSpeed * sleepSpeed)
+            {
+                ent.PhysicsState.IdleFrames = 0;
+                return;
+            }
+
+            if (++ent.PhysicsState.IdleFrames >= _sv_sleepframes.Integer)
+            {
+                ent.RefVelocity = Vector3.Zero;
+                ent.RefBaseVelocity = Vector3.Zero;
+                ent.PhysicsState.Sleep(ent.RefOrigin);
+            }
+        }
+
         public void RunPhysics(double frameTime)
         {
             _frameTime = frameTime;
 
-            //Iterate by handle to avoid iterator invalidating when entities are removed
-            for (var handle = _entityList.GetFirstEntity(); handle.Valid; handle = _entityList.GetNextEntity(handle))
-            {
-                var pEntity = _entityList.GetEntity(handle);
+            var awakeCount = 0;
+            var sleepingCount = 0;
 
-                if (ForceRetouch != 0)
+            //Touches from entities linked during movement are dispatched together afterwards
+            _physics.BatchingTouches = true;
+
+            try
+            {
+                //Iterate by handle to avoid iterator invalidating when entities are removed
+                for (var handle = _entityList.GetFirstEntity(); handle.Valid; handle = _entityList.GetNextEntity(handle))
                 {
-                    _physics.LinkEdict(pEntity, true);
-                }
+                    var pEntity = _entityList.GetEntity(handle);
 
-                var index = handle.Id;
+                    if (ForceRetouch != 0)
+                    {
+                        _physics.LinkEdict(pEntity, true);
+                    }
 
-                //Don't run for players
-                //TODO: update entity list to properly assign indices to match
-                if (index != 0 && index <= _serverClients.MaxClients)
-                {
-                    continue;
-                }
+                    var index = handle.Id;
 
-                if ((pEntity.Flags & EntityFlags.OnGround) != 0)
-                {
-                    var pGroundEnt = _entityList.GetEntity(pEntity.GroundEntity);
+                    //Don't run for players
+                    //TODO: update entity list to properly assign indices to match
+                    if (index != 0 && index <= _serverClients.MaxClients)
+                    {
+                        continue;
+                    }
 
-                    if (pGroundEnt != null
-                        && (pGroundEnt.Flags & EntityFlags.Conveyor) != 0)
+                    if (pEntity.PhysicsState.Sleeping)
                     {
-                        if ((pEntity.Flags & EntityFlags.BaseVelocity) != 0)
+                        if (!ShouldWake(pEntity))
                         {
-                            pEntity.RefBaseVelocity += pGroundEnt.Speed * pGroundEnt.RefMoveDirection;
+                            //Sleeping entities still think so they can remove themselves or start moving again
+                            RunThink(pEntity);
+
+                            ++sleepingCount;
+                            continue;
                         }
-                        else
+
+                        pEntity.PhysicsState.Wake();
+                    }
+
+                    ++awakeCount;
+
+                    if ((pEntity.Flags & EntityFlags.OnGround) != 0)
+                    {
+                        var pGroundEnt = _entityList.GetEntity(pEntity.GroundEntity);
+
+                        if (pGroundEnt != null
+                            && (pGroundEnt.Flags & EntityFlags.Conveyor) != 0)
                         {
-                            pEntity.RefBaseVelocity = pGroundEnt.Speed * pGroundEnt.RefMoveDirection;
+                            if ((pEntity.Flags & EntityFlags.BaseVelocity) != 0)
+                            {
+                                pEntity.RefBaseVelocity += pGroundEnt.Speed * pGroundEnt.RefMoveDirection;
+                            }
+                            else
+                            {
+                                pEntity.RefBaseVelocity = pGroundEnt.Speed * pGroundEnt.RefMoveDirection;
+                            }
+
+                            pEntity.Flags |= EntityFlags.BaseVelocity;
                         }
+                    }
+
+                    if ((pEntity.Flags & EntityFlags.BaseVelocity) == 0)
+                    {
+                        var scale = (0.5f * (float)_frameTime) + 1.0f;
+
+                        pEntity.RefVelocity += scale * pEntity.RefBaseVelocity;
 
-                        pEntity.Flags |= EntityFlags.BaseVelocity;
+                        pEntity.RefBaseVelocity = Vector3.Zero;
                     }
-                }
 
-                if ((pEntity.Flags & EntityFlags.BaseVelocity) == 0)
-                {
-                    var scale = (0.5f * (float)_frameTime) + 1.0f;
+                    pEntity.Flags &= ~EntityFlags.BaseVelocity;
 
-                    pEntity.RefVelocity += scale * pEntity.RefBaseVelocity;
+                    switch (pEntity.MoveType)
+                    {
+                        case MoveType.None:
+                            Physics_None(pEntity);
+                            break;
 
-                    pEntity.RefBaseVelocity = Vector3.Zero;
-                }
+                        case MoveType.Follow:
+                            Physics_Follow(pEntity);
+                            break;
 
-                pEntity.Flags &= ~EntityFlags.BaseVelocity;
+                        case MoveType.Noclip:
+                            Physics_Noclip(pEntity);
+                            break;
 
-                switch (pEntity.MoveType)
-                {
-                    case MoveType.None:
-                        Physics_None(pEntity);
-                        break;
-
-                    case MoveType.Follow:
-                        Physics_Follow(pEntity);
-                        break;
-
-                    case MoveType.Noclip:
-                        Physics_Noclip(pEntity);
-                        break;
-
-                    case MoveType.Push:
-                        Physics_Pusher(pEntity);
-                        break;
-
-                    case MoveType.Step:
-                    case MoveType.PushStep:
-                        Physics_Step(pEntity);
-                        break;
-
-                    case MoveType.Bounce:
-                    case MoveType.Toss:
-                    case MoveType.BounceMissile:
-                    case MoveType.Fly:
-                    case MoveType.FlyMissile:
-                        Physics_Toss(pEntity);
-                        break;
-
-                    default:
-                        throw new InvalidOperationException($"SV_Physics: {pEntity.ClassName} bad movetype {pEntity.MoveType}");
-                }
+                        case MoveType.Push:
+                            Physics_Pusher(pEntity);
+                            break;
 
-                if (pEntity.PendingDestruction)
-                {
-                    _entityList.DestroyEntity(pEntity);
+                        case MoveType.Step:
+                        case MoveType.PushStep:
+                            Physics_Step(pEntity);
+                            break;
+
+                        case MoveType.Bounce:
+                        case MoveType.Toss:
+                        case MoveType.BounceMissile:
+                        case MoveType.Fly:
+                        case MoveType.FlyMissile:
+                            Physics_Toss(pEntity);
+                            break;
+
+                        default:
+                            throw new InvalidOperationException($"SV_Physics: {pEntity.ClassName} bad movetype {pEntity.MoveType}");
+                    }
+
+                    if (pEntity.PendingDestruction)
+                    {
+                        _entityList.DestroyEntity(pEntity);
+                    }
+                    else if (_sv_sleep.Boolean)
+                    {
+                        CheckSleep(pEntity);
+                    }
                 }
             }
+            finally
+            {
+                _physics.BatchingTouches = false;
+            }
+
+            AwakeEntityCount = awakeCount;
+            SleepingEntityCount = sleepingCount;
+
+            //Dispatch trigger touches collected during movement, if deferred
+            _physics.DispatchTouches();
 
             if (ForceRetouch != 0)
             {
@@ -27,6 +27,7 @@ using SharpLife.Models.BSP.FileFormat;
 using SharpLife.Utility;
 using SharpLife.Utility.Mathematics;
 using System;
+using System.Collections.Generic;
 using System.Linq;
 using System.Numerics;
 
@@ -69,6 +70,12 @@ namespace SharpLife.Game.Server.Physics
 
         private readonly IVariable _sv_friction;
 
+        private readonly IVariable _sv_sleep;
+
+        private readonly IVariable _sv_sleepspeed;
+
+        private readonly IVariable _sv_sleepframes;
+
         //Tracked separately from engine frametime to allow independent updating of physics
         private double _frameTime;
 
@@ -78,8 +85,23 @@ namespace SharpLife.Game.Server.Physics
 
         public int ForceRetouch { get; set; }
 
+        /// <summary>
+        /// Number of non-player entities that were simulated in the last frame
+        /// </summary>
+        public int AwakeEntityCount { get; private set; }
+
+        /// <summary>
+        /// Number of non-player entities that were skipped in the last frame because they were sleeping
+        /// </summary>
+        public int SleepingEntityCount { get; private set; }
+
         private MoveCache[] _moveCache = new MoveCache[0];
 
+        /// <summary>
+        /// Reusable queries for <see cref="FlyMove(BaseEntity, float, ref Trace?)"/>
+        /// </summary>
+        private readonly Stack<SweptMoveQuery> _sweptMoveQueries = new Stack<SweptMoveQuery>();
+
         public GameMovement(ILogger logger, ITime engineTime, SnapshotTime gameTime,
             IServerClients serverClients,
             ServerEntities entities, ServerEntityList entityList,
@@ -142,6 +164,29 @@ namespace SharpLife.Game.Server.Physics
                 .WithValue(4)
                 .WithNumberFilter()
                 .WithNumberSignFilter(true));
+
+            //TODO: mark as server cvar
+            _sv_sleep = commandContext.RegisterVariable(
+                new VariableInfo("sv_sleep")
+                .WithHelpInfo("If non-zero, tossed entities that come to rest on the ground stop being simulated until they are disturbed")
+                .WithValue(false)
+                .WithBooleanFilter());
+
+            //TODO: mark as server cvar
+            _sv_sleepspeed = commandContext.RegisterVariable(
+                new VariableInfo("sv_sleepspeed")
+                .WithHelpInfo("Speed below which an entity is considered to be at rest")
+                .WithValue(1)
+                .WithNumberFilter()
+                .WithNumberSignFilter(true));
+
+            //TODO: mark as server cvar
+            _sv_sleepframes = commandContext.RegisterVariable(
+                new VariableInfo("sv_sleepframes")
+                .WithHelpInfo("Number of consecutive frames an entity must be at rest before it goes to sleep")
+                .WithValue(10)
+                .WithNumberFilter()
+                .WithNumberSignFilter(true));
         }
 
         private void SetGlobalTrace(in Trace trace)
@@ -203,39 +248,6 @@ namespace SharpLife.Game.Server.Physics
             ent.Origin = origin;
         }
 
-        private byte ClipVelocity(ref Vector3 input, ref Vector3 normal, out Vector3 output, float overbounce)
-        {
-            output = new Vector3();
-
-            byte result = 0;
-
-            if (normal.Z > 0.0)
-            {
-                result |= 1;
-            }
-
-            if (normal.Z == 0.0)
-            {
-                result |= 2;
-            }
-
-            var dot = Vector3.Dot(input, normal) * overbounce;
-
-            for (int i = 0; i < 3; ++i)
-            {
-                var value = input.Index(i) - (normal.Index(i) * dot);
-
-                output.Index(i, value);
-
-                if (value > -0.1 && value < 0.1)
-                {
-                    output.Index(i, 0);
-                }
-            }
-
-            return result;
-        }
-
         private BaseEntity TestEntityPosition(BaseEntity ent)
         {
             var trace = _physics.Move(ref ent.RefOrigin, ent.Mins, ent.Maxs, ent.RefOrigin, 0, ent, false, false);
@@ -317,6 +329,10 @@ namespace SharpLife.Game.Server.Physics
                     return;
                 }
 
+                //Touching can change either entity's movement
+                e1.PhysicsState.Wake();
+                e2.PhysicsState.Wake();
+
                 if (e1.Solid != Solid.Not)
                 {
                     SetGlobalTrace(ptrace);
@@ -364,17 +380,7 @@ namespace SharpLife.Game.Server.Physics
                 {
                     point.Z = (ent.AbsMax.Z + ent.AbsMin.Z) * 0.5f;
 
-                    if (_physics.PointContents(ref point) <= Contents.Water)
-                    {
-                        ent.WaterLevel = WaterLevel.Waist;
-
-                        point += ent.ViewOffset;
-
-                        if (_physics.PointContents(ref point) <= Contents.Water)
-                        {
-                            ent.WaterLevel = WaterLevel.Head;
-                        }
-                    }
+                    SetWaterLevelAboveFeet(ent, point);
                 }
 
                 if (contents <= Contents.Current0)
@@ -386,6 +392,33 @@ namespace SharpLife.Game.Server.Physics
             return ent.WaterLevel > WaterLevel.Feet;
         }
 
+        /// <summary>
+        /// Raises the water level of an entity whose feet are in water based on the contents at its waist and head
+        /// </summary>
+        /// <param name="ent"></param>
+        /// <param name="waist"></param>
+        private void SetWaterLevelAboveFeet(BaseEntity ent, in Vector3 waist)
+        {
+            //Query both points at once, the head only counts if the waist is in water too
+            Span<Vector3> points = stackalloc Vector3[2];
+            Span<Contents> contents = stackalloc Contents[2];
+
+            points[0] = waist;
+            points[1] = waist + ent.ViewOffset;
+
+            _physics.PointContents(points, contents);
+
+            if (contents[0] <= Contents.Water)
+            {
+                ent.WaterLevel = WaterLevel.Waist;
+
+                if (contents[1] <= Contents.Water)
+                {
+                    ent.WaterLevel = WaterLevel.Head;
+                }
+            }
+        }
+
         private void CheckWaterTransition(BaseEntity ent)
         {
             _physics.GroupMask = ent.PhysicsState.GroupInfo;
@@ -433,17 +466,7 @@ namespace SharpLife.Game.Server.Physics
                     {
                         point.Z = (ent._absMax.Z + ent._absMin.Z) * 0.5f;
 
-                        if (_physics.PointContents(ref point) <= Contents.Water)
-                        {
-                            ent.WaterLevel = WaterLevel.Waist;
-
-                            point += ent.ViewOffset;
-
-                            if (_physics.PointContents(ref point) <= Contents.Water)
-                            {
-                                ent.WaterLevel = WaterLevel.Head;
-                            }
-                        }
+                        SetWaterLevelAboveFeet(ent, point);
                     }
                 }
             }
@@ -25,11 +25,13 @@ using SharpLife.Game.Shared.Models;
 using SharpLife.Game.Shared.Models.BSP;
 using SharpLife.Game.Shared.Models.MDL;
 using SharpLife.Game.Shared.Physics;
+using SharpLife.Models.BSP;
 using SharpLife.Models.BSP.FileFormat;
 using SharpLife.Models.MDL.FileFormat;
 using SharpLife.Utility;
 using SharpLife.Utility.Mathematics;
 using System;
+using System.Collections.Generic;
 using System.Numerics;
 
 namespace SharpLife.Game.Server.Physics
@@ -51,6 +53,8 @@ namespace SharpLife.Game.Server.Physics
 
         private readonly BSPModel _worldModel;
 
+        private readonly BSPVisibility _visibility;
+
         /// <summary>
         /// Binary tree that divides the world into sections for fast lookups
         /// </summary>
@@ -62,15 +66,40 @@ namespace SharpLife.Game.Server.Physics
 
         private readonly StudioCache _studioCache = new StudioCache();
 
+        /// <summary>
+        /// Speeds up point contents lookups in the world
+        /// The world model doesn't change for the lifetime of this object so the cache never needs to be invalidated
+        /// </summary>
+        private readonly HullContentsCache _worldContentsCache;
+
         //TODO: create
         private readonly IVariable _sv_clienttrace;
 
+        private readonly IVariable _sv_defertouches;
+
+        private readonly TouchContactSet _touchContacts = new TouchContactSet();
+
+        private bool _dispatchingTouches;
+
+        /// <summary>
+        /// Whether touches are being collected for a later call to <see cref="DispatchTouches"/>
+        /// If not, entities linked outside of a dispatch have their touches dispatched right away
+        /// </summary>
+        public bool BatchingTouches { get; set; }
+
         private GroupOperation _groupOp;
 
         public uint GroupMask { get; set; }
 
         private bool _touchLinkSemaphore;
 
+        private int _linkGeneration;
+
+        /// <summary>
+        /// Incremented whenever an entity is linked or unlinked
+        /// </summary>
+        public int LinkGeneration => _linkGeneration;
+
         //TODO: get rid of the global flags state and pass it into trace functions
         public TraceFlags TraceFlags { get; set; }
 
@@ -101,7 +130,7 @@ namespace SharpLife.Game.Server.Physics
         public GamePhysics(ILogger logger,
             ITime engineTime, SnapshotTime gameTime,
             ServerEntities entities, ServerEntityList entityList,
-            BSPModel worldModel,
+            BSPModel worldModel, BSPVisibility visibility,
             ICommandContext commandContext)
         {
             _logger = logger ?? throw new ArgumentNullException(nameof(logger));
@@ -110,6 +139,8 @@ namespace SharpLife.Game.Server.Physics
             _entities = entities ?? throw new ArgumentNullException(nameof(entities));
             _entityList = entityList ?? throw new ArgumentNullException(nameof(entityList));
             _worldModel = worldModel ?? throw new ArgumentNullException(nameof(worldModel));
+            _visibility = visibility ?? throw new ArgumentNullException(nameof(visibility));
+            _worldContentsCache = new HullContentsCache(_worldModel.Hulls[0]);
 
             //TODO: need to reset this on map spawn for singleplayer
             //TODO: mark as server cvar
@@ -119,6 +150,13 @@ namespace SharpLife.Game.Server.Physics
                 .WithValue(1)
                 .WithNumberFilter());
 
+            //TODO: mark as server cvar
+            _sv_defertouches = commandContext.RegisterVariable(
+                new VariableInfo("sv_defertouches")
+                .WithHelpInfo("If non-zero, trigger touches are collected during movement and dispatched once per frame after movement has finished")
+                .WithValue(false)
+                .WithBooleanFilter());
+
             InitBoxHull();
 
             box_hull = new Hull[1]
@@ -205,8 +243,7 @@ namespace SharpLife.Game.Server.Physics
 
             if (node.Contents < Contents.Node)
             {
-                //TODO: use a more efficient way to get the index
-                ent.PhysicsState.AddLeafNumber((short)_worldModel.BSPFile.Leaves.IndexOf((Leaf)node));
+                ent.PhysicsState.AddLeafNumber((short)_visibility.GetLeafNumber((Leaf)node));
                 return;
             }
 
@@ -216,8 +253,7 @@ namespace SharpLife.Game.Server.Physics
 
             if (result == BoxOnPlaneSideResult.CrossesPlane && topnode == -1)
             {
-                //TODO: use a more efficient way to get the index
-                topnode = _worldModel.BSPFile.Nodes.IndexOf(currentNode);
+                topnode = _visibility.GetNodeNumber(currentNode);
             }
 
             if ((result & BoxOnPlaneSideResult.InFront) != 0)
@@ -278,32 +314,7 @@ namespace SharpLife.Game.Server.Physics
 
         public Contents HullPointContents(Hull hull, int num, ref Vector3 p)
         {
-            int i;
-
-            for (i = num; i >= 0;)
-            {
-                if (hull.FirstClipNode > i || hull.LastClipNode < i)
-                {
-                    throw new InvalidOperationException("HullPointContents: bad node number");
-                }
-
-                var pNode = hull.ClipNodes[i];
-
-                var pPlane = hull.Planes.Span[pNode.PlaneIndex];
-
-                var dot = (pPlane.Type > PlaneType.Z ? Vector3.Dot(pPlane.Normal, p) : p.Index((int)pPlane.Type)) - pPlane.Distance;
-
-                if (dot >= 0.0)
-                {
-                    i = pNode.Children[0];
-                }
-                else
-                {
-                    i = pNode.Children[1];
-                }
-            }
-
-            return (Contents)i;
+            return HullTracer.HullPointContents(hull, num, ref p);
         }
 
         private Contents LinkContents(AreaNode node, ref Vector3 pos)
@@ -368,8 +379,31 @@ namespace SharpLife.Game.Server.Physics
 
         public Contents PointContents(ref Vector3 p)
         {
-            var contents = HullPointContents(_worldModel.Hulls[0], 0, ref p);
+            var contents = _worldContentsCache.PointContents(ref p);
+
+            return CombineLinkContents(contents, ref p);
+        }
+
+        /// <summary>
+        /// Gets the contents at each of the given points
+        /// <see cref="PointContents(ref Vector3)"/>
+        /// </summary>
+        /// <param name="points"></param>
+        /// <param name="results">Receives the contents for each point. Must be at least as large as <paramref name="points"/></param>
+        public void PointContents(ReadOnlySpan<Vector3> points, Span<Contents> results)
+        {
+            _worldContentsCache.PointContents(points, results);
+
+            for (var i = 0; i < points.Length; ++i)
+            {
+                var point = points[i];
 
+                results[i] = CombineLinkContents(results[i], ref point);
+            }
+        }
+
+        private Contents CombineLinkContents(Contents contents, ref Vector3 p)
+        {
             if (contents == Contents.Solid)
             {
                 return Contents.Solid;
@@ -435,6 +469,12 @@ namespace SharpLife.Game.Server.Physics
                     }
                 }
 
+                if (_sv_defertouches.Boolean)
+                {
+                    _touchContacts.Add(ent, touched);
+                    continue;
+                }
+
                 _gameTime.ElapsedTime = _engineTime.ElapsedTime;
                 touched.Touch(ent);
             }
@@ -455,6 +495,8 @@ namespace SharpLife.Game.Server.Physics
 
         public void UnlinkEdict(BaseEntity ent)
         {
+            ++_linkGeneration;
+
             if (ent.PhysicsState.Area != null)
             {
                 //TODO: optimize
@@ -526,6 +568,9 @@ namespace SharpLife.Game.Server.Physics
                     }
                 }
 
+                //Inserting changes the entities that queries can find, not just the removal done by unlinking
+                ++_linkGeneration;
+
                 if (ent.Solid == Solid.Trigger)
                 {
                     i.Triggers.Add(ent);
@@ -535,13 +580,83 @@ namespace SharpLife.Game.Server.Physics
                     i.Solids.Add(ent);
                 }
 
-                if (touchTriggers && !_touchLinkSemaphore)
+                if (touchTriggers)
+                {
+                    if (_sv_defertouches.Boolean)
+                    {
+                        //Contacts are only recorded here so there is no re-entry to guard against
+                        _touchContacts.MarkLinked(ent);
+                        TouchLinks(ent, HeadAreaNode);
+
+                        //Entities linked by game code outside of physics would otherwise touch a frame late
+                        //Links made by touch functions during a dispatch are handled by the next dispatch
+                        if (!BatchingTouches && !_dispatchingTouches)
+                        {
+                            DispatchTouches();
+                        }
+                    }
+                    else if (!_touchLinkSemaphore)
+                    {
+                        _touchLinkSemaphore = true;
+                        TouchLinks(ent, HeadAreaNode);
+                        _touchLinkSemaphore = false;
+                    }
+                }
+            }
+        }
+
+        /// <summary>
+        /// Dispatches all trigger contacts collected since the last dispatch
+        /// Each entity touches a given trigger at most once per dispatch, regardless of how often it was relinked
+        /// Does nothing if touches are not deferred
+        /// </summary>
+        public void DispatchTouches()
+        {
+            if (_dispatchingTouches)
+            {
+                throw new InvalidOperationException("Cannot dispatch touches while touches are being dispatched");
+            }
+
+            if (!_sv_defertouches.Boolean)
+            {
+                //Drop any contacts left over from when deferring was enabled
+                if (_touchContacts.Count > 0)
+                {
+                    _touchContacts.Clear();
+                }
+
+                return;
+            }
+
+            _dispatchingTouches = true;
+
+            try
+            {
+                var contacts = _touchContacts.CollectPendingDispatch();
+
+                _gameTime.ElapsedTime = _engineTime.ElapsedTime;
+
+                foreach (var contact in contacts)
                 {
-                    _touchLinkSemaphore = true;
-                    TouchLinks(ent, HeadAreaNode);
-                    _touchLinkSemaphore = false;
+                    if (contact.Trigger.PendingDestruction || contact.Entity.PendingDestruction)
+                    {
+                        continue;
+                    }
+
+                    if (contact.State == TouchState.End)
+                    {
+                        contact.Trigger.EndTouch(contact.Entity);
+                    }
+                    else
+                    {
+                        contact.Trigger.Touch(contact.Entity);
+                    }
                 }
             }
+            finally
+            {
+                _dispatchingTouches = false;
+            }
         }
 
         //TODO: part of the renderer as well
@@ -681,140 +796,18 @@ namespace SharpLife.Game.Server.Physics
             return HullForEntity(pEdict, mins, maxs, out offset);
         }
 
-        private bool RecursiveHullCheck(Hull hull, int num, float p1f, float p2f, ref Vector3 p1, ref Vector3 p2, ref Trace trace)
+        private static void HullCheck(Hull hull, in Vector3 start, in Vector3 end, ref Trace trace)
         {
-            if (num >= 0)
-            {
-                //TODO: figure out if planes check is possible
-                if (num < hull.FirstClipNode || num > hull.LastClipNode /*|| hull.Planes == null*/)
-                {
-                    throw new InvalidOperationException("RecursiveHullCheck: bad node number");
-                }
-
-                float front, back;
-
-                var pNode = hull.ClipNodes[num];
-                var pPlane = hull.Planes.Span[pNode.PlaneIndex];
-
-                if (pPlane.Type <= PlaneType.Z)
-                {
-                    front = p1.Index((int)pPlane.Type) - pPlane.Distance;
-                    back = p2.Index((int)pPlane.Type) - pPlane.Distance;
-                }
-                else
-                {
-                    front = Vector3.Dot(pPlane.Normal, p1) - pPlane.Distance;
-                    back = Vector3.Dot(pPlane.Normal, p2) - pPlane.Distance;
-                }
-
-                if (front >= 0.0 && back >= 0.0)
-                {
-                    return RecursiveHullCheck(hull, pNode.Children[0], p1f, p2f, ref p1, ref p2, ref trace);
-                }
-
-                if (front < 0.0 && back < 0.0)
-                {
-                    return RecursiveHullCheck(hull, pNode.Children[1], p1f, p2f, ref p1, ref p2, ref trace);
-                }
-
-                float frac;
-
-                if (front < 0.0)
-                {
-                    frac = (float)((front + 0.03125) / (front - back));
-                }
-                else
-                {
-                    frac = (float)((front - 0.03125) / (front - back));
-                }
-
-                frac = Math.Clamp(frac, 0, 1);
-
-                if (float.IsNaN(frac))
-                {
-                    return false;
-                }
-
-                var distanceFraction = p2f - p1f;
-                var mid = p1 + ((p2 - p1) * frac);
-                var midFraction = (distanceFraction * frac) + p1f;
-                var side = front > 0.0 ? 1 : 0;
-
-                if (!RecursiveHullCheck(hull, pNode.Children[side], p1f, midFraction, ref p1, ref mid, ref trace))
-                {
-                    return false;
-                }
-
-                if (HullPointContents(hull, pNode.Children[side ^ 1], ref mid) != Contents.Solid)
-                {
-                    return RecursiveHullCheck(hull, pNode.Children[side ^ 1], midFraction, p2f, ref mid, ref p2, ref trace);
-                }
-
-                if (trace.AllSolid)
-                {
-                    return false;
-                }
-
-                if (side != 0)
-                {
-                    trace.Plane.Normal = -pPlane.Normal;
-                    trace.Plane.Distance = -pPlane.Distance;
-                }
-                else
-                {
-                    trace.Plane.Normal = pPlane.Normal;
-                    trace.Plane.Distance = pPlane.Distance;
-                }
-
-                while (true)
-                {
-                    trace.Fraction = midFraction;
-                    if (HullPointContents(hull, hull.FirstClipNode, ref mid) != Contents.Solid)
-                    {
-                        trace.EndPosition = mid;
-                        return false;
-                    }
-
-                    frac -= 0.1f;
-
-                    if (frac < 0.0)
-                    {
-                        break;
-                    }
-
-                    midFraction = (distanceFraction * frac) + p1f;
-                    mid = p1 + ((p2 - p1) * frac);
-                }
-                trace.EndPosition = mid;
-                _logger.Debug("backup past 0");
-
-                return false;
-            }
-
-            var contents = (Contents)num;
-
-            if (contents == Contents.Solid)
-            {
-                trace.StartSolid = true;
-                return true;
-            }
-
-            trace.AllSolid = false;
-
-            if (contents == Contents.Empty)
-            {
-                trace.InOpen = true;
-                return true;
-            }
-
-            if (contents == Contents.Translucent)
-            {
-                return true;
-            }
-
-            trace.InWater = true;
-
-            return true;
+            HullTracer.TraceLine(hull, start, end, out var hullTrace);
+
+            trace.AllSolid = hullTrace.AllSolid;
+            trace.StartSolid = hullTrace.StartSolid;
+            trace.InOpen = hullTrace.InOpen;
+            trace.InWater = hullTrace.InWater;
+            trace.Fraction = hullTrace.Fraction;
+            trace.EndPosition = hullTrace.EndPosition;
+            trace.Plane.Normal = hullTrace.PlaneNormal;
+            trace.Plane.Distance = hullTrace.PlaneDistance;
         }
 
         private void SingleClipMoveToEntity(BaseEntity ent, in Vector3 start, in Vector3 mins, in Vector3 maxs, in Vector3 end, out Trace trace)
@@ -875,7 +868,7 @@ namespace SharpLife.Game.Server.Physics
 
             if (numhulls == 1)
             {
-                RecursiveHullCheck(pHulls[0], pHulls[0].FirstClipNode, 0.0f, 1.0f, ref start_l, ref end_l, ref trace);
+                HullCheck(pHulls[0], start_l, end_l, ref trace);
             }
             else
             {
@@ -890,7 +883,7 @@ namespace SharpLife.Game.Server.Physics
                         EndPosition = end
                     };
 
-                    RecursiveHullCheck(pHulls[i], pHulls[i].FirstClipNode, 0.0f, 1.0f, ref start_l, ref end_l, ref tempTrace);
+                    HullCheck(pHulls[i], start_l, end_l, ref tempTrace);
 
                     if (i == 0 || tempTrace.AllSolid || tempTrace.StartSolid || trace.Fraction > tempTrace.Fraction)
                     {
@@ -989,107 +982,123 @@ namespace SharpLife.Game.Server.Physics
             return DoesSphereIntersect(ent.Origin, fSphereRadiusSquared, traceOrg, traceDir);
         }
 
-        private void ClipToLinks(AreaNode node, ref MoveClip clip)
+        /// <summary>
+        /// Clips the move against a single entity
+        /// </summary>
+        /// <param name="pEntity"></param>
+        /// <param name="clip"></param>
+        /// <returns>False if no further entities in the current area node should be clipped against</returns>
+        private bool ClipToEntity(BaseEntity pEntity, ref MoveClip clip)
         {
-            foreach (var pEntity in node.Solids)
+            if (pEntity.PhysicsState.GroupInfo != 0 && clip.PassEntity?.PhysicsState.GroupInfo != 0
+                && !TestGroupOperation(pEntity.PhysicsState.GroupInfo, clip.PassEntity.PhysicsState.GroupInfo))
             {
-                if (pEntity.PhysicsState.GroupInfo != 0 && clip.PassEntity?.PhysicsState.GroupInfo != 0
-                    && !TestGroupOperation(pEntity.PhysicsState.GroupInfo, clip.PassEntity.PhysicsState.GroupInfo))
-                {
-                    continue;
-                }
+                return true;
+            }
 
-                if (pEntity.Solid == Solid.Not
-                    || ReferenceEquals(clip.PassEntity, pEntity))
-                {
-                    continue;
-                }
+            if (pEntity.Solid == Solid.Not
+                || ReferenceEquals(clip.PassEntity, pEntity))
+            {
+                return true;
+            }
 
-                if (pEntity.Solid == Solid.Trigger)
-                {
-                    throw new InvalidOperationException("Trigger in clipping list");
-                }
+            if (pEntity.Solid == Solid.Trigger)
+            {
+                throw new InvalidOperationException("Trigger in clipping list");
+            }
 
-                //TODO: change from return to continue to process remaining entities
-                //TODO: does it make sense to pass passentity?
-                if (!pEntity.ShouldCollide(clip.PassEntity))
-                {
-                    return;
-                }
+            //TODO: change from return to continue to process remaining entities
+            //TODO: does it make sense to pass passentity?
+            if (!pEntity.ShouldCollide(clip.PassEntity))
+            {
+                return false;
+            }
 
-                if (pEntity.Solid == Solid.BSP)
-                {
-                    if ((pEntity.Flags & EntityFlags.MonsterClip) != 0 && !clip.MonsterClipBrush)
-                    {
-                        continue;
-                    }
-                }
-                else if (clip.Type == TraceType.IgnoreMonsters && pEntity.MoveType != MoveType.PushStep)
+            if (pEntity.Solid == Solid.BSP)
+            {
+                if ((pEntity.Flags & EntityFlags.MonsterClip) != 0 && !clip.MonsterClipBrush)
                 {
-                    continue;
+                    return true;
                 }
+            }
+            else if (clip.Type == TraceType.IgnoreMonsters && pEntity.MoveType != MoveType.PushStep)
+            {
+                return true;
+            }
 
-                if (clip.IgnoreTransparent && pEntity.RenderMode != RenderMode.Normal && (pEntity.Flags & EntityFlags.WorldBrush) == 0)
-                {
-                    continue;
-                }
+            if (clip.IgnoreTransparent && pEntity.RenderMode != RenderMode.Normal && (pEntity.Flags & EntityFlags.WorldBrush) == 0)
+            {
+                return true;
+            }
 
-                if (clip.BoxMins.X > pEntity.AbsMax.X
-                    || clip.BoxMins.Y > pEntity.AbsMax.Y
-                    || clip.BoxMins.Z < pEntity.AbsMax.Z
-                    || pEntity.AbsMin.X > clip.BoxMaxs.X
-                    || pEntity.AbsMin.Y > clip.BoxMaxs.Y
-                    || pEntity.AbsMin.Z > clip.BoxMaxs.Z)
-                {
-                    continue;
-                }
+            if (clip.BoxMins.X > pEntity.AbsMax.X
+                || clip.BoxMins.Y > pEntity.AbsMax.Y
+                || clip.BoxMins.Z < pEntity.AbsMax.Z
+                || pEntity.AbsMin.X > clip.BoxMaxs.X
+                || pEntity.AbsMin.Y > clip.BoxMaxs.Y
+                || pEntity.AbsMin.Z > clip.BoxMaxs.Z)
+            {
+                return true;
+            }
 
-                if (pEntity.Solid != Solid.SlideBox && !CheckSphereIntersection(pEntity, clip.Start, clip.End))
-                {
-                    continue;
-                }
+            if (pEntity.Solid != Solid.SlideBox && !CheckSphereIntersection(pEntity, clip.Start, clip.End))
+            {
+                return true;
+            }
 
-                if (clip.PassEntity != null && clip.PassEntity.Size.X != 0 && pEntity.Size.X == 0)
-                {
-                    continue;
-                }
+            if (clip.PassEntity != null && clip.PassEntity.Size.X != 0 && pEntity.Size.X == 0)
+            {
+                return true;
+            }
 
-                if (clip.Trace.AllSolid)
-                {
-                    return;
-                }
+            if (clip.Trace.AllSolid)
+            {
+                return false;
+            }
 
-                if (clip.PassEntity != null
-                    && (SharedEntityUtils.HandleEquals(pEntity.Owner, clip.PassEntity)
-                    || SharedEntityUtils.HandleEquals(clip.PassEntity.Owner, pEntity)))
-                {
-                    continue;
-                }
+            if (clip.PassEntity != null
+                && (SharedEntityUtils.HandleEquals(pEntity.Owner, clip.PassEntity)
+                || SharedEntityUtils.HandleEquals(clip.PassEntity.Owner, pEntity)))
+            {
+                return true;
+            }
+
+            Trace trace;
+
+            if ((pEntity.Flags & EntityFlags.Monster) != 0)
+            {
+                SingleClipMoveToEntity(pEntity, clip.Start, clip.Mins2, clip.Maxs2, clip.End, out trace);
+            }
+            else
+            {
+                SingleClipMoveToEntity(pEntity, clip.Start, clip.Mins, clip.Maxs, clip.End, out trace);
+            }
 
-                Trace trace;
+            if (trace.AllSolid || trace.StartSolid || clip.Trace.Fraction > trace.Fraction)
+            {
+                clip.Trace.Entity = pEntity;
 
-                if ((pEntity.Flags & EntityFlags.Monster) != 0)
+                if (clip.Trace.StartSolid)
                 {
-                    SingleClipMoveToEntity(pEntity, clip.Start, clip.Mins2, clip.Maxs2, clip.End, out trace);
+                    clip.Trace = trace;
+                    clip.Trace.StartSolid = true;
                 }
                 else
                 {
-                    SingleClipMoveToEntity(pEntity, clip.Start, clip.Mins, clip.Maxs, clip.End, out trace);
+                    clip.Trace = trace;
                 }
+            }
 
-                if (trace.AllSolid || trace.StartSolid || clip.Trace.Fraction > trace.Fraction)
-                {
-                    clip.Trace.Entity = pEntity;
+            return true;
+        }
 
-                    if (clip.Trace.StartSolid)
-                    {
-                        clip.Trace = trace;
-                        clip.Trace.StartSolid = true;
-                    }
-                    else
-                    {
-                        clip.Trace = trace;
-                    }
+        private void ClipToLinks(AreaNode node, ref MoveClip clip)
+        {
+            foreach (var pEntity in node.Solids)
+            {
+                if (!ClipToEntity(pEntity, ref clip))
+                {
+                    return;
                 }
             }
 
@@ -1109,17 +1118,19 @@ namespace SharpLife.Game.Server.Physics
             }
         }
 
-        public Trace Move(ref Vector3 start, in Vector3 mins, in Vector3 maxs, in Vector3 end, TraceType type, BaseEntity passedict, bool ignoreTransparent, bool monsterClipBrush)
+        /// <summary>
+        /// Traces the move against the world and sets up the clip to trace against entities
+        /// </summary>
+        /// <returns>The fraction of the move that was completed before hitting the world</returns>
+        private float BeginMoveClip(ref MoveClip clip, ref Vector3 start, in Vector3 mins, in Vector3 maxs, in Vector3 end, TraceType type, BaseEntity passedict, bool ignoreTransparent, bool monsterClipBrush)
         {
-            var clip = new MoveClip();
-
             SingleClipMoveToEntity(_entities.World, start, mins, maxs, end, out clip.Trace);
 
             var worldFraction = clip.Trace.Fraction;
 
             if (clip.Trace.Fraction == 0)
             {
-                return clip.Trace;
+                return worldFraction;
             }
 
             clip.Trace.Fraction = 1.0f;
@@ -1154,6 +1165,21 @@ namespace SharpLife.Game.Server.Physics
             }
 
             MoveBounds(ref start, ref clip.Mins2, ref clip.Maxs2, ref clip.End, out clip.BoxMins, out clip.BoxMaxs);
+
+            return worldFraction;
+        }
+
+        public Trace Move(ref Vector3 start, in Vector3 mins, in Vector3 maxs, in Vector3 end, TraceType type, BaseEntity passedict, bool ignoreTransparent, bool monsterClipBrush)
+        {
+            var clip = new MoveClip();
+
+            var worldFraction = BeginMoveClip(ref clip, ref start, mins, maxs, end, type, passedict, ignoreTransparent, monsterClipBrush);
+
+            if (worldFraction == 0)
+            {
+                return clip.Trace;
+            }
+
             ClipToLinks(_areaNodes[0], ref clip);
 
             //TODO: set this here?
@@ -1162,5 +1188,152 @@ namespace SharpLife.Game.Server.Physics
 
             return clip.Trace;
         }
+
+        /// <summary>
+        /// Prepares a swept move query for an entity that will make multiple moves inside the given bounds
+        /// The area nodes are walked once to find the entities inside the bounds,
+        /// moves made with the query are only clipped against those entities
+        /// </summary>
+        /// <param name="query"></param>
+        /// <param name="boxMins">Minimum bounds of all moves, including the size of the moving entity</param>
+        /// <param name="boxMaxs">Maximum bounds of all moves, including the size of the moving entity</param>
+        /// <param name="type"></param>
+        /// <param name="passedict"></param>
+        /// <param name="ignoreTransparent"></param>
+        /// <param name="monsterClipBrush"></param>
+        public void BeginSweptMove(SweptMoveQuery query, in Vector3 boxMins, in Vector3 boxMaxs, TraceType type, BaseEntity passedict, bool ignoreTransparent, bool monsterClipBrush)
+        {
+            if (query == null)
+            {
+                throw new ArgumentNullException(nameof(query));
+            }
+
+            query.Type = type;
+            query.PassEntity = passedict;
+            query.IgnoreTransparent = ignoreTransparent;
+            query.MonsterClipBrush = monsterClipBrush;
+
+            GatherSweptMoveCandidates(query, boxMins, boxMaxs);
+        }
+
+        /// <summary>
+        /// Keeps a swept move query valid after the moving entity has been relinked
+        /// Must be called right after relinking, with the link generation from before the relink
+        /// </summary>
+        /// <param name="query"></param>
+        /// <param name="previousLinkGeneration"></param>
+        public void RevalidateSweptMove(SweptMoveQuery query, int previousLinkGeneration)
+        {
+            if (query == null)
+            {
+                throw new ArgumentNullException(nameof(query));
+            }
+
+            if (query.LinkGeneration == previousLinkGeneration)
+            {
+                query.LinkGeneration = _linkGeneration;
+            }
+        }
+
+        /// <summary>
+        /// Moves using the entities found by a swept move query
+        /// If the move leaves the query's bounds or entities were linked since the query was prepared, the entities are gathered again
+        /// </summary>
+        /// <param name="query"></param>
+        /// <param name="start"></param>
+        /// <param name="mins"></param>
+        /// <param name="maxs"></param>
+        /// <param name="end"></param>
+        /// <returns></returns>
+        public Trace Move(SweptMoveQuery query, ref Vector3 start, in Vector3 mins, in Vector3 maxs, in Vector3 end)
+        {
+            if (query == null)
+            {
+                throw new ArgumentNullException(nameof(query));
+            }
+
+            var clip = new MoveClip();
+
+            var worldFraction = BeginMoveClip(ref clip, ref start, mins, maxs, end, query.Type, query.PassEntity, query.IgnoreTransparent, query.MonsterClipBrush);
+
+            if (worldFraction == 0)
+            {
+                return clip.Trace;
+            }
+
+            EnsureSweptMoveCandidates(query, clip.BoxMins, clip.BoxMaxs);
+
+            foreach (var candidate in query.Candidates)
+            {
+                //Unlike ClipToLinks, entities that shouldn't collide don't stop clipping against the remaining entities
+                if (!ClipToEntity(candidate, ref clip) && clip.Trace.AllSolid)
+                {
+                    break;
+                }
+            }
+
+            clip.Trace.Fraction *= worldFraction;
+
+            return clip.Trace;
+        }
+
+        private void EnsureSweptMoveCandidates(SweptMoveQuery query, in Vector3 boxMins, in Vector3 boxMaxs)
+        {
+            if (query.LinkGeneration != _linkGeneration
+                || boxMins.X < query.BoxMins.X
+                || boxMins.Y < query.BoxMins.Y
+                || boxMins.Z < query.BoxMins.Z
+                || boxMaxs.X > query.BoxMaxs.X
+                || boxMaxs.Y > query.BoxMaxs.Y
+                || boxMaxs.Z > query.BoxMaxs.Z)
+            {
+                GatherSweptMoveCandidates(query, boxMins, boxMaxs);
+            }
+        }
+
+        private void GatherSweptMoveCandidates(SweptMoveQuery query, in Vector3 boxMins, in Vector3 boxMaxs)
+        {
+            query.Candidates.Clear();
+            query.BoxMins = boxMins;
+            query.BoxMaxs = boxMaxs;
+            query.LinkGeneration = _linkGeneration;
+
+            GatherSweptMoveCandidates(_areaNodes[0], query);
+        }
+
+        private void GatherSweptMoveCandidates(AreaNode node, SweptMoveQuery query)
+        {
+            foreach (var pEntity in node.Solids)
+            {
+                //Only reject entities by position here, everything else can change without relinking and is checked when clipping
+                //The Z check matches the one in ClipToEntity so no entity that it would accept is rejected
+                if (ReferenceEquals(query.PassEntity, pEntity)
+                    || query.BoxMins.X > pEntity.AbsMax.X
+                    || query.BoxMins.Y > pEntity.AbsMax.Y
+                    || pEntity.AbsMin.X > query.BoxMaxs.X
+                    || pEntity.AbsMin.Y > query.BoxMaxs.Y
+                    || pEntity.AbsMin.Z > query.BoxMaxs.Z)
+                {
+                    continue;
+                }
+
+                query.Candidates.Add(pEntity);
+            }
+
+            if (node.Axis == -1)
+            {
+                return;
+            }
+
+            if (query.BoxMaxs.Index(node.Axis) > node.Distance)
+            {
+                GatherSweptMoveCandidates(node.Children[0], query);
+            }
+
+            if (query.BoxMins.Index(node.Axis) < node.Distance)
+            {
+                GatherSweptMoveCandidates(node.Children[1], query);
+            }
+        }
     }
 }
@@ -0,0 +1,184 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using SharpLife.Game.Shared.Models.BSP;
+using SharpLife.Game.Shared.Physics;
+using SharpLife.Models.BSP.FileFormat;
+using System;
+using System.Collections.Generic;
+using System.Numerics;
+
+namespace SharpLife.Game.Server.Physics
+{
+    /// <summary>
+    /// Caches where point contents lookups in a hull should start for cells of a uniform grid
+    /// For each cell the hull is walked with the cell's bounds until the bounds cross a plane,
+    /// lookups for points in that cell can then skip all nodes above that point
+    /// Cells that lie entirely inside a single leaf resolve to that leaf's contents without walking the hull at all
+    /// The hull must not change while the cache is in use
+    /// </summary>
+    public sealed class HullContentsCache
+    {
+        public const float DefaultCellSize = 64;
+
+        public const int DefaultMaxCells = 1 << 16;
+
+        private readonly Hull _hull;
+
+        /// <summary>
+        /// Maps cells to the node to start at, or the contents of the cell if it is negative
+        /// </summary>
+        private readonly Dictionary<(int X, int Y, int Z), int> _cells = new Dictionary<(int X, int Y, int Z), int>();
+
+        private (int X, int Y, int Z) _lastCell;
+
+        private int _lastStartNode = -1;
+
+        private bool _hasLastCell;
+
+        public float CellSize { get; }
+
+        /// <summary>
+        /// Maximum number of cells to cache before the cache is cleared
+        /// </summary>
+        public int MaxCells { get; }
+
+        public int Count => _cells.Count;
+
+        public HullContentsCache(Hull hull, float cellSize = DefaultCellSize, int maxCells = DefaultMaxCells)
+        {
+            _hull = hull ?? throw new ArgumentNullException(nameof(hull));
+
+            if (cellSize <= 0)
+            {
+                throw new ArgumentOutOfRangeException(nameof(cellSize));
+            }
+
+            if (maxCells <= 0)
+            {
+                throw new ArgumentOutOfRangeException(nameof(maxCells));
+            }
+
+            CellSize = cellSize;
+            MaxCells = maxCells;
+        }
+
+        /// <summary>
+        /// Gets the contents of the hull at the given point
+        /// </summary>
+        /// <param name="p"></param>
+        /// <returns></returns>
+        public Contents PointContents(ref Vector3 p)
+        {
+            var startNode = GetStartNode(ref p);
+
+            return HullTracer.HullPointContents(_hull, startNode, ref p);
+        }
+
+        /// <summary>
+        /// Gets the contents of the hull at each of the given points
+        /// Points that are close together are resolved with a single cache lookup
+        /// </summary>
+        /// <param name="points"></param>
+        /// <param name="results">Receives the contents for each point. Must be at least as large as <paramref name="points"/></param>
+        public void PointContents(ReadOnlySpan<Vector3> points, Span<Contents> results)
+        {
+            if (results.Length < points.Length)
+            {
+                throw new ArgumentException("Results span is too small", nameof(results));
+            }
+
+            for (var i = 0; i < points.Length; ++i)
+            {
+                var point = points[i];
+
+                results[i] = HullTracer.HullPointContents(_hull, GetStartNode(ref point), ref point);
+            }
+        }
+
+        /// <summary>
+        /// Removes all cached cells
+        /// </summary>
+        public void Clear()
+        {
+            _cells.Clear();
+            _hasLastCell = false;
+            _lastStartNode = -1;
+        }
+
+        private int GetStartNode(ref Vector3 p)
+        {
+            var cell = (
+                (int)Math.Floor(p.X / CellSize),
+                (int)Math.Floor(p.Y / CellSize),
+                (int)Math.Floor(p.Z / CellSize));
+
+            //Consecutive queries are usually for points close to each other
+            if (_hasLastCell && _lastCell == cell)
+            {
+                return _lastStartNode;
+            }
+
+            if (!_cells.TryGetValue(cell, out var startNode))
+            {
+                if (_cells.Count >= MaxCells)
+                {
+                    _cells.Clear();
+                }
+
+                startNode = FindStartNode(cell);
+
+                _cells.Add(cell, startNode);
+            }
+
+            _lastCell = cell;
+            _lastStartNode = startNode;
+            _hasLastCell = true;
+
+            return startNode;
+        }
+
+        private int FindStartNode((int X, int Y, int Z) cell)
+        {
+            //Expand the bounds so points that round into a neighboring cell are still inside them
+            var mins = new Vector3(cell.X * CellSize, cell.Y * CellSize, cell.Z * CellSize) - Vector3.One;
+            var maxs = mins + new Vector3(CellSize + 2);
+
+            var node = _hull.FirstClipNode;
+
+            while (node >= 0)
+            {
+                var clipNode = _hull.ClipNodes[node];
+
+                var side = PhysicsUtils.BoxOnPlaneSide(ref mins, ref maxs, _hull.Planes.Span[clipNode.PlaneIndex]);
+
+                if (side == BoxOnPlaneSideResult.InFront)
+                {
+                    node = clipNode.Children[0];
+                }
+                else if (side == BoxOnPlaneSideResult.Behind)
+                {
+                    node = clipNode.Children[1];
+                }
+                else
+                {
+                    break;
+                }
+            }
+
+            return node;
+        }
+    }
+}
@@ -15,6 +15,7 @@
 
 using SharpLife.Game.Shared.Physics;
 using System;
+using System.Numerics;
 
 namespace SharpLife.Game.Server.Physics
 {
@@ -30,6 +31,34 @@ namespace SharpLife.Game.Server.Physics
 
         public AreaNode Area { get; set; }
 
+        /// <summary>
+        /// Whether the entity is at rest and is skipped by physics until something disturbs it
+        /// </summary>
+        public bool Sleeping { get; private set; }
+
+        /// <summary>
+        /// Number of consecutive frames that the entity has been at rest while awake
+        /// </summary>
+        public int IdleFrames { get; set; }
+
+        /// <summary>
+        /// Origin of the entity when it went to sleep
+        /// Used to detect when the entity has been moved
+        /// </summary>
+        public Vector3 SleepOrigin { get; private set; }
+
+        public void Sleep(in Vector3 origin)
+        {
+            Sleeping = true;
+            SleepOrigin = origin;
+        }
+
+        public void Wake()
+        {
+            Sleeping = false;
+            IdleFrames = 0;
+        }
+
         public short GetLeafNumber(int index) => _leafNums[index];
 
         public void AddLeafNumber(short number)
@@ -107,5 +107,6 @@ namespace SharpLife.Game.Server.Physics
                 return InternalBoxOnPlaneSide(emins, emaxs, p);
             }
         }
+
     }
 }
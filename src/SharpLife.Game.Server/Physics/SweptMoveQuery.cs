@@ -0,0 +1,54 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using SharpLife.Game.Server.Entities;
+using SharpLife.Game.Shared.Physics;
+using System.Collections.Generic;
+using System.Numerics;
+
+namespace SharpLife.Game.Server.Physics
+{
+    /// <summary>
+    /// Entities that a moving entity can collide with inside a region
+    /// Lets an entity make multiple moves in the same region without walking the area nodes for every move
+    /// Instances are reusable, see <see cref="GamePhysics.BeginSweptMove(SweptMoveQuery, in Vector3, in Vector3, TraceType, BaseEntity, bool, bool)"/>
+    /// </summary>
+    public sealed class SweptMoveQuery
+    {
+        internal readonly List<BaseEntity> Candidates = new List<BaseEntity>();
+
+        internal Vector3 BoxMins;
+
+        internal Vector3 BoxMaxs;
+
+        /// <summary>
+        /// <see cref="GamePhysics.LinkGeneration"/> at the time the candidates were gathered
+        /// </summary>
+        internal int LinkGeneration;
+
+        public TraceType Type { get; internal set; }
+
+        public BaseEntity PassEntity { get; internal set; }
+
+        public bool IgnoreTransparent { get; internal set; }
+
+        public bool MonsterClipBrush { get; internal set; }
+
+        /// <summary>
+        /// Number of entities found inside the region
+        /// </summary>
+        public int CandidateCount => Candidates.Count;
+    }
+}
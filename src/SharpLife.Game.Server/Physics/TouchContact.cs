@@ -0,0 +1,37 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using SharpLife.Game.Server.Entities;
+
+namespace SharpLife.Game.Server.Physics
+{
+    /// <summary>
+    /// A single trigger contact that is pending dispatch
+    /// </summary>
+    public struct TouchContact
+    {
+        /// <summary>
+        /// The entity that was linked
+        /// </summary>
+        public BaseEntity Entity;
+
+        /// <summary>
+        /// The trigger that the entity overlaps
+        /// </summary>
+        public BaseEntity Trigger;
+
+        public TouchState State;
+    }
+}
@@ -0,0 +1,198 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using SharpLife.Game.Server.Entities;
+using System;
+using System.Collections.Generic;
+using System.Runtime.CompilerServices;
+
+namespace SharpLife.Game.Server.Physics
+{
+    /// <summary>
+    /// Collects trigger contacts over the course of a frame so they can be dispatched once after movement
+    /// Entities that are relinked multiple times in a frame only produce a single contact per trigger
+    /// </summary>
+    public sealed class TouchContactSet
+    {
+        private struct ContactKey : IEquatable<ContactKey>
+        {
+            public readonly BaseEntity Entity;
+            public readonly BaseEntity Trigger;
+
+            public ContactKey(BaseEntity entity, BaseEntity trigger)
+            {
+                Entity = entity;
+                Trigger = trigger;
+            }
+
+            public bool Equals(ContactKey other)
+            {
+                return ReferenceEquals(Entity, other.Entity) && ReferenceEquals(Trigger, other.Trigger);
+            }
+
+            public override bool Equals(object obj)
+            {
+                return obj is ContactKey && Equals((ContactKey)obj);
+            }
+
+            public override int GetHashCode()
+            {
+                return HashCode.Combine(RuntimeHelpers.GetHashCode(Entity), RuntimeHelpers.GetHashCode(Trigger));
+            }
+        }
+
+        private sealed class Contact
+        {
+            public ContactKey Key;
+
+            /// <summary>
+            /// Whether this contact has been dispatched before
+            /// </summary>
+            public bool Dispatched;
+
+            /// <summary>
+            /// Whether the entity was linked inside the trigger since the last dispatch
+            /// </summary>
+            public bool Touched;
+        }
+
+        private readonly Dictionary<ContactKey, Contact> _contacts = new Dictionary<ContactKey, Contact>();
+
+        /// <summary>
+        /// Entities that were linked with trigger touching enabled since the last dispatch
+        /// </summary>
+        private readonly HashSet<BaseEntity> _linkedEntities = new HashSet<BaseEntity>();
+
+        private readonly List<Contact> _endedContacts = new List<Contact>();
+
+        private readonly List<TouchContact> _pendingDispatch = new List<TouchContact>();
+
+        /// <summary>
+        /// Number of contacts currently being tracked
+        /// </summary>
+        public int Count => _contacts.Count;
+
+        /// <summary>
+        /// Marks an entity as having been linked with trigger touching enabled
+        /// Contacts for this entity that are not added again before the next dispatch will end
+        /// </summary>
+        /// <param name="entity"></param>
+        public void MarkLinked(BaseEntity entity)
+        {
+            if (entity == null)
+            {
+                throw new ArgumentNullException(nameof(entity));
+            }
+
+            _linkedEntities.Add(entity);
+        }
+
+        /// <summary>
+        /// Adds a contact between an entity and a trigger
+        /// Adding the same contact multiple times before the next dispatch has no additional effect
+        /// </summary>
+        /// <param name="entity"></param>
+        /// <param name="trigger"></param>
+        public void Add(BaseEntity entity, BaseEntity trigger)
+        {
+            if (entity == null)
+            {
+                throw new ArgumentNullException(nameof(entity));
+            }
+
+            if (trigger == null)
+            {
+                throw new ArgumentNullException(nameof(trigger));
+            }
+
+            var key = new ContactKey(entity, trigger);
+
+            if (!_contacts.TryGetValue(key, out var contact))
+            {
+                contact = new Contact
+                {
+                    Key = key
+                };
+
+                _contacts.Add(key, contact);
+            }
+
+            contact.Touched = true;
+        }
+
+        /// <summary>
+        /// Builds the list of contacts to dispatch for this frame and resets the per-frame state
+        /// Contacts added while the returned list is being dispatched are deferred to the next dispatch
+        /// </summary>
+        /// <returns>The contacts to dispatch. Only valid until the next call to this method</returns>
+        public IReadOnlyList<TouchContact> CollectPendingDispatch()
+        {
+            _pendingDispatch.Clear();
+
+            foreach (var contact in _contacts.Values)
+            {
+                if (contact.Touched)
+                {
+                    _pendingDispatch.Add(new TouchContact
+                    {
+                        Entity = contact.Key.Entity,
+                        Trigger = contact.Key.Trigger,
+                        State = contact.Dispatched ? TouchState.Persist : TouchState.Begin
+                    });
+
+                    contact.Dispatched = true;
+                    contact.Touched = false;
+                }
+                else if (_linkedEntities.Contains(contact.Key.Entity)
+                    || contact.Key.Entity.PendingDestruction
+                    || contact.Key.Trigger.PendingDestruction)
+                {
+                    //The entity moved and is no longer inside the trigger, or one of them is gone
+                    _pendingDispatch.Add(new TouchContact
+                    {
+                        Entity = contact.Key.Entity,
+                        Trigger = contact.Key.Trigger,
+                        State = TouchState.End
+                    });
+
+                    _endedContacts.Add(contact);
+                }
+
+                //Entities that weren't relinked keep their contacts without dispatching, same as immediate touches
+            }
+
+            foreach (var contact in _endedContacts)
+            {
+                _contacts.Remove(contact.Key);
+            }
+
+            _endedContacts.Clear();
+            _linkedEntities.Clear();
+
+            return _pendingDispatch;
+        }
+
+        /// <summary>
+        /// Removes all contacts
+        /// </summary>
+        public void Clear()
+        {
+            _contacts.Clear();
+            _linkedEntities.Clear();
+            _endedContacts.Clear();
+            _pendingDispatch.Clear();
+        }
+    }
+}
@@ -0,0 +1,38 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+namespace SharpLife.Game.Server.Physics
+{
+    /// <summary>
+    /// State of a trigger contact when touches are deferred
+    /// </summary>
+    public enum TouchState
+    {
+        /// <summary>
+        /// The entity started touching the trigger this frame
+        /// </summary>
+        Begin = 0,
+
+        /// <summary>
+        /// The entity was already touching the trigger and was relinked inside it again this frame
+        /// </summary>
+        Persist,
+
+        /// <summary>
+        /// The entity was relinked this frame and is no longer touching the trigger
+        /// </summary>
+        End
+    }
+}
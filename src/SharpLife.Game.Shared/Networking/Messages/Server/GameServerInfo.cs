@@ -25,13 +25,14 @@ namespace SharpLife.Game.Shared.Networking.Messages.Server {
       byte[] descriptorData = global::System.Convert.FromBase64String(
           string.Concat(
             "ChRHYW1lU2VydmVySW5mby5wcm90bxIwU2hhcnBMaWZlLkdhbWUuU2hhcmVk",
-            "Lk5ldHdvcmtpbmcuTWVzc2FnZXMuU2VydmVyIk4KDkdhbWVTZXJ2ZXJJbmZv",
+            "Lk5ldHdvcmtpbmcuTWVzc2FnZXMuU2VydmVyImQKDkdhbWVTZXJ2ZXJJbmZv",
             "EhUKDW1hcF9maWxlX25hbWUYASABKAkSDwoHbWFwX2NyYxgCIAEoDRIUCgxh",
-            "bGxvd19jaGVhdHMYAyABKAhiBnByb3RvMw=="));
+            "bGxvd19jaGVhdHMYAyABKAgSFAoMY2xpZW50X2luZGV4GAQgASgNYgZwcm90",
+            "bzM="));
       descriptor = pbr::FileDescriptor.FromGeneratedCode(descriptorData,
           new pbr::FileDescriptor[] { },
           new pbr::GeneratedClrTypeInfo(null, new pbr::GeneratedClrTypeInfo[] {
-            new pbr::GeneratedClrTypeInfo(typeof(global::SharpLife.Game.Shared.Networking.Messages.Server.GameServerInfo), global::SharpLife.Game.Shared.Networking.Messages.Server.GameServerInfo.Parser, new[]{ "MapFileName", "MapCrc", "AllowCheats" }, null, null, null)
+            new pbr::GeneratedClrTypeInfo(typeof(global::SharpLife.Game.Shared.Networking.Messages.Server.GameServerInfo), global::SharpLife.Game.Shared.Networking.Messages.Server.GameServerInfo.Parser, new[]{ "MapFileName", "MapCrc", "AllowCheats", "ClientIndex" }, null, null, null)
           }));
     }
     #endregion
@@ -69,6 +70,7 @@ namespace SharpLife.Game.Shared.Networking.Messages.Server {
       mapFileName_ = other.mapFileName_;
       mapCrc_ = other.mapCrc_;
       allowCheats_ = other.allowCheats_;
+      clientIndex_ = other.clientIndex_;
       _unknownFields = pb::UnknownFieldSet.Clone(other._unknownFields);
     }
 
@@ -110,6 +112,20 @@ namespace SharpLife.Game.Shared.Networking.Messages.Server {
       }
     }
 
+    /// <summary>Field number for the "client_index" field.</summary>
+    public const int ClientIndexFieldNumber = 4;
+    private uint clientIndex_;
+    /// <summary>
+    ///Index of the client that receives this message, identifies its player entity
+    /// </summary>
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public uint ClientIndex {
+      get { return clientIndex_; }
+      set {
+        clientIndex_ = value;
+      }
+    }
+
     [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
     public override bool Equals(object other) {
       return Equals(other as GameServerInfo);
@@ -126,6 +142,7 @@ namespace SharpLife.Game.Shared.Networking.Messages.Server {
       if (MapFileName != other.MapFileName) return false;
       if (MapCrc != other.MapCrc) return false;
       if (AllowCheats != other.AllowCheats) return false;
+      if (ClientIndex != other.ClientIndex) return false;
       return Equals(_unknownFields, other._unknownFields);
     }
 
@@ -135,6 +152,7 @@ namespace SharpLife.Game.Shared.Networking.Messages.Server {
       if (MapFileName.Length != 0) hash ^= MapFileName.GetHashCode();
       if (MapCrc != 0) hash ^= MapCrc.GetHashCode();
       if (AllowCheats != false) hash ^= AllowCheats.GetHashCode();
+      if (ClientIndex != 0) hash ^= ClientIndex.GetHashCode();
       if (_unknownFields != null) {
         hash ^= _unknownFields.GetHashCode();
       }
@@ -160,6 +178,10 @@ namespace SharpLife.Game.Shared.Networking.Messages.Server {
         output.WriteRawTag(24);
         output.WriteBool(AllowCheats);
       }
+      if (ClientIndex != 0) {
+        output.WriteRawTag(32);
+        output.WriteUInt32(ClientIndex);
+      }
       if (_unknownFields != null) {
         _unknownFields.WriteTo(output);
       }
@@ -177,6 +199,9 @@ namespace SharpLife.Game.Shared.Networking.Messages.Server {
       if (AllowCheats != false) {
         size += 1 + 1;
       }
+      if (ClientIndex != 0) {
+        size += 1 + pb::CodedOutputStream.ComputeUInt32Size(ClientIndex);
+      }
       if (_unknownFields != null) {
         size += _unknownFields.CalculateSize();
       }
@@ -197,6 +222,9 @@ namespace SharpLife.Game.Shared.Networking.Messages.Server {
       if (other.AllowCheats != false) {
         AllowCheats = other.AllowCheats;
       }
+      if (other.ClientIndex != 0) {
+        ClientIndex = other.ClientIndex;
+      }
       _unknownFields = pb::UnknownFieldSet.MergeFrom(_unknownFields, other._unknownFields);
     }
 
@@ -220,6 +248,10 @@ namespace SharpLife.Game.Shared.Networking.Messages.Server {
             AllowCheats = input.ReadBool();
             break;
           }
+          case 32: {
+            ClientIndex = input.ReadUInt32();
+            break;
+          }
         }
       }
     }
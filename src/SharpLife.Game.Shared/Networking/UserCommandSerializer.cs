@@ -0,0 +1,257 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using Google.Protobuf;
+using SharpLife.Game.Shared.Physics;
+using SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData.Conversion;
+using System;
+using System.IO;
+using System.Numerics;
+
+namespace SharpLife.Game.Shared.Networking
+{
+    /// <summary>
+    /// Encodes user commands and player movement state for transmission
+    /// Each command is delta encoded against the command before it, so a command that is the same as the previous one takes only a few bits
+    /// Buffers are reused between calls, so instances must not be used by multiple threads at the same time
+    /// </summary>
+    public sealed class UserCommandSerializer
+    {
+        /// <summary>
+        /// Maximum number of commands in a single message
+        /// Limits the amount of work that a single message can cause on the server
+        /// </summary>
+        public const int MaxCommandsPerMessage = 32;
+
+        private readonly MemoryStream _data = new MemoryStream();
+
+        private readonly CodedOutputStream _stream;
+
+        private readonly BitWriter _writer = new BitWriter();
+
+        private readonly BitReader _reader = new BitReader();
+
+        public UserCommandSerializer()
+        {
+            _stream = new CodedOutputStream(_data, true);
+        }
+
+        private ByteString Finish()
+        {
+            _data.SetLength(0);
+
+            _writer.WriteTo(_stream);
+
+            _stream.Flush();
+
+            return ByteString.CopyFrom(_data.GetBuffer(), 0, (int)_data.Length);
+        }
+
+        /// <summary>
+        /// Encodes a list of commands
+        /// The first command is encoded against an empty command
+        /// </summary>
+        /// <param name="commands">Commands from oldest to newest</param>
+        /// <param name="count">Number of commands to encode</param>
+        public ByteString SerializeCommands(UserCommand[] commands, int count)
+        {
+            if (commands == null)
+            {
+                throw new ArgumentNullException(nameof(commands));
+            }
+
+            if (count < 0 || count > commands.Length || count > MaxCommandsPerMessage)
+            {
+                throw new ArgumentOutOfRangeException(nameof(count));
+            }
+
+            _writer.Reset();
+
+            var previous = new UserCommand();
+
+            for (var i = 0; i < count; ++i)
+            {
+                WriteDelta(previous, commands[i]);
+
+                previous = commands[i];
+            }
+
+            return Finish();
+        }
+
+        /// <summary>
+        /// Decodes a list of commands encoded by <see cref="SerializeCommands(UserCommand[], int)"/>
+        /// Sequence numbers are not encoded, they are assigned based on the sequence number of the newest command
+        /// </summary>
+        /// <param name="data"></param>
+        /// <param name="count">Number of commands in the data</param>
+        /// <param name="newestSequence">Sequence number of the newest command</param>
+        /// <param name="commands">Receives the commands from oldest to newest</param>
+        /// <exception cref="InvalidOperationException">If the data is malformed</exception>
+        /// <exception cref="InvalidProtocolBufferException">If the data is malformed</exception>
+        public void DeserializeCommands(ByteString data, int count, uint newestSequence, UserCommand[] commands)
+        {
+            if (data == null)
+            {
+                throw new ArgumentNullException(nameof(data));
+            }
+
+            if (commands == null)
+            {
+                throw new ArgumentNullException(nameof(commands));
+            }
+
+            if (count < 0 || count > commands.Length || count > MaxCommandsPerMessage)
+            {
+                throw new ArgumentOutOfRangeException(nameof(count));
+            }
+
+            using (var stream = data.CreateCodedInput())
+            {
+                _reader.ReadFrom(stream);
+            }
+
+            var previous = new UserCommand();
+
+            for (var i = 0; i < count; ++i)
+            {
+                ReadDelta(previous, out commands[i]);
+
+                commands[i].Sequence = newestSequence - (uint)(count - 1 - i);
+
+                previous = commands[i];
+            }
+        }
+
+        /// <summary>
+        /// Encodes a player's movement state
+        /// Values are sent at full precision so clients predict from exactly the same state that the server has
+        /// </summary>
+        /// <param name="state"></param>
+        public ByteString SerializeState(in PlayerMovementState state)
+        {
+            _writer.Reset();
+
+            WriteVector(state.Origin);
+            WriteVector(state.Velocity);
+            _writer.WriteBool(state.OnGround);
+            _writer.WriteBits((ushort)state.OldButtons, 16);
+
+            return Finish();
+        }
+
+        /// <summary>
+        /// Decodes a player's movement state encoded by <see cref="SerializeState(in PlayerMovementState)"/>
+        /// </summary>
+        /// <param name="data"></param>
+        /// <param name="state"></param>
+        /// <exception cref="InvalidOperationException">If the data is malformed</exception>
+        /// <exception cref="InvalidProtocolBufferException">If the data is malformed</exception>
+        public void DeserializeState(ByteString data, out PlayerMovementState state)
+        {
+            if (data == null)
+            {
+                throw new ArgumentNullException(nameof(data));
+            }
+
+            using (var stream = data.CreateCodedInput())
+            {
+                _reader.ReadFrom(stream);
+            }
+
+            state.Origin = ReadVector();
+            state.Velocity = ReadVector();
+            state.OnGround = _reader.ReadBool();
+            state.OldButtons = (InputButtons)_reader.ReadBits(16);
+        }
+
+        private void WriteDelta(in UserCommand from, in UserCommand to)
+        {
+            if (WriteChanged(from.Msec != to.Msec))
+            {
+                _writer.WriteBits(to.Msec, 8);
+            }
+
+            WriteSingleDelta(from.ViewAngles.X, to.ViewAngles.X);
+            WriteSingleDelta(from.ViewAngles.Y, to.ViewAngles.Y);
+            WriteSingleDelta(from.ViewAngles.Z, to.ViewAngles.Z);
+            WriteSingleDelta(from.ForwardMove, to.ForwardMove);
+            WriteSingleDelta(from.SideMove, to.SideMove);
+            WriteSingleDelta(from.UpMove, to.UpMove);
+
+            if (WriteChanged(from.Buttons != to.Buttons))
+            {
+                _writer.WriteBits((ushort)to.Buttons, 16);
+            }
+        }
+
+        private void ReadDelta(in UserCommand from, out UserCommand to)
+        {
+            to = from;
+
+            if (_reader.ReadBool())
+            {
+                to.Msec = (byte)_reader.ReadBits(8);
+            }
+
+            to.ViewAngles.X = ReadSingleDelta(from.ViewAngles.X);
+            to.ViewAngles.Y = ReadSingleDelta(from.ViewAngles.Y);
+            to.ViewAngles.Z = ReadSingleDelta(from.ViewAngles.Z);
+            to.ForwardMove = ReadSingleDelta(from.ForwardMove);
+            to.SideMove = ReadSingleDelta(from.SideMove);
+            to.UpMove = ReadSingleDelta(from.UpMove);
+
+            if (_reader.ReadBool())
+            {
+                to.Buttons = (InputButtons)_reader.ReadBits(16);
+            }
+        }
+
+        /// <summary>
+        /// Writes whether a value has changed, and returns it so the value can be written after it
+        /// </summary>
+        private bool WriteChanged(bool changed)
+        {
+            _writer.WriteBool(changed);
+            return changed;
+        }
+
+        private void WriteSingleDelta(float from, float to)
+        {
+            //Compare bits so negative zero and NaN are sent as they are
+            if (WriteChanged(BitConverter.SingleToInt32Bits(from) != BitConverter.SingleToInt32Bits(to)))
+            {
+                _writer.WriteSingle(to);
+            }
+        }
+
+        private float ReadSingleDelta(float from)
+        {
+            return _reader.ReadBool() ? _reader.ReadSingle() : from;
+        }
+
+        private void WriteVector(Vector3 value)
+        {
+            _writer.WriteSingle(value.X);
+            _writer.WriteSingle(value.Y);
+            _writer.WriteSingle(value.Z);
+        }
+
+        private Vector3 ReadVector()
+        {
+            return new Vector3(_reader.ReadSingle(), _reader.ReadSingle(), _reader.ReadSingle());
+        }
+    }
+}
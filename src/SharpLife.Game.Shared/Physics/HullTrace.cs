@@ -0,0 +1,54 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using System.Numerics;
+
+namespace SharpLife.Game.Shared.Physics
+{
+    /// <summary>
+    /// Result of a trace through a single hull
+    /// Used by code shared between client and server that has no access to entities
+    /// </summary>
+    public struct HullTrace
+    {
+        /// <summary>
+        /// if true, plane is not valid
+        /// </summary>
+        public bool AllSolid;
+
+        /// <summary>
+        /// if true, the initial point was in a solid area
+        /// </summary>
+        public bool StartSolid;
+        public bool InOpen, InWater;
+
+        /// <summary>
+        /// time completed, 1.0 = didn't hit anything
+        /// </summary>
+        public float Fraction;
+
+        /// <summary>
+        /// final position
+        /// </summary>
+        public Vector3 EndPosition;
+
+        /// <summary>
+        /// surface normal at impact
+        /// </summary>
+        public Vector3 PlaneNormal;
+
+        public float PlaneDistance;
+    }
+}
@@ -0,0 +1,226 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using SharpLife.Game.Shared.Models.BSP;
+using SharpLife.Models.BSP.FileFormat;
+using SharpLife.Utility.Mathematics;
+using System;
+using System.Numerics;
+
+namespace SharpLife.Game.Shared.Physics
+{
+    /// <summary>
+    /// Stateless functions to test points and trace lines against BSP hulls
+    /// Shared so the client can run the same collision code as the server when predicting movement
+    /// </summary>
+    public static class HullTracer
+    {
+        /// <summary>
+        /// Gets the contents of the given hull at the given point
+        /// </summary>
+        /// <param name="hull"></param>
+        /// <param name="num">Clip node to start at</param>
+        /// <param name="p"></param>
+        /// <returns></returns>
+        public static Contents HullPointContents(Hull hull, int num, ref Vector3 p)
+        {
+            int i;
+
+            for (i = num; i >= 0;)
+            {
+                if (hull.FirstClipNode > i || hull.LastClipNode < i)
+                {
+                    throw new InvalidOperationException("HullPointContents: bad node number");
+                }
+
+                var pNode = hull.ClipNodes[i];
+
+                var pPlane = hull.Planes.Span[pNode.PlaneIndex];
+
+                var dot = (pPlane.Type > PlaneType.Z ? Vector3.Dot(pPlane.Normal, p) : p.Index((int)pPlane.Type)) - pPlane.Distance;
+
+                if (dot >= 0.0)
+                {
+                    i = pNode.Children[0];
+                }
+                else
+                {
+                    i = pNode.Children[1];
+                }
+            }
+
+            return (Contents)i;
+        }
+
+        /// <summary>
+        /// Traces a line through the entire hull
+        /// </summary>
+        /// <param name="hull"></param>
+        /// <param name="start"></param>
+        /// <param name="end"></param>
+        /// <param name="trace"></param>
+        public static void TraceLine(Hull hull, in Vector3 start, in Vector3 end, out HullTrace trace)
+        {
+            trace = new HullTrace
+            {
+                Fraction = 1.0f,
+                AllSolid = true,
+                EndPosition = end
+            };
+
+            var p1 = start;
+            var p2 = end;
+
+            RecursiveHullCheck(hull, hull.FirstClipNode, 0.0f, 1.0f, ref p1, ref p2, ref trace);
+        }
+
+        public static bool RecursiveHullCheck(Hull hull, int num, float p1f, float p2f, ref Vector3 p1, ref Vector3 p2, ref HullTrace trace)
+        {
+            if (num >= 0)
+            {
+                //TODO: figure out if planes check is possible
+                if (num < hull.FirstClipNode || num > hull.LastClipNode /*|| hull.Planes == null*/)
+                {
+                    throw new InvalidOperationException("RecursiveHullCheck: bad node number");
+                }
+
+                float front, back;
+
+                var pNode = hull.ClipNodes[num];
+                var pPlane = hull.Planes.Span[pNode.PlaneIndex];
+
+                if (pPlane.Type <= PlaneType.Z)
+                {
+                    front = p1.Index((int)pPlane.Type) - pPlane.Distance;
+                    back = p2.Index((int)pPlane.Type) - pPlane.Distance;
+                }
+                else
+                {
+                    front = Vector3.Dot(pPlane.Normal, p1) - pPlane.Distance;
+                    back = Vector3.Dot(pPlane.Normal, p2) - pPlane.Distance;
+                }
+
+                if (front >= 0.0 && back >= 0.0)
+                {
+                    return RecursiveHullCheck(hull, pNode.Children[0], p1f, p2f, ref p1, ref p2, ref trace);
+                }
+
+                if (front < 0.0 && back < 0.0)
+                {
+                    return RecursiveHullCheck(hull, pNode.Children[1], p1f, p2f, ref p1, ref p2, ref trace);
+                }
+
+                float frac;
+
+                if (front < 0.0)
+                {
+                    frac = (float)((front + 0.03125) / (front - back));
+                }
+                else
+                {
+                    frac = (float)((front - 0.03125) / (front - back));
+                }
+
+                frac = Math.Clamp(frac, 0, 1);
+
+                if (float.IsNaN(frac))
+                {
+                    return false;
+                }
+
+                var distanceFraction = p2f - p1f;
+                var mid = p1 + ((p2 - p1) * frac);
+                var midFraction = (distanceFraction * frac) + p1f;
+                var side = front > 0.0 ? 1 : 0;
+
+                if (!RecursiveHullCheck(hull, pNode.Children[side], p1f, midFraction, ref p1, ref mid, ref trace))
+                {
+                    return false;
+                }
+
+                if (HullPointContents(hull, pNode.Children[side ^ 1], ref mid) != Contents.Solid)
+                {
+                    return RecursiveHullCheck(hull, pNode.Children[side ^ 1], midFraction, p2f, ref mid, ref p2, ref trace);
+                }
+
+                if (trace.AllSolid)
+                {
+                    return false;
+                }
+
+                if (side != 0)
+                {
+                    trace.PlaneNormal = -pPlane.Normal;
+                    trace.PlaneDistance = -pPlane.Distance;
+                }
+                else
+                {
+                    trace.PlaneNormal = pPlane.Normal;
+                    trace.PlaneDistance = pPlane.Distance;
+                }
+
+                while (true)
+                {
+                    trace.Fraction = midFraction;
+                    if (HullPointContents(hull, hull.FirstClipNode, ref mid) != Contents.Solid)
+                    {
+                        trace.EndPosition = mid;
+                        return false;
+                    }
+
+                    frac -= 0.1f;
+
+                    if (frac < 0.0)
+                    {
+                        break;
+                    }
+
+                    midFraction = (distanceFraction * frac) + p1f;
+                    mid = p1 + ((p2 - p1) * frac);
+                }
+
+                //Backed up past the start of the line
+                trace.EndPosition = mid;
+
+                return false;
+            }
+
+            var contents = (Contents)num;
+
+            if (contents == Contents.Solid)
+            {
+                trace.StartSolid = true;
+                return true;
+            }
+
+            trace.AllSolid = false;
+
+            if (contents == Contents.Empty)
+            {
+                trace.InOpen = true;
+                return true;
+            }
+
+            if (contents == Contents.Translucent)
+            {
+                return true;
+            }
+
+            trace.InWater = true;
+
+            return true;
+        }
+    }
+}
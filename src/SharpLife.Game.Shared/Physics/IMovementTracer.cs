@@ -0,0 +1,33 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using System.Numerics;
+
+namespace SharpLife.Game.Shared.Physics
+{
+    /// <summary>
+    /// Provides collision detection for player movement
+    /// </summary>
+    public interface IMovementTracer
+    {
+        /// <summary>
+        /// Traces the player's bounding box from start to end
+        /// </summary>
+        /// <param name="start"></param>
+        /// <param name="end"></param>
+        /// <param name="trace"></param>
+        void TracePlayer(in Vector3 start, in Vector3 end, out HullTrace trace);
+    }
+}
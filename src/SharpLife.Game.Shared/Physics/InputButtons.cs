@@ -0,0 +1,44 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using System;
+
+namespace SharpLife.Game.Shared.Physics
+{
+    /// <summary>
+    /// Buttons that a player can hold down in a <see cref="UserCommand"/>
+    /// </summary>
+    [Flags]
+    public enum InputButtons : ushort
+    {
+        None = 0,
+        Attack = 1 << 0,
+        Jump = 1 << 1,
+        Duck = 1 << 2,
+        Forward = 1 << 3,
+        Back = 1 << 4,
+        Use = 1 << 5,
+        Cancel = 1 << 6,
+        Left = 1 << 7,
+        Right = 1 << 8,
+        MoveLeft = 1 << 9,
+        MoveRight = 1 << 10,
+        Attack2 = 1 << 11,
+        Run = 1 << 12,
+        Reload = 1 << 13,
+        Alt1 = 1 << 14,
+        Score = 1 << 15,
+    }
+}
@@ -0,0 +1,61 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+namespace SharpLife.Game.Shared.Physics
+{
+    /// <summary>
+    /// Tunable parameters for player movement
+    /// Client and server must use the same settings or predicted movement will be corrected constantly
+    /// </summary>
+    public struct MovementSettings
+    {
+        public static readonly MovementSettings Default = new MovementSettings
+        {
+            Gravity = 800,
+            StopSpeed = 100,
+            MaxSpeed = 320,
+            Accelerate = 10,
+            AirAccelerate = 10,
+            Friction = 4,
+            JumpSpeed = 268.3281573f,
+            StepSize = 18
+        };
+
+        public float Gravity;
+
+        /// <summary>
+        /// Minimum stopping speed when on the ground
+        /// </summary>
+        public float StopSpeed;
+
+        public float MaxSpeed;
+
+        public float Accelerate;
+
+        public float AirAccelerate;
+
+        public float Friction;
+
+        /// <summary>
+        /// Upward velocity when jumping, the default reaches a height of 45 units
+        /// </summary>
+        public float JumpSpeed;
+
+        /// <summary>
+        /// Maximum height of steps that players can walk up
+        /// </summary>
+        public float StepSize;
+    }
+}
@@ -0,0 +1,67 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using SharpLife.Utility.Mathematics;
+using System.Numerics;
+
+namespace SharpLife.Game.Shared.Physics
+{
+    /// <summary>
+    /// Stateless movement helpers used by both entity physics and player movement
+    /// </summary>
+    public static class MovementUtils
+    {
+        /// <summary>
+        /// Slides off of the impacting object
+        /// </summary>
+        /// <param name="input"></param>
+        /// <param name="normal"></param>
+        /// <param name="output"></param>
+        /// <param name="overbounce"></param>
+        /// <returns>1 if the plane is a floor, 2 if it is a wall or step</returns>
+        public static byte ClipVelocity(ref Vector3 input, ref Vector3 normal, out Vector3 output, float overbounce)
+        {
+            output = new Vector3();
+
+            byte result = 0;
+
+            if (normal.Z > 0.0)
+            {
+                result |= 1;
+            }
+
+            if (normal.Z == 0.0)
+            {
+                result |= 2;
+            }
+
+            var dot = Vector3.Dot(input, normal) * overbounce;
+
+            for (int i = 0; i < 3; ++i)
+            {
+                var value = input.Index(i) - (normal.Index(i) * dot);
+
+                output.Index(i, value);
+
+                if (value > -0.1 && value < 0.1)
+                {
+                    output.Index(i, 0);
+                }
+            }
+
+            return result;
+        }
+    }
+}
@@ -39,6 +39,11 @@ namespace SharpLife.Game.Shared.Physics
         {
             public static readonly Vector3 ClipMins = new Vector3(-16, -16, -36);
             public static readonly Vector3 ClipMaxs = new Vector3(16, 16, 36);
+
+            /// <summary>
+            /// Offset from the origin of a standing player to their eyes
+            /// </summary>
+            public static readonly Vector3 ViewOffset = new Vector3(0, 0, 28);
         }
 
         public static class Hull2
@@ -51,6 +56,11 @@ namespace SharpLife.Game.Shared.Physics
         {
             public static readonly Vector3 ClipMins = new Vector3(-16, -16, -18);
             public static readonly Vector3 ClipMaxs = new Vector3(16, 16, 18);
+
+            /// <summary>
+            /// Offset from the origin of a ducking player to their eyes
+            /// </summary>
+            public static readonly Vector3 ViewOffset = new Vector3(0, 0, 12);
         }
     }
 }
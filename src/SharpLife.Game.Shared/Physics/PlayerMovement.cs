@@ -0,0 +1,350 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using SharpLife.Utility.Mathematics;
+using System;
+using System.Numerics;
+
+namespace SharpLife.Game.Shared.Physics
+{
+    /// <summary>
+    /// Deterministic player movement shared by client and server
+    /// The client uses this to predict the result of its own commands before the server has processed them
+    /// Must not depend on anything that differs between client and server, like the current time or random numbers
+    /// </summary>
+    public static class PlayerMovement
+    {
+        private const int MaxBumps = 4;
+
+        private const int MaxClipPlanes = 5;
+
+        /// <summary>
+        /// Surfaces steeper than this are too steep to stand on
+        /// </summary>
+        private const float MinWalkableNormal = 0.7f;
+
+        /// <summary>
+        /// Players moving up faster than this are never on the ground
+        /// </summary>
+        private const float MaxGroundUpwardSpeed = 180;
+
+        /// <summary>
+        /// Limits how fast players can accelerate in the air
+        /// </summary>
+        private const float MaxAirWishSpeed = 30;
+
+        /// <summary>
+        /// Runs a single command
+        /// </summary>
+        /// <param name="state"></param>
+        /// <param name="command"></param>
+        /// <param name="settings"></param>
+        /// <param name="tracer"></param>
+        public static void Simulate(ref PlayerMovementState state, in UserCommand command, in MovementSettings settings, IMovementTracer tracer)
+        {
+            if (tracer == null)
+            {
+                throw new ArgumentNullException(nameof(tracer));
+            }
+
+            var frameTime = command.Msec * 0.001f;
+
+            CategorizePosition(ref state, tracer);
+
+            if ((command.Buttons & InputButtons.Jump) != 0)
+            {
+                //Jumping requires the button to be released in between jumps
+                if (state.OnGround && (state.OldButtons & InputButtons.Jump) == 0)
+                {
+                    state.Velocity.Z = settings.JumpSpeed;
+                    state.OnGround = false;
+                }
+            }
+
+            if (state.OnGround)
+            {
+                state.Velocity.Z = 0;
+                ApplyFriction(ref state, settings, frameTime);
+            }
+
+            VectorUtils.AngleToVectors(command.ViewAngles, out var forward, out var right, out _);
+
+            //Movement is always horizontal, regardless of where the player is looking
+            forward.Z = 0;
+            right.Z = 0;
+
+            forward = forward != Vector3.Zero ? Vector3.Normalize(forward) : Vector3.Zero;
+            right = right != Vector3.Zero ? Vector3.Normalize(right) : Vector3.Zero;
+
+            var wishVelocity = (forward * command.ForwardMove) + (right * command.SideMove);
+
+            var wishSpeed = wishVelocity.Length();
+            var wishDirection = wishSpeed > 0 ? wishVelocity / wishSpeed : Vector3.Zero;
+
+            if (wishSpeed > settings.MaxSpeed)
+            {
+                wishSpeed = settings.MaxSpeed;
+            }
+
+            if (state.OnGround)
+            {
+                Accelerate(ref state.Velocity, wishDirection, wishSpeed, settings.Accelerate, frameTime);
+                WalkMove(ref state, settings, frameTime, tracer);
+            }
+            else
+            {
+                AirAccelerate(ref state.Velocity, wishDirection, wishSpeed, settings.AirAccelerate, frameTime);
+                state.Velocity.Z -= settings.Gravity * frameTime;
+                FlyMove(ref state, frameTime, tracer);
+            }
+
+            CategorizePosition(ref state, tracer);
+
+            state.OldButtons = command.Buttons;
+        }
+
+        private static void CategorizePosition(ref PlayerMovementState state, IMovementTracer tracer)
+        {
+            if (state.Velocity.Z > MaxGroundUpwardSpeed)
+            {
+                state.OnGround = false;
+                return;
+            }
+
+            var point = state.Origin;
+            point.Z -= 2;
+
+            tracer.TracePlayer(state.Origin, point, out var trace);
+
+            state.OnGround = trace.Fraction < 1.0 && trace.PlaneNormal.Z >= MinWalkableNormal;
+
+            if (state.OnGround && !trace.StartSolid && !trace.AllSolid)
+            {
+                //Stick to the ground
+                state.Origin = trace.EndPosition;
+            }
+        }
+
+        private static void ApplyFriction(ref PlayerMovementState state, in MovementSettings settings, float frameTime)
+        {
+            var speed = state.Velocity.Length();
+
+            if (speed < 0.1f)
+            {
+                return;
+            }
+
+            var control = speed < settings.StopSpeed ? settings.StopSpeed : speed;
+
+            var newSpeed = Math.Max(0, speed - (frameTime * control * settings.Friction));
+
+            state.Velocity *= newSpeed / speed;
+        }
+
+        private static void Accelerate(ref Vector3 velocity, in Vector3 wishDirection, float wishSpeed, float accelerate, float frameTime)
+        {
+            var addSpeed = wishSpeed - Vector3.Dot(velocity, wishDirection);
+
+            if (addSpeed <= 0)
+            {
+                return;
+            }
+
+            var accelerationSpeed = Math.Min(accelerate * frameTime * wishSpeed, addSpeed);
+
+            velocity += accelerationSpeed * wishDirection;
+        }
+
+        private static void AirAccelerate(ref Vector3 velocity, in Vector3 wishDirection, float wishSpeed, float accelerate, float frameTime)
+        {
+            var addSpeed = Math.Min(wishSpeed, MaxAirWishSpeed) - Vector3.Dot(velocity, wishDirection);
+
+            if (addSpeed <= 0)
+            {
+                return;
+            }
+
+            var accelerationSpeed = Math.Min(accelerate * frameTime * wishSpeed, addSpeed);
+
+            velocity += accelerationSpeed * wishDirection;
+        }
+
+        /// <summary>
+        /// Moves along the ground, stepping up onto stairs if that gets the player further
+        /// </summary>
+        private static void WalkMove(ref PlayerMovementState state, in MovementSettings settings, float frameTime, IMovementTracer tracer)
+        {
+            if (state.Velocity.X == 0 && state.Velocity.Y == 0)
+            {
+                return;
+            }
+
+            var destination = state.Origin + (state.Velocity * frameTime);
+
+            tracer.TracePlayer(state.Origin, destination, out var trace);
+
+            if (trace.Fraction == 1.0)
+            {
+                state.Origin = trace.EndPosition;
+                return;
+            }
+
+            var start = state;
+
+            var down = state;
+            FlyMove(ref down, frameTime, tracer);
+
+            var up = start;
+
+            var stepUp = new Vector3(0, 0, settings.StepSize);
+
+            tracer.TracePlayer(up.Origin, up.Origin + stepUp, out trace);
+
+            if (!trace.StartSolid && !trace.AllSolid)
+            {
+                up.Origin = trace.EndPosition;
+            }
+
+            FlyMove(ref up, frameTime, tracer);
+
+            tracer.TracePlayer(up.Origin, up.Origin - stepUp, out trace);
+
+            if (!trace.StartSolid && !trace.AllSolid)
+            {
+                up.Origin = trace.EndPosition;
+            }
+
+            //Stepped onto something that can't be stood on, or didn't step onto anything
+            if (trace.PlaneNormal.Z < MinWalkableNormal)
+            {
+                state = down;
+                return;
+            }
+
+            var downDistance = new Vector2(down.Origin.X - start.Origin.X, down.Origin.Y - start.Origin.Y).LengthSquared();
+            var upDistance = new Vector2(up.Origin.X - start.Origin.X, up.Origin.Y - start.Origin.Y).LengthSquared();
+
+            if (downDistance > upDistance)
+            {
+                state = down;
+            }
+            else
+            {
+                up.Velocity.Z = down.Velocity.Z;
+                state = up;
+            }
+        }
+
+        /// <summary>
+        /// Moves for the given amount of time, sliding along anything that is hit
+        /// </summary>
+        private static void FlyMove(ref PlayerMovementState state, float frameTime, IMovementTracer tracer)
+        {
+            Span<Vector3> planes = stackalloc Vector3[MaxClipPlanes];
+
+            var planeCount = 0;
+
+            var originalVelocity = state.Velocity;
+            var primalVelocity = state.Velocity;
+
+            var timeLeft = frameTime;
+
+            for (var bump = 0; bump < MaxBumps; ++bump)
+            {
+                if (state.Velocity == Vector3.Zero)
+                {
+                    break;
+                }
+
+                var end = state.Origin + (state.Velocity * timeLeft);
+
+                tracer.TracePlayer(state.Origin, end, out var trace);
+
+                if (trace.AllSolid)
+                {
+                    //Trapped in another solid
+                    state.Velocity = Vector3.Zero;
+                    return;
+                }
+
+                if (trace.Fraction > 0)
+                {
+                    state.Origin = trace.EndPosition;
+                    originalVelocity = state.Velocity;
+                    planeCount = 0;
+                }
+
+                if (trace.Fraction == 1)
+                {
+                    break;
+                }
+
+                timeLeft -= timeLeft * trace.Fraction;
+
+                if (planeCount >= MaxClipPlanes)
+                {
+                    state.Velocity = Vector3.Zero;
+                    break;
+                }
+
+                planes[planeCount++] = trace.PlaneNormal;
+
+                //Find a velocity that goes along all planes
+                int i;
+
+                for (i = 0; i < planeCount; ++i)
+                {
+                    MovementUtils.ClipVelocity(ref originalVelocity, ref planes[i], out var newVelocity, 1.0f);
+
+                    int j;
+
+                    for (j = 0; j < planeCount; ++j)
+                    {
+                        if (j != i && Vector3.Dot(newVelocity, planes[j]) < 0)
+                        {
+                            break;
+                        }
+                    }
+
+                    if (j == planeCount)
+                    {
+                        state.Velocity = newVelocity;
+                        break;
+                    }
+                }
+
+                if (i == planeCount)
+                {
+                    if (planeCount != 2)
+                    {
+                        state.Velocity = Vector3.Zero;
+                        break;
+                    }
+
+                    //Slide along the crease between the two planes
+                    var direction = Vector3.Cross(planes[0], planes[1]);
+                    state.Velocity = direction * Vector3.Dot(direction, state.Velocity);
+                }
+
+                //Don't bounce back and forth in corners
+                if (Vector3.Dot(state.Velocity, primalVelocity) <= 0)
+                {
+                    state.Velocity = Vector3.Zero;
+                    break;
+                }
+            }
+        }
+    }
+}
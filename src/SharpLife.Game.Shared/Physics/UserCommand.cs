@@ -0,0 +1,47 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using System.Numerics;
+
+namespace SharpLife.Game.Shared.Physics
+{
+    /// <summary>
+    /// A single frame of player input
+    /// Clients run these locally to predict their own movement, the server runs the same commands to get the authoritative result
+    /// </summary>
+    public struct UserCommand
+    {
+        /// <summary>
+        /// Increases by one for every command a client creates
+        /// Used to match server results to the command that produced them
+        /// </summary>
+        public uint Sequence;
+
+        /// <summary>
+        /// Duration of the command, in milliseconds
+        /// </summary>
+        public byte Msec;
+
+        public Vector3 ViewAngles;
+
+        public float ForwardMove;
+
+        public float SideMove;
+
+        public float UpMove;
+
+        public InputButtons Buttons;
+    }
+}
@@ -0,0 +1,50 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using SharpLife.Game.Shared.Models.BSP;
+using System;
+using System.Numerics;
+
+namespace SharpLife.Game.Shared.Physics
+{
+    /// <summary>
+    /// Traces player movement against the world only
+    /// </summary>
+    public sealed class WorldMovementTracer : IMovementTracer
+    {
+        private readonly Hull _hull;
+
+        public WorldMovementTracer(BSPModel worldModel)
+        {
+            if (worldModel == null)
+            {
+                throw new ArgumentNullException(nameof(worldModel));
+            }
+
+            //Standing player hull
+            _hull = worldModel.Hulls[1];
+        }
+
+        public void TracePlayer(in Vector3 start, in Vector3 end, out HullTrace trace)
+        {
+            HullTracer.TraceLine(_hull, start, end, out trace);
+
+            if (trace.Fraction != 1.0)
+            {
+                trace.EndPosition = start + ((end - start) * trace.Fraction);
+            }
+        }
+    }
+}
@@ -0,0 +1,272 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using SharpLife.Models.BSP.FileFormat;
+using System;
+using System.Collections.Generic;
+using System.Numerics;
+
+namespace SharpLife.Models.BSP
+{
+    /// <summary>
+    /// Potentially visible set data for a BSP file
+    /// The compressed visibility data is decompressed into one bit set per leaf when this is created so lookups don't need to decompress anything
+    /// Bit sets are indexed by leaf number - 1 since the solid leaf 0 has no visibility data
+    /// </summary>
+    public sealed class BSPVisibility
+    {
+        private readonly BSPFile _bspFile;
+
+        private readonly ulong[] _rows;
+
+        private readonly Dictionary<Leaf, int> _leafNumbers;
+
+        private readonly Dictionary<Node, int> _nodeNumbers;
+
+        /// <summary>
+        /// Number of leafs that have visibility data
+        /// </summary>
+        public int VisLeafCount { get; }
+
+        /// <summary>
+        /// Length of a single leaf's bit set, in 64 bit words
+        /// </summary>
+        public int RowLength { get; }
+
+        public BSPVisibility(BSPFile bspFile)
+        {
+            _bspFile = bspFile ?? throw new ArgumentNullException(nameof(bspFile));
+
+            VisLeafCount = Math.Min(_bspFile.Models[0].NumVisLeaves, _bspFile.Leaves.Count - 1);
+            RowLength = (VisLeafCount + 63) / 64;
+
+            _rows = new ulong[RowLength * VisLeafCount];
+
+            for (var i = 0; i < VisLeafCount; ++i)
+            {
+                DecompressRow(_bspFile.Leaves[i + 1].VisOffset, new Span<ulong>(_rows, i * RowLength, RowLength));
+            }
+
+            _leafNumbers = new Dictionary<Leaf, int>(_bspFile.Leaves.Count);
+
+            for (var i = 0; i < _bspFile.Leaves.Count; ++i)
+            {
+                _leafNumbers.Add(_bspFile.Leaves[i], i);
+            }
+
+            _nodeNumbers = new Dictionary<Node, int>(_bspFile.Nodes.Count);
+
+            for (var i = 0; i < _bspFile.Nodes.Count; ++i)
+            {
+                _nodeNumbers.Add(_bspFile.Nodes[i], i);
+            }
+        }
+
+        private void DecompressRow(int visOffset, Span<ulong> row)
+        {
+            var rowBytes = (VisLeafCount + 7) / 8;
+
+            var data = _bspFile.Visibility;
+
+            //No visibility data means everything is visible
+            if (visOffset == -1 || data == null || visOffset >= data.Length)
+            {
+                for (var i = 0; i < VisLeafCount; ++i)
+                {
+                    row[i >> 6] |= 1UL << (i & 63);
+                }
+
+                return;
+            }
+
+            var input = visOffset;
+            var output = 0;
+
+            while (output < rowBytes && input < data.Length)
+            {
+                if (data[input] != 0)
+                {
+                    row[output >> 3] |= (ulong)data[input] << ((output & 7) * 8);
+                    ++output;
+                    ++input;
+                    continue;
+                }
+
+                //Run of zero bytes
+                if (input + 1 >= data.Length)
+                {
+                    break;
+                }
+
+                output += data[input + 1];
+                input += 2;
+            }
+        }
+
+        /// <summary>
+        /// Gets the index of a leaf in <see cref="BSPFile.Leaves"/>
+        /// </summary>
+        /// <param name="leaf"></param>
+        public int GetLeafNumber(Leaf leaf)
+        {
+            return _leafNumbers.TryGetValue(leaf, out var number) ? number : -1;
+        }
+
+        /// <summary>
+        /// Gets the index of a node in <see cref="BSPFile.Nodes"/>
+        /// </summary>
+        /// <param name="node"></param>
+        public int GetNodeNumber(Node node)
+        {
+            return _nodeNumbers.TryGetValue(node, out var number) ? number : -1;
+        }
+
+        /// <summary>
+        /// Finds the leaf that contains the given point
+        /// </summary>
+        /// <param name="point"></param>
+        public Leaf FindLeaf(in Vector3 point)
+        {
+            BaseNode node = _bspFile.Nodes[0];
+
+            while (node.Contents >= Contents.Node)
+            {
+                var currentNode = (Node)node;
+
+                var distance = Vector3.Dot(point, currentNode.Plane.Normal) - currentNode.Plane.Distance;
+
+                node = currentNode.Children[distance > 0 ? 0 : 1];
+            }
+
+            return (Leaf)node;
+        }
+
+        /// <summary>
+        /// Gets the set of leafs that are potentially visible from the given leaf
+        /// </summary>
+        /// <param name="leafNumber">Index of the leaf in <see cref="BSPFile.Leaves"/></param>
+        public ReadOnlySpan<ulong> GetPVS(int leafNumber)
+        {
+            if (leafNumber < 1 || leafNumber > VisLeafCount)
+            {
+                return ReadOnlySpan<ulong>.Empty;
+            }
+
+            return new ReadOnlySpan<ulong>(_rows, (leafNumber - 1) * RowLength, RowLength);
+        }
+
+        /// <summary>
+        /// Merges the visibility of all leafs within <paramref name="radius"/> units of <paramref name="origin"/> into <paramref name="pvs"/>
+        /// Call this once for every view origin to build a fat PVS
+        /// </summary>
+        /// <param name="origin"></param>
+        /// <param name="radius"></param>
+        /// <param name="pvs">Bit set that is at least <see cref="RowLength"/> words long</param>
+        public void AddToFatPVS(in Vector3 origin, float radius, Span<ulong> pvs)
+        {
+            if (pvs.Length < RowLength)
+            {
+                throw new ArgumentException($"PVS must be at least {RowLength} words long", nameof(pvs));
+            }
+
+            AddToFatPVS(origin, radius, pvs, _bspFile.Nodes[0]);
+        }
+
+        private void AddToFatPVS(in Vector3 origin, float radius, Span<ulong> pvs, BaseNode node)
+        {
+            while (true)
+            {
+                if (node.Contents < Contents.Node)
+                {
+                    if (node.Contents != Contents.Solid)
+                    {
+                        var leafVis = GetPVS(GetLeafNumber((Leaf)node));
+
+                        for (var i = 0; i < leafVis.Length; ++i)
+                        {
+                            pvs[i] |= leafVis[i];
+                        }
+                    }
+
+                    return;
+                }
+
+                var currentNode = (Node)node;
+
+                var distance = Vector3.Dot(origin, currentNode.Plane.Normal) - currentNode.Plane.Distance;
+
+                if (distance > radius)
+                {
+                    node = currentNode.Children[0];
+                }
+                else if (distance < -radius)
+                {
+                    node = currentNode.Children[1];
+                }
+                else
+                {
+                    //Crosses the plane, add both sides
+                    AddToFatPVS(origin, radius, pvs, currentNode.Children[0]);
+                    node = currentNode.Children[1];
+                }
+            }
+        }
+
+        /// <summary>
+        /// Returns whether the given leaf is in a PVS
+        /// </summary>
+        /// <param name="pvs"></param>
+        /// <param name="leafNumber">Index of the leaf in <see cref="BSPFile.Leaves"/></param>
+        public static bool IsLeafVisible(ReadOnlySpan<ulong> pvs, int leafNumber)
+        {
+            var bit = leafNumber - 1;
+
+            if (bit < 0 || (bit >> 6) >= pvs.Length)
+            {
+                return false;
+            }
+
+            return (pvs[bit >> 6] & (1UL << (bit & 63))) != 0;
+        }
+
+        /// <summary>
+        /// Returns whether any leaf under the given node is in a PVS
+        /// Used for objects that touch too many leafs to track them individually
+        /// </summary>
+        /// <param name="pvs"></param>
+        /// <param name="nodeNumber">Index of the node in <see cref="BSPFile.Nodes"/></param>
+        public bool IsNodeVisible(ReadOnlySpan<ulong> pvs, int nodeNumber)
+        {
+            if (nodeNumber < 0 || nodeNumber >= _bspFile.Nodes.Count)
+            {
+                return false;
+            }
+
+            return IsNodeVisible(pvs, _bspFile.Nodes[nodeNumber]);
+        }
+
+        private bool IsNodeVisible(ReadOnlySpan<ulong> pvs, BaseNode node)
+        {
+            if (node.Contents < Contents.Node)
+            {
+                return node.Contents != Contents.Solid && IsLeafVisible(pvs, GetLeafNumber((Leaf)node));
+            }
+
+            var currentNode = (Node)node;
+
+            return IsNodeVisible(pvs, currentNode.Children[0]) || IsNodeVisible(pvs, currentNode.Children[1]);
+        }
+    }
+}
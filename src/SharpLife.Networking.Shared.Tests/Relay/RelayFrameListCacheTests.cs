@@ -0,0 +1,285 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using SharpLife.Networking.Shared.Communication.NetworkObjectLists;
+using SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData;
+using SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData.Conversion.Primitives;
+using SharpLife.Networking.Shared.Communication.NetworkObjectLists.Reception;
+using SharpLife.Networking.Shared.Communication.NetworkObjectLists.Transmission;
+using SharpLife.Networking.Shared.Communication.Relay;
+using SharpLife.Networking.Shared.Messages.NetworkObjectLists;
+using Xunit;
+
+namespace SharpLife.Networking.Shared.Tests.Relay
+{
+    /// <summary>
+    /// Passes frame lists from a transmitter through a relay cache to spectators
+    /// and checks that the spectators end up with the transmitted state
+    /// </summary>
+    public class RelayFrameListCacheTests
+    {
+        public class TestObject : INetworkable
+        {
+            public ObjectHandle Handle { get; set; }
+
+            [Networked]
+            public int Value { get; set; }
+        }
+
+        private sealed class TransmitAllListener : IFrameListTransmitterListener
+        {
+            public bool CanTransmit => true;
+
+            public void OnBeginProcessList(INetworkObjectList networkObjectList)
+            {
+            }
+
+            public void OnEndProcessList(INetworkObjectList networkObjectList)
+            {
+            }
+
+            public bool FilterNetworkObject(INetworkObjectList networkObjectList, INetworkObject networkObject) => true;
+        }
+
+        private sealed class ReceiveListener : IFrameListReceiverListener
+        {
+            public void OnBeginProcessList(INetworkObjectList networkObjectList, double serverTime)
+            {
+            }
+
+            public void OnEndProcessList(INetworkObjectList networkObjectList)
+            {
+            }
+
+            public void OnNetworkObjectCreated(INetworkObjectList networkObjectList, INetworkObject networkObject, INetworkable networkableObject)
+            {
+            }
+
+            public void OnNetworkObjectDestroyed(INetworkObjectList networkObjectList, INetworkObject networkObject, INetworkable networkableObject)
+            {
+            }
+
+            public void OnBeginUpdateNetworkObject(INetworkObjectList networkObjectList, INetworkObject networkObject)
+            {
+            }
+
+            public void OnEndUpdateNetworkObject(INetworkObjectList networkObjectList, INetworkObject networkObject)
+            {
+            }
+        }
+
+        private const string ListName = "objects";
+
+        private const int MaxFrameLists = 8;
+
+        private static TypeRegistry BuildRegistry()
+        {
+            var builder = new TypeRegistryBuilder();
+
+            builder.RegisterType(typeof(int), Int32Converter.Instance);
+
+            builder.NewBuilder(typeof(TestObject))
+                .AddNetworkedProperties()
+                .WithFactory((TypeMetaData metaData, in ObjectHandle handle) => new TestObject { Handle = handle })
+                .Build();
+
+            return builder.BuildRegistry();
+        }
+
+        /// <summary>
+        /// Creates a registry that has received the transmitter's metadata
+        /// </summary>
+        private static TypeRegistry BuildReceivingRegistry(TypeRegistry transmitterRegistry)
+        {
+            var registry = BuildRegistry();
+
+            registry.Deserialize(transmitterRegistry.Serialize());
+
+            return registry;
+        }
+
+        private readonly TypeRegistry _transmitterRegistry;
+
+        private readonly NetworkObjectListTransmitter _transmitter;
+
+        private readonly INetworkFrameListTransmitter _frameListTransmitter;
+
+        private readonly TestObject _first = new TestObject { Handle = new ObjectHandle(0, 1), Value = 1 };
+
+        private readonly TestObject _second = new TestObject { Handle = new ObjectHandle(1, 1), Value = 10 };
+
+        private readonly RelayFrameListCache _cache;
+
+        public RelayFrameListCacheTests()
+        {
+            _transmitterRegistry = BuildRegistry();
+
+            _transmitter = new NetworkObjectListTransmitter(_transmitterRegistry, MaxFrameLists);
+
+            var list = _transmitter.CreateList(ListName);
+
+            list.CreateNetworkObject(_first);
+            list.CreateNetworkObject(_second);
+
+            _frameListTransmitter = _transmitter.CreateTransmitter(new TransmitAllListener());
+
+            _cache = new RelayFrameListCache(BuildReceivingRegistry(_transmitterRegistry), MaxFrameLists);
+
+            _cache.DeserializeListMetaData(_transmitter.SerializeListMetaData());
+        }
+
+        /// <summary>
+        /// Creates a frame list on the transmitter and passes it to the relay the way the game server would
+        /// </summary>
+        private uint Transmit()
+        {
+            _transmitter.CreateFramesForTransmitters();
+
+            var message = _frameListTransmitter.SerializeCurrentFrameList();
+
+            Assert.True(_cache.AddFrameList(message));
+
+            _frameListTransmitter.AcknowledgeFrameList(message.Sequence);
+
+            return message.Sequence;
+        }
+
+        private NetworkObjectListReceiver CreateSpectator()
+        {
+            var receiver = new NetworkObjectListReceiver(BuildReceivingRegistry(_transmitterRegistry), MaxFrameLists, new ReceiveListener());
+
+            receiver.DeserializeListMetaData(_transmitter.SerializeListMetaData());
+
+            return receiver;
+        }
+
+        private static void Receive(NetworkObjectListReceiver spectator, NetworkObjectListFrameListUpdate message)
+        {
+            Assert.NotNull(message);
+            Assert.True(spectator.DeserializeFrameList(message));
+
+            spectator.ApplyCurrentFrame();
+        }
+
+        private static int GetValue(NetworkObjectListReceiver spectator, int id)
+        {
+            var networkObject = spectator.FindListByName(ListName).GetNetworkObjectById(id);
+
+            Assert.NotNull(networkObject);
+
+            return ((TestObject)networkObject.Instance).Value;
+        }
+
+        [Fact]
+        public void FullUpdateIsDecodable()
+        {
+            Transmit();
+
+            _first.Value = 2;
+
+            var sequence = Transmit();
+
+            var message = _cache.GetFrameList(sequence, 0);
+
+            Assert.Equal(0u, message.BaselineSequence);
+
+            var spectator = CreateSpectator();
+
+            Receive(spectator, message);
+
+            Assert.Equal(2, GetValue(spectator, _first.Handle.Id));
+            Assert.Equal(10, GetValue(spectator, _second.Handle.Id));
+        }
+
+        [Fact]
+        public void BaselineUpdateIsDecodable()
+        {
+            var firstSequence = Transmit();
+
+            _first.Value = 2;
+
+            Transmit();
+
+            _second.Value = 20;
+
+            var thirdSequence = Transmit();
+
+            var spectator = CreateSpectator();
+
+            Receive(spectator, _cache.GetFrameList(firstSequence, 0));
+
+            //Skip the second list to make sure changes made since the baseline are included, not just those in the sent list
+            var message = _cache.GetFrameList(thirdSequence, firstSequence);
+
+            Assert.Equal(firstSequence, message.BaselineSequence);
+
+            Receive(spectator, message);
+
+            Assert.Equal(2, GetValue(spectator, _first.Handle.Id));
+            Assert.Equal(20, GetValue(spectator, _second.Handle.Id));
+
+            //Spectators with the same baseline share the encoded message
+            Assert.Same(message, _cache.GetFrameList(thirdSequence, firstSequence));
+        }
+
+        [Fact]
+        public void UnavailableBaselineFallsBackToFullUpdate()
+        {
+            var sequence = Transmit();
+
+            for (var i = 0; i < MaxFrameLists; ++i)
+            {
+                ++_first.Value;
+
+                sequence = Transmit();
+            }
+
+            var message = _cache.GetFrameList(sequence, 1);
+
+            Assert.Equal(0u, message.BaselineSequence);
+
+            var spectator = CreateSpectator();
+
+            Receive(spectator, message);
+
+            Assert.Equal(_first.Value, GetValue(spectator, _first.Handle.Id));
+        }
+
+        [Fact]
+        public void DestructionsReachSpectatorsThatMissedThem()
+        {
+            var firstSequence = Transmit();
+
+            var list = _transmitter.FindListByName(ListName);
+
+            list.DestroyNetworkObject(list.FindNetworkObjectForObject(_second));
+
+            Transmit();
+
+            var thirdSequence = Transmit();
+
+            var spectator = CreateSpectator();
+
+            Receive(spectator, _cache.GetFrameList(firstSequence, 0));
+
+            Assert.NotNull(spectator.FindListByName(ListName).GetNetworkObjectById(_second.Handle.Id));
+
+            Receive(spectator, _cache.GetFrameList(thirdSequence, firstSequence));
+
+            Assert.Null(spectator.FindListByName(ListName).GetNetworkObjectById(_second.Handle.Id));
+            Assert.Equal(1, GetValue(spectator, _first.Handle.Id));
+        }
+    }
+}
@@ -0,0 +1,44 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using Lidgren.Network;
+
+namespace SharpLife.Networking.Shared.Communication.Capture
+{
+    /// <summary>
+    /// A data packet read from a traffic capture
+    /// </summary>
+    public struct CapturedPacket
+    {
+        public PacketDirection Direction;
+
+        /// <summary>
+        /// Identifies the remote peer the packet was sent to or received from
+        /// </summary>
+        public long ConnectionId;
+
+        /// <summary>
+        /// Time the packet was sent or received, in seconds
+        /// </summary>
+        public double Time;
+
+        public NetDeliveryMethod DeliveryMethod;
+
+        /// <summary>
+        /// The packet contents, as sent over the network
+        /// </summary>
+        public byte[] Data;
+    }
+}
@@ -13,14 +13,14 @@
 *
 ****/
 
-using System.IO;
-
-namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.Frames
+namespace SharpLife.Networking.Shared.Communication.Capture
 {
-    internal struct ObjectUpdateResult
+    /// <summary>
+    /// Direction of a captured packet, as seen by the peer that recorded it
+    /// </summary>
+    public enum PacketDirection : byte
     {
-        public MemoryStream Memory;
-        public bool IsDelta;
-        public bool ContainsChanges;
+        Outgoing = 0,
+        Incoming
     }
 }
@@ -0,0 +1,281 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using Google.Protobuf;
+using Google.Protobuf.Reflection;
+using SharpLife.Networking.Shared.Communication.Messages;
+using SharpLife.Networking.Shared.Communication.NetworkObjectLists.Frames;
+using SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData;
+using SharpLife.Networking.Shared.Communication.NetworkObjectLists.Reception;
+using SharpLife.Networking.Shared.Messages;
+using SharpLife.Networking.Shared.Messages.NetworkObjectLists;
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.IO;
+
+namespace SharpLife.Networking.Shared.Communication.Capture
+{
+    /// <summary>
+    /// Replays a traffic capture through the message parser and the frame list serializer to measure their cost
+    /// Frame lists are decoded and then encoded again against the same baseline,
+    /// so changes to the serializer can be compared against real traffic
+    /// </summary>
+    public sealed class TrafficBenchmark
+    {
+        /// <summary>
+        /// Number of frame lists to keep as baselines for each client
+        /// </summary>
+        private const int MaxFrameLists = 8;
+
+        /// <summary>
+        /// Oldest protocol version whose captures can still be replayed
+        /// Captures contain packets exactly as they were sent, so they can only be decoded if no message was changed, removed or reordered since
+        /// Version 10 only appended a client-to-server message and version 11 only added a field to the game's server info, so version 9 captures decode the same way
+        /// Whenever <see cref="NetConstants.ProtocolVersion"/> is incremented, raise this to the new version unless older captures are still decoded correctly
+        /// </summary>
+        public const uint MinProtocolVersion = 9;
+
+        private sealed class ConnectionState
+        {
+            public bool hasTypeMetaData;
+
+            public NetworkObjectListReceiver receiver;
+        }
+
+        private readonly TypeRegistry _typeRegistry;
+
+        private readonly SendMappings _serverToClientMappings = new SendMappings(NetMessages.ServerToClientMessages);
+
+        private readonly SendMappings _clientToServerMappings = new SendMappings(NetMessages.ClientToServerMessages);
+
+        private readonly List<IMessage> _messages = new List<IMessage>();
+
+        private readonly MessagesList _list = new MessagesList();
+
+        private readonly MemoryStream _encodeStream = new MemoryStream();
+
+        private readonly FrameSerializer _frameSerializer = new FrameSerializer();
+
+        /// <summary>
+        /// Creates a new benchmark
+        /// </summary>
+        /// <param name="typeRegistry">Registry of the networked types that the capture was recorded with
+        /// If null, frame lists are not replayed</param>
+        public TrafficBenchmark(TypeRegistry typeRegistry)
+        {
+            _typeRegistry = typeRegistry;
+        }
+
+        /// <summary>
+        /// Replays all packets in a capture
+        /// </summary>
+        /// <param name="reader"></param>
+        public TrafficBenchmarkResults Run(TrafficCaptureReader reader)
+        {
+            if (reader == null)
+            {
+                throw new ArgumentNullException(nameof(reader));
+            }
+
+            if (reader.ProtocolVersion < MinProtocolVersion || reader.ProtocolVersion > NetConstants.ProtocolVersion)
+            {
+                throw new InvalidOperationException($"Capture was recorded with protocol version {reader.ProtocolVersion}, expected {MinProtocolVersion} to {NetConstants.ProtocolVersion}");
+            }
+
+            var results = new TrafficBenchmarkResults();
+
+            var connections = new Dictionary<long, ConnectionState>();
+
+            var firstTime = double.NaN;
+            var lastTime = 0.0;
+
+            while (reader.TryRead(out var packet))
+            {
+                if (double.IsNaN(firstTime))
+                {
+                    firstTime = packet.Time;
+                }
+
+                lastTime = packet.Time;
+
+                if (!connections.TryGetValue(packet.ConnectionId, out var connection))
+                {
+                    connection = new ConnectionState();
+                    connections.Add(packet.ConnectionId, connection);
+                }
+
+                var serverToClient = (packet.Direction == PacketDirection.Outgoing) == reader.IsServer;
+
+                if (serverToClient)
+                {
+                    ++results.ServerToClientPackets;
+                    results.ServerToClientBytes += packet.Data.Length;
+                }
+                else
+                {
+                    ++results.ClientToServerPackets;
+                    results.ClientToServerBytes += packet.Data.Length;
+                }
+
+                ReplayPacket(packet.Data, serverToClient ? NetMessages.ServerToClientMessages : NetMessages.ClientToServerMessages, results);
+
+                EncodeMessages(serverToClient ? _serverToClientMappings : _clientToServerMappings, results);
+
+                if (serverToClient)
+                {
+                    foreach (var message in _messages)
+                    {
+                        ReplayServerMessage(connection, message, results);
+                    }
+                }
+
+                _messages.Clear();
+            }
+
+            results.Connections = connections.Count;
+            results.Duration = double.IsNaN(firstTime) ? 0 : lastTime - firstTime;
+
+            return results;
+        }
+
+        private void ReplayPacket(byte[] data, IReadOnlyList<MessageDescriptor> descriptors, TrafficBenchmarkResults results)
+        {
+            var startAllocated = GC.GetAllocatedBytesForCurrentThread();
+            var startTime = Stopwatch.GetTimestamp();
+
+            MessagesParser.ParseMessages(data, 0, data.Length, descriptors, _messages);
+
+            results.MessageDecode.Add(Stopwatch.GetTimestamp() - startTime, GC.GetAllocatedBytesForCurrentThread() - startAllocated);
+
+            results.Messages += _messages.Count;
+        }
+
+        private void EncodeMessages(SendMappings sendMappings, TrafficBenchmarkResults results)
+        {
+            var startAllocated = GC.GetAllocatedBytesForCurrentThread();
+            var startTime = Stopwatch.GetTimestamp();
+
+            _encodeStream.SetLength(0);
+
+            foreach (var message in _messages)
+            {
+                _list.MessageIds.Add(sendMappings.GetId(message));
+            }
+
+            _list.WriteDelimitedTo(_encodeStream);
+
+            foreach (var message in _messages)
+            {
+                message.WriteDelimitedTo(_encodeStream);
+            }
+
+            _list.MessageIds.Clear();
+
+            results.MessageEncode.Add(Stopwatch.GetTimestamp() - startTime, GC.GetAllocatedBytesForCurrentThread() - startAllocated);
+        }
+
+        private void ReplayServerMessage(ConnectionState connection, IMessage message, TrafficBenchmarkResults results)
+        {
+            if (_typeRegistry == null)
+            {
+                if (message is NetworkObjectListFrameListUpdate)
+                {
+                    ++results.SkippedFrameLists;
+                }
+
+                return;
+            }
+
+            switch (message)
+            {
+                case NetworkObjectListObjectMetaDataHash hash:
+                    {
+                        connection.hasTypeMetaData = _typeRegistry.TryUseCachedMetaData(hash.Hash);
+
+                        //Captures recorded by a server with the same types can be replayed without the metadata having been sent
+                        if (!connection.hasTypeMetaData && hash.Hash.Equals(_typeRegistry.MetaDataHash))
+                        {
+                            _typeRegistry.Deserialize(_typeRegistry.Serialize());
+                            connection.hasTypeMetaData = true;
+                        }
+                        break;
+                    }
+
+                case NetworkObjectListObjectMetaDataList metaDataList:
+                    {
+                        _typeRegistry.Deserialize(metaDataList);
+                        connection.hasTypeMetaData = true;
+                        break;
+                    }
+
+                case NetworkObjectListListMetaDataList listMetaDataList:
+                    {
+                        connection.receiver = new NetworkObjectListReceiver(_typeRegistry, MaxFrameLists, NullFrameListReceiverListener.Instance);
+                        connection.receiver.DeserializeListMetaData(listMetaDataList);
+                        break;
+                    }
+
+                case NetworkObjectListFrameListUpdate frameListUpdate:
+                    {
+                        if (connection.hasTypeMetaData && connection.receiver != null)
+                        {
+                            ReplayFrameList(connection.receiver, frameListUpdate, results);
+                        }
+                        else
+                        {
+                            ++results.SkippedFrameLists;
+                        }
+                        break;
+                    }
+            }
+        }
+
+        private void ReplayFrameList(NetworkObjectListReceiver receiver, NetworkObjectListFrameListUpdate frameListUpdate, TrafficBenchmarkResults results)
+        {
+            var startAllocated = GC.GetAllocatedBytesForCurrentThread();
+            var startTime = Stopwatch.GetTimestamp();
+
+            var deserialized = receiver.DeserializeFrameList(frameListUpdate);
+
+            results.FrameListDecode.Add(Stopwatch.GetTimestamp() - startTime, GC.GetAllocatedBytesForCurrentThread() - startAllocated);
+
+            //Stale lists and lists whose baseline was lost are dropped by clients as well
+            if (!deserialized)
+            {
+                ++results.SkippedFrameLists;
+                return;
+            }
+
+            var frameList = receiver.CurrentFrameList;
+
+            var baseline = frameListUpdate.BaselineSequence != 0 ? receiver.FindListBySequence(frameListUpdate.BaselineSequence) : null;
+
+            startAllocated = GC.GetAllocatedBytesForCurrentThread();
+            startTime = Stopwatch.GetTimestamp();
+
+            var reencoded = frameList.SerializeFrames(receiver, baseline, _frameSerializer);
+
+            results.FrameListEncode.Add(Stopwatch.GetTimestamp() - startTime, GC.GetAllocatedBytesForCurrentThread() - startAllocated);
+
+            //The server sets the time after serializing the frames
+            reencoded.ServerTime = frameListUpdate.ServerTime;
+
+            ++results.FrameLists;
+            results.FrameListBytes += frameListUpdate.CalculateSize();
+            results.ReencodedFrameListBytes += reencoded.CalculateSize();
+        }
+    }
+}
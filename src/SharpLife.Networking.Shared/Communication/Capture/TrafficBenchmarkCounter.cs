@@ -0,0 +1,51 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using System.Diagnostics;
+
+namespace SharpLife.Networking.Shared.Communication.Capture
+{
+    /// <summary>
+    /// Accumulated cost of a benchmarked operation
+    /// </summary>
+    public sealed class TrafficBenchmarkCounter
+    {
+        /// <summary>
+        /// Number of times the operation was performed
+        /// </summary>
+        public int Count { get; private set; }
+
+        /// <summary>
+        /// Total time spent, in <see cref="Stopwatch"/> ticks
+        /// </summary>
+        public long ElapsedTicks { get; private set; }
+
+        /// <summary>
+        /// Total number of bytes allocated
+        /// </summary>
+        public long AllocatedBytes { get; private set; }
+
+        public double AverageNanoseconds => Count > 0 ? ElapsedTicks * (1.0e9 / Stopwatch.Frequency) / Count : 0;
+
+        public double AverageAllocatedBytes => Count > 0 ? (double)AllocatedBytes / Count : 0;
+
+        internal void Add(long elapsedTicks, long allocatedBytes)
+        {
+            ++Count;
+            ElapsedTicks += elapsedTicks;
+            AllocatedBytes += allocatedBytes;
+        }
+    }
+}
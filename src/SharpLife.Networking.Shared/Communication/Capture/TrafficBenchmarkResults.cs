@@ -0,0 +1,101 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using System.Diagnostics;
+
+namespace SharpLife.Networking.Shared.Communication.Capture
+{
+    /// <summary>
+    /// Results of replaying a traffic capture
+    /// </summary>
+    public sealed class TrafficBenchmarkResults
+    {
+        /// <summary>
+        /// Number of remote peers in the capture
+        /// </summary>
+        public int Connections { get; internal set; }
+
+        /// <summary>
+        /// Time between the first and last packet, in seconds
+        /// </summary>
+        public double Duration { get; internal set; }
+
+        public int ServerToClientPackets { get; internal set; }
+
+        public long ServerToClientBytes { get; internal set; }
+
+        public int ClientToServerPackets { get; internal set; }
+
+        public long ClientToServerBytes { get; internal set; }
+
+        /// <summary>
+        /// Number of frame lists that were replayed
+        /// Each client receives at most one frame list per server frame
+        /// </summary>
+        public int FrameLists { get; internal set; }
+
+        /// <summary>
+        /// Number of frame lists that could not be replayed
+        /// This happens when the capture doesn't include the client's connection setup
+        /// </summary>
+        public int SkippedFrameLists { get; internal set; }
+
+        /// <summary>
+        /// Size of the replayed frame lists, as captured
+        /// </summary>
+        public long FrameListBytes { get; internal set; }
+
+        /// <summary>
+        /// Size of the replayed frame lists when encoded by the current serializer
+        /// </summary>
+        public long ReencodedFrameListBytes { get; internal set; }
+
+        /// <summary>
+        /// Average size of a replayed frame list as captured
+        /// Each client receives at most one frame list per server frame, so this is the object list traffic per client per frame
+        /// </summary>
+        public double FrameListBytesPerTick => FrameLists > 0 ? (double)FrameListBytes / FrameLists : 0;
+
+        /// <summary>
+        /// Number of messages in all packets
+        /// </summary>
+        public long Messages { get; internal set; }
+
+        /// <summary>
+        /// Parsing of the messages in each packet
+        /// </summary>
+        public TrafficBenchmarkCounter MessageDecode { get; } = new TrafficBenchmarkCounter();
+
+        /// <summary>
+        /// Number of messages that a single thread can parse per second, based on the measured cost
+        /// </summary>
+        public double MaxMessagesDecodedPerSecond => MessageDecode.ElapsedTicks > 0 ? Messages * (double)Stopwatch.Frequency / MessageDecode.ElapsedTicks : 0;
+
+        /// <summary>
+        /// Writing of the messages in each packet
+        /// </summary>
+        public TrafficBenchmarkCounter MessageEncode { get; } = new TrafficBenchmarkCounter();
+
+        /// <summary>
+        /// Deserialization of frame lists
+        /// </summary>
+        public TrafficBenchmarkCounter FrameListDecode { get; } = new TrafficBenchmarkCounter();
+
+        /// <summary>
+        /// Serialization of frame lists against the same baselines they were originally encoded against
+        /// </summary>
+        public TrafficBenchmarkCounter FrameListEncode { get; } = new TrafficBenchmarkCounter();
+    }
+}
@@ -0,0 +1,104 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using Lidgren.Network;
+using System;
+using System.IO;
+using System.Text;
+
+namespace SharpLife.Networking.Shared.Communication.Capture
+{
+    /// <summary>
+    /// Reads packets recorded by <see cref="TrafficCaptureWriter"/>
+    /// </summary>
+    public sealed class TrafficCaptureReader : IDisposable
+    {
+        private readonly BinaryReader _reader;
+
+        /// <summary>
+        /// Protocol version of the peer that recorded the capture
+        /// </summary>
+        public uint ProtocolVersion { get; }
+
+        /// <summary>
+        /// Whether the capture was recorded by a server
+        /// </summary>
+        public bool IsServer { get; }
+
+        /// <summary>
+        /// Creates a new capture reader
+        /// </summary>
+        /// <param name="stream">Stream to read from. The reader takes ownership of it</param>
+        public TrafficCaptureReader(Stream stream)
+        {
+            if (stream == null)
+            {
+                throw new ArgumentNullException(nameof(stream));
+            }
+
+            _reader = new BinaryReader(stream, Encoding.UTF8, false);
+
+            if (_reader.ReadUInt32() != TrafficCaptureWriter.Magic)
+            {
+                throw new InvalidDataException("Stream does not contain a traffic capture");
+            }
+
+            var formatVersion = _reader.ReadInt32();
+
+            if (formatVersion != TrafficCaptureWriter.FormatVersion)
+            {
+                throw new InvalidDataException($"Traffic capture format version {formatVersion} is not supported (expected {TrafficCaptureWriter.FormatVersion})");
+            }
+
+            ProtocolVersion = _reader.ReadUInt32();
+            IsServer = _reader.ReadBoolean();
+        }
+
+        /// <summary>
+        /// Reads the next packet
+        /// </summary>
+        /// <param name="packet"></param>
+        /// <returns>Whether a packet was read. Returns false at the end of the capture</returns>
+        public bool TryRead(out CapturedPacket packet)
+        {
+            if (_reader.BaseStream.Position >= _reader.BaseStream.Length)
+            {
+                packet = default;
+                return false;
+            }
+
+            packet.Direction = (PacketDirection)_reader.ReadByte();
+            packet.ConnectionId = _reader.ReadInt64();
+            packet.Time = _reader.ReadDouble();
+            packet.DeliveryMethod = (NetDeliveryMethod)_reader.ReadByte();
+
+            var length = _reader.ReadInt32();
+
+            packet.Data = _reader.ReadBytes(length);
+
+            if (packet.Data.Length != length)
+            {
+                throw new EndOfStreamException("Traffic capture ends in the middle of a packet");
+            }
+
+            return true;
+        }
+
+        public void Dispose()
+        {
+            _reader.Dispose();
+        }
+    }
+}
@@ -0,0 +1,108 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using Lidgren.Network;
+using System;
+using System.IO;
+using System.Text;
+
+namespace SharpLife.Networking.Shared.Communication.Capture
+{
+    /// <summary>
+    /// Records the data packets sent and received by a peer so the traffic can be analyzed offline
+    /// Packets can be written from multiple threads
+    /// </summary>
+    public sealed class TrafficCaptureWriter : IDisposable
+    {
+        /// <summary>
+        /// Identifies capture files
+        /// </summary>
+        public const uint Magic = 0x50435453; //STCP
+
+        public const int FormatVersion = 1;
+
+        private readonly object _lock = new object();
+
+        private readonly BinaryWriter _writer;
+
+        private bool _disposed;
+
+        /// <summary>
+        /// Creates a new capture writer
+        /// </summary>
+        /// <param name="stream">Stream to write to. The writer takes ownership of it</param>
+        /// <param name="isServer">Whether the capturing peer is a server</param>
+        public TrafficCaptureWriter(Stream stream, bool isServer)
+        {
+            if (stream == null)
+            {
+                throw new ArgumentNullException(nameof(stream));
+            }
+
+            _writer = new BinaryWriter(stream, Encoding.UTF8, false);
+
+            _writer.Write(Magic);
+            _writer.Write(FormatVersion);
+            _writer.Write(NetConstants.ProtocolVersion);
+            _writer.Write(isServer);
+        }
+
+        /// <summary>
+        /// Records a packet
+        /// </summary>
+        /// <param name="direction"></param>
+        /// <param name="connectionId"></param>
+        /// <param name="deliveryMethod"></param>
+        /// <param name="data">Buffer containing the packet</param>
+        /// <param name="length">Length of the packet, in bytes</param>
+        public void Write(PacketDirection direction, long connectionId, NetDeliveryMethod deliveryMethod, byte[] data, int length)
+        {
+            if (data == null)
+            {
+                throw new ArgumentNullException(nameof(data));
+            }
+
+            var time = NetTime.Now;
+
+            lock (_lock)
+            {
+                //The network thread can still be receiving packets while the capture is stopped
+                if (_disposed)
+                {
+                    return;
+                }
+
+                _writer.Write((byte)direction);
+                _writer.Write(connectionId);
+                _writer.Write(time);
+                _writer.Write((byte)deliveryMethod);
+                _writer.Write(length);
+                _writer.Write(data, 0, length);
+            }
+        }
+
+        public void Dispose()
+        {
+            lock (_lock)
+            {
+                if (!_disposed)
+                {
+                    _disposed = true;
+                    _writer.Dispose();
+                }
+            }
+        }
+    }
+}
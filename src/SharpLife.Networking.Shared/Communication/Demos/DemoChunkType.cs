@@ -0,0 +1,31 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+namespace SharpLife.Networking.Shared.Communication.Demos
+{
+    public enum DemoChunkType : byte
+    {
+        /// <summary>
+        /// Messages received in a single frame
+        /// </summary>
+        Messages = 0,
+
+        /// <summary>
+        /// All messages needed to set up a client and a full update of all objects
+        /// Playback can start at any keyframe, they are skipped during normal playback
+        /// </summary>
+        Keyframe
+    }
+}
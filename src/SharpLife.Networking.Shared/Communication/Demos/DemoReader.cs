@@ -0,0 +1,310 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+﻿using Google.Protobuf;
+using SharpLife.Networking.Shared.Communication.Messages;
+using SharpLife.Networking.Shared.Messages;
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.IO.MemoryMappedFiles;
+
+namespace SharpLife.Networking.Shared.Communication.Demos
+{
+    /// <summary>
+    /// Reads demos written by <see cref="DemoWriter"/>
+    /// The file is memory mapped so seeking to a keyframe doesn't need to read anything before it
+    /// </summary>
+    public sealed class DemoReader : IDisposable
+    {
+        private readonly MemoryMappedFile _file;
+
+        private readonly MemoryMappedViewAccessor _view;
+
+        /// <summary>
+        /// End of the chunk data, the index follows it
+        /// </summary>
+        private readonly long _dataEnd;
+
+        private readonly List<DemoKeyframe> _keyframes = new List<DemoKeyframe>();
+
+        private long _position = DemoWriter.HeaderSize;
+
+        private byte[] _buffer = new byte[1024];
+
+        public uint ProtocolVersion { get; }
+
+        public IReadOnlyList<DemoKeyframe> Keyframes => _keyframes;
+
+        /// <summary>
+        /// Opens a demo
+        /// </summary>
+        /// <param name="path">Absolute path to the demo file</param>
+        public DemoReader(string path)
+        {
+            if (path == null)
+            {
+                throw new ArgumentNullException(nameof(path));
+            }
+
+            var length = new FileInfo(path).Length;
+
+            if (length < DemoWriter.HeaderSize)
+            {
+                throw new InvalidDataException("File is not a demo");
+            }
+
+            _file = MemoryMappedFile.CreateFromFile(path, FileMode.Open, null, 0, MemoryMappedFileAccess.Read);
+
+            try
+            {
+                _view = _file.CreateViewAccessor(0, 0, MemoryMappedFileAccess.Read);
+
+                if (_view.ReadUInt32(0) != DemoWriter.Magic)
+                {
+                    throw new InvalidDataException("File is not a demo");
+                }
+
+                var formatVersion = _view.ReadInt32(sizeof(uint));
+
+                if (formatVersion != DemoWriter.FormatVersion)
+                {
+                    throw new InvalidDataException($"Demo format version {formatVersion} is not supported (expected {DemoWriter.FormatVersion})");
+                }
+
+                ProtocolVersion = _view.ReadUInt32(sizeof(uint) + sizeof(int));
+
+                _dataEnd = ReadIndex(length);
+
+                if (_dataEnd < 0)
+                {
+                    //The index is missing if the recording host didn't shut down properly
+                    _dataEnd = RebuildIndex(length);
+                }
+            }
+            catch
+            {
+                _view?.Dispose();
+                _file.Dispose();
+                throw;
+            }
+        }
+
+        /// <summary>
+        /// Reads the keyframe index from the end of the file
+        /// </summary>
+        /// <param name="length"></param>
+        /// <returns>Offset of the index, or -1 if there is no valid index</returns>
+        private long ReadIndex(long length)
+        {
+            if (length < DemoWriter.HeaderSize + sizeof(int) + DemoWriter.TrailerSize
+                || _view.ReadUInt32(length - sizeof(uint)) != DemoWriter.IndexMagic)
+            {
+                return -1;
+            }
+
+            var indexOffset = _view.ReadInt64(length - DemoWriter.TrailerSize);
+
+            if (indexOffset < DemoWriter.HeaderSize || indexOffset > length - DemoWriter.TrailerSize - sizeof(int))
+            {
+                return -1;
+            }
+
+            var count = _view.ReadInt32(indexOffset);
+
+            if (count < 0 || indexOffset + sizeof(int) + (count * (long)(sizeof(double) + sizeof(long))) != length - DemoWriter.TrailerSize)
+            {
+                return -1;
+            }
+
+            var position = indexOffset + sizeof(int);
+
+            for (var i = 0; i < count; ++i)
+            {
+                _keyframes.Add(new DemoKeyframe
+                {
+                    Time = _view.ReadDouble(position),
+                    Offset = _view.ReadInt64(position + sizeof(double))
+                });
+
+                position += sizeof(double) + sizeof(long);
+            }
+
+            return indexOffset;
+        }
+
+        /// <summary>
+        /// Finds all keyframes by walking the chunks
+        /// </summary>
+        /// <param name="length"></param>
+        /// <returns>End of the last complete chunk</returns>
+        private long RebuildIndex(long length)
+        {
+            _keyframes.Clear();
+
+            var position = (long)DemoWriter.HeaderSize;
+
+            while (position + DemoWriter.ChunkHeaderSize <= length)
+            {
+                var chunkLength = _view.ReadInt32(position + sizeof(byte) + sizeof(double));
+
+                if (chunkLength < 0 || position + DemoWriter.ChunkHeaderSize + chunkLength > length)
+                {
+                    break;
+                }
+
+                if ((DemoChunkType)_view.ReadByte(position) == DemoChunkType.Keyframe)
+                {
+                    _keyframes.Add(new DemoKeyframe
+                    {
+                        Time = _view.ReadDouble(position + sizeof(byte)),
+                        Offset = position
+                    });
+                }
+
+                position += DemoWriter.ChunkHeaderSize + chunkLength;
+            }
+
+            return position;
+        }
+
+        /// <summary>
+        /// Finds the last keyframe at or before the given time
+        /// </summary>
+        /// <param name="time"></param>
+        /// <returns>Index of the keyframe, or -1 if there are no keyframes before the given time</returns>
+        public int FindKeyframe(double time)
+        {
+            var low = 0;
+            var high = _keyframes.Count - 1;
+            var result = -1;
+
+            while (low <= high)
+            {
+                var middle = low + ((high - low) / 2);
+
+                if (_keyframes[middle].Time <= time)
+                {
+                    result = middle;
+                    low = middle + 1;
+                }
+                else
+                {
+                    high = middle - 1;
+                }
+            }
+
+            return result;
+        }
+
+        /// <summary>
+        /// Continues reading at the given keyframe
+        /// </summary>
+        /// <param name="keyframe"></param>
+        public void Seek(in DemoKeyframe keyframe)
+        {
+            if (keyframe.Offset < DemoWriter.HeaderSize || keyframe.Offset >= _dataEnd)
+            {
+                throw new ArgumentOutOfRangeException(nameof(keyframe), "Keyframe is not in this demo");
+            }
+
+            _position = keyframe.Offset;
+        }
+
+        /// <summary>
+        /// Gets the type and time of the next chunk without reading it
+        /// </summary>
+        /// <param name="type"></param>
+        /// <param name="time"></param>
+        /// <returns>Whether there is another chunk</returns>
+        public bool TryPeekChunk(out DemoChunkType type, out double time)
+        {
+            if (_position + DemoWriter.ChunkHeaderSize > _dataEnd)
+            {
+                type = DemoChunkType.Messages;
+                time = 0;
+                return false;
+            }
+
+            type = (DemoChunkType)_view.ReadByte(_position);
+            time = _view.ReadDouble(_position + sizeof(byte));
+
+            return true;
+        }
+
+        /// <summary>
+        /// Gets the length of the next chunk's data
+        /// </summary>
+        /// <exception cref="InvalidDataException">If the chunk extends past the end of the chunk data</exception>
+        private int ReadChunkLength()
+        {
+            if (_position + DemoWriter.ChunkHeaderSize > _dataEnd)
+            {
+                throw new InvalidDataException("Demo chunk header is truncated");
+            }
+
+            var length = _view.ReadInt32(_position + sizeof(byte) + sizeof(double));
+
+            if (length < 0 || length > _dataEnd - (_position + DemoWriter.ChunkHeaderSize))
+            {
+                throw new InvalidDataException($"Demo chunk length {length} is invalid");
+            }
+
+            return length;
+        }
+
+        /// <summary>
+        /// Reads the messages in the next chunk
+        /// </summary>
+        /// <param name="messages">List to add the messages to</param>
+        /// <exception cref="InvalidDataException">If the chunk is malformed</exception>
+        /// <exception cref="InvalidProtocolBufferException">If a message in the chunk is malformed</exception>
+        public void ReadChunk(List<IMessage> messages)
+        {
+            if (messages == null)
+            {
+                throw new ArgumentNullException(nameof(messages));
+            }
+
+            var length = ReadChunkLength();
+
+            if (_buffer.Length < length)
+            {
+                Array.Resize(ref _buffer, length);
+            }
+
+            _view.ReadArray(_position + DemoWriter.ChunkHeaderSize, _buffer, 0, length);
+
+            _position += DemoWriter.ChunkHeaderSize + length;
+
+            MessagesParser.ParseMessages(_buffer, 0, length, NetMessages.ServerToClientMessages, messages);
+        }
+
+        /// <summary>
+        /// Skips the next chunk
+        /// </summary>
+        /// <exception cref="InvalidDataException">If the chunk is malformed</exception>
+        public void SkipChunk()
+        {
+            _position += DemoWriter.ChunkHeaderSize + ReadChunkLength();
+        }
+
+        public void Dispose()
+        {
+            _view.Dispose();
+            _file.Dispose();
+        }
+    }
+}
@@ -0,0 +1,186 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using Google.Protobuf;
+using SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData;
+using SharpLife.Networking.Shared.Messages.NetworkObjectLists;
+using SharpLife.Networking.Shared.Messages.Server;
+using System;
+using System.Collections.Generic;
+
+namespace SharpLife.Networking.Shared.Communication.Demos
+{
+    /// <summary>
+    /// Records the messages sent to a client into a demo
+    /// Messages are buffered and written as a single chunk per frame
+    /// A keyframe is written after frame lists at regular intervals
+    /// </summary>
+    public sealed class DemoRecorder : IDisposable
+    {
+        private readonly DemoWriter _writer;
+
+        private readonly TypeRegistry _typeRegistry;
+
+        private readonly DemoSignOnState _signOnState;
+
+        private readonly Func<List<NetworkObjectListFrameListUpdate>> _serializeFrameLists;
+
+        private readonly List<IMessage> _messages = new List<IMessage>();
+
+        /// <summary>
+        /// Server time of recorded frame lists, by sequence
+        /// Frame lists serialized by a transmitter don't have the time set
+        /// </summary>
+        private readonly Dictionary<uint, double> _frameListTimes = new Dictionary<uint, double>();
+
+        private bool _hasFrameList;
+
+        private double _lastKeyframeTime = double.NegativeInfinity;
+
+        /// <summary>
+        /// Minimum amount of time between keyframes, in seconds
+        /// </summary>
+        public double KeyframeInterval { get; set; }
+
+        /// <summary>
+        /// Creates a new recorder
+        /// </summary>
+        /// <param name="writer">Writer to write the demo to. The recorder takes ownership of it</param>
+        /// <param name="typeRegistry">Type registry used to look up object metadata by hash</param>
+        /// <param name="signOnState">Messages that have been sent to the client to set up the current map</param>
+        /// <param name="serializeFrameLists">Serializes all frame lists that recorded frame lists can be delta encoded against as full updates</param>
+        /// <param name="keyframeInterval"></param>
+        public DemoRecorder(DemoWriter writer,
+            TypeRegistry typeRegistry,
+            DemoSignOnState signOnState,
+            Func<List<NetworkObjectListFrameListUpdate>> serializeFrameLists,
+            double keyframeInterval)
+        {
+            _writer = writer ?? throw new ArgumentNullException(nameof(writer));
+            _typeRegistry = typeRegistry ?? throw new ArgumentNullException(nameof(typeRegistry));
+            _signOnState = signOnState ?? throw new ArgumentNullException(nameof(signOnState));
+            _serializeFrameLists = serializeFrameLists ?? throw new ArgumentNullException(nameof(serializeFrameLists));
+            KeyframeInterval = keyframeInterval;
+        }
+
+        /// <summary>
+        /// Adds a message to the current chunk
+        /// </summary>
+        /// <param name="message"></param>
+        public void Record(IMessage message)
+        {
+            switch (message ?? throw new ArgumentNullException(nameof(message)))
+            {
+                //Only meaningful for the connection it was sent on
+                case ConnectAcknowledgement _:
+                    return;
+
+                case NetworkObjectListFrameListUpdate frameList:
+                    _frameListTimes[frameList.Sequence] = frameList.ServerTime;
+                    _hasFrameList = true;
+                    break;
+            }
+
+            _messages.Add(ResolveMessage(message));
+        }
+
+        /// <summary>
+        /// Players can't request metadata, so hashes are replaced with the metadata they refer to
+        /// </summary>
+        /// <param name="message"></param>
+        private IMessage ResolveMessage(IMessage message)
+        {
+            if (message is NetworkObjectListObjectMetaDataHash hash)
+            {
+                var metaData = _typeRegistry.FindMetaData(hash.Hash);
+
+                if (metaData != null)
+                {
+                    return metaData;
+                }
+            }
+
+            return message;
+        }
+
+        /// <summary>
+        /// Writes all messages recorded since the last call
+        /// </summary>
+        /// <param name="time">Current time on the recording host</param>
+        public void Flush(double time)
+        {
+            if (_messages.Count > 0)
+            {
+                _writer.Write(DemoChunkType.Messages, time, _messages);
+                _messages.Clear();
+            }
+
+            //Keyframes are only useful once the client has objects
+            if (_hasFrameList && time - _lastKeyframeTime >= KeyframeInterval)
+            {
+                WriteKeyframe(time);
+            }
+
+            _hasFrameList = false;
+        }
+
+        private void WriteKeyframe(double time)
+        {
+            var frameLists = _serializeFrameLists();
+
+            if (frameLists.Count == 0)
+            {
+                return;
+            }
+
+            foreach (var message in _signOnState.Messages)
+            {
+                _messages.Add(ResolveMessage(message));
+            }
+
+            foreach (var frameList in frameLists)
+            {
+                if (frameList.ServerTime == 0 && _frameListTimes.TryGetValue(frameList.Sequence, out var serverTime))
+                {
+                    frameList.ServerTime = serverTime;
+                }
+
+                _messages.Add(frameList);
+            }
+
+            _writer.Write(DemoChunkType.Keyframe, time, _messages);
+            _messages.Clear();
+
+            //Only lists that are still buffered can be used as baselines
+            _frameListTimes.Clear();
+
+            foreach (var frameList in frameLists)
+            {
+                _frameListTimes[frameList.Sequence] = frameList.ServerTime;
+            }
+
+            _lastKeyframeTime = time;
+        }
+
+        /// <summary>
+        /// Closes the demo
+        /// Messages recorded since the last call to <see cref="Flush(double)"/> are discarded
+        /// </summary>
+        public void Dispose()
+        {
+            _writer.Dispose();
+        }
+    }
+}
@@ -0,0 +1,68 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using Google.Protobuf;
+using SharpLife.Networking.Shared.Messages.BinaryData;
+using SharpLife.Networking.Shared.Messages.NetworkObjectLists;
+using SharpLife.Networking.Shared.Messages.NetworkStringLists;
+using SharpLife.Networking.Shared.Messages.Server;
+using System;
+using System.Collections.Generic;
+
+namespace SharpLife.Networking.Shared.Communication.Demos
+{
+    /// <summary>
+    /// Keeps track of the messages a client needs to set up the current map
+    /// Demo keyframes start with these so playback can start at any keyframe
+    /// </summary>
+    public sealed class DemoSignOnState
+    {
+        private readonly List<IMessage> _messages = new List<IMessage>();
+
+        public IReadOnlyList<IMessage> Messages => _messages;
+
+        /// <summary>
+        /// Adds a message sent to the client, if it is part of the setup of the current map
+        /// </summary>
+        /// <param name="message"></param>
+        public void Add(IMessage message)
+        {
+            switch (message ?? throw new ArgumentNullException(nameof(message)))
+            {
+                //A new map is starting, nothing sent before this is needed anymore
+                case ServerInfo _:
+                    _messages.Clear();
+                    _messages.Add(message);
+                    break;
+
+                case BinaryMetaData _:
+                case NetworkStringListFullUpdate _:
+                case NetworkStringListFullUpdateChunk _:
+                case NetworkStringListUpdate _:
+                case NetworkStringListFullUpdatesComplete _:
+                case NetworkObjectListObjectMetaDataHash _:
+                case NetworkObjectListObjectMetaDataList _:
+                case NetworkObjectListListMetaDataList _:
+                    _messages.Add(message);
+                    break;
+            }
+        }
+
+        public void Clear()
+        {
+            _messages.Clear();
+        }
+    }
+}
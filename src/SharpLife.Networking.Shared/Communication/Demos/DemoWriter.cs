@@ -0,0 +1,138 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using Google.Protobuf;
+using SharpLife.Networking.Shared.Communication.Messages;
+using SharpLife.Networking.Shared.Messages;
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Text;
+
+namespace SharpLife.Networking.Shared.Communication.Demos
+{
+    /// <summary>
+    /// Writes server-to-client messages to a demo file
+    /// The file is a header followed by chunks, and ends with an index of all keyframes so players can seek without reading the entire file
+    /// Messages are stored in the same format they are sent over the network in
+    /// </summary>
+    public sealed class DemoWriter : IDisposable
+    {
+        public const uint Magic = 0x4D444C53; //SLDM
+
+        public const uint IndexMagic = 0x58444E49; //INDX
+
+        public const int FormatVersion = 1;
+
+        public const int HeaderSize = sizeof(uint) + sizeof(int) + sizeof(uint);
+
+        public const int ChunkHeaderSize = sizeof(byte) + sizeof(double) + sizeof(int);
+
+        public const int TrailerSize = sizeof(long) + sizeof(uint);
+
+        private readonly BinaryWriter _writer;
+
+        private readonly SendMappings _sendMappings = new SendMappings(NetMessages.ServerToClientMessages);
+
+        private readonly MessagesList _list = new MessagesList();
+
+        private readonly MemoryStream _data = new MemoryStream();
+
+        private readonly List<DemoKeyframe> _keyframes = new List<DemoKeyframe>();
+
+        /// <summary>
+        /// Creates a new demo writer
+        /// </summary>
+        /// <param name="stream">Stream to write to. Must be seekable. The writer takes ownership of it</param>
+        public DemoWriter(Stream stream)
+        {
+            if (stream == null)
+            {
+                throw new ArgumentNullException(nameof(stream));
+            }
+
+            _writer = new BinaryWriter(stream, Encoding.UTF8, false);
+
+            _writer.Write(Magic);
+            _writer.Write(FormatVersion);
+            _writer.Write(NetConstants.ProtocolVersion);
+        }
+
+        /// <summary>
+        /// Writes a chunk containing the given messages
+        /// </summary>
+        /// <param name="type"></param>
+        /// <param name="time">Time on the recording host</param>
+        /// <param name="messages"></param>
+        public void Write(DemoChunkType type, double time, IReadOnlyList<IMessage> messages)
+        {
+            if (messages == null)
+            {
+                throw new ArgumentNullException(nameof(messages));
+            }
+
+            _data.SetLength(0);
+
+            foreach (var message in messages)
+            {
+                _list.MessageIds.Add(_sendMappings.GetId(message));
+            }
+
+            _list.WriteDelimitedTo(_data);
+
+            foreach (var message in messages)
+            {
+                message.WriteDelimitedTo(_data);
+            }
+
+            _list.MessageIds.Clear();
+
+            if (type == DemoChunkType.Keyframe)
+            {
+                _keyframes.Add(new DemoKeyframe
+                {
+                    Time = time,
+                    Offset = _writer.BaseStream.Position
+                });
+            }
+
+            _writer.Write((byte)type);
+            _writer.Write(time);
+            _writer.Write((int)_data.Length);
+            _writer.Write(_data.GetBuffer(), 0, (int)_data.Length);
+        }
+
+        /// <summary>
+        /// Writes the keyframe index and closes the file
+        /// </summary>
+        public void Dispose()
+        {
+            var indexOffset = _writer.BaseStream.Position;
+
+            _writer.Write(_keyframes.Count);
+
+            foreach (var keyframe in _keyframes)
+            {
+                _writer.Write(keyframe.Time);
+                _writer.Write(keyframe.Offset);
+            }
+
+            _writer.Write(indexOffset);
+            _writer.Write(IndexMagic);
+
+            _writer.Dispose();
+        }
+    }
+}
@@ -0,0 +1,83 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using Google.Protobuf;
+using System;
+using System.Collections.Concurrent;
+
+namespace SharpLife.Networking.Shared.Communication.Loopback
+{
+    /// <summary>
+    /// In-process channel between a listen server and its local client
+    /// Messages are passed as objects, so they don't need to be serialized, sent over the network and deserialized again
+    /// The connection itself is still established through Lidgren so status changes, timeouts and disconnects work as they do for remote clients
+    /// Messages must not be modified after they have been sent since the receiver gets the same instance
+    /// </summary>
+    public sealed class LoopbackChannel
+    {
+        private readonly ConcurrentQueue<IMessage> _toServer = new ConcurrentQueue<IMessage>();
+
+        private readonly ConcurrentQueue<IMessage> _toClient = new ConcurrentQueue<IMessage>();
+
+        /// <summary>
+        /// Identifies this channel to the server
+        /// The local client sends this when connecting so the server can tell it apart from other clients on the same machine
+        /// </summary>
+        public ulong Id { get; }
+
+        public LoopbackChannel()
+        {
+            var bytes = Guid.NewGuid().ToByteArray();
+
+            //0 means no loopback channel
+            Id = BitConverter.ToUInt64(bytes, 0) | 1;
+        }
+
+        public void SendToServer(IMessage message)
+        {
+            _toServer.Enqueue(message ?? throw new ArgumentNullException(nameof(message)));
+        }
+
+        public void SendToClient(IMessage message)
+        {
+            _toClient.Enqueue(message ?? throw new ArgumentNullException(nameof(message)));
+        }
+
+        public bool TryReceiveOnServer(out IMessage message)
+        {
+            return _toServer.TryDequeue(out message);
+        }
+
+        public bool TryReceiveOnClient(out IMessage message)
+        {
+            return _toClient.TryDequeue(out message);
+        }
+
+        /// <summary>
+        /// Discards all messages that haven't been received yet
+        /// Should be called when a new connection is started so messages meant for a previous connection are not processed
+        /// </summary>
+        public void Clear()
+        {
+            while (_toServer.TryDequeue(out _))
+            {
+            }
+
+            while (_toClient.TryDequeue(out _))
+            {
+            }
+        }
+    }
+}
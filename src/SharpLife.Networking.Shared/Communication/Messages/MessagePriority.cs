@@ -0,0 +1,34 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+namespace SharpLife.Networking.Shared.Communication.Messages
+{
+    /// <summary>
+    /// Priority of a reliable message when the send budget doesn't allow all pending messages to be sent
+    /// Lower values are sent first
+    /// </summary>
+    public enum MessagePriority
+    {
+        /// <summary>
+        /// Connection setup and other control messages
+        /// </summary>
+        Control = 0,
+
+        /// <summary>
+        /// Network string list updates
+        /// </summary>
+        StringLists
+    }
+}
@@ -0,0 +1,364 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using Google.Protobuf;
+using Lidgren.Network;
+using SharpLife.Networking.Shared.Messages;
+using System;
+using System.Collections.Generic;
+using System.IO;
+
+namespace SharpLife.Networking.Shared.Communication.Messages
+{
+    /// <summary>
+    /// Schedules reliable messages for transmission to a single remote host
+    /// Messages are packed into packets that fit in the connection's MTU, and no more data is sent than the rate allows
+    /// When the budget doesn't allow everything to be sent, messages are sent in order of priority
+    /// </summary>
+    public sealed class MessageScheduler
+    {
+        /// <summary>
+        /// Maximum amount of time that unused budget can accumulate for
+        /// Prevents bursts after idle periods
+        /// </summary>
+        public const double MaxBurstTime = 0.1;
+
+        /// <summary>
+        /// Space reserved in each packet for the list of message ids
+        /// </summary>
+        private const int PacketHeaderSize = 8;
+
+        private struct QueuedMessage
+        {
+            public uint id;
+            public int offset;
+            public int length;
+        }
+
+        private sealed class MessageQueue
+        {
+            public readonly MemoryStream data = new MemoryStream();
+
+            public readonly List<QueuedMessage> messages = new List<QueuedMessage>();
+
+            public int head;
+
+            public bool IsEmpty => head >= messages.Count;
+
+            public int Count => messages.Count - head;
+
+            public QueuedMessage Peek() => messages[head];
+
+            /// <summary>
+            /// Removes sent messages from the queue
+            /// </summary>
+            public void Compact()
+            {
+                if (head == 0)
+                {
+                    return;
+                }
+
+                if (IsEmpty)
+                {
+                    messages.Clear();
+                    data.SetLength(0);
+                }
+                else
+                {
+                    var start = messages[head].offset;
+                    var remaining = (int)data.Length - start;
+
+                    var buffer = data.GetBuffer();
+
+                    Buffer.BlockCopy(buffer, start, buffer, 0, remaining);
+                    data.SetLength(remaining);
+
+                    messages.RemoveRange(0, head);
+
+                    for (var i = 0; i < messages.Count; ++i)
+                    {
+                        var message = messages[i];
+                        message.offset -= start;
+                        messages[i] = message;
+                    }
+                }
+
+                head = 0;
+            }
+        }
+
+        private struct PacketEntry
+        {
+            public MessageQueue queue;
+            public QueuedMessage message;
+        }
+
+        private readonly SendMappings _sendMappings;
+
+        private readonly MessageQueue[] _queues;
+
+        private readonly MessagesList _list = new MessagesList();
+
+        private readonly List<PacketEntry> _packetEntries = new List<PacketEntry>();
+
+        private double _budget;
+
+        private double _lastBudgetUpdateTime = -1;
+
+        /// <summary>
+        /// Maximum number of bytes to send per second
+        /// 0 if there is no limit
+        /// </summary>
+        public int Rate { get; set; }
+
+        /// <summary>
+        /// The number of messages that are pending transmission
+        /// </summary>
+        public int MessageCount
+        {
+            get
+            {
+                var count = 0;
+
+                foreach (var queue in _queues)
+                {
+                    count += queue.Count;
+                }
+
+                return count;
+            }
+        }
+
+        public MessageScheduler(SendMappings sendMappings)
+        {
+            _sendMappings = sendMappings ?? throw new ArgumentNullException(nameof(sendMappings));
+
+            _queues = new MessageQueue[(int)MessagePriority.StringLists + 1];
+
+            for (var i = 0; i < _queues.Length; ++i)
+            {
+                _queues[i] = new MessageQueue();
+            }
+        }
+
+        /// <summary>
+        /// Returns whether there are any messages of the given priority pending transmission
+        /// </summary>
+        /// <param name="priority"></param>
+        public bool HasPendingMessages(MessagePriority priority)
+        {
+            return !_queues[(int)priority].IsEmpty;
+        }
+
+        /// <summary>
+        /// Adds a message to the queue for its priority
+        /// </summary>
+        /// <param name="message"></param>
+        /// <param name="priority"></param>
+        public void Add(IMessage message, MessagePriority priority)
+        {
+            if (message == null)
+            {
+                throw new ArgumentNullException(nameof(message));
+            }
+
+            var queue = _queues[(int)priority];
+
+            var offset = (int)queue.data.Length;
+
+            message.WriteDelimitedTo(queue.data);
+
+            queue.messages.Add(new QueuedMessage
+            {
+                id = _sendMappings.GetId(message),
+                offset = offset,
+                length = (int)queue.data.Length - offset
+            });
+        }
+
+        private MessageQueue SelectNextQueue()
+        {
+            foreach (var queue in _queues)
+            {
+                if (!queue.IsEmpty)
+                {
+                    return queue;
+                }
+            }
+
+            return null;
+        }
+
+        private void UpdateBudget(double currentTime, int maxPacketSize)
+        {
+            if (Rate > 0)
+            {
+                var elapsedTime = _lastBudgetUpdateTime >= 0 ? currentTime - _lastBudgetUpdateTime : MaxBurstTime;
+
+                _budget = Math.Min(_budget + (Rate * elapsedTime), Math.Max(maxPacketSize, Rate * MaxBurstTime));
+            }
+            else
+            {
+                _budget = double.PositiveInfinity;
+            }
+
+            _lastBudgetUpdateTime = currentTime;
+        }
+
+        /// <summary>
+        /// Returns whether the rate allows any data to be sent at the given time
+        /// </summary>
+        /// <param name="currentTime"></param>
+        public bool HasBudget(double currentTime)
+        {
+            if (Rate <= 0)
+            {
+                return true;
+            }
+
+            var elapsedTime = _lastBudgetUpdateTime >= 0 ? currentTime - _lastBudgetUpdateTime : MaxBurstTime;
+
+            return _budget + (Rate * elapsedTime) > 0;
+        }
+
+        /// <summary>
+        /// Gets the number of bytes that the rate allows to be sent at the given time
+        /// </summary>
+        /// <param name="currentTime"></param>
+        /// <param name="maxPacketSize"></param>
+        /// <returns>The number of bytes, or <see cref="int.MaxValue"/> if there is no limit</returns>
+        public int GetAvailableBudget(double currentTime, int maxPacketSize)
+        {
+            UpdateBudget(currentTime, maxPacketSize);
+
+            return (int)Math.Max(0, Math.Min(_budget, int.MaxValue));
+        }
+
+        /// <summary>
+        /// Accounts for data that is sent to the same remote host without going through the scheduler
+        /// </summary>
+        /// <param name="size">Size of the data, in bytes</param>
+        /// <param name="currentTime"></param>
+        /// <param name="maxPacketSize"></param>
+        public void ConsumeBudget(int size, double currentTime, int maxPacketSize)
+        {
+            UpdateBudget(currentTime, maxPacketSize);
+
+            _budget -= size;
+        }
+
+        /// <summary>
+        /// Sends as many pending messages as the rate allows
+        /// </summary>
+        /// <param name="peer"></param>
+        /// <param name="connection"></param>
+        /// <param name="currentTime"></param>
+        /// <param name="maxPacketSize">Maximum size of a single packet. Messages larger than this are sent by themselves</param>
+        public void Send(NetworkPeer peer, NetConnection connection, double currentTime, int maxPacketSize)
+        {
+            if (peer == null)
+            {
+                throw new ArgumentNullException(nameof(peer));
+            }
+
+            if (connection == null)
+            {
+                throw new ArgumentNullException(nameof(connection));
+            }
+
+            UpdateBudget(currentTime, maxPacketSize);
+
+            var packetSize = PacketHeaderSize;
+
+            //Messages are always sent if there is any budget left so messages larger than the budget still get sent eventually
+            MessageQueue queue;
+
+            while (_budget > 0 && (queue = SelectNextQueue()) != null)
+            {
+                var message = queue.Peek();
+
+                var size = message.length + CodedOutputStream.ComputeUInt32Size(message.id);
+
+                if (_packetEntries.Count > 0 && packetSize + size > maxPacketSize)
+                {
+                    SendPacket(peer, connection);
+                    packetSize = PacketHeaderSize;
+                }
+
+                _packetEntries.Add(new PacketEntry
+                {
+                    queue = queue,
+                    message = message
+                });
+
+                packetSize += size;
+                _budget -= size;
+
+                ++queue.head;
+            }
+
+            SendPacket(peer, connection);
+
+            foreach (var messageQueue in _queues)
+            {
+                messageQueue.Compact();
+            }
+        }
+
+        private void SendPacket(NetworkPeer peer, NetConnection connection)
+        {
+            if (_packetEntries.Count == 0)
+            {
+                return;
+            }
+
+            foreach (var entry in _packetEntries)
+            {
+                _list.MessageIds.Add(entry.message.id);
+            }
+
+            var packet = peer.CreatePacket();
+
+            using (var stream = new NetBufferStream(packet))
+            {
+                _list.WriteDelimitedTo(stream);
+
+                foreach (var entry in _packetEntries)
+                {
+                    stream.Write(entry.queue.data.GetBuffer(), entry.message.offset, entry.message.length);
+                }
+            }
+
+            peer.SendPacket(packet, connection, NetDeliveryMethod.ReliableOrdered);
+
+            _list.MessageIds.Clear();
+            _packetEntries.Clear();
+        }
+
+        /// <summary>
+        /// Clears all pending messages
+        /// </summary>
+        public void Clear()
+        {
+            foreach (var queue in _queues)
+            {
+                queue.messages.Clear();
+                queue.data.SetLength(0);
+                queue.head = 0;
+            }
+        }
+    }
+}
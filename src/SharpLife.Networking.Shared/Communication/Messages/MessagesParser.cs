@@ -0,0 +1,142 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using Google.Protobuf;
+using Google.Protobuf.Reflection;
+using SharpLife.Networking.Shared.Messages;
+using System;
+using System.Collections.Generic;
+using System.IO;
+
+namespace SharpLife.Networking.Shared.Communication.Messages
+{
+    /// <summary>
+    /// Parses packets containing a list of message ids followed by length delimited messages
+    /// Messages are parsed directly from the packet's buffer, without wrapping it in a stream
+    /// </summary>
+    public static class MessagesParser
+    {
+        /// <summary>
+        /// Maximum number of bytes in a 32 bit varint
+        /// </summary>
+        private const int MaxVarint32Size = 5;
+
+        /// <summary>
+        /// Reads the length prefix of a delimited message
+        /// </summary>
+        /// <param name="data"></param>
+        /// <param name="position">Position of the prefix. Receives the position of the message</param>
+        /// <param name="end">End of the data that can be read</param>
+        /// <exception cref="InvalidDataException">If the length is malformed or the message extends past the end of the data</exception>
+        private static int ReadLength(byte[] data, ref int position, int end)
+        {
+            uint length = 0;
+
+            for (var i = 0; i < MaxVarint32Size; ++i)
+            {
+                if (position >= end)
+                {
+                    throw new InvalidDataException("Message length is truncated");
+                }
+
+                var value = data[position++];
+
+                length |= (uint)(value & 0x7F) << (7 * i);
+
+                if ((value & 0x80) == 0)
+                {
+                    if (length > (uint)(end - position))
+                    {
+                        throw new InvalidDataException($"Message length {length} is larger than the remaining {end - position} bytes");
+                    }
+
+                    return (int)length;
+                }
+            }
+
+            throw new InvalidDataException("Message length is malformed");
+        }
+
+        private static IMessage ReadMessage(MessageParser parser, byte[] data, ref int position, int end)
+        {
+            var length = ReadLength(data, ref position, end);
+
+            //The stream reads from the array without copying it
+            var message = parser.ParseFrom(new CodedInputStream(data, position, length));
+
+            position += length;
+
+            return message;
+        }
+
+        /// <summary>
+        /// Reads messages from a buffer in the order that they are encountered
+        /// </summary>
+        /// <param name="data"></param>
+        /// <param name="offset">Offset of the list of message ids</param>
+        /// <param name="length">Number of bytes that can be read</param>
+        /// <param name="messageDescriptors">Descriptors of the messages that can be received, indexed by message id</param>
+        /// <param name="messages">List to add the messages to</param>
+        /// <returns>Number of bytes that were read</returns>
+        /// <exception cref="InvalidDataException">If the data is malformed</exception>
+        /// <exception cref="InvalidProtocolBufferException">If a message is malformed</exception>
+        public static int ParseMessages(byte[] data, int offset, int length, IReadOnlyList<MessageDescriptor> messageDescriptors, List<IMessage> messages)
+        {
+            if (data == null)
+            {
+                throw new ArgumentNullException(nameof(data));
+            }
+
+            if (offset < 0 || offset > data.Length)
+            {
+                throw new ArgumentOutOfRangeException(nameof(offset));
+            }
+
+            if (length < 0 || length > data.Length - offset)
+            {
+                throw new ArgumentOutOfRangeException(nameof(length));
+            }
+
+            if (messageDescriptors == null)
+            {
+                throw new ArgumentNullException(nameof(messageDescriptors));
+            }
+
+            if (messages == null)
+            {
+                throw new ArgumentNullException(nameof(messages));
+            }
+
+            var position = offset;
+            var end = offset + length;
+
+            var list = (MessagesList)ReadMessage(MessagesList.Parser, data, ref position, end);
+
+            for (var i = 0; i < list.MessageIds.Count; ++i)
+            {
+                var messageId = list.MessageIds[i];
+
+                if (messageId >= messageDescriptors.Count)
+                {
+                    throw new InvalidDataException($"Message id {messageId} is invalid");
+                }
+
+                messages.Add(ReadMessage(messageDescriptors[(int)messageId].Parser, data, ref position, end));
+            }
+
+            return position - offset;
+        }
+    }
+}
@@ -17,9 +17,9 @@ using Google.Protobuf;
 using Google.Protobuf.Reflection;
 using Lidgren.Network;
 using Serilog;
-using SharpLife.Networking.Shared.Messages;
 using System;
 using System.Collections.Generic;
+using System.Diagnostics;
 using System.Linq;
 
 namespace SharpLife.Networking.Shared.Communication.Messages
@@ -30,22 +30,54 @@ namespace SharpLife.Networking.Shared.Communication.Messages
     /// </summary>
     public sealed class MessagesReceiveHandler
     {
-        private delegate void Handler(NetConnection connection, IMessage message);
+        /// <summary>
+        /// Passes messages to a handler as their actual type
+        /// </summary>
+        private abstract class MessageInvoker
+        {
+            public abstract void Invoke(NetConnection connection, IMessage message);
+        }
+
+        private sealed class MessageInvoker<TMessage> : MessageInvoker
+            where TMessage : class, IMessage
+        {
+            private readonly IMessageReceiveHandler<TMessage> _handler;
+
+            public MessageInvoker(IMessageReceiveHandler<TMessage> handler)
+            {
+                _handler = handler;
+            }
+
+            public override void Invoke(NetConnection connection, IMessage message)
+            {
+                _handler.ReceiveMessage(connection, (TMessage)message);
+            }
+        }
+
+        private sealed class DefaultMessageInvoker : MessageInvoker
+        {
+            public static readonly DefaultMessageInvoker Instance = new DefaultMessageInvoker();
 
+            public override void Invoke(NetConnection connection, IMessage message)
+            {
 #pragma warning disable RCS1079 // Throwing of new NotImplementedException.
-        private static readonly Handler DefaultHandler = (_, message) => throw new NotImplementedException($"The handler for {message.GetType().FullName} has not been registered");
+                throw new NotImplementedException($"The handler for {message.GetType().FullName} has not been registered");
 #pragma warning restore RCS1079 // Throwing of new NotImplementedException.
+            }
+        }
 
         private sealed class MessageHandlerData
         {
-            public Handler Handler = DefaultHandler;
+            public MessageInvoker Invoker = DefaultMessageInvoker.Instance;
 
             public MessageDescriptor MessageDescriptor;
         }
 
         private readonly ILogger _logger;
 
-        private readonly IReadOnlyList<MessageHandlerData> _messageHandlers;
+        private readonly IReadOnlyList<MessageDescriptor> _messageDescriptors;
+
+        private readonly Dictionary<Type, MessageHandlerData> _typeToHandlerData;
 
         //TODO: make this atomic if accessed from another thread
         public bool TraceMessageLogging { get; set; }
@@ -60,27 +92,20 @@ namespace SharpLife.Networking.Shared.Communication.Messages
         {
             _logger = logger ?? throw new ArgumentNullException(nameof(logger));
 
-            if (messageDescriptors == null)
-            {
-                throw new ArgumentNullException(nameof(messageDescriptors));
-            }
+            _messageDescriptors = messageDescriptors ?? throw new ArgumentNullException(nameof(messageDescriptors));
 
-            _messageHandlers = messageDescriptors.Select(messageDescriptor => new MessageHandlerData { MessageDescriptor = messageDescriptor }).ToList();
+            _typeToHandlerData = messageDescriptors.ToDictionary(
+                messageDescriptor => messageDescriptor.ClrType,
+                messageDescriptor => new MessageHandlerData { MessageDescriptor = messageDescriptor });
 
             TraceMessageLogging = traceMessageLogging;
         }
 
         private MessageHandlerData FindMessageData(Type type)
         {
-            foreach (var messageHandlerData in _messageHandlers)
-            {
-                if (messageHandlerData.MessageDescriptor.ClrType == type)
-                {
-                    return messageHandlerData;
-                }
-            }
+            _typeToHandlerData.TryGetValue(type, out var messageHandlerData);
 
-            return null;
+            return messageHandlerData;
         }
 
         /// <summary>
@@ -106,71 +131,86 @@ namespace SharpLife.Networking.Shared.Communication.Messages
                 throw new InvalidOperationException($"Message type {type.FullName} has not been registered in the messages receive handler and handlers cannot be registered for it");
             }
 
-            if (data.Handler != DefaultHandler)
+            if (data.Invoker != DefaultMessageInvoker.Instance)
             {
                 throw new InvalidOperationException($"Message type {type.FullName} already has a handler registered for it");
             }
 
-            data.Handler = (connection, message) => handler.ReceiveMessage(connection, message as TMessage);
+            data.Invoker = new MessageInvoker<TMessage>(handler);
         }
 
-        private MessageHandlerData LookupMessageHandlerData(uint messageId)
+        /// <summary>
+        /// Reads messages from the packet in the order that they are encountered
+        /// This does not dispatch the messages, so it can be called from the network thread
+        /// Messages are parsed directly from the packet's buffer
+        /// </summary>
+        /// <param name="packet"></param>
+        /// <param name="messages">List to add the messages to</param>
+        public void ParseMessages(NetIncomingMessage packet, List<IMessage> messages)
         {
-            if (messageId >= _messageHandlers.Count)
+            if (packet == null)
             {
-                throw new ArgumentOutOfRangeException(nameof(messageId), $"Message id {messageId} is invalid");
+                throw new ArgumentNullException(nameof(packet));
             }
 
-            return _messageHandlers[(int)messageId];
-        }
+            if (messages == null)
+            {
+                throw new ArgumentNullException(nameof(messages));
+            }
 
-        private IMessage ReadDelimitedMessage(NetBufferStream stream, MessageDescriptor messageDescriptor)
-        {
-            //Deserialize the Protobuf message
-            return messageDescriptor.Parser.ParseDelimitedFrom(stream);
-        }
+            //Packets are written using whole bytes, so the position is always aligned
+            Debug.Assert(packet.Position % 8 == 0);
 
-        private MessagesList ReadMessagesList(NetBufferStream stream)
-        {
-            return MessagesList.Parser.ParseDelimitedFrom(stream);
+            var offset = packet.PositionInBytes;
+
+            var bytesRead = MessagesParser.ParseMessages(packet.Data, offset, packet.LengthBytes - offset, _messageDescriptors, messages);
+
+            packet.Position += bytesRead * 8L;
         }
 
         /// <summary>
-        /// Reads messages from the stream and dispatches them to their registered handlers in the order that they are encountered
+        /// Dispatches messages to their registered handlers in order
         /// </summary>
-        /// <param name="sender"></param>
-        /// <param name="message"></param>
-        public void ReadMessages(NetConnection sender, NetIncomingMessage message)
+        /// <param name="sender">Connection the messages were received on. Null for messages played back from a demo</param>
+        /// <param name="messages"></param>
+        public void DispatchMessages(NetConnection sender, IReadOnlyList<IMessage> messages)
         {
-            //Sender is passed separately into this method because remote hails don't have a sender
-            if (sender == null)
+            if (messages == null)
             {
-                throw new ArgumentNullException(nameof(sender));
+                throw new ArgumentNullException(nameof(messages));
             }
 
-            if (message == null)
+            for (var i = 0; i < messages.Count; ++i)
             {
-                throw new ArgumentNullException(nameof(message));
+                DispatchMessage(sender, messages[i]);
             }
+        }
 
-            using (var stream = new NetBufferStream(message))
+        /// <summary>
+        /// Dispatches a message to its registered handler
+        /// </summary>
+        /// <param name="sender">Connection the message was received on. Null for messages played back from a demo</param>
+        /// <param name="message"></param>
+        public void DispatchMessage(NetConnection sender, IMessage message)
+        {
+            if (message == null)
             {
-                var list = ReadMessagesList(stream);
-
-                for (var i = 0; i < list.MessageIds.Count; ++i)
-                {
-                    var data = LookupMessageHandlerData(list.MessageIds[i]);
+                throw new ArgumentNullException(nameof(message));
+            }
 
-                    var protobufMessage = ReadDelimitedMessage(stream, data.MessageDescriptor);
+            var data = FindMessageData(message.GetType());
 
-                    if (TraceMessageLogging)
-                    {
-                        _logger.Verbose($"Received message {protobufMessage.GetType().Name} from {sender.RemoteEndPoint}");
-                    }
+            if (data == null)
+            {
+                throw new InvalidOperationException($"Message type {message.GetType().FullName} has not been registered in the messages receive handler");
+            }
 
-                    data.Handler(sender, protobufMessage);
-                }
+            if (TraceMessageLogging)
+            {
+                _logger.Verbose($"Received message {message.GetType().Name} from {sender?.RemoteEndPoint.ToString() ?? "demo"}");
             }
+
+            data.Invoker.Invoke(sender, message);
         }
     }
 }
@@ -15,10 +15,10 @@
 
 using Google.Protobuf;
 using SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData;
+using SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData.Conversion;
 using SharpLife.Networking.Shared.Messages.NetworkObjectLists;
 using System;
 using System.Collections.Generic;
-using System.IO;
 using System.Linq;
 
 namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.Frames
@@ -32,6 +32,8 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.Frames
 
         private readonly List<ObjectUpdate> _updates = new List<ObjectUpdate>();
 
+        private readonly Dictionary<int, ObjectUpdate> _updatesById = new Dictionary<int, ObjectUpdate>();
+
         public int ListId { get; }
 
         public IReadOnlyList<ObjectDestruction> DestroyedObjects => _destroyedObjects;
@@ -51,20 +53,18 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.Frames
 
         public ObjectUpdate FindUpdateByObjectId(int id)
         {
-            foreach (var update in _updates)
-            {
-                if (update.ObjectHandle.Id == id)
-                {
-                    return update;
-                }
-            }
+            _updatesById.TryGetValue(id, out var update);
 
-            return null;
+            return update;
         }
 
-        public void CreateObjectDestruction(int id)
+        public void CreateObjectDestruction(in ObjectHandle handle)
         {
-            _destroyedObjects.Add(new ObjectDestruction { ObjectId = (uint)id });
+            _destroyedObjects.Add(new ObjectDestruction
+            {
+                ObjectId = (uint)handle.Id,
+                SerialNumber = handle.SerialNumber
+            });
         }
 
         public void CreateUpdate(NetworkObject networkObject, Frame previousFrame)
@@ -76,97 +76,81 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.Frames
 
             var previousUpdate = previousFrame?.FindUpdateByObjectId(networkObject.Handle.Id);
 
-            _updates.Add(new ObjectUpdate(networkObject.Handle, networkObject.MetaData, networkObject.TakeSnapshot(previousUpdate?.Snapshot)));
+            AddUpdate(new ObjectUpdate(networkObject.Handle, networkObject.MetaData, networkObject.TakeSnapshot(previousUpdate?.Snapshot)));
         }
 
-        private void DeserializeUpdate(ByteString data, TypeRegistry typeRegistry, Frame previousFrame)
+        /// <summary>
+        /// Adds an existing update, which may be shared with other frames
+        /// </summary>
+        /// <param name="update"></param>
+        public void AddUpdate(ObjectUpdate update)
         {
-            using (var codedStream = new CodedInputStream(data.ToByteArray()))
+            if (update == null)
             {
-                var objectId = ObjectUpdate.DeserializeObjectId(codedStream);
-                var serialNumber = ObjectUpdate.DeserializeSerialNumber(codedStream);
-                var typeId = ObjectUpdate.DeserializeTypeId(codedStream);
-
-                var metaData = typeRegistry.FindMetaDataByTransmitterId(typeId);
-
-                var previousUpdate = previousFrame?.FindUpdateByObjectId(objectId);
-
-                var update = ObjectUpdate.DeserializeFromStream(codedStream, new ObjectHandle(objectId, serialNumber), metaData, previousUpdate);
-
-                _updates.Add(update);
+                throw new ArgumentNullException(nameof(update));
             }
+
+            _updates.Add(update);
+            _updatesById[update.ObjectHandle.Id] = update;
         }
 
-        public FrameMessage Serialize(NetworkObjectList objectList, Frame previousFrame)
+        public FrameMessage Serialize(NetworkObjectList objectList, Frame previousFrame, FrameSerializer serializer)
         {
-            var updateList = new List<MemoryStream>();
-
-            foreach (var update in _updates)
-            {
-                var data = update.Serialize(objectList.InternalGetNetworkObjectById(update.ObjectHandle.Id), previousFrame?.FindUpdateByObjectId(update.ObjectHandle.Id));
-
-                //TODO: figure out if there's a better way to handle change detection during serialization
-                //if (data.ContainsChanges)
-                {
-                    data.Memory.Position = 0;
-                    updateList.Add(data.Memory);
-                }
-            }
-
-            var stream = new MemoryStream();
-
-            using (var codedStream = new CodedOutputStream(stream, true))
-            {
-                codedStream.WriteInt32(updateList.Count);
-
-                foreach (var update in updateList)
-                {
-                    codedStream.WriteBytes(ByteString.FromStream(update));
-                    update.Dispose();
-                }
-            }
-
-            stream.Position = 0;
-
             var frameMessage = new FrameMessage
             {
                 ListId = (uint)ListId,
 
-                ObjectUpdates = ByteString.FromStream(stream)
+                ObjectUpdates = serializer.SerializeUpdates(this, objectList, previousFrame)
             };
 
-            stream.Dispose();
-
             frameMessage.ObjectsDestroyed.AddRange(_destroyedObjects);
 
             return frameMessage;
         }
 
+        private void DeserializeUpdate(CodedInputStream codedStream, TypeRegistry typeRegistry, Frame previousFrame, BitReader bits)
+        {
+            var objectId = ObjectUpdate.DeserializeObjectId(codedStream);
+            var serialNumber = ObjectUpdate.DeserializeSerialNumber(codedStream);
+            var typeId = ObjectUpdate.DeserializeTypeId(codedStream);
+
+            var metaData = typeRegistry.FindMetaDataByTransmitterId(typeId);
+
+            var previousUpdate = previousFrame?.FindUpdateByObjectId(objectId);
+
+            var update = ObjectUpdate.DeserializeFromStream(codedStream, new ObjectHandle(objectId, serialNumber), metaData, previousUpdate, bits);
+
+            AddUpdate(update);
+        }
+
         public static Frame Deserialize(FrameMessage frameMessage, TypeRegistry typeRegistry, Frame previousFrame)
         {
             var frame = new Frame(
                 (int)frameMessage.ListId,
                 frameMessage.ObjectsDestroyed.ToList());
 
-            using (var stream = new MemoryStream())
+            using (var codedStream = frameMessage.ObjectUpdates.CreateCodedInput())
             {
-                frameMessage.ObjectUpdates.WriteTo(stream);
+                var updateCount = codedStream.ReadInt32();
 
-                stream.Position = 0;
+                var bits = new BitReader();
 
-                using (var codedStream = new CodedInputStream(stream))
+                for (var i = 0; i < updateCount; ++i)
                 {
-                    var updateCount = codedStream.ReadInt32();
+                    //Updates are read in place instead of being copied out first
+                    var length = codedStream.ReadLength();
 
-                    for (var i = 0; i < updateCount; ++i)
-                    {
-                        var update = codedStream.ReadBytes();
+                    var end = codedStream.Position + length;
 
-                        frame.DeserializeUpdate(update, typeRegistry, previousFrame);
-                    }
+                    frame.DeserializeUpdate(codedStream, typeRegistry, previousFrame, bits);
 
-                    return frame;
+                    if (codedStream.Position != end)
+                    {
+                        throw new InvalidOperationException($"Object update in frame for list {frame.ListId} has the wrong size (expected {length} bytes, read {length - (end - codedStream.Position)})");
+                    }
                 }
+
+                return frame;
             }
         }
     }
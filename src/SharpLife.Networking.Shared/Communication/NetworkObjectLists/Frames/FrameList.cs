@@ -28,6 +28,48 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.Frames
 
         public IReadOnlyList<Frame> Frames => _frames;
 
+        /// <summary>
+        /// If not null, the shared snapshots that the updates in this list's frames come from
+        /// </summary>
+        public SnapshotHistoryEntry Snapshots { get; private set; }
+
+        /// <summary>
+        /// Server time when the frames were created
+        /// Only set for received frame lists
+        /// </summary>
+        public double ServerTime { get; private set; }
+
+        /// <summary>
+        /// Identifies this list so the receiver can acknowledge it and later lists can be delta encoded against it
+        /// </summary>
+        public uint Sequence { get; internal set; }
+
+        public FrameList()
+        {
+        }
+
+        /// <summary>
+        /// Creates a frame list that references the given snapshots until it is released
+        /// </summary>
+        /// <param name="snapshots"></param>
+        public FrameList(SnapshotHistoryEntry snapshots)
+        {
+            Snapshots = snapshots ?? throw new ArgumentNullException(nameof(snapshots));
+
+            Snapshots.AddReference();
+        }
+
+        /// <summary>
+        /// Releases the shared snapshots referenced by this list
+        /// The list can no longer be serialized after this
+        /// </summary>
+        public void Release()
+        {
+            Snapshots?.Release();
+            Snapshots = null;
+            _frames.Clear();
+        }
+
         public Frame FindFrameByListId(int listId)
         {
             return _frames.Find(frame => frame.ListId == listId);
@@ -42,10 +84,15 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.Frames
         /// Serializes all frames to a message
         /// </summary>
         /// <param name="objectListManager"></param>
-        /// <param name="previousFrames"></param>
-        public NetworkObjectListFrameListUpdate SerializeFrames(BaseNetworkObjectListManager objectListManager, FrameList previousFrames)
+        /// <param name="previousFrames">If not null, the list to delta encode against</param>
+        /// <param name="serializer"></param>
+        public NetworkObjectListFrameListUpdate SerializeFrames(BaseNetworkObjectListManager objectListManager, FrameList previousFrames, FrameSerializer serializer)
         {
-            var frameListMessage = new NetworkObjectListFrameListUpdate();
+            var frameListMessage = new NetworkObjectListFrameListUpdate
+            {
+                Sequence = Sequence,
+                BaselineSequence = previousFrames?.Sequence ?? 0
+            };
 
             foreach (var frame in _frames)
             {
@@ -53,7 +100,7 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.Frames
 
                 var previousFrame = previousFrames?.FindFrameByListId(frame.ListId);
 
-                var result = frame.Serialize(objectList, previousFrame);
+                var result = frame.Serialize(objectList, previousFrame, serializer);
 
                 //TODO: check if anything was written to allow discarding of empty frames
 
@@ -65,7 +112,11 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.Frames
 
         public static FrameList DeserializeFrameList(BaseNetworkObjectListManager listManager, FrameList previousFrames, NetworkObjectListFrameListUpdate frameListMessage)
         {
-            var frameList = new FrameList();
+            var frameList = new FrameList
+            {
+                ServerTime = frameListMessage.ServerTime,
+                Sequence = frameListMessage.Sequence
+            };
 
             foreach (var frameMessage in frameListMessage.Frames)
             {
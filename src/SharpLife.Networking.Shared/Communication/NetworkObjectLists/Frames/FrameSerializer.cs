@@ -0,0 +1,112 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using Google.Protobuf;
+using SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData.Conversion;
+using System;
+using System.IO;
+
+namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.Frames
+{
+    /// <summary>
+    /// Serializes frame updates using buffers that are reused for every frame
+    /// This avoids creating streams for every object update
+    /// </summary>
+    internal sealed class FrameSerializer
+    {
+        private readonly MemoryStream _updateData = new MemoryStream();
+
+        private readonly CodedOutputStream _updateStream;
+
+        private readonly MemoryStream _frameData = new MemoryStream();
+
+        private readonly CodedOutputStream _frameStream;
+
+        private readonly BitWriter _bits = new BitWriter();
+
+        private bool[] _changedMembers = new bool[64];
+
+        public FrameSerializer()
+        {
+            _updateStream = new CodedOutputStream(_updateData, true);
+            _frameStream = new CodedOutputStream(_frameData, true);
+        }
+
+        /// <summary>
+        /// Serializes all updates in a frame
+        /// Each update is prefixed with its length
+        /// </summary>
+        /// <param name="frame"></param>
+        /// <param name="objectList"></param>
+        /// <param name="previousFrame"></param>
+        /// <returns></returns>
+        public ByteString SerializeUpdates(Frame frame, NetworkObjectList objectList, Frame previousFrame)
+        {
+            if (frame == null)
+            {
+                throw new ArgumentNullException(nameof(frame));
+            }
+
+            if (objectList == null)
+            {
+                throw new ArgumentNullException(nameof(objectList));
+            }
+
+            _frameData.SetLength(0);
+
+            //TODO: figure out if there's a better way to handle change detection during serialization
+            _frameStream.WriteInt32(frame.Updates.Count);
+
+            foreach (var update in frame.Updates)
+            {
+                _updateData.SetLength(0);
+
+                var previousUpdate = previousFrame?.FindUpdateByObjectId(update.ObjectHandle.Id);
+
+                //The id may have been reused by another object since the previous frame
+                if (previousUpdate != null && previousUpdate.ObjectHandle != update.ObjectHandle)
+                {
+                    previousUpdate = null;
+                }
+
+                if (_changedMembers.Length < update.MetaData.Members.Count)
+                {
+                    Array.Resize(ref _changedMembers, update.MetaData.Members.Count);
+                }
+
+                //Replayed frames have no objects associated with them
+                update.Serialize(
+                    objectList.InternalGetNetworkObjectById(update.ObjectHandle.Id)?.ChangeNotifications,
+                    previousUpdate,
+                    _updateStream,
+                    _bits,
+                    _changedMembers);
+
+                _updateStream.Flush();
+
+                _frameStream.WriteLength((int)_updateData.Length);
+
+                //The update data is appended to the frame data directly, so anything still buffered has to be written first
+                _frameStream.Flush();
+
+                _frameData.Write(_updateData.GetBuffer(), 0, (int)_updateData.Length);
+            }
+
+            _frameStream.Flush();
+
+            return ByteString.CopyFrom(_frameData.GetBuffer(), 0, (int)_frameData.Length);
+        }
+    }
+}
@@ -17,7 +17,6 @@ using Google.Protobuf;
 using SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData;
 using SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData.Conversion;
 using System;
-using System.IO;
 
 namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.Frames
 {
@@ -27,96 +26,118 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.Frames
 
         public TypeMetaData MetaData { get; }
 
-        public MemberSnapshot[] Snapshot { get; }
+        public ObjectSnapshot Snapshot { get; }
 
-        public ObjectUpdate(in ObjectHandle objectHandle, TypeMetaData metaData, MemberSnapshot[] snapshot)
+        /// <summary>
+        /// Whether this update was received as a delta
+        /// Members that didn't change were copied from the previous update, and are not marked as changed
+        /// </summary>
+        public bool IsDelta { get; }
+
+        public ObjectUpdate(in ObjectHandle objectHandle, TypeMetaData metaData, ObjectSnapshot snapshot, bool isDelta = false)
         {
             ObjectHandle = objectHandle;
             MetaData = metaData ?? throw new ArgumentNullException(nameof(metaData));
             Snapshot = snapshot ?? throw new ArgumentNullException(nameof(snapshot));
+            IsDelta = isDelta;
         }
 
-        internal ObjectUpdateResult Serialize(NetworkObject networkObject, ObjectUpdate previousUpdate)
+        /// <summary>
+        /// Serializes this update to the given stream
+        /// Updates start with a bitmask of changed members, followed by the bit packed values of changed blittable members
+        /// Changed members that can't be bit packed are written using their converter afterwards
+        /// </summary>
+        /// <param name="changeNotifications">Change notifications of the object being serialized, consumed by this call
+        /// If null, changes are detected by comparing against the previous update only</param>
+        /// <param name="previousUpdate">If not null, the update is delta encoded against this update</param>
+        /// <param name="stream"></param>
+        /// <param name="bits">Writer for the bit packed block</param>
+        /// <param name="changedMembers">Scratch space for changed member flags, must have room for all members</param>
+        /// <returns>Whether any members were written</returns>
+        internal bool Serialize(bool[] changeNotifications, ObjectUpdate previousUpdate, CodedOutputStream stream, BitWriter bits, bool[] changedMembers)
         {
-            if (networkObject == null)
+            if (stream == null)
             {
-                throw new ArgumentNullException(nameof(networkObject));
+                throw new ArgumentNullException(nameof(stream));
             }
 
-            var previousSnapshot = previousUpdate?.Snapshot;
-
-            var memory = new MemoryStream();
-            var stream = new CodedOutputStream(memory, true);
+            if (bits == null)
+            {
+                throw new ArgumentNullException(nameof(bits));
+            }
 
-            var data = new ObjectUpdateResult
+            if (changedMembers == null)
             {
-                Memory = memory,
-                IsDelta = previousSnapshot != null
-            };
+                throw new ArgumentNullException(nameof(changedMembers));
+            }
+
+            var previousSnapshot = previousUpdate?.Snapshot;
+
+            var isDelta = previousSnapshot != null;
 
             stream.WriteInt32(ObjectHandle.Id);
             stream.WriteInt32(ObjectHandle.SerialNumber);
             stream.WriteUInt32(MetaData.Id);
 
-            stream.WriteBool(data.IsDelta);
-
-            //TODO: if nothing has to be networked, don't network the updates (still need create & destroy)
-            if (data.IsDelta)
-            {
-                data.ContainsChanges = SerializeDelta(networkObject, previousSnapshot, stream);
-            }
-            else
-            {
-                data.ContainsChanges = SerializeFull(stream);
-            }
-
-            stream.Dispose();
+            stream.WriteBool(isDelta);
 
-            return data;
-        }
+            bits.Reset();
 
-        private bool SerializeDelta(NetworkObject networkObject, MemberSnapshot[] previousSnapshot, CodedOutputStream stream)
-        {
             var changes = false;
 
+            //TODO: if nothing has to be networked, don't network the updates (still need create & destroy)
             for (var i = 0; i < MetaData.Members.Count; ++i)
             {
                 var member = MetaData.Members[i];
 
-                if (member.ChangeNotificationIndex.HasValue ? networkObject.ChangeNotifications[member.ChangeNotificationIndex.Value] : member.Converter.Changed(Snapshot[i].Value, previousSnapshot[i].Value))
+                var changed = true;
+
+                if (isDelta)
                 {
-                    if (member.ChangeNotificationIndex.HasValue)
+                    if (member.ChangeNotificationIndex.HasValue && changeNotifications != null)
+                    {
+                        //Notifications only cover changes since the last transmitted frame, which may not be the frame this update is delta encoded against
+                        changed = changeNotifications[member.ChangeNotificationIndex.Value]
+                            || Snapshot.ValueChanged(member, i, previousSnapshot);
+                        changeNotifications[member.ChangeNotificationIndex.Value] = false;
+                    }
+                    else
                     {
-                        networkObject.ChangeNotifications[member.ChangeNotificationIndex.Value] = false;
+                        changed = Snapshot.ValueChanged(member, i, previousSnapshot);
                     }
+                }
 
-                    member.Converter.Write(Snapshot[i].Value, previousSnapshot[i].Value, member.ConverterOptions, stream);
+                changedMembers[i] = changed;
+                changes = changes || changed;
 
-                    changes = true;
-                }
-                else
+                bits.WriteBool(changed);
+            }
+
+            for (var i = 0; i < MetaData.Members.Count; ++i)
+            {
+                var member = MetaData.Members[i];
+
+                if (changedMembers[i] && member.BitPackedConverter != null)
                 {
-                    //Write unchanged values for each member
-                    for (var unchanged = 0; unchanged < member.Converter.MemberCount; ++unchanged)
-                    {
-                        ConversionUtils.AddUnchangedValue(stream);
-                    }
+                    member.BitPackedConverter.WriteBits(Snapshot.Data, member.DataOffset, member.ConverterOptions, bits);
                 }
             }
 
-            return changes;
-        }
+            bits.WriteTo(stream);
 
-        private bool SerializeFull(CodedOutputStream stream)
-        {
             for (var i = 0; i < MetaData.Members.Count; ++i)
             {
                 var member = MetaData.Members[i];
 
-                member.Converter.Write(Snapshot[i].Value, member.Converter.Default, member.ConverterOptions, stream);
+                if (changedMembers[i] && member.BitPackedConverter == null)
+                {
+                    var previousValue = isDelta ? previousSnapshot.GetValue(member, i) : member.Converter.Default;
+
+                    member.Converter.Write(Snapshot.GetValue(member, i), previousValue, member.ConverterOptions, stream);
+                }
             }
 
-            return true;
+            return changes;
         }
 
         internal static int DeserializeObjectId(CodedInputStream stream)
@@ -134,54 +155,74 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.Frames
             return stream.ReadUInt32();
         }
 
-        internal static ObjectUpdate DeserializeFromStream(CodedInputStream stream, in ObjectHandle objectHandle, TypeMetaData metaData, ObjectUpdate previousUpdate)
+        internal static ObjectUpdate DeserializeFromStream(CodedInputStream stream, in ObjectHandle objectHandle, TypeMetaData metaData, ObjectUpdate previousUpdate, BitReader bits)
         {
             var snapshot = metaData.AllocateSnapshot();
 
             //Is it a delta?
-            if (stream.ReadBool())
+            var isDelta = stream.ReadBool();
+
+            //previousUpdate can be non-null for full updates, its contents will not be used
+            var previousSnapshot = isDelta ? previousUpdate?.Snapshot : null;
+
+            if (isDelta && previousSnapshot == null)
             {
-                if (previousUpdate == null)
-                {
-                    throw new InvalidOperationException($"Object with handle {objectHandle} ({metaData.Type.FullName}) received delta update, but no previous update to delta from");
-                }
+                throw new InvalidOperationException($"Object with handle {objectHandle} ({metaData.Type.FullName}) received delta update, but no previous update to delta from");
+            }
 
-                var previousSnapshot = previousUpdate.Snapshot;
+            bits.ReadFrom(stream);
 
-                for (var i = 0; i < metaData.Members.Count; ++i)
-                {
-                    var member = metaData.Members[i];
+            for (var i = 0; i < metaData.Members.Count; ++i)
+            {
+                snapshot.Members[i].Changed = bits.ReadBool();
+            }
 
-                    if (member.Converter.Read(stream, previousSnapshot[i].Value, member.ConverterOptions, out var result))
+            for (var i = 0; i < metaData.Members.Count; ++i)
+            {
+                var member = metaData.Members[i];
+
+                if (member.BitPackedConverter != null)
+                {
+                    if (snapshot.Members[i].Changed)
                     {
-                        snapshot[i].Value = result;
-                        snapshot[i].Changed = true;
+                        member.BitPackedConverter.ReadBits(bits, member.ConverterOptions, snapshot.Data, member.DataOffset);
                     }
-                    else
+                    else if (previousSnapshot != null)
                     {
-                        snapshot[i].Value = previousSnapshot[i].Value;
-                        snapshot[i].Changed = false;
+                        snapshot.CopyValue(member, i, previousSnapshot);
                     }
                 }
             }
-            else
+
+            for (var i = 0; i < metaData.Members.Count; ++i)
             {
-                //previousUpdate can be non-null here, its contents will not be used
+                var member = metaData.Members[i];
 
-                for (var i = 0; i < metaData.Members.Count; ++i)
+                if (member.BitPackedConverter == null)
                 {
-                    var member = metaData.Members[i];
-
-                    //Full updates can contain deltas, in which case we can just use the default value provided by the Read method
-                    //So don't check the return value
-                    member.Converter.Read(stream, member.Converter.Default, member.ConverterOptions, out var result);
-
-                    snapshot[i].Value = result;
-                    snapshot[i].Changed = true;
+                    if (snapshot.Members[i].Changed)
+                    {
+                        var previousValue = isDelta ? previousSnapshot.GetValue(member, i) : member.Converter.Default;
+
+                        //Full updates can contain deltas, in which case we can just use the default value provided by the Read method
+                        if (member.Converter.Read(stream, previousValue, member.ConverterOptions, out var result) || !isDelta)
+                        {
+                            snapshot.SetValue(member, i, result);
+                        }
+                        else
+                        {
+                            snapshot.CopyValue(member, i, previousSnapshot);
+                            snapshot.Members[i].Changed = false;
+                        }
+                    }
+                    else if (previousSnapshot != null)
+                    {
+                        snapshot.CopyValue(member, i, previousSnapshot);
+                    }
                 }
             }
 
-            return new ObjectUpdate(objectHandle, metaData, snapshot);
+            return new ObjectUpdate(objectHandle, metaData, snapshot, isDelta);
         }
     }
 }
@@ -0,0 +1,116 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData;
+using System;
+using System.Collections.Generic;
+
+namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.Frames
+{
+    /// <summary>
+    /// Shared history of object snapshots, with one entry per transmitted frame
+    /// Each object is snapshotted at most once per entry, all transmitters share the resulting updates
+    /// Entries are reference counted and recycled once no frame lists refer to them anymore
+    /// </summary>
+    internal sealed class SnapshotHistory
+    {
+        private readonly Stack<SnapshotHistoryEntry> _freeEntries = new Stack<SnapshotHistoryEntry>();
+
+        private readonly Dictionary<TypeMetaData, Stack<ObjectSnapshot>> _freeSnapshots = new Dictionary<TypeMetaData, Stack<ObjectSnapshot>>();
+
+        /// <summary>
+        /// The entry that is being created, or the last entry if none is being created
+        /// </summary>
+        public SnapshotHistoryEntry Current { get; private set; }
+
+        /// <summary>
+        /// The entry created before the current entry
+        /// Used to determine which members changed, only valid while creating an entry
+        /// </summary>
+        public SnapshotHistoryEntry Previous { get; private set; }
+
+        /// <summary>
+        /// Number of entries that are referenced by frame lists or by this history
+        /// </summary>
+        public int LiveEntryCount { get; private set; }
+
+        /// <summary>
+        /// Begins a new entry
+        /// The history holds a reference to the new entry until the next one is created
+        /// </summary>
+        /// <param name="listCount"></param>
+        /// <returns></returns>
+        public SnapshotHistoryEntry BeginEntry(int listCount)
+        {
+            if (Previous != null)
+            {
+                throw new InvalidOperationException("Cannot begin a snapshot history entry while another entry is being created");
+            }
+
+            var entry = _freeEntries.Count > 0 ? _freeEntries.Pop() : new SnapshotHistoryEntry(this);
+
+            entry.Reset(listCount);
+
+            ++LiveEntryCount;
+
+            Previous = Current;
+            Current = entry;
+
+            return entry;
+        }
+
+        /// <summary>
+        /// Ends creation of the current entry
+        /// </summary>
+        public void EndEntry()
+        {
+            Previous?.Release();
+            Previous = null;
+        }
+
+        internal ObjectSnapshot AllocateSnapshot(TypeMetaData metaData)
+        {
+            if (_freeSnapshots.TryGetValue(metaData, out var snapshots) && snapshots.Count > 0)
+            {
+                return snapshots.Pop();
+            }
+
+            return metaData.AllocateSnapshot();
+        }
+
+        internal void Recycle(SnapshotHistoryEntry entry)
+        {
+            foreach (var update in entry.Updates)
+            {
+                //Don't keep values alive
+                update.Snapshot.Clear();
+
+                if (!_freeSnapshots.TryGetValue(update.MetaData, out var snapshots))
+                {
+                    snapshots = new Stack<ObjectSnapshot>();
+                    _freeSnapshots.Add(update.MetaData, snapshots);
+                }
+
+                snapshots.Push(update.Snapshot);
+            }
+
+            entry.Clear();
+
+            --LiveEntryCount;
+
+            _freeEntries.Push(entry);
+        }
+    }
+}
@@ -0,0 +1,142 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using System;
+using System.Collections.Generic;
+
+namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.Frames
+{
+    /// <summary>
+    /// The snapshots taken for a single frame, for all lists
+    /// </summary>
+    internal sealed class SnapshotHistoryEntry
+    {
+        private readonly SnapshotHistory _history;
+
+        private readonly List<Dictionary<int, ObjectUpdate>> _listUpdates = new List<Dictionary<int, ObjectUpdate>>();
+
+        private int _referenceCount;
+
+        public SnapshotHistoryEntry(SnapshotHistory history)
+        {
+            _history = history ?? throw new ArgumentNullException(nameof(history));
+        }
+
+        /// <summary>
+        /// Enumerates all updates in this entry
+        /// </summary>
+        public IEnumerable<ObjectUpdate> Updates
+        {
+            get
+            {
+                foreach (var updates in _listUpdates)
+                {
+                    foreach (var update in updates.Values)
+                    {
+                        yield return update;
+                    }
+                }
+            }
+        }
+
+        internal void Reset(int listCount)
+        {
+            while (_listUpdates.Count < listCount)
+            {
+                _listUpdates.Add(new Dictionary<int, ObjectUpdate>());
+            }
+
+            _referenceCount = 1;
+        }
+
+        internal void Clear()
+        {
+            foreach (var updates in _listUpdates)
+            {
+                updates.Clear();
+            }
+        }
+
+        public void AddReference()
+        {
+            if (_referenceCount <= 0)
+            {
+                throw new InvalidOperationException("Cannot reference a snapshot history entry that has been released");
+            }
+
+            ++_referenceCount;
+        }
+
+        public void Release()
+        {
+            if (_referenceCount <= 0)
+            {
+                throw new InvalidOperationException("Snapshot history entry has already been released");
+            }
+
+            if (--_referenceCount == 0)
+            {
+                _history.Recycle(this);
+            }
+        }
+
+        public ObjectUpdate FindUpdate(int listId, int objectId)
+        {
+            if (listId < _listUpdates.Count && _listUpdates[listId].TryGetValue(objectId, out var update))
+            {
+                return update;
+            }
+
+            return null;
+        }
+
+        /// <summary>
+        /// Gets the update for an object, snapshotting the object if this is the first time it is requested for this entry
+        /// </summary>
+        /// <param name="listId"></param>
+        /// <param name="networkObject"></param>
+        /// <returns></returns>
+        public ObjectUpdate GetOrCreateUpdate(int listId, NetworkObject networkObject)
+        {
+            if (networkObject == null)
+            {
+                throw new ArgumentNullException(nameof(networkObject));
+            }
+
+            var updates = _listUpdates[listId];
+
+            if (!updates.TryGetValue(networkObject.Handle.Id, out var update))
+            {
+                var previousUpdate = _history.Previous?.FindUpdate(listId, networkObject.Handle.Id);
+
+                //The id may have been reused by another object since the previous entry
+                if (previousUpdate != null && previousUpdate.ObjectHandle != networkObject.Handle)
+                {
+                    previousUpdate = null;
+                }
+
+                var snapshot = _history.AllocateSnapshot(networkObject.MetaData);
+
+                networkObject.TakeSnapshot(previousUpdate?.Snapshot, snapshot);
+
+                update = new ObjectUpdate(networkObject.Handle, networkObject.MetaData, snapshot);
+
+                updates.Add(networkObject.Handle.Id, update);
+            }
+
+            return update;
+        }
+    }
+}
@@ -22,6 +22,10 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists
     public struct MemberSnapshot
     {
         public bool Changed;
+
+        /// <summary>
+        /// The member value, unless the member is stored in <see cref="ObjectSnapshot.Data"/>
+        /// </summary>
         public object Value;
     }
 }
@@ -58,6 +58,13 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData.
 
         public bool ShouldPostMultiply => ShouldMultiplyWithMultiplier(PostMultiplier);
 
+        /// <summary>
+        /// Gets the number of bits to use for a value that has at most <paramref name="maximumBits"/> bits
+        /// </summary>
+        /// <param name="maximumBits"></param>
+        /// <returns><see cref="Bits"/> if specified and smaller than the maximum, the maximum otherwise</returns>
+        public int GetBitCount(int maximumBits) => Bits > 0 && Bits < maximumBits ? (int)Bits : maximumBits;
+
         public BitConverterOptions(
             uint bits,
             float multiplier = NoMultiplication,
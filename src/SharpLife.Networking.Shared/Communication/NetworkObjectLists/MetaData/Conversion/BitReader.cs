@@ -0,0 +1,155 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using Google.Protobuf;
+using System;
+
+namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData.Conversion
+{
+    /// <summary>
+    /// Reads values written by <see cref="BitWriter"/>
+    /// </summary>
+    public sealed class BitReader
+    {
+        /// <summary>
+        /// Upper limit on the number of bits in a single block, to avoid allocating huge buffers for invalid data
+        /// </summary>
+        public const int MaxBitCount = 1 << 20;
+
+        private uint[] _words = new uint[8];
+
+        private int _position;
+
+        /// <summary>
+        /// The number of bits that can be read
+        /// </summary>
+        public int BitCount { get; private set; }
+
+        /// <summary>
+        /// Reads a block of bits written by <see cref="BitWriter.WriteTo(CodedOutputStream)"/>
+        /// Any bits that have not been read yet are discarded
+        /// </summary>
+        /// <param name="stream"></param>
+        public void ReadFrom(CodedInputStream stream)
+        {
+            if (stream == null)
+            {
+                throw new ArgumentNullException(nameof(stream));
+            }
+
+            var bitCount = stream.ReadUInt32();
+
+            if (bitCount > MaxBitCount)
+            {
+                throw new InvalidOperationException($"Bit block is too large ({bitCount} bits, maximum {MaxBitCount})");
+            }
+
+            BitCount = (int)bitCount;
+            _position = 0;
+
+            var wordCount = (BitCount + 31) / 32;
+
+            if (wordCount > _words.Length)
+            {
+                Array.Resize(ref _words, Math.Max(wordCount, _words.Length * 2));
+            }
+
+            var fullWords = BitCount / 32;
+
+            for (var i = 0; i < fullWords; ++i)
+            {
+                _words[i] = stream.ReadFixed32();
+            }
+
+            if ((BitCount & 31) != 0)
+            {
+                _words[fullWords] = stream.ReadUInt32();
+            }
+        }
+
+        /// <summary>
+        /// Reads an unsigned value of <paramref name="bits"/> bits
+        /// </summary>
+        /// <param name="bits">Number of bits to read, between 0 and 64</param>
+        public ulong ReadBits(int bits)
+        {
+            if (bits < 0 || bits > 64)
+            {
+                throw new ArgumentOutOfRangeException(nameof(bits));
+            }
+
+            if (_position + bits > BitCount)
+            {
+                throw new InvalidOperationException($"Attempted to read past the end of the bit block ({bits} bits at {_position}, {BitCount} available)");
+            }
+
+            var result = 0UL;
+            var shift = 0;
+
+            while (bits > 0)
+            {
+                var bitIndex = _position & 31;
+                var count = Math.Min(32 - bitIndex, bits);
+
+                var chunk = (_words[_position >> 5] >> bitIndex) & (uint)((1UL << count) - 1);
+
+                result |= (ulong)chunk << shift;
+
+                shift += count;
+                bits -= count;
+                _position += count;
+            }
+
+            return result;
+        }
+
+        /// <summary>
+        /// Reads a signed two's complement value of <paramref name="bits"/> bits
+        /// </summary>
+        /// <param name="bits">Number of bits to read, between 1 and 64</param>
+        public long ReadSignedBits(int bits)
+        {
+            if (bits < 1)
+            {
+                throw new ArgumentOutOfRangeException(nameof(bits));
+            }
+
+            var value = ReadBits(bits);
+
+            //Sign extend
+            if (bits < 64 && (value & (1UL << (bits - 1))) != 0)
+            {
+                value |= ~0UL << bits;
+            }
+
+            return (long)value;
+        }
+
+        public bool ReadBool()
+        {
+            return ReadBits(1) != 0;
+        }
+
+        public float ReadSingle()
+        {
+            return BitConverter.Int32BitsToSingle((int)ReadBits(32));
+        }
+
+        public double ReadDouble()
+        {
+            return BitConverter.Int64BitsToDouble((long)ReadBits(64));
+        }
+    }
+}
@@ -0,0 +1,155 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using Google.Protobuf;
+using System;
+
+namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData.Conversion
+{
+    /// <summary>
+    /// Writes values using only as many bits as needed
+    /// Bits are packed into 32 bit words, least significant bit first
+    /// </summary>
+    public sealed class BitWriter
+    {
+        private uint[] _words = new uint[8];
+
+        /// <summary>
+        /// The number of bits that have been written
+        /// </summary>
+        public int BitCount { get; private set; }
+
+        /// <summary>
+        /// Clears all written bits
+        /// </summary>
+        public void Reset()
+        {
+            Array.Clear(_words, 0, (BitCount + 31) / 32);
+            BitCount = 0;
+        }
+
+        private void EnsureCapacity(int bitCount)
+        {
+            var wordCount = (bitCount + 31) / 32;
+
+            if (wordCount > _words.Length)
+            {
+                Array.Resize(ref _words, Math.Max(wordCount, _words.Length * 2));
+            }
+        }
+
+        /// <summary>
+        /// Writes the lower <paramref name="bits"/> bits of an unsigned value
+        /// Values that don't fit are clamped to the largest value that does
+        /// </summary>
+        /// <param name="value"></param>
+        /// <param name="bits">Number of bits to write, between 0 and 64</param>
+        public void WriteBits(ulong value, int bits)
+        {
+            if (bits < 0 || bits > 64)
+            {
+                throw new ArgumentOutOfRangeException(nameof(bits));
+            }
+
+            if (bits < 64)
+            {
+                value = Math.Min(value, (1UL << bits) - 1);
+            }
+
+            EnsureCapacity(BitCount + bits);
+
+            while (bits > 0)
+            {
+                var bitIndex = BitCount & 31;
+                var count = Math.Min(32 - bitIndex, bits);
+
+                _words[BitCount >> 5] |= (uint)(value & ((1UL << count) - 1)) << bitIndex;
+
+                value >>= count;
+                bits -= count;
+                BitCount += count;
+            }
+        }
+
+        /// <summary>
+        /// Writes a signed value as a two's complement number of <paramref name="bits"/> bits
+        /// Values that don't fit are clamped to the nearest value that does
+        /// </summary>
+        /// <param name="value"></param>
+        /// <param name="bits">Number of bits to write, between 1 and 64</param>
+        public void WriteSignedBits(long value, int bits)
+        {
+            if (bits < 1 || bits > 64)
+            {
+                throw new ArgumentOutOfRangeException(nameof(bits));
+            }
+
+            if (bits < 64)
+            {
+                var max = (1L << (bits - 1)) - 1;
+
+                value = Math.Max(-max - 1, Math.Min(value, max));
+
+                WriteBits((ulong)value & ((1UL << bits) - 1), bits);
+            }
+            else
+            {
+                WriteBits((ulong)value, bits);
+            }
+        }
+
+        public void WriteBool(bool value)
+        {
+            WriteBits(value ? 1UL : 0UL, 1);
+        }
+
+        public void WriteSingle(float value)
+        {
+            WriteBits((uint)BitConverter.SingleToInt32Bits(value), 32);
+        }
+
+        public void WriteDouble(double value)
+        {
+            WriteBits((ulong)BitConverter.DoubleToInt64Bits(value), 64);
+        }
+
+        /// <summary>
+        /// Writes all bits to the stream
+        /// The last word is written as a varint since its upper bits are unused
+        /// </summary>
+        /// <param name="stream"></param>
+        public void WriteTo(CodedOutputStream stream)
+        {
+            if (stream == null)
+            {
+                throw new ArgumentNullException(nameof(stream));
+            }
+
+            stream.WriteUInt32((uint)BitCount);
+
+            var fullWords = BitCount / 32;
+
+            for (var i = 0; i < fullWords; ++i)
+            {
+                stream.WriteFixed32(_words[i]);
+            }
+
+            if ((BitCount & 31) != 0)
+            {
+                stream.WriteUInt32(_words[fullWords]);
+            }
+        }
+    }
+}
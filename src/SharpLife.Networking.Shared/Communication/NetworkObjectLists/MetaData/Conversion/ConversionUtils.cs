@@ -14,6 +14,7 @@
 ****/
 
 using Google.Protobuf;
+using System;
 
 namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData.Conversion
 {
@@ -28,5 +29,66 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData.
         {
             stream.WriteBool(false);
         }
+
+        /// <summary>
+        /// Writes a value quantized to an integer using the multiplier in the options
+        /// If the options specify <see cref="BitConverterFlags.Signed"/>, a sign bit is written, otherwise the magnitude is sent
+        /// The magnitude is truncated, the same as the non bit packed converters do
+        /// </summary>
+        /// <param name="value"></param>
+        /// <param name="options"></param>
+        /// <param name="writer"></param>
+        public static void WriteQuantized(double value, in BitConverterOptions options, BitWriter writer)
+        {
+            var isSigned = (options.Flags & BitConverterFlags.Signed) != 0;
+
+            var magnitude = Math.Abs(value);
+
+            if (options.ShouldMultiply)
+            {
+                magnitude *= options.Multiplier;
+            }
+
+            //Bit count includes the sign bit
+            var bits = options.GetBitCount(32);
+
+            if (isSigned)
+            {
+                writer.WriteBool(value < 0);
+                --bits;
+            }
+
+            //Clamped by the writer if it doesn't fit
+            writer.WriteBits(!double.IsNaN(magnitude) ? (ulong)Math.Min(magnitude, uint.MaxValue) : 0, bits);
+        }
+
+        public static double ReadQuantized(in BitConverterOptions options, BitReader reader)
+        {
+            var isSigned = (options.Flags & BitConverterFlags.Signed) != 0;
+
+            var bits = options.GetBitCount(32);
+
+            var isNegative = false;
+
+            if (isSigned)
+            {
+                isNegative = reader.ReadBool();
+                --bits;
+            }
+
+            double value = reader.ReadBits(bits);
+
+            if (options.ShouldMultiply)
+            {
+                value /= options.Multiplier;
+            }
+
+            if (options.ShouldPostMultiply)
+            {
+                value *= options.PostMultiplier;
+            }
+
+            return isNegative ? -value : value;
+        }
     }
 }
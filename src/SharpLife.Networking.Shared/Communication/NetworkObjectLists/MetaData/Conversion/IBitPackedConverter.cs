@@ -0,0 +1,42 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData.Conversion
+{
+    /// <summary>
+    /// Converters for blittable types that can write values directly from snapshot data using only as many bits as the member options require
+    /// Members that use these converters are sent in the bit packed block of an object update
+    /// </summary>
+    public interface IBitPackedConverter
+    {
+        /// <summary>
+        /// Writes the value stored in snapshot data at the given offset
+        /// </summary>
+        /// <param name="data"></param>
+        /// <param name="offset"></param>
+        /// <param name="options"></param>
+        /// <param name="writer"></param>
+        void WriteBits(byte[] data, int offset, in BitConverterOptions options, BitWriter writer);
+
+        /// <summary>
+        /// Reads a value and stores it in snapshot data at the given offset
+        /// </summary>
+        /// <param name="reader"></param>
+        /// <param name="options"></param>
+        /// <param name="data"></param>
+        /// <param name="offset"></param>
+        void ReadBits(BitReader reader, in BitConverterOptions options, byte[] data, int offset);
+    }
+}
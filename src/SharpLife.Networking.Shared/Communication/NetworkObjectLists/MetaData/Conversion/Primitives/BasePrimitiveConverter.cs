@@ -13,13 +13,15 @@
 *
 ****/
 
+using System.Runtime.CompilerServices;
+
 namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData.Conversion.Primitives
 {
     /// <summary>
     /// Base class for primitive type converters
     /// </summary>
     /// <typeparam name="T"></typeparam>
-    public abstract class BasePrimitiveConverter<T> : BaseValueTypeConverter<T>
+    public abstract class BasePrimitiveConverter<T> : BaseValueTypeConverter<T>, IBitPackedConverter
     {
         public override int MemberCount => 1;
 
@@ -27,5 +29,19 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData.
         {
             return !value.Equals(previousValue);
         }
+
+        public abstract void WriteBits(T value, in BitConverterOptions options, BitWriter writer);
+
+        public abstract T ReadBits(BitReader reader, in BitConverterOptions options);
+
+        void IBitPackedConverter.WriteBits(byte[] data, int offset, in BitConverterOptions options, BitWriter writer)
+        {
+            WriteBits(Unsafe.ReadUnaligned<T>(ref data[offset]), options, writer);
+        }
+
+        void IBitPackedConverter.ReadBits(BitReader reader, in BitConverterOptions options, byte[] data, int offset)
+        {
+            Unsafe.WriteUnaligned(ref data[offset], ReadBits(reader, options));
+        }
     }
 }
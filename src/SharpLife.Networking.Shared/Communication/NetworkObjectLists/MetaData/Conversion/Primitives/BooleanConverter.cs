@@ -46,5 +46,15 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData.
 
             return changed;
         }
+
+        public override void WriteBits(bool value, in BitConverterOptions options, BitWriter writer)
+        {
+            writer.WriteBool(value);
+        }
+
+        public override bool ReadBits(BitReader reader, in BitConverterOptions options)
+        {
+            return reader.ReadBool();
+        }
     }
 }
@@ -46,5 +46,15 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData.
 
             return changed;
         }
+
+        public override void WriteBits(double value, in BitConverterOptions options, BitWriter writer)
+        {
+            writer.WriteDouble(value);
+        }
+
+        public override double ReadBits(BitReader reader, in BitConverterOptions options)
+        {
+            return reader.ReadDouble();
+        }
     }
 }
@@ -19,7 +19,6 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData.
 {
     /// <summary>
     /// Converts doubles to integers for networking
-    /// TODO: implement bit stream so that bit operations can be performed
     /// TODO: converters should be checked for compatibility so unmatched ones don't break
     /// </summary>
     public class DoubleToIntConverter : BasePrimitiveConverter<double>
@@ -89,5 +88,15 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData.
 
             return changed;
         }
+
+        public override void WriteBits(double value, in BitConverterOptions options, BitWriter writer)
+        {
+            ConversionUtils.WriteQuantized(value, options, writer);
+        }
+
+        public override double ReadBits(BitReader reader, in BitConverterOptions options)
+        {
+            return ConversionUtils.ReadQuantized(options, reader);
+        }
     }
 }
@@ -60,5 +60,15 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData.
 
             return changed;
         }
+
+        public override void WriteBits(float value, in BitConverterOptions options, BitWriter writer)
+        {
+            writer.WriteSingle(value);
+        }
+
+        public override float ReadBits(BitReader reader, in BitConverterOptions options)
+        {
+            return reader.ReadSingle();
+        }
     }
 }
@@ -46,5 +46,15 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData.
 
             return changed;
         }
+
+        public override void WriteBits(short value, in BitConverterOptions options, BitWriter writer)
+        {
+            writer.WriteSignedBits(value, options.GetBitCount(16));
+        }
+
+        public override short ReadBits(BitReader reader, in BitConverterOptions options)
+        {
+            return (short)reader.ReadSignedBits(options.GetBitCount(16));
+        }
     }
 }
@@ -60,5 +60,15 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData.
 
             return changed;
         }
+
+        public override void WriteBits(int value, in BitConverterOptions options, BitWriter writer)
+        {
+            writer.WriteSignedBits(value, options.GetBitCount(32));
+        }
+
+        public override int ReadBits(BitReader reader, in BitConverterOptions options)
+        {
+            return (int)reader.ReadSignedBits(options.GetBitCount(32));
+        }
     }
 }
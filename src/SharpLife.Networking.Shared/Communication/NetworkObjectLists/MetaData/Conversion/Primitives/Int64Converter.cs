@@ -46,5 +46,15 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData.
 
             return changed;
         }
+
+        public override void WriteBits(long value, in BitConverterOptions options, BitWriter writer)
+        {
+            writer.WriteSignedBits(value, options.GetBitCount(64));
+        }
+
+        public override long ReadBits(BitReader reader, in BitConverterOptions options)
+        {
+            return reader.ReadSignedBits(options.GetBitCount(64));
+        }
     }
 }
@@ -46,5 +46,15 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData.
 
             return changed;
         }
+
+        public override void WriteBits(sbyte value, in BitConverterOptions options, BitWriter writer)
+        {
+            writer.WriteSignedBits(value, options.GetBitCount(8));
+        }
+
+        public override sbyte ReadBits(BitReader reader, in BitConverterOptions options)
+        {
+            return (sbyte)reader.ReadSignedBits(options.GetBitCount(8));
+        }
     }
 }
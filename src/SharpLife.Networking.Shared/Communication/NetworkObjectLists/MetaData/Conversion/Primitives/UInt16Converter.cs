@@ -46,5 +46,15 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData.
 
             return changed;
         }
+
+        public override void WriteBits(ushort value, in BitConverterOptions options, BitWriter writer)
+        {
+            writer.WriteBits(value, options.GetBitCount(16));
+        }
+
+        public override ushort ReadBits(BitReader reader, in BitConverterOptions options)
+        {
+            return (ushort)reader.ReadBits(options.GetBitCount(16));
+        }
     }
 }
@@ -46,5 +46,15 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData.
 
             return changed;
         }
+
+        public override void WriteBits(ulong value, in BitConverterOptions options, BitWriter writer)
+        {
+            writer.WriteBits(value, options.GetBitCount(64));
+        }
+
+        public override ulong ReadBits(BitReader reader, in BitConverterOptions options)
+        {
+            return reader.ReadBits(options.GetBitCount(64));
+        }
     }
 }
@@ -46,5 +46,15 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData.
 
             return changed;
         }
+
+        public override void WriteBits(byte value, in BitConverterOptions options, BitWriter writer)
+        {
+            writer.WriteBits(value, options.GetBitCount(8));
+        }
+
+        public override byte ReadBits(BitReader reader, in BitConverterOptions options)
+        {
+            return (byte)reader.ReadBits(options.GetBitCount(8));
+        }
     }
 }
@@ -46,5 +46,15 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData.
 
             return changed;
         }
+
+        public override void WriteBits(uint value, in BitConverterOptions options, BitWriter writer)
+        {
+            writer.WriteBits(value, options.GetBitCount(32));
+        }
+
+        public override uint ReadBits(BitReader reader, in BitConverterOptions options)
+        {
+            return (uint)reader.ReadBits(options.GetBitCount(32));
+        }
     }
 }
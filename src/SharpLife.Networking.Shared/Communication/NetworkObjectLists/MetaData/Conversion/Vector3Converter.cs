@@ -16,10 +16,11 @@
 using Google.Protobuf;
 using SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData.Conversion.Primitives;
 using System.Numerics;
+using System.Runtime.CompilerServices;
 
 namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData.Conversion
 {
-    public sealed class Vector3Converter : BaseValueTypeConverter<Vector3>
+    public sealed class Vector3Converter : BaseValueTypeConverter<Vector3>, IBitPackedConverter
     {
         public static Vector3Converter Instance { get; } = new Vector3Converter();
 
@@ -55,5 +56,37 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData.
 
             return xDiff || yDiff || zDiff;
         }
+
+        //Components are sent as raw floats unless a bit count is specified, in which case they are quantized
+        private static void WriteComponent(float value, in BitConverterOptions options, BitWriter writer)
+        {
+            if (options.Bits > 0)
+            {
+                ConversionUtils.WriteQuantized(value, options, writer);
+            }
+            else
+            {
+                writer.WriteSingle(value);
+            }
+        }
+
+        private static float ReadComponent(in BitConverterOptions options, BitReader reader)
+        {
+            return options.Bits > 0 ? (float)ConversionUtils.ReadQuantized(options, reader) : reader.ReadSingle();
+        }
+
+        void IBitPackedConverter.WriteBits(byte[] data, int offset, in BitConverterOptions options, BitWriter writer)
+        {
+            var vector = Unsafe.ReadUnaligned<Vector3>(ref data[offset]);
+
+            WriteComponent(vector.X, options, writer);
+            WriteComponent(vector.Y, options, writer);
+            WriteComponent(vector.Z, options, writer);
+        }
+
+        void IBitPackedConverter.ReadBits(BitReader reader, in BitConverterOptions options, byte[] data, int offset)
+        {
+            Unsafe.WriteUnaligned(ref data[offset], new Vector3(ReadComponent(options, reader), ReadComponent(options, reader), ReadComponent(options, reader)));
+        }
     }
 }
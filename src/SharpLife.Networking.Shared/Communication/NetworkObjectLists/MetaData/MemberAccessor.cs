@@ -0,0 +1,203 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData.Conversion;
+using System;
+using System.Linq.Expressions;
+using System.Reflection;
+using System.Runtime.CompilerServices;
+
+namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData
+{
+    /// <summary>
+    /// Compiled accessors for a networked member
+    /// Avoids the name lookup done by <see cref="FastMember.TypeAccessor"/>,
+    /// and allows blittable members to be copied into snapshot data without boxing
+    /// </summary>
+    public sealed class MemberAccessor
+    {
+        /// <summary>
+        /// Number of bytes this member uses in snapshot data
+        /// If 0, the member is not blittable and is stored as an object in snapshots
+        /// </summary>
+        public int DataSize { get; }
+
+        /// <summary>
+        /// Whether the member can be written to
+        /// </summary>
+        public bool CanWrite => SetValue != null;
+
+        internal Func<object, object> GetValue { get; }
+
+        internal Action<object, object> SetValue { get; }
+
+        /// <summary>
+        /// Copies the member value of an instance into snapshot data at the given offset
+        /// </summary>
+        internal Action<object, byte[], int> CopyToData { get; }
+
+        /// <summary>
+        /// Copies snapshot data at the given offset into the member of an instance
+        /// </summary>
+        internal Action<object, byte[], int> CopyFromData { get; }
+
+        /// <summary>
+        /// Reads a boxed value from snapshot data at the given offset
+        /// </summary>
+        internal Func<byte[], int, object> ReadData { get; }
+
+        /// <summary>
+        /// Writes a boxed value to snapshot data at the given offset
+        /// </summary>
+        internal Action<byte[], int, object> WriteData { get; }
+
+        private MemberAccessor(Func<object, object> getValue, Action<object, object> setValue)
+        {
+            GetValue = getValue;
+            SetValue = setValue;
+        }
+
+        private MemberAccessor(Func<object, object> getValue, Action<object, object> setValue,
+            int dataSize,
+            Action<object, byte[], int> copyToData, Action<object, byte[], int> copyFromData,
+            Func<byte[], int, object> readData, Action<byte[], int, object> writeData)
+            : this(getValue, setValue)
+        {
+            DataSize = dataSize;
+            CopyToData = copyToData;
+            CopyFromData = copyFromData;
+            ReadData = readData;
+            WriteData = writeData;
+        }
+
+        private static T Read<T>(byte[] data, int offset)
+            where T : struct
+        {
+            return Unsafe.ReadUnaligned<T>(ref data[offset]);
+        }
+
+        private static void Write<T>(byte[] data, int offset, T value)
+            where T : struct
+        {
+            Unsafe.WriteUnaligned(ref data[offset], value);
+        }
+
+        private static readonly MethodInfo ReadMethod = typeof(MemberAccessor).GetMethod(nameof(Read), BindingFlags.NonPublic | BindingFlags.Static);
+
+        private static readonly MethodInfo WriteMethod = typeof(MemberAccessor).GetMethod(nameof(Write), BindingFlags.NonPublic | BindingFlags.Static);
+
+        private static readonly MethodInfo CreateBlittableMethod = typeof(MemberAccessor).GetMethod(nameof(CreateBlittable), BindingFlags.NonPublic | BindingFlags.Static);
+
+        /// <summary>
+        /// Creates an accessor for the given member
+        /// </summary>
+        /// <param name="info">Field or property to access</param>
+        /// <param name="converter">Converter used for the member, if any</param>
+        /// <returns></returns>
+        internal static MemberAccessor Create(MemberInfo info, ITypeConverter converter)
+        {
+            if (info == null)
+            {
+                throw new ArgumentNullException(nameof(info));
+            }
+
+            //Properties obtained through a derived type don't expose private accessors declared in the base type
+            MemberInfo declaredInfo;
+            Type memberType;
+            bool canWrite;
+
+            switch (info)
+            {
+                case PropertyInfo property:
+                    {
+                        var declaredProperty = property.DeclaringType.GetProperty(property.Name, BindingFlags.Public | BindingFlags.NonPublic | BindingFlags.Instance | BindingFlags.DeclaredOnly) ?? property;
+                        declaredInfo = declaredProperty;
+                        memberType = declaredProperty.PropertyType;
+                        canWrite = declaredProperty.GetSetMethod(true) != null;
+                        break;
+                    }
+
+                case FieldInfo field:
+                    declaredInfo = field;
+                    memberType = field.FieldType;
+                    canWrite = !field.IsInitOnly;
+                    break;
+
+                default: throw new ArgumentException($"Member {info.Name} must be a field or property", nameof(info));
+            }
+
+            var instance = Expression.Parameter(typeof(object), "instance");
+
+            var member = Expression.MakeMemberAccess(Expression.Convert(instance, info.DeclaringType), declaredInfo);
+
+            var getValue = Expression.Lambda<Func<object, object>>(Expression.Convert(member, typeof(object)), instance).Compile();
+
+            Action<object, object> setValue = null;
+
+            if (canWrite)
+            {
+                var value = Expression.Parameter(typeof(object), "value");
+
+                setValue = Expression.Lambda<Action<object, object>>(Expression.Assign(member, Expression.Convert(value, memberType)), instance, value).Compile();
+            }
+
+            //Only value types whose converter passes values through unchanged can be stored as raw data
+            if (converter != null
+                && memberType.IsValueType
+                && typeof(BaseValueTypeConverter<>).MakeGenericType(memberType).IsAssignableFrom(converter.GetType()))
+            {
+                var blittable = (MemberAccessor)CreateBlittableMethod.MakeGenericMethod(memberType).Invoke(null, new object[] { instance, member, getValue, setValue });
+
+                if (blittable != null)
+                {
+                    return blittable;
+                }
+            }
+
+            return new MemberAccessor(getValue, setValue);
+        }
+
+        private static MemberAccessor CreateBlittable<T>(ParameterExpression instance, MemberExpression member, Func<object, object> getValue, Action<object, object> setValue)
+            where T : struct
+        {
+            if (RuntimeHelpers.IsReferenceOrContainsReferences<T>())
+            {
+                return null;
+            }
+
+            var data = Expression.Parameter(typeof(byte[]), "data");
+            var offset = Expression.Parameter(typeof(int), "offset");
+
+            var copyToData = Expression.Lambda<Action<object, byte[], int>>(
+                Expression.Call(WriteMethod.MakeGenericMethod(typeof(T)), data, offset, member),
+                instance, data, offset).Compile();
+
+            Action<object, byte[], int> copyFromData = null;
+
+            if (setValue != null)
+            {
+                copyFromData = Expression.Lambda<Action<object, byte[], int>>(
+                    Expression.Assign(member, Expression.Call(ReadMethod.MakeGenericMethod(typeof(T)), data, offset)),
+                    instance, data, offset).Compile();
+            }
+
+            return new MemberAccessor(getValue, setValue,
+                Unsafe.SizeOf<T>(),
+                copyToData, copyFromData,
+                (buffer, index) => Read<T>(buffer, index),
+                (buffer, index, value) => Write(buffer, index, value is T typedValue ? typedValue : default));
+        }
+    }
+}
@@ -52,6 +52,18 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData
 
             public BitConverterOptions ConverterOptions { get; }
 
+            public MemberAccessor Accessor { get; }
+
+            /// <summary>
+            /// Offset of this member in snapshot data, or -1 if the member is not stored in snapshot data
+            /// </summary>
+            public int DataOffset { get; internal set; } = -1;
+
+            /// <summary>
+            /// If not null, this member is stored in snapshot data and is sent in the bit packed block of object updates
+            /// </summary>
+            public IBitPackedConverter BitPackedConverter { get; internal set; }
+
             public Member(MemberInfo info, TypeMetaData metaData, ITypeConverter typeConverter, in BitConverterOptions converterOptions, int? changeNotificationIndex)
             {
                 Info = info ?? throw new ArgumentNullException(nameof(info));
@@ -59,6 +71,8 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData
                 Converter = typeConverter;
                 ConverterOptions = converterOptions;
                 ChangeNotificationIndex = changeNotificationIndex;
+
+                Accessor = MemberAccessor.Create(info, typeConverter);
             }
         }
 
@@ -92,6 +106,11 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData
 
         public TypeAccessor Accessor { get; }
 
+        /// <summary>
+        /// Number of bytes needed to store all blittable members in a snapshot
+        /// </summary>
+        public int SnapshotDataSize { get; }
+
         public TypeMetaData(uint id, Type type, ObjectFactory factory, ITypeConverter converter, Member[] members, string mapFromType)
         {
             Id = id;
@@ -105,6 +124,17 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData
             ChangeNotificationMembersCount = _members.Count(member => member.ChangeNotificationIndex.HasValue);
 
             Accessor = TypeAccessor.Create(Type, true);
+
+            foreach (var member in _members)
+            {
+                if (member.Accessor.DataSize > 0)
+                {
+                    member.DataOffset = SnapshotDataSize;
+                    SnapshotDataSize += member.Accessor.DataSize;
+
+                    member.BitPackedConverter = member.Converter as IBitPackedConverter;
+                }
+            }
         }
 
         /// <summary>
@@ -135,9 +165,9 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData
             return member;
         }
 
-        internal MemberSnapshot[] AllocateSnapshot()
+        internal ObjectSnapshot AllocateSnapshot()
         {
-            return new MemberSnapshot[Members.Count];
+            return new ObjectSnapshot(this);
         }
     }
 }
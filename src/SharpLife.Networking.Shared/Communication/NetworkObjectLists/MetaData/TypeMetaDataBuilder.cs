@@ -90,6 +90,14 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData
             return this;
         }
 
+        private static bool IsSignedInteger(Type type)
+        {
+            return type == typeof(sbyte)
+                || type == typeof(short)
+                || type == typeof(int)
+                || type == typeof(long);
+        }
+
         private void InternalAddMember(MemberInfo memberInfo, Type type, ITypeConverter typeConverter, in BitConverterOptions converterOptions, bool usesChangeNotification)
         {
             var typeMetaData = _registryBuilder.LookupMemberType(type);
@@ -108,6 +116,13 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData
             //Convert the converter options to the most optimal format now
             var optimizedConverterOptions = typeConverter?.OptimizeOptions(converterOptions) ?? converterOptions;
 
+            //The bit count includes the sign bit, so a single bit would leave nothing for the value itself
+            if (optimizedConverterOptions.Bits == 1
+                && ((optimizedConverterOptions.Flags & BitConverterFlags.Signed) != 0 || IsSignedInteger(type)))
+            {
+                throw new ArgumentException($"Signed networked member \"{memberInfo.Name}\" in {Type.FullName} must use at least 2 bits", nameof(converterOptions));
+            }
+
             _members.Add(new TypeMetaData.Member(memberInfo, typeMetaData, typeConverter, optimizedConverterOptions, usesChangeNotification ? _nextChangeNotificationIndex++ : (int?)null));
         }
 
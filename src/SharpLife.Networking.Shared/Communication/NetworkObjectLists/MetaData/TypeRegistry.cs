@@ -13,24 +13,59 @@
 *
 ****/
 
+using Google.Protobuf;
 using SharpLife.Networking.Shared.Messages.NetworkObjectLists;
 using System;
 using System.Collections.Generic;
 using System.Linq;
+using System.Security.Cryptography;
 
 namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData
 {
     /// <summary>
     /// Registry of networkable types
+    /// The transmitter serializes its metadata once and identifies it by hash,
+    /// receivers keep the mappings for hashes they have seen so they don't need the metadata again when reconnecting
     /// </summary>
     public sealed class TypeRegistry
     {
+        /// <summary>
+        /// Maximum number of transmitter mappings to keep
+        /// </summary>
+        public const int MaxCachedMappings = 8;
+
         private readonly IReadOnlyDictionary<Type, TypeMetaData> _types;
 
         private readonly IReadOnlyDictionary<Type, TypeMetaData> _remappedTypes;
 
         private Dictionary<uint, TypeMetaData> _transmitterToReceiverMap;
 
+        private readonly Dictionary<ByteString, Dictionary<uint, TypeMetaData>> _cachedMappings = new Dictionary<ByteString, Dictionary<uint, TypeMetaData>>();
+
+        private readonly Dictionary<ByteString, NetworkObjectListObjectMetaDataList> _cachedMetaData = new Dictionary<ByteString, NetworkObjectListObjectMetaDataList>();
+
+        private Dictionary<string, TypeMetaData> _localLookup;
+
+        private NetworkObjectListObjectMetaDataList _serializedMetaData;
+
+        private ByteString _metaDataHash;
+
+        /// <summary>
+        /// Hash of the serialized metadata
+        /// </summary>
+        public ByteString MetaDataHash
+        {
+            get
+            {
+                if (_metaDataHash == null)
+                {
+                    _metaDataHash = ComputeHash(Serialize());
+                }
+
+                return _metaDataHash;
+            }
+        }
+
         internal TypeRegistry(IReadOnlyDictionary<Type, TypeMetaData> types, IReadOnlyDictionary<Type, TypeMetaData> remappedTypes)
         {
             _types = types ?? throw new ArgumentNullException(nameof(types));
@@ -70,8 +105,26 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData
             return metaData;
         }
 
+        private static ByteString ComputeHash(NetworkObjectListObjectMetaDataList list)
+        {
+            using (var sha = SHA256.Create())
+            {
+                return ByteString.CopyFrom(sha.ComputeHash(list.ToByteArray()));
+            }
+        }
+
+        /// <summary>
+        /// Serializes the metadata of all types
+        /// The registry can't change after it has been built, so the result is created once and shared
+        /// </summary>
+        /// <returns></returns>
         public NetworkObjectListObjectMetaDataList Serialize()
         {
+            if (_serializedMetaData != null)
+            {
+                return _serializedMetaData;
+            }
+
             var list = new NetworkObjectListObjectMetaDataList();
 
             var sortedTypes = _types.Values.ToList();
@@ -97,6 +150,52 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData
                 list.MetaData.Add(metaData);
             }
 
+            _serializedMetaData = list;
+
+            return list;
+        }
+
+        /// <summary>
+        /// Uses the mapping for the metadata with the given hash if it was received before
+        /// </summary>
+        /// <param name="hash"></param>
+        /// <returns>Whether a mapping was found</returns>
+        public bool TryUseCachedMetaData(ByteString hash)
+        {
+            if (hash == null)
+            {
+                throw new ArgumentNullException(nameof(hash));
+            }
+
+            if (!_cachedMappings.TryGetValue(hash, out var mapping))
+            {
+                return false;
+            }
+
+            _transmitterToReceiverMap = mapping;
+
+            return true;
+        }
+
+        /// <summary>
+        /// Gets the metadata with the given hash if it is this registry's own metadata or it was received before
+        /// </summary>
+        /// <param name="hash"></param>
+        /// <returns>The metadata, or null if it is unknown</returns>
+        public NetworkObjectListObjectMetaDataList FindMetaData(ByteString hash)
+        {
+            if (hash == null)
+            {
+                throw new ArgumentNullException(nameof(hash));
+            }
+
+            if (hash.Equals(MetaDataHash))
+            {
+                return Serialize();
+            }
+
+            _cachedMetaData.TryGetValue(hash, out var list);
+
             return list;
         }
 
@@ -109,14 +208,17 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData
 
             _transmitterToReceiverMap = new Dictionary<uint, TypeMetaData>();
 
-            //Construct a temporary map mapping our types by name so we can perform fast lookup
-            var localLookup = _types.ToDictionary(
-                entry => entry.Value.MapFromType ?? entry.Value.Type.FullName,
-                entry => entry.Value);
+            //Construct a map mapping our types by name so we can perform fast lookup
+            if (_localLookup == null)
+            {
+                _localLookup = _types.ToDictionary(
+                    entry => entry.Value.MapFromType ?? entry.Value.Type.FullName,
+                    entry => entry.Value);
+            }
 
             foreach (var metaData in list.MetaData)
             {
-                if (!localLookup.TryGetValue(metaData.TypeName, out var type))
+                if (!_localLookup.TryGetValue(metaData.TypeName, out var type))
                 {
                     throw new InvalidOperationException($"The type {metaData.TypeName} (id: {metaData.TypeId}) has no type mapping to it on the receiving end");
                 }
@@ -133,6 +235,17 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData
                 //Add the lookup
                 _transmitterToReceiverMap.Add(metaData.TypeId, type);
             }
+
+            if (_cachedMappings.Count >= MaxCachedMappings)
+            {
+                _cachedMappings.Clear();
+                _cachedMetaData.Clear();
+            }
+
+            var hash = ComputeHash(list);
+
+            _cachedMappings[hash] = _transmitterToReceiverMap;
+            _cachedMetaData[hash] = list;
         }
     }
 }
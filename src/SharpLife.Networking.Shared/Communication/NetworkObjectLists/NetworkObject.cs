@@ -84,48 +84,104 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists
             ChangeNotifications[member.ChangeNotificationIndex.Value] = true;
         }
 
-        internal MemberSnapshot[] TakeSnapshot(MemberSnapshot[] previousSnapshot)
+        internal ObjectSnapshot TakeSnapshot(ObjectSnapshot previousSnapshot)
         {
             var snapshot = MetaData.AllocateSnapshot();
 
+            TakeSnapshot(previousSnapshot, snapshot);
+
+            return snapshot;
+        }
+
+        /// <summary>
+        /// Takes a snapshot of this object's current state
+        /// </summary>
+        /// <param name="previousSnapshot">If not null, used to determine which members have changed</param>
+        /// <param name="snapshot">Receives the snapshot</param>
+        internal void TakeSnapshot(ObjectSnapshot previousSnapshot, ObjectSnapshot snapshot)
+        {
+            var members = snapshot.Members;
+
             for (var i = 0; i < MetaData.Members.Count; ++i)
             {
                 var member = MetaData.Members[i];
 
-                var childInstance = MetaData.Accessor[Instance, member.Info.Name];
+                if (member.DataOffset != -1)
+                {
+                    member.Accessor.CopyToData(Instance, snapshot.Data, member.DataOffset);
+                }
+                else
+                {
+                    var childInstance = member.Accessor.GetValue(Instance);
 
-                snapshot[i].Value = member.Converter.Copy(childInstance);
+                    members[i].Value = member.Converter.Copy(childInstance);
 
-                //Only mark it as changed it if it actually changed
-                //This prevents client instances from being forcefully reset when the server isn't updating the value
-                //TODO: needs to be more robust (better comparison), a way to force updates
-                snapshot[i].Changed = snapshot[i].Value?.Equals(previousSnapshot?[i].Value) != true;
+                    //Only mark it as changed it if it actually changed
+                    //This prevents client instances from being forcefully reset when the server isn't updating the value
+                    //TODO: needs to be more robust (better comparison), a way to force updates
+                    members[i].Changed = members[i].Value?.Equals(previousSnapshot?.Members[i].Value) != true;
+                }
             }
 
-            return snapshot;
+            //Blittable members are compared as raw data, which lets objects that didn't move skip all per-member comparisons
+            if (MetaData.SnapshotDataSize > 0)
+            {
+                var dataChanged = previousSnapshot == null || !snapshot.DataEquals(previousSnapshot);
+
+                for (var i = 0; i < MetaData.Members.Count; ++i)
+                {
+                    var member = MetaData.Members[i];
+
+                    if (member.DataOffset != -1)
+                    {
+                        members[i].Changed = previousSnapshot == null || (dataChanged && snapshot.ValueChanged(member, i, previousSnapshot));
+                    }
+                }
+            }
         }
 
-        internal void ApplySnapshot(MemberSnapshot[] snapshot)
+        /// <summary>
+        /// Applies the members of a snapshot to the object
+        /// </summary>
+        /// <param name="snapshot"></param>
+        /// <param name="applyAllMembers">Whether to apply members that are not marked as changed as well</param>
+        internal void ApplySnapshot(ObjectSnapshot snapshot, bool applyAllMembers = false)
         {
             if (snapshot == null)
             {
                 throw new ArgumentNullException(nameof(snapshot));
             }
 
-            if (snapshot.Length != MetaData.Members.Count)
+            if (snapshot.Members.Length != MetaData.Members.Count)
             {
-                throw new InvalidOperationException($"Snapshot for object {Handle} and type {MetaData.Type.FullName} has the wrong size (got {snapshot.Length}, expected {MetaData.Members.Count}");
+                throw new InvalidOperationException($"Snapshot for object {Handle} and type {MetaData.Type.FullName} has the wrong size (got {snapshot.Members.Length}, expected {MetaData.Members.Count}");
             }
 
             for (var i = 0; i < MetaData.Members.Count; ++i)
             {
-                var member = MetaData.Members[i];
+                if (!applyAllMembers && !snapshot.Members[i].Changed)
+                {
+                    continue;
+                }
 
-                var currentValue = MetaData.Accessor[Instance, member.Info.Name];
+                var member = MetaData.Members[i];
 
-                if (snapshot[i].Changed)
+                if (member.DataOffset != -1 && member.Accessor.CanWrite)
+                {
+                    member.Accessor.CopyFromData(Instance, snapshot.Data, member.DataOffset);
+                }
+                else
                 {
-                    MetaData.Accessor[Instance, member.Info.Name] = member.Converter.CreateInstance(member.MetaData.Type, snapshot[i].Value);
+                    var value = member.Converter.CreateInstance(member.MetaData.Type, snapshot.GetValue(member, i));
+
+                    if (member.Accessor.CanWrite)
+                    {
+                        member.Accessor.SetValue(Instance, value);
+                    }
+                    else
+                    {
+                        MetaData.Accessor[Instance, member.Info.Name] = value;
+                    }
                 }
             }
         }
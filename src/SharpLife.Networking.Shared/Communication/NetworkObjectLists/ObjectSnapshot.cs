@@ -0,0 +1,122 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData;
+using System;
+
+namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists
+{
+    /// <summary>
+    /// Snapshot of a network object's members
+    /// Blittable members are stored unboxed in <see cref="Data"/>, all other members store their value in <see cref="Members"/>
+    /// </summary>
+    internal sealed class ObjectSnapshot
+    {
+        public MemberSnapshot[] Members { get; }
+
+        public byte[] Data { get; }
+
+        public ObjectSnapshot(TypeMetaData metaData)
+        {
+            if (metaData == null)
+            {
+                throw new ArgumentNullException(nameof(metaData));
+            }
+
+            Members = new MemberSnapshot[metaData.Members.Count];
+            Data = metaData.SnapshotDataSize > 0 ? new byte[metaData.SnapshotDataSize] : Array.Empty<byte>();
+        }
+
+        /// <summary>
+        /// Gets the value of a member
+        /// Blittable members are boxed
+        /// </summary>
+        /// <param name="member"></param>
+        /// <param name="index"></param>
+        public object GetValue(TypeMetaData.Member member, int index)
+        {
+            if (member.DataOffset != -1)
+            {
+                return member.Accessor.ReadData(Data, member.DataOffset);
+            }
+
+            return Members[index].Value;
+        }
+
+        public void SetValue(TypeMetaData.Member member, int index, object value)
+        {
+            if (member.DataOffset != -1)
+            {
+                member.Accessor.WriteData(Data, member.DataOffset, value);
+            }
+            else
+            {
+                Members[index].Value = value;
+            }
+        }
+
+        /// <summary>
+        /// Copies the value of a member from another snapshot of the same type
+        /// </summary>
+        /// <param name="member"></param>
+        /// <param name="index"></param>
+        /// <param name="other"></param>
+        public void CopyValue(TypeMetaData.Member member, int index, ObjectSnapshot other)
+        {
+            if (member.DataOffset != -1)
+            {
+                Buffer.BlockCopy(other.Data, member.DataOffset, Data, member.DataOffset, member.Accessor.DataSize);
+            }
+            else
+            {
+                Members[index].Value = other.Members[index].Value;
+            }
+        }
+
+        /// <summary>
+        /// Returns whether the value of a member differs from its value in another snapshot of the same type
+        /// </summary>
+        /// <param name="member"></param>
+        /// <param name="index"></param>
+        /// <param name="other"></param>
+        public bool ValueChanged(TypeMetaData.Member member, int index, ObjectSnapshot other)
+        {
+            if (member.DataOffset != -1)
+            {
+                return !new ReadOnlySpan<byte>(Data, member.DataOffset, member.Accessor.DataSize)
+                    .SequenceEqual(new ReadOnlySpan<byte>(other.Data, member.DataOffset, member.Accessor.DataSize));
+            }
+
+            return member.Converter.Changed(Members[index].Value, other.Members[index].Value);
+        }
+
+        /// <summary>
+        /// Returns whether all blittable members are identical to those in another snapshot of the same type
+        /// </summary>
+        /// <param name="other"></param>
+        public bool DataEquals(ObjectSnapshot other)
+        {
+            return new ReadOnlySpan<byte>(Data).SequenceEqual(other.Data);
+        }
+
+        /// <summary>
+        /// Clears all member values so they are no longer kept alive by this snapshot
+        /// </summary>
+        public void Clear()
+        {
+            Array.Clear(Members, 0, Members.Length);
+        }
+    }
+}
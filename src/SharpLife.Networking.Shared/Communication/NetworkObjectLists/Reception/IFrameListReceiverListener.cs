@@ -21,7 +21,8 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.Reception
         /// Invoked when a list begins processing
         /// </summary>
         /// <param name="networkObjectList"></param>
-        void OnBeginProcessList(INetworkObjectList networkObjectList);
+        /// <param name="serverTime">Server time when the frame being processed was created</param>
+        void OnBeginProcessList(INetworkObjectList networkObjectList, double serverTime);
 
         /// <summary>
         /// Invoked when a list ends processing
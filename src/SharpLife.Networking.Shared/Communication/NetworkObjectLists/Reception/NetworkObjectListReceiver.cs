@@ -18,19 +18,28 @@ using SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData;
 using SharpLife.Networking.Shared.Messages.NetworkObjectLists;
 using SharpLife.Utility.Collections.Generic;
 using System;
+using System.Collections.Generic;
 
 namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.Reception
 {
     /// <summary>
     /// Handles the receiving of frames
-    /// Keeps tracks of previous frames
+    /// Keeps tracks of previous frames so frame lists delta encoded against any of them can be decoded
     /// </summary>
     public sealed class NetworkObjectListReceiver : BaseNetworkObjectListManager
     {
         private readonly CircularBuffer<FrameList> _frameListLists;
 
+        private FrameSerializer _frameSerializer;
+
         public IFrameListReceiverListener Listener { get; }
 
+        /// <summary>
+        /// Sequence of the newest frame list that has been received
+        /// 0 if none have been received
+        /// </summary>
+        public uint LastReceivedSequence { get; private set; }
+
         public NetworkObjectListReceiver(TypeRegistry typeRegistry, int maxFrameLists, IFrameListReceiverListener listener)
             : base(typeRegistry)
         {
@@ -59,13 +68,93 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.Reception
             return networkObject;
         }
 
-        public void DeserializeFrameList(NetworkObjectListFrameListUpdate frameListMessage)
+        /// <summary>
+        /// The most recently deserialized frame list
+        /// </summary>
+        internal FrameList CurrentFrameList => _frameListLists.Count > 0 ? _frameListLists.Current : null;
+
+        internal int FrameListCount => _frameListLists.Count;
+
+        /// <summary>
+        /// Gets a frame list by index, oldest first
+        /// </summary>
+        /// <param name="index"></param>
+        internal FrameList GetFrameList(int index) => _frameListLists[index];
+
+        internal FrameList FindListBySequence(uint sequence)
+        {
+            //Search by index since enumerating the buffer copies it, and baselines are usually recent
+            for (var i = _frameListLists.Count - 1; i >= 0; --i)
+            {
+                var list = _frameListLists[i];
+
+                if (list.Sequence == sequence)
+                {
+                    return list;
+                }
+            }
+
+            return null;
+        }
+
+        /// <summary>
+        /// Serializes all frame lists that can still be used as a baseline as full updates, oldest first
+        /// Used to store the state of all objects so it can be restored without the lists they were delta encoded against
+        /// </summary>
+        public List<NetworkObjectListFrameListUpdate> SerializeFrameLists()
+        {
+            if (_frameSerializer == null)
+            {
+                _frameSerializer = new FrameSerializer();
+            }
+
+            var messages = new List<NetworkObjectListFrameListUpdate>(_frameListLists.Count);
+
+            foreach (var frameList in _frameListLists)
+            {
+                var message = frameList.SerializeFrames(this, null, _frameSerializer);
+
+                message.ServerTime = frameList.ServerTime;
+
+                messages.Add(message);
+            }
+
+            return messages;
+        }
+
+        /// <summary>
+        /// Deserializes a frame list
+        /// </summary>
+        /// <param name="frameListMessage"></param>
+        /// <returns>Whether the frame list was deserialized and can be applied
+        /// Frame lists that are older than the last received list or delta encoded against a list that is no longer available are ignored</returns>
+        public bool DeserializeFrameList(NetworkObjectListFrameListUpdate frameListMessage)
         {
-            var previous = _frameListLists.Count > 0 ? _frameListLists[_frameListLists.Count - 1] : null;
+            if (frameListMessage.Sequence <= LastReceivedSequence)
+            {
+                return false;
+            }
+
+            FrameList baseline = null;
+
+            if (frameListMessage.BaselineSequence != 0)
+            {
+                baseline = FindListBySequence(frameListMessage.BaselineSequence);
+
+                //The server will send a full update once it notices that newer lists aren't being acknowledged
+                if (baseline == null)
+                {
+                    return false;
+                }
+            }
 
-            var frameList = FrameList.DeserializeFrameList(this, previous, frameListMessage);
+            var frameList = FrameList.DeserializeFrameList(this, baseline, frameListMessage);
 
             _frameListLists.Add(frameList);
+
+            LastReceivedSequence = frameListMessage.Sequence;
+
+            return true;
         }
 
         public void ApplyCurrentFrame()
@@ -81,11 +170,17 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.Reception
             {
                 var objectList = _objectLists[frame.ListId];
 
-                Listener.OnBeginProcessList(objectList);
+                Listener.OnBeginProcessList(objectList, frameList.ServerTime);
 
                 foreach (var destruction in frame.DestroyedObjects)
                 {
-                    var networkObject = objectList.GetNetworkObjectById((int)destruction.ObjectId);
+                    var networkObject = objectList.InternalGetNetworkObjectById((int)destruction.ObjectId);
+
+                    //Destructions are resent until acknowledged, so the object may already be gone or its id reused
+                    if (networkObject == null || networkObject.Handle.SerialNumber != destruction.SerialNumber)
+                    {
+                        continue;
+                    }
 
                     Listener.OnNetworkObjectDestroyed(objectList, networkObject, networkObject.Instance);
 
@@ -97,10 +192,18 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.Reception
                 foreach (var update in frame.Updates)
                 {
                     //Create the object if it does not already exist
-                    var networkObject = objectList.InternalGetNetworkObjectById(update.ObjectHandle.Id) ?? CreateNetworkObject(objectList, update.MetaData, update.ObjectHandle);
+                    var networkObject = objectList.InternalGetNetworkObjectById(update.ObjectHandle.Id);
+
+                    var created = networkObject == null;
+
+                    if (created)
+                    {
+                        networkObject = CreateNetworkObject(objectList, update.MetaData, update.ObjectHandle);
+                    }
 
                     Listener.OnBeginUpdateNetworkObject(objectList, networkObject);
-                    networkObject.ApplySnapshot(update.Snapshot);
+                    //An object that was destroyed because it was filtered out can come back with a delta against a frame from before it was destroyed
+                    networkObject.ApplySnapshot(update.Snapshot, created && update.IsDelta);
                     Listener.OnEndUpdateNetworkObject(objectList, networkObject);
                 }
 
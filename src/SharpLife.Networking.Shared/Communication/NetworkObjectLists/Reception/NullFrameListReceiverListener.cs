@@ -0,0 +1,53 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.Reception
+{
+    /// <summary>
+    /// Listener for receivers that only decode frame lists and never apply them
+    /// </summary>
+    internal sealed class NullFrameListReceiverListener : IFrameListReceiverListener
+    {
+        public static readonly NullFrameListReceiverListener Instance = new NullFrameListReceiverListener();
+
+        private NullFrameListReceiverListener()
+        {
+        }
+
+        public void OnBeginProcessList(INetworkObjectList networkObjectList, double serverTime)
+        {
+        }
+
+        public void OnEndProcessList(INetworkObjectList networkObjectList)
+        {
+        }
+
+        public void OnNetworkObjectCreated(INetworkObjectList networkObjectList, INetworkObject networkObject, INetworkable networkableObject)
+        {
+        }
+
+        public void OnNetworkObjectDestroyed(INetworkObjectList networkObjectList, INetworkObject networkObject, INetworkable networkableObject)
+        {
+        }
+
+        public void OnBeginUpdateNetworkObject(INetworkObjectList networkObjectList, INetworkObject networkObject)
+        {
+        }
+
+        public void OnEndUpdateNetworkObject(INetworkObjectList networkObjectList, INetworkObject networkObject)
+        {
+        }
+    }
+}
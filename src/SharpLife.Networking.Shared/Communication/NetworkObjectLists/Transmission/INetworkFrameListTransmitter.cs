@@ -14,6 +14,7 @@
 ****/
 
 using SharpLife.Networking.Shared.Messages.NetworkObjectLists;
+using System.Collections.Generic;
 
 namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.Transmission
 {
@@ -21,6 +22,21 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.Transmiss
     {
         IFrameListTransmitterListener Listener { get; }
 
+        /// <summary>
+        /// Serializes the newest frame list, delta encoded against the newest acknowledged list if it is still available
+        /// </summary>
         NetworkObjectListFrameListUpdate SerializeCurrentFrameList();
+
+        /// <summary>
+        /// Serializes all frame lists that can still be used as a baseline as full updates, oldest first
+        /// Does not affect what is sent to the receiver
+        /// </summary>
+        List<NetworkObjectListFrameListUpdate> SerializeFullFrameLists();
+
+        /// <summary>
+        /// Marks the frame list with the given sequence as received by the receiver
+        /// </summary>
+        /// <param name="sequence"></param>
+        void AcknowledgeFrameList(uint sequence);
     }
 }
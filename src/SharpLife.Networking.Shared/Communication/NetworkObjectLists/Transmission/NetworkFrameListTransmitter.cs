@@ -17,19 +17,48 @@ using SharpLife.Networking.Shared.Communication.NetworkObjectLists.Frames;
 using SharpLife.Networking.Shared.Messages.NetworkObjectLists;
 using SharpLife.Utility.Collections.Generic;
 using System;
+using System.Collections.Generic;
 
 namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.Transmission
 {
     /// <summary>
     /// Handles the transmitting of frames
     /// Keeps tracks of frames pending transmission
+    /// Frames are delta encoded against the newest frame list that the receiver has acknowledged,
+    /// so frame lists can be sent unreliably without the receiver falling out of sync when one is lost
     /// </summary>
     internal sealed class NetworkFrameListTransmitter : INetworkFrameListTransmitter
     {
+        private struct PendingDestruction
+        {
+            /// <summary>
+            /// Sequence of the frame list the object was destroyed in
+            /// </summary>
+            public uint sequence;
+
+            public uint listId;
+
+            public ObjectDestruction destruction;
+        }
+
         private readonly NetworkObjectListTransmitter _listTransmitter;
 
         private readonly CircularBuffer<FrameList> _frameListLists;
 
+        /// <summary>
+        /// Destructions are only part of the frame that the object was destroyed in,
+        /// so they are resent with every frame list until a list containing them has been acknowledged
+        /// </summary>
+        private readonly List<PendingDestruction> _pendingDestructions = new List<PendingDestruction>();
+
+        private uint _nextSequence = 1;
+
+        /// <summary>
+        /// Sequence of the newest frame list that the receiver has acknowledged
+        /// 0 if none have been acknowledged
+        /// </summary>
+        private uint _acknowledgedSequence;
+
         public IFrameListTransmitterListener Listener { get; }
 
         internal FrameList CurrentList => !_frameListLists.IsEmpty ? _frameListLists.Current : null;
@@ -48,7 +77,73 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.Transmiss
                 throw new ArgumentNullException(nameof(list));
             }
 
-            _frameListLists.Add(list);
+            list.Sequence = _nextSequence++;
+
+            //Objects that were filtered out and are being sent again must not be destroyed by resent destructions
+            _pendingDestructions.RemoveAll(pending =>
+            {
+                var update = list.FindFrameByListId((int)pending.listId)?.FindUpdateByObjectId((int)pending.destruction.ObjectId);
+
+                return update != null && update.ObjectHandle.SerialNumber == pending.destruction.SerialNumber;
+            });
+
+            foreach (var frame in list.Frames)
+            {
+                foreach (var destruction in frame.DestroyedObjects)
+                {
+                    _pendingDestructions.Add(new PendingDestruction
+                    {
+                        sequence = list.Sequence,
+                        listId = (uint)frame.ListId,
+                        destruction = destruction
+                    });
+                }
+            }
+
+            //Frame lists that fall out of the buffer no longer need their snapshots
+            //If the acknowledged list falls out, the next list is sent as a full update
+            _frameListLists.Add(list)?.Release();
+        }
+
+        /// <summary>
+        /// Releases all frame lists
+        /// </summary>
+        internal void ReleaseLists()
+        {
+            foreach (var list in _frameListLists)
+            {
+                list.Release();
+            }
+
+            _frameListLists.Clear();
+            _pendingDestructions.Clear();
+            _acknowledgedSequence = 0;
+        }
+
+        private FrameList FindListBySequence(uint sequence)
+        {
+            foreach (var list in _frameListLists)
+            {
+                if (list.Sequence == sequence)
+                {
+                    return list;
+                }
+            }
+
+            return null;
+        }
+
+        public void AcknowledgeFrameList(uint sequence)
+        {
+            //Acknowledgements can arrive out of order, and can refer to lists that have already been discarded
+            if (sequence <= _acknowledgedSequence || sequence >= _nextSequence)
+            {
+                return;
+            }
+
+            _acknowledgedSequence = sequence;
+
+            _pendingDestructions.RemoveAll(pending => pending.sequence <= sequence);
         }
 
         public NetworkObjectListFrameListUpdate SerializeCurrentFrameList()
@@ -58,11 +153,37 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.Transmiss
                 throw new InvalidOperationException("No frame list to serialize");
             }
 
-            var previous = _frameListLists.Count > 1 ? _frameListLists[_frameListLists.Count - 2] : null;
-
             var current = _frameListLists[_frameListLists.Count - 1];
 
-            return current.SerializeFrames(_listTransmitter, previous);
+            var baseline = _acknowledgedSequence != 0 ? FindListBySequence(_acknowledgedSequence) : null;
+
+            var message = current.SerializeFrames(_listTransmitter, baseline, _listTransmitter.FrameSerializer);
+
+            foreach (var frame in message.Frames)
+            {
+                foreach (var pending in _pendingDestructions)
+                {
+                    //The current list's own destructions are already in its frames
+                    if (pending.listId == frame.ListId && pending.sequence != current.Sequence)
+                    {
+                        frame.ObjectsDestroyed.Add(pending.destruction);
+                    }
+                }
+            }
+
+            return message;
+        }
+
+        public List<NetworkObjectListFrameListUpdate> SerializeFullFrameLists()
+        {
+            var messages = new List<NetworkObjectListFrameListUpdate>(_frameListLists.Count);
+
+            foreach (var list in _frameListLists)
+            {
+                messages.Add(list.SerializeFrames(_listTransmitter, null, _listTransmitter.FrameSerializer));
+            }
+
+            return messages;
         }
     }
 }
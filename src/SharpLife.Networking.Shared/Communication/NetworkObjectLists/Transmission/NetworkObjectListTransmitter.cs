@@ -27,6 +27,13 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.Transmiss
 
         private readonly int _maxFrameLists;
 
+        private readonly SnapshotHistory _snapshotHistory = new SnapshotHistory();
+
+        /// <summary>
+        /// Shared by all transmitters since frame lists are serialized one at a time
+        /// </summary>
+        internal FrameSerializer FrameSerializer { get; } = new FrameSerializer();
+
         public NetworkObjectListTransmitter(TypeRegistry typeRegistry, int maxFrameLists)
             : base(typeRegistry)
         {
@@ -83,40 +90,49 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.Transmiss
                 throw new ArgumentNullException(nameof(transmitter));
             }
 
-            if (!_transmitters.Remove((NetworkFrameListTransmitter)transmitter))
+            var frameListTransmitter = (NetworkFrameListTransmitter)transmitter;
+
+            if (!_transmitters.Remove(frameListTransmitter))
             {
                 throw new InvalidOperationException("Network frame list transmitter is not managed by this system");
             }
+
+            frameListTransmitter.ReleaseLists();
         }
 
         /// <summary>
         /// Creates a frame for a specific transmitter and list
+        /// Objects are snapshotted the first time any transmitter includes them, after which the update is shared
         /// </summary>
         /// <param name="transmitter"></param>
         /// <param name="objectList"></param>
+        /// <param name="snapshots"></param>
         /// <returns></returns>
-        private Frame CreateFrame(NetworkFrameListTransmitter transmitter, NetworkObjectList objectList)
+        private Frame CreateFrame(NetworkFrameListTransmitter transmitter, NetworkObjectList objectList, SnapshotHistoryEntry snapshots)
         {
-            var previousFrame = transmitter.CurrentList?.FindFrameByListId(objectList.Id);
-
             var frame = new Frame(objectList.Id);
 
+            var previousFrame = transmitter.CurrentList?.FindFrameByListId(objectList.Id);
+
             transmitter.Listener.OnBeginProcessList(objectList);
 
             foreach (var networkObject in objectList.InternalNetworkObjects)
             {
                 if (networkObject.Destroyed)
                 {
-                    frame.CreateObjectDestruction(networkObject.Handle.Id);
+                    frame.CreateObjectDestruction(networkObject.Handle);
 
                     //Don't remove a destroyed object's data from previous frames, we may need to reconstruct it for lag compensation
                 }
-                else
+                else if (transmitter.Listener.FilterNetworkObject(objectList, networkObject))
+                {
+                    frame.AddUpdate(snapshots.GetOrCreateUpdate(objectList.Id, networkObject));
+                }
+                else if (previousFrame?.FindUpdateByObjectId(networkObject.Handle.Id)?.ObjectHandle == networkObject.Handle)
                 {
-                    if (transmitter.Listener.FilterNetworkObject(objectList, networkObject))
-                    {
-                        frame.CreateUpdate(networkObject, previousFrame);
-                    }
+                    //Filtered out after being sent, destroy it on the receiver so it isn't left frozen in its last state
+                    //It is created again if it passes the filter later on
+                    frame.CreateObjectDestruction(networkObject.Handle);
                 }
             }
 
@@ -133,12 +149,15 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.Transmiss
             //Only create frames for transmitters that are ready to transmit
             var transmitters = _transmitters.Where(transmitter => transmitter.Listener.CanTransmit).ToList();
 
+            //Objects are snapshotted once and shared between all transmitters
+            var snapshots = transmitters.Count > 0 ? _snapshotHistory.BeginEntry(_objectLists.Count) : null;
+
             //Create a frame list for each transmitter
             var frameListList = new FrameList[transmitters.Count];
 
             for (var i = 0; i < transmitters.Count; ++i)
             {
-                frameListList[i] = new FrameList();
+                frameListList[i] = new FrameList(snapshots);
             }
 
             //For each object list, create a frame for each transmitter
@@ -150,7 +169,7 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.Transmiss
                     var transmitter = transmitters[i];
                     var frameList = frameListList[i];
 
-                    frameList.AddFrame(CreateFrame(transmitter, objectList));
+                    frameList.AddFrame(CreateFrame(transmitter, objectList, snapshots));
                 }
 
                 objectList.PostFramesCreated();
@@ -160,6 +179,11 @@ namespace SharpLife.Networking.Shared.Communication.NetworkObjectLists.Transmiss
             {
                 transmitters[i].AddList(frameListList[i]);
             }
+
+            if (snapshots != null)
+            {
+                _snapshotHistory.EndEntry();
+            }
         }
     }
 }
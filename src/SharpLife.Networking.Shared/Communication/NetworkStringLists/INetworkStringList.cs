@@ -14,6 +14,8 @@
 ****/
 
 using Google.Protobuf;
+using System;
+using System.Collections.Generic;
 
 namespace SharpLife.Networking.Shared.Communication.NetworkStringLists
 {
@@ -29,6 +31,16 @@ namespace SharpLife.Networking.Shared.Communication.NetworkStringLists
         /// <exception cref="System.ArgumentNullException">If the given string is null</exception>
         int Add(string value, IMessage binaryData = null);
 
+        /// <summary>
+        /// Adds a set of strings to the list
+        /// Strings that already exist are skipped
+        /// Use this when adding many strings at once, such as precache lists during map load
+        /// </summary>
+        /// <param name="values"></param>
+        /// <param name="binaryDataFactory">Optional factory to create binary data for each string that is added</param>
+        /// <exception cref="System.ArgumentNullException">If the given list or any string in it is null</exception>
+        void AddRange(IReadOnlyList<string> values, Func<string, IMessage> binaryDataFactory = null);
+
         /// <summary>
         /// Sets binary data for the given string
         /// Changing the binary data object will not automatically network changes; call this again to send changes
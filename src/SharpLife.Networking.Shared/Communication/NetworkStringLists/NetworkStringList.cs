@@ -32,6 +32,11 @@ namespace SharpLife.Networking.Shared.Communication.NetworkStringLists
 
         private readonly List<StringData> _list = new List<StringData>();
 
+        /// <summary>
+        /// Maps strings to their index in <see cref="_list"/>
+        /// </summary>
+        private readonly Dictionary<string, int> _indices = new Dictionary<string, int>();
+
         private readonly IBinaryDataDescriptorSet _binaryDataDescriptorSet;
 
         public string Name { get; }
@@ -72,7 +77,7 @@ namespace SharpLife.Networking.Shared.Communication.NetworkStringLists
                 throw new ArgumentNullException(nameof(value));
             }
 
-            return _list.FindIndex(data => data.value == value);
+            return _indices.TryGetValue(value, out var index) ? index : -1;
         }
 
         public IMessage GetBinaryData(string value)
@@ -144,20 +149,63 @@ namespace SharpLife.Networking.Shared.Communication.NetworkStringLists
 
             if (index == -1)
             {
-                _list.Add(new StringData
+                index = InternalAdd(value, binaryData);
+            }
+
+            return index;
+        }
+
+        public void AddRange(IReadOnlyList<string> values, Func<string, IMessage> binaryDataFactory = null)
+        {
+            if (values == null)
+            {
+                throw new ArgumentNullException(nameof(values));
+            }
+
+            EnsureCapacity(_list.Count + values.Count);
+
+            foreach (var value in values)
+            {
+                if (IndexOf(value) == -1)
                 {
-                    value = value,
-                    binaryData = binaryData
-                });
+                    var binaryData = binaryDataFactory?.Invoke(value);
 
-                index = _list.Count - 1;
+                    CheckBinaryDataType(binaryData);
 
-                OnStringAdded?.Invoke(this, index);
+                    InternalAdd(value, binaryData);
+                }
             }
+        }
+
+        private int InternalAdd(string value, IMessage binaryData)
+        {
+            var index = _list.Count;
+
+            _list.Add(new StringData
+            {
+                value = value,
+                binaryData = binaryData
+            });
+
+            _indices.Add(value, index);
+
+            OnStringAdded?.Invoke(this, index);
 
             return index;
         }
 
+        /// <summary>
+        /// Ensures that the list can hold at least <paramref name="capacity"/> strings without resizing
+        /// </summary>
+        /// <param name="capacity"></param>
+        internal void EnsureCapacity(int capacity)
+        {
+            if (_list.Capacity < capacity)
+            {
+                _list.Capacity = capacity;
+            }
+        }
+
         public void SetBinaryData(string value, IMessage binaryData)
         {
             var index = IndexOf(value);
@@ -196,6 +244,8 @@ namespace SharpLife.Networking.Shared.Communication.NetworkStringLists
         {
             _list.Clear();
             _list.TrimExcess();
+
+            _indices.Clear();
         }
     }
 }
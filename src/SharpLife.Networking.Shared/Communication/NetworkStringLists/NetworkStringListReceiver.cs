@@ -19,6 +19,8 @@ using SharpLife.Networking.Shared.Communication.BinaryData;
 using SharpLife.Networking.Shared.Messages.NetworkStringLists;
 using System;
 using System.Collections.Generic;
+using System.IO;
+using System.IO.Compression;
 
 namespace SharpLife.Networking.Shared.Communication.NetworkStringLists
 {
@@ -26,6 +28,23 @@ namespace SharpLife.Networking.Shared.Communication.NetworkStringLists
     {
         private readonly Dictionary<uint, NetworkStringList> _idToListMap = new Dictionary<uint, NetworkStringList>();
 
+        /// <summary>
+        /// Compressed full update that is being received in chunks
+        /// </summary>
+        private sealed class PendingFullUpdate
+        {
+            public uint listId;
+            public byte[] data;
+            public int receivedSize;
+
+            /// <summary>
+            /// Updates for the list that were received before the full update was complete
+            /// </summary>
+            public List<NetworkStringListUpdate> deferredUpdates = new List<NetworkStringListUpdate>();
+        }
+
+        private PendingFullUpdate _pendingFullUpdate;
+
         public NetworkStringListReceiver(BinaryDataReceptionDescriptorSet descriptorSet, IReadOnlyList<NetworkStringList> lists)
             : base(descriptorSet, lists)
         {
@@ -46,6 +65,8 @@ namespace SharpLife.Networking.Shared.Communication.NetworkStringLists
 
         private void ProcessStringData(RepeatedField<ListStringData> strings, NetworkStringList list)
         {
+            list.EnsureCapacity(list.Count + strings.Count);
+
             foreach (var data in strings)
             {
                 list.Add(data.Value, ParseBinaryData(data.BinaryData));
@@ -66,6 +87,108 @@ namespace SharpLife.Networking.Shared.Communication.NetworkStringLists
             ProcessStringData(update.Strings, list);
         }
 
+        /// <summary>
+        /// Decompresses a full update
+        /// The compressed size is limited separately, this limits the size of the output so small updates can't expand without bound
+        /// </summary>
+        /// <param name="data"></param>
+        /// <exception cref="InvalidDataException">If the data is not valid or decompresses to more than the maximum size</exception>
+        private static MemoryStream Decompress(byte[] data)
+        {
+            var decompressed = new MemoryStream();
+
+            using (var decompressor = new DeflateStream(new MemoryStream(data, false), CompressionMode.Decompress))
+            {
+                var buffer = new byte[4096];
+
+                int bytesRead;
+
+                while ((bytesRead = decompressor.Read(buffer, 0, buffer.Length)) > 0)
+                {
+                    if (decompressed.Length + bytesRead > NetConstants.MaxStringListDecompressedFullUpdateSize)
+                    {
+                        throw new InvalidDataException($"String list full update decompresses to more than {NetConstants.MaxStringListDecompressedFullUpdateSize} bytes");
+                    }
+
+                    decompressed.Write(buffer, 0, bytesRead);
+                }
+            }
+
+            decompressed.Position = 0;
+
+            return decompressed;
+        }
+
+        /// <summary>
+        /// Processes a chunk of a compressed full update
+        /// </summary>
+        /// <param name="chunk"></param>
+        /// <returns>Whether the full update is complete and has been processed</returns>
+        /// <exception cref="InvalidOperationException">If the chunk is invalid</exception>
+        public bool ProcessFullUpdateChunk(NetworkStringListFullUpdateChunk chunk)
+        {
+            if (chunk == null)
+            {
+                throw new ArgumentNullException(nameof(chunk));
+            }
+
+            if (chunk.Offset == 0)
+            {
+                if (chunk.TotalSize > NetConstants.MaxStringListFullUpdateSize)
+                {
+                    throw new InvalidOperationException($"String list full update is too large ({chunk.TotalSize} bytes, maximum {NetConstants.MaxStringListFullUpdateSize})");
+                }
+
+                _pendingFullUpdate = new PendingFullUpdate
+                {
+                    listId = chunk.ListId,
+                    data = new byte[chunk.TotalSize]
+                };
+            }
+
+            var pending = _pendingFullUpdate;
+
+            //Chunks are sent reliably and in order so they should always follow on from the previous chunk
+            if (pending == null
+                || pending.listId != chunk.ListId
+                || pending.data.Length != chunk.TotalSize
+                || pending.receivedSize != chunk.Offset
+                || pending.receivedSize + chunk.Data.Length > pending.data.Length)
+            {
+                throw new InvalidOperationException($"Received out of order full update chunk for list {chunk.ListId}");
+            }
+
+            chunk.Data.CopyTo(pending.data, pending.receivedSize);
+            pending.receivedSize += chunk.Data.Length;
+
+            if (pending.receivedSize < pending.data.Length)
+            {
+                return false;
+            }
+
+            _pendingFullUpdate = null;
+
+            NetworkStringListFullUpdate update;
+
+            try
+            {
+                update = NetworkStringListFullUpdate.Parser.ParseFrom(Decompress(pending.data));
+            }
+            catch (Exception e) when (e is InvalidDataException || e is InvalidProtocolBufferException)
+            {
+                throw new InvalidOperationException($"Could not decompress full update for list {chunk.ListId}", e);
+            }
+
+            ProcessFullUpdate(update);
+
+            foreach (var deferred in pending.deferredUpdates)
+            {
+                ProcessUpdate(deferred);
+            }
+
+            return true;
+        }
+
         public void ProcessUpdate(NetworkStringListUpdate update)
         {
             if (update == null)
@@ -73,6 +196,13 @@ namespace SharpLife.Networking.Shared.Communication.NetworkStringLists
                 throw new ArgumentNullException(nameof(update));
             }
 
+            //The server sends updates made while a full update is still being sent, apply them once the full update has been processed
+            if (_pendingFullUpdate?.listId == update.ListId)
+            {
+                _pendingFullUpdate.deferredUpdates.Add(update);
+                return;
+            }
+
             if (!_idToListMap.TryGetValue(update.ListId, out var list))
             {
                 throw new ArgumentOutOfRangeException(nameof(update), "Update has invalid list id");
@@ -19,6 +19,7 @@ using SharpLife.Networking.Shared.Messages.NetworkStringLists;
 using System;
 using System.Collections.Generic;
 using System.IO;
+using System.IO.Compression;
 
 namespace SharpLife.Networking.Shared.Communication.NetworkStringLists
 {
@@ -30,6 +31,11 @@ namespace SharpLife.Networking.Shared.Communication.NetworkStringLists
 
             public List<int> changedStrings = new List<int>();
 
+            /// <summary>
+            /// Compressed full update shared by all clients, null if the list has changed since it was created
+            /// </summary>
+            public IReadOnlyList<NetworkStringListFullUpdateChunk> fullUpdateChunks;
+
             public bool HasChanges => addedStrings.Count > 0 || changedStrings.Count > 0;
 
             public void Clear()
@@ -66,6 +72,7 @@ namespace SharpLife.Networking.Shared.Communication.NetworkStringLists
             var data = _listData[internalList.Index];
 
             data.addedStrings.Add(index);
+            data.fullUpdateChunks = null;
         }
 
         private void OnBinaryDataChanged(IReadOnlyNetworkStringList stringList, int index)
@@ -75,6 +82,7 @@ namespace SharpLife.Networking.Shared.Communication.NetworkStringLists
             var data = _listData[internalList.Index];
 
             data.changedStrings.Add(index);
+            data.fullUpdateChunks = null;
         }
 
         private ListBinaryData CreateBinaryDataFor(Stream stream, NetworkStringList list, int index)
@@ -137,6 +145,74 @@ namespace SharpLife.Networking.Shared.Communication.NetworkStringLists
             return update;
         }
 
+        /// <summary>
+        /// Gets the full update for the given table, compressed and split into chunks
+        /// The chunks are created once and shared by all clients until the list changes
+        /// </summary>
+        /// <param name="index"></param>
+        public IReadOnlyList<NetworkStringListFullUpdateChunk> GetFullUpdateChunks(int index)
+        {
+            if (index < 0 || index >= Count)
+            {
+                throw new ArgumentOutOfRangeException(nameof(index));
+            }
+
+            var data = _listData[index];
+
+            if (data.fullUpdateChunks == null)
+            {
+                data.fullUpdateChunks = CreateFullUpdateChunks(index);
+            }
+
+            return data.fullUpdateChunks;
+        }
+
+        private IReadOnlyList<NetworkStringListFullUpdateChunk> CreateFullUpdateChunks(int index)
+        {
+            var update = CreateFullUpdate(index);
+
+            var updateSize = update.CalculateSize();
+
+            //Clients reject updates that decompress to more than this
+            if (updateSize > NetConstants.MaxStringListDecompressedFullUpdateSize)
+            {
+                throw new InvalidOperationException($"String list {update.Name} full update is too large ({updateSize} bytes, maximum {NetConstants.MaxStringListDecompressedFullUpdateSize})");
+            }
+
+            var compressedData = new MemoryStream();
+
+            using (var compressor = new DeflateStream(compressedData, CompressionLevel.Fastest, true))
+            {
+                update.WriteTo(compressor);
+            }
+
+            var buffer = compressedData.GetBuffer();
+            var totalSize = (int)compressedData.Length;
+
+            var chunks = new List<NetworkStringListFullUpdateChunk>((totalSize / NetConstants.StringListChunkSize) + 1);
+
+            var offset = 0;
+
+            //Always send at least one chunk so empty lists still get a full update
+            do
+            {
+                var size = Math.Min(NetConstants.StringListChunkSize, totalSize - offset);
+
+                chunks.Add(new NetworkStringListFullUpdateChunk
+                {
+                    ListId = (uint)index,
+                    TotalSize = (uint)totalSize,
+                    Offset = (uint)offset,
+                    Data = ByteString.CopyFrom(buffer, offset, size)
+                });
+
+                offset += size;
+            }
+            while (offset < totalSize);
+
+            return chunks;
+        }
+
         /// <summary>
         /// Create list updates and update listeners
         /// </summary>
@@ -0,0 +1,163 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using System;
+using System.Diagnostics;
+using System.Net;
+
+namespace SharpLife.Networking.Shared.Communication.Queries
+{
+    /// <summary>
+    /// Runs simulated query traffic through a responder to measure its cost and how well it holds up against floods
+    /// Legitimate senders request a challenge and then alternate between info and player queries,
+    /// spoofed senders use random addresses and challenges
+    /// Time is simulated, so rate limits behave as they would at the given query rate
+    /// </summary>
+    public sealed class QueryBenchmark
+    {
+        private readonly QueryResponder _responder = new QueryResponder();
+
+        /// <summary>
+        /// Creates a new benchmark
+        /// </summary>
+        /// <param name="infoResponse"></param>
+        /// <param name="playersResponse"></param>
+        /// <param name="addressRate">Maximum number of queries per second per address, or 0 for no limit</param>
+        /// <param name="globalRate">Maximum number of queries per second in total, or 0 for no limit</param>
+        public QueryBenchmark(byte[] infoResponse, byte[] playersResponse, int addressRate, int globalRate)
+        {
+            _responder.SetResponses(
+                infoResponse ?? throw new ArgumentNullException(nameof(infoResponse)),
+                playersResponse ?? throw new ArgumentNullException(nameof(playersResponse)));
+
+            _responder.RateLimiter.AddressRate = addressRate;
+            _responder.RateLimiter.GlobalRate = globalRate;
+        }
+
+        /// <summary>
+        /// Runs the benchmark
+        /// </summary>
+        /// <param name="queryCount">Total number of queries to send</param>
+        /// <param name="senderCount">Number of legitimate senders</param>
+        /// <param name="queriesPerSecond">Rate at which queries arrive</param>
+        /// <param name="spoofedFraction">Fraction of queries that have a spoofed sender address</param>
+        public QueryBenchmarkResults Run(int queryCount, int senderCount, double queriesPerSecond, double spoofedFraction)
+        {
+            if (queryCount < 0)
+            {
+                throw new ArgumentOutOfRangeException(nameof(queryCount));
+            }
+
+            if (senderCount <= 0)
+            {
+                throw new ArgumentOutOfRangeException(nameof(senderCount));
+            }
+
+            if (queriesPerSecond <= 0)
+            {
+                throw new ArgumentOutOfRangeException(nameof(queriesPerSecond));
+            }
+
+            var results = new QueryBenchmarkResults();
+
+            //Fixed seed so runs can be compared
+            var random = new Random(0);
+
+            var senders = new IPEndPoint[senderCount];
+            var challenges = new uint[senderCount];
+            var nextTypes = new QueryType[senderCount];
+
+            for (var i = 0; i < senderCount; ++i)
+            {
+                senders[i] = new IPEndPoint(new IPAddress(new byte[] { 10, (byte)(i >> 16), (byte)(i >> 8), (byte)i }), NetConstants.DefaultClientPort);
+                nextTypes[i] = QueryType.Info;
+            }
+
+            var spoofedAddress = new byte[4];
+
+            for (var i = 0; i < queryCount; ++i)
+            {
+                var currentTime = i / queriesPerSecond;
+
+                var spoofed = random.NextDouble() < spoofedFraction;
+
+                IPEndPoint sender;
+                byte[] request;
+                var senderIndex = i % senderCount;
+
+                if (spoofed)
+                {
+                    random.NextBytes(spoofedAddress);
+
+                    sender = new IPEndPoint(new IPAddress(spoofedAddress), random.Next(1024, 65536));
+                    request = QueryProtocol.CreateRequest(random.Next(2) == 0 ? QueryType.Info : QueryType.Players, (uint)random.Next());
+                }
+                else
+                {
+                    sender = senders[senderIndex];
+                    request = QueryProtocol.CreateRequest(nextTypes[senderIndex], challenges[senderIndex]);
+                }
+
+                var startAllocated = GC.GetAllocatedBytesForCurrentThread();
+                var startTime = Stopwatch.GetTimestamp();
+
+                var result = _responder.HandleRequest(sender, request, request.Length, currentTime, out var response, out var responseLength);
+
+                results.Handling.Add(Stopwatch.GetTimestamp() - startTime, GC.GetAllocatedBytesForCurrentThread() - startAllocated);
+
+                ++results.Queries;
+                results.RequestBytes += request.Length;
+                results.ResponseBytes += responseLength;
+
+                if (spoofed)
+                {
+                    results.SpoofedRequestBytes += request.Length;
+                    results.SpoofedResponseBytes += responseLength;
+                }
+
+                switch (result)
+                {
+                    case QueryResult.Answered:
+                        ++results.Answered;
+
+                        if (!spoofed)
+                        {
+                            nextTypes[senderIndex] = nextTypes[senderIndex] == QueryType.Info ? QueryType.Players : QueryType.Info;
+                        }
+                        break;
+
+                    case QueryResult.Challenged:
+                        ++results.Challenged;
+
+                        if (!spoofed)
+                        {
+                            challenges[senderIndex] = QueryProtocol.ReadChallenge(response);
+                        }
+                        break;
+
+                    case QueryResult.RateLimited:
+                        ++results.RateLimited;
+                        break;
+
+                    default:
+                        ++results.Ignored;
+                        break;
+                }
+            }
+
+            return results;
+        }
+    }
+}
@@ -0,0 +1,58 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using SharpLife.Networking.Shared.Communication.Capture;
+
+namespace SharpLife.Networking.Shared.Communication.Queries
+{
+    public sealed class QueryBenchmarkResults
+    {
+        public int Queries { get; internal set; }
+
+        public int Answered { get; internal set; }
+
+        public int Challenged { get; internal set; }
+
+        public int RateLimited { get; internal set; }
+
+        public int Ignored { get; internal set; }
+
+        public long RequestBytes { get; internal set; }
+
+        public long ResponseBytes { get; internal set; }
+
+        /// <summary>
+        /// Bytes received in queries with spoofed sender addresses
+        /// </summary>
+        public long SpoofedRequestBytes { get; internal set; }
+
+        /// <summary>
+        /// Bytes sent to spoofed sender addresses
+        /// </summary>
+        public long SpoofedResponseBytes { get; internal set; }
+
+        /// <summary>
+        /// How many bytes an attacker can get sent to someone else per byte they send
+        /// </summary>
+        public double SpoofedAmplification => SpoofedRequestBytes > 0 ? (double)SpoofedResponseBytes / SpoofedRequestBytes : 0;
+
+        public TrafficBenchmarkCounter Handling { get; } = new TrafficBenchmarkCounter();
+
+        /// <summary>
+        /// Number of queries that a single thread can handle per second, based on the measured cost
+        /// </summary>
+        public double MaxQueriesPerSecond => Handling.AverageNanoseconds > 0 ? 1.0e9 / Handling.AverageNanoseconds : 0;
+    }
+}
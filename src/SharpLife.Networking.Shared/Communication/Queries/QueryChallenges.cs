@@ -0,0 +1,134 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using System;
+using System.Net;
+using System.Security.Cryptography;
+
+namespace SharpLife.Networking.Shared.Communication.Queries
+{
+    /// <summary>
+    /// Creates and validates query challenges
+    /// A challenge is a keyed hash of the sender's address and port, so nothing needs to be stored per sender
+    /// Only someone that can receive packets at an address can know its challenge, which prevents spoofed queries from being answered
+    /// </summary>
+    public sealed class QueryChallenges
+    {
+        /// <summary>
+        /// Time after which the secret is replaced, in seconds
+        /// Challenges created with the previous secret remain valid until it is replaced again
+        /// </summary>
+        public const double SecretLifetime = 30;
+
+        /// <summary>
+        /// Size of the secret keys, in bytes
+        /// </summary>
+        private const int SecretSize = 32;
+
+        /// <summary>
+        /// Large enough for an IPv6 address followed by the port
+        /// </summary>
+        private const int MaxEndPointSize = 16 + sizeof(ushort);
+
+        private readonly RandomNumberGenerator _random = RandomNumberGenerator.Create();
+
+        private readonly byte[] _endPointBytes = new byte[MaxEndPointSize];
+
+        private readonly byte[] _hash = new byte[256 / 8];
+
+        private HMACSHA256 _secret;
+
+        private HMACSHA256 _previousSecret;
+
+        private double _nextRotationTime = double.NegativeInfinity;
+
+        private void UpdateSecret(double currentTime)
+        {
+            if (currentTime < _nextRotationTime)
+            {
+                return;
+            }
+
+            var key = new byte[SecretSize];
+
+            _random.GetBytes(key);
+
+            if (!ReferenceEquals(_previousSecret, _secret))
+            {
+                _previousSecret?.Dispose();
+            }
+
+            _previousSecret = _secret;
+            _secret = new HMACSHA256(key);
+
+            //Rotate both if there was a long gap so old challenges don't remain valid
+            if (_previousSecret == null || currentTime >= _nextRotationTime + SecretLifetime)
+            {
+                _previousSecret?.Dispose();
+                _previousSecret = _secret;
+            }
+
+            _nextRotationTime = currentTime + SecretLifetime;
+        }
+
+        private uint Compute(HMACSHA256 secret, IPEndPoint endPoint)
+        {
+            if (!endPoint.Address.TryWriteBytes(_endPointBytes, out var length))
+            {
+                throw new ArgumentException("Address is too large", nameof(endPoint));
+            }
+
+            _endPointBytes[length++] = (byte)(endPoint.Port >> 8);
+            _endPointBytes[length++] = (byte)endPoint.Port;
+
+            if (!secret.TryComputeHash(new ReadOnlySpan<byte>(_endPointBytes, 0, length), _hash, out _))
+            {
+                throw new InvalidOperationException("Couldn't compute challenge hash");
+            }
+
+            //0 means no challenge
+            return BitConverter.ToUInt32(_hash, 0) | 1;
+        }
+
+        public uint Create(IPEndPoint endPoint, double currentTime)
+        {
+            if (endPoint == null)
+            {
+                throw new ArgumentNullException(nameof(endPoint));
+            }
+
+            UpdateSecret(currentTime);
+
+            return Compute(_secret, endPoint);
+        }
+
+        public bool Validate(IPEndPoint endPoint, uint challenge, double currentTime)
+        {
+            if (endPoint == null)
+            {
+                throw new ArgumentNullException(nameof(endPoint));
+            }
+
+            if (challenge == 0)
+            {
+                return false;
+            }
+
+            UpdateSecret(currentTime);
+
+            return challenge == Compute(_secret, endPoint) || challenge == Compute(_previousSecret, endPoint);
+        }
+    }
+}
@@ -0,0 +1,187 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Text;
+
+namespace SharpLife.Networking.Shared.Communication.Queries
+{
+    /// <summary>
+    /// Layout of query packets
+    /// Queries are sent as unconnected packets, so they don't go through the message list used on connections
+    /// Every packet starts with <see cref="Magic"/> followed by the <see cref="QueryType"/>
+    /// Requests then contain the challenge, or 0 if the sender doesn't have one yet, and are padded to <see cref="RequestSize"/>
+    /// </summary>
+    public static class QueryProtocol
+    {
+        /// <summary>
+        /// "SLQR"
+        /// </summary>
+        public const uint Magic = 0x52514C53;
+
+        public const int HeaderSize = sizeof(uint) + sizeof(byte);
+
+        /// <summary>
+        /// Size of a request, including padding
+        /// Challenges are never larger than this, so spoofed requests can't be used to send more data to someone than the attacker sent
+        /// </summary>
+        public const int RequestSize = 16;
+
+        public const int ChallengeResponseSize = HeaderSize + sizeof(uint);
+
+        /// <summary>
+        /// Responses must fit in a single packet since unconnected packets are not fragmented
+        /// </summary>
+        public const int MaxResponseSize = 1200;
+
+        private static readonly Encoding StringEncoding = new UTF8Encoding(false);
+
+        /// <summary>
+        /// Reads the header of a packet
+        /// </summary>
+        /// <param name="data"></param>
+        /// <param name="length"></param>
+        /// <param name="type"></param>
+        /// <returns>Whether the packet is a query packet</returns>
+        public static bool TryReadHeader(byte[] data, int length, out QueryType type)
+        {
+            if (data == null)
+            {
+                throw new ArgumentNullException(nameof(data));
+            }
+
+            if (length < HeaderSize || BitConverter.ToUInt32(data, 0) != Magic)
+            {
+                type = default;
+                return false;
+            }
+
+            type = (QueryType)data[sizeof(uint)];
+            return true;
+        }
+
+        public static uint ReadChallenge(byte[] data)
+        {
+            return BitConverter.ToUInt32(data, HeaderSize);
+        }
+
+        private static void WriteHeader(BinaryWriter writer, QueryType type)
+        {
+            writer.Write(Magic);
+            writer.Write((byte)type);
+        }
+
+        /// <summary>
+        /// Creates a request
+        /// </summary>
+        /// <param name="type"></param>
+        /// <param name="challenge">Challenge received from the server, or 0 to ask for one</param>
+        public static byte[] CreateRequest(QueryType type, uint challenge)
+        {
+            var data = new byte[RequestSize];
+
+            using (var writer = new BinaryWriter(new MemoryStream(data)))
+            {
+                WriteHeader(writer, type);
+                writer.Write(challenge);
+            }
+
+            return data;
+        }
+
+        /// <summary>
+        /// Writes a challenge response into the given buffer
+        /// </summary>
+        /// <param name="buffer">Buffer of at least <see cref="ChallengeResponseSize"/> bytes</param>
+        /// <param name="challenge"></param>
+        public static void WriteChallengeResponse(byte[] buffer, uint challenge)
+        {
+            using (var writer = new BinaryWriter(new MemoryStream(buffer)))
+            {
+                WriteHeader(writer, QueryType.Challenge);
+                writer.Write(challenge);
+            }
+        }
+
+        public static byte[] CreateInfoResponse(string hostName, string mapName, string gameDirectory, int playerCount, int maxPlayers)
+        {
+            using (var stream = new MemoryStream())
+            {
+                using (var writer = new BinaryWriter(stream, StringEncoding, true))
+                {
+                    WriteHeader(writer, QueryType.Info);
+                    writer.Write(NetConstants.ProtocolVersion);
+                    writer.Write(hostName ?? throw new ArgumentNullException(nameof(hostName)));
+                    writer.Write(mapName ?? throw new ArgumentNullException(nameof(mapName)));
+                    writer.Write(gameDirectory ?? throw new ArgumentNullException(nameof(gameDirectory)));
+                    writer.Write((byte)playerCount);
+                    writer.Write((byte)maxPlayers);
+                }
+
+                return stream.ToArray();
+            }
+        }
+
+        /// <summary>
+        /// Creates a player list response
+        /// Players that don't fit in a single packet are left out
+        /// </summary>
+        /// <param name="players"></param>
+        public static byte[] CreatePlayersResponse(IReadOnlyList<QueryPlayer> players)
+        {
+            if (players == null)
+            {
+                throw new ArgumentNullException(nameof(players));
+            }
+
+            using (var stream = new MemoryStream())
+            {
+                using (var writer = new BinaryWriter(stream, StringEncoding, true))
+                {
+                    WriteHeader(writer, QueryType.Players);
+
+                    var countPosition = stream.Position;
+                    writer.Write((byte)0);
+
+                    var count = 0;
+
+                    foreach (var player in players)
+                    {
+                        var position = stream.Position;
+
+                        writer.Write(player.Name ?? string.Empty);
+                        writer.Write(player.ConnectedTime);
+                        writer.Flush();
+
+                        if (stream.Length > MaxResponseSize || count == byte.MaxValue)
+                        {
+                            stream.SetLength(position);
+                            break;
+                        }
+
+                        ++count;
+                    }
+
+                    stream.Position = countPosition;
+                    writer.Write((byte)count);
+                }
+
+                return stream.ToArray();
+            }
+        }
+    }
+}
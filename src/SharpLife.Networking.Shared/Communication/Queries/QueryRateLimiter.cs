@@ -0,0 +1,165 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using System;
+using System.Collections.Generic;
+using System.Net;
+
+namespace SharpLife.Networking.Shared.Communication.Queries
+{
+    /// <summary>
+    /// Limits the number of queries that are answered, both per sender address and in total
+    /// Addresses that haven't sent a query in a while are forgotten so the amount of memory used stays bounded
+    /// </summary>
+    public sealed class QueryRateLimiter
+    {
+        /// <summary>
+        /// Maximum number of addresses to keep track of
+        /// When this many addresses are being tracked, new addresses are only limited by the global rate
+        /// </summary>
+        public const int MaxTrackedAddresses = 4096;
+
+        /// <summary>
+        /// Time after which an address that hasn't sent any queries is forgotten, in seconds
+        /// </summary>
+        public const double IdleTime = 10;
+
+        /// <summary>
+        /// Maximum amount of time that unused queries can accumulate for, in seconds
+        /// </summary>
+        public const double MaxBurstTime = 1;
+
+        private struct Bucket
+        {
+            public double tokens;
+            public double lastTime;
+        }
+
+        private readonly Dictionary<IPAddress, Bucket> _buckets = new Dictionary<IPAddress, Bucket>();
+
+        private readonly List<IPAddress> _expiredAddresses = new List<IPAddress>();
+
+        private Bucket _global = new Bucket { lastTime = double.NaN };
+
+        private double _nextPurgeTime;
+
+        /// <summary>
+        /// Maximum number of queries per second to answer for a single address
+        /// 0 if there is no limit
+        /// </summary>
+        public int AddressRate { get; set; }
+
+        /// <summary>
+        /// Maximum number of queries per second to answer in total
+        /// 0 if there is no limit
+        /// </summary>
+        public int GlobalRate { get; set; }
+
+        public int TrackedAddressCount => _buckets.Count;
+
+        private static bool TryConsume(ref Bucket bucket, int rate, double currentTime)
+        {
+            if (rate <= 0)
+            {
+                return true;
+            }
+
+            var capacity = Math.Max(1, rate * MaxBurstTime);
+
+            var elapsedTime = double.IsNaN(bucket.lastTime) ? MaxBurstTime : currentTime - bucket.lastTime;
+
+            bucket.tokens = Math.Min(bucket.tokens + (rate * elapsedTime), capacity);
+            bucket.lastTime = currentTime;
+
+            if (bucket.tokens < 1)
+            {
+                return false;
+            }
+
+            --bucket.tokens;
+            return true;
+        }
+
+        /// <summary>
+        /// Returns whether a query from the given address may be answered, and counts it if so
+        /// </summary>
+        /// <param name="address"></param>
+        /// <param name="currentTime"></param>
+        public bool TryConsume(IPAddress address, double currentTime)
+        {
+            if (address == null)
+            {
+                throw new ArgumentNullException(nameof(address));
+            }
+
+            var addressRate = AddressRate;
+
+            if (addressRate > 0)
+            {
+                var tracked = _buckets.TryGetValue(address, out var bucket);
+
+                if (!tracked)
+                {
+                    if (_buckets.Count >= MaxTrackedAddresses)
+                    {
+                        PurgeIdleAddresses(currentTime);
+                    }
+
+                    bucket.lastTime = double.NaN;
+                }
+
+                var allowed = TryConsume(ref bucket, addressRate, currentTime);
+
+                if (tracked || _buckets.Count < MaxTrackedAddresses)
+                {
+                    _buckets[address] = bucket;
+                }
+
+                if (!allowed)
+                {
+                    return false;
+                }
+            }
+
+            return TryConsume(ref _global, GlobalRate, currentTime);
+        }
+
+        private void PurgeIdleAddresses(double currentTime)
+        {
+            //Purging is linear in the number of addresses, so don't do it for every query during a flood
+            if (currentTime < _nextPurgeTime)
+            {
+                return;
+            }
+
+            _nextPurgeTime = currentTime + 1;
+
+            foreach (var entry in _buckets)
+            {
+                if (currentTime - entry.Value.lastTime >= IdleTime)
+                {
+                    _expiredAddresses.Add(entry.Key);
+                }
+            }
+
+            foreach (var address in _expiredAddresses)
+            {
+                _buckets.Remove(address);
+            }
+
+            _expiredAddresses.Clear();
+        }
+    }
+}
@@ -0,0 +1,123 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using System;
+using System.Net;
+
+namespace SharpLife.Networking.Shared.Communication.Queries
+{
+    /// <summary>
+    /// Answers server queries from prebuilt responses
+    /// Responses are built on the main thread whenever the information in them changes,
+    /// requests are handled on the network thread without touching any game state
+    /// </summary>
+    public sealed class QueryResponder
+    {
+        private readonly QueryChallenges _challenges = new QueryChallenges();
+
+        private readonly byte[] _challengeResponse = new byte[QueryProtocol.ChallengeResponseSize];
+
+        private volatile byte[] _infoResponse;
+
+        private volatile byte[] _playersResponse;
+
+        public QueryRateLimiter RateLimiter { get; } = new QueryRateLimiter();
+
+        /// <summary>
+        /// Replaces the responses
+        /// Can be called from any thread
+        /// </summary>
+        /// <param name="infoResponse">Response to info queries, created by <see cref="QueryProtocol.CreateInfoResponse"/>. Null to not respond</param>
+        /// <param name="playersResponse">Response to player queries, created by <see cref="QueryProtocol.CreatePlayersResponse"/>. Null to not respond</param>
+        public void SetResponses(byte[] infoResponse, byte[] playersResponse)
+        {
+            _infoResponse = infoResponse;
+            _playersResponse = playersResponse;
+        }
+
+        /// <summary>
+        /// Handles a request
+        /// Must only be called from one thread at a time
+        /// </summary>
+        /// <param name="sender"></param>
+        /// <param name="data"></param>
+        /// <param name="length"></param>
+        /// <param name="currentTime">Time in seconds, used for rate limiting and challenges</param>
+        /// <param name="response">If not null, the data to send back. Only valid until the next call</param>
+        /// <param name="responseLength"></param>
+        public QueryResult HandleRequest(IPEndPoint sender, byte[] data, int length, double currentTime, out byte[] response, out int responseLength)
+        {
+            if (sender == null)
+            {
+                throw new ArgumentNullException(nameof(sender));
+            }
+
+            response = null;
+            responseLength = 0;
+
+            if (!QueryProtocol.TryReadHeader(data, length, out var type))
+            {
+                return QueryResult.NotAQuery;
+            }
+
+            //Short requests would allow responses larger than the request
+            if (length < QueryProtocol.RequestSize)
+            {
+                return QueryResult.Invalid;
+            }
+
+            byte[] answer;
+
+            switch (type)
+            {
+                case QueryType.Info:
+                    answer = _infoResponse;
+                    break;
+
+                case QueryType.Players:
+                    answer = _playersResponse;
+                    break;
+
+                default:
+                    return QueryResult.Invalid;
+            }
+
+            if (!RateLimiter.TryConsume(sender.Address, currentTime))
+            {
+                return QueryResult.RateLimited;
+            }
+
+            if (answer == null)
+            {
+                return QueryResult.Unavailable;
+            }
+
+            if (!_challenges.Validate(sender, QueryProtocol.ReadChallenge(data), currentTime))
+            {
+                QueryProtocol.WriteChallengeResponse(_challengeResponse, _challenges.Create(sender, currentTime));
+
+                response = _challengeResponse;
+                responseLength = _challengeResponse.Length;
+
+                return QueryResult.Challenged;
+            }
+
+            response = answer;
+            responseLength = answer.Length;
+
+            return QueryResult.Answered;
+        }
+    }
+}
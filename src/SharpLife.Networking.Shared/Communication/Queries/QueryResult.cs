@@ -0,0 +1,53 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+namespace SharpLife.Networking.Shared.Communication.Queries
+{
+    /// <summary>
+    /// How a query request was handled
+    /// </summary>
+    public enum QueryResult
+    {
+        /// <summary>
+        /// The packet is not a query
+        /// </summary>
+        NotAQuery = 0,
+
+        /// <summary>
+        /// The packet is a malformed query and was ignored
+        /// </summary>
+        Invalid,
+
+        /// <summary>
+        /// The sender has sent too many queries and was ignored
+        /// </summary>
+        RateLimited,
+
+        /// <summary>
+        /// The server is not running a map, there is nothing to respond with
+        /// </summary>
+        Unavailable,
+
+        /// <summary>
+        /// The query had no valid challenge, a challenge was sent back
+        /// </summary>
+        Challenged,
+
+        /// <summary>
+        /// The query was answered
+        /// </summary>
+        Answered
+    }
+}
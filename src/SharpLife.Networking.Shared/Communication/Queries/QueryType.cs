@@ -0,0 +1,36 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+namespace SharpLife.Networking.Shared.Communication.Queries
+{
+    public enum QueryType : byte
+    {
+        /// <summary>
+        /// Sent in response to a query without a valid challenge
+        /// The query has to be sent again with the challenge to get a response
+        /// </summary>
+        Challenge = 0,
+
+        /// <summary>
+        /// Server name, map and player count
+        /// </summary>
+        Info,
+
+        /// <summary>
+        /// Names of connected players
+        /// </summary>
+        Players
+    }
+}
@@ -0,0 +1,180 @@
+﻿/***
+*
+*	Copyright (c) 1996-2001, Valve LLC. All rights reserved.
+*	
+*	This product contains software technology licensed from Id 
+*	Software, Inc. ("Id Technology").  Id Technology (c) 1996 Id Software, Inc. 
+*	All Rights Reserved.
+*
+*   This source code contains proprietary and confidential information of
+*   Valve LLC and its suppliers.  Access to this code is restricted to
+*   persons who have executed a written SDK license with Valve.  Any access,
+*   use or distribution of this code by or to any unlicensed person is illegal.
+*
+****/
+
+using SharpLife.Networking.Shared.Communication.NetworkObjectLists.Frames;
+using SharpLife.Networking.Shared.Communication.NetworkObjectLists.MetaData;
+using SharpLife.Networking.Shared.Communication.NetworkObjectLists.Reception;
+using SharpLife.Networking.Shared.Messages.NetworkObjectLists;
+using System;
+using System.Collections.Generic;
+
+namespace SharpLife.Networking.Shared.Communication.Relay
+{
+    /// <summary>
+    /// Decodes the frame lists a relay receives from a game server and encodes them again for spectators
+    /// Spectators that have acknowledged the same frame list get the same encoded message,
+    /// so the cost of encoding depends on the number of distinct baselines instead of the number of spectators
+    /// </summary>
+    public sealed class RelayFrameListCache
+    {
+        private readonly TypeRegistry _typeRegistry;
+
+        private readonly int _maxFrameLists;
+
+        private readonly FrameSerializer _frameSerializer = new FrameSerializer();
+
+        /// <summary>
+        /// Encoded messages for <see cref="_encodedSequence"/>, by baseline sequence
+        /// 0 is the full update
+        /// </summary>
+        private readonly Dictionary<uint, NetworkObjectListFrameListUpdate> _encodedLists = new Dictionary<uint, NetworkObjectListFrameListUpdate>();
+
+        private uint _encodedSequence;
+
+        private NetworkObjectListReceiver _receiver;
+
+        /// <summary>
+        /// Whether the list metadata has been received and frame lists can be decoded
+        /// </summary>
+        public bool HasListMetaData => _receiver != null;
+
+        /// <summary>
+        /// Creates a new cache
+        /// </summary>
+        /// <param name="typeRegistry">Registry to decode objects with. Must have the game server's metadata</param>
+        /// <param name="maxFrameLists">Number of frame lists to keep
+        /// Must cover the relay's delay as well as the time it takes for spectators to acknowledge frame lists</param>
+        public RelayFrameListCache(TypeRegistry typeRegistry, int maxFrameLists)
+        {
+            _typeRegistry = typeRegistry ?? throw new ArgumentNullException(nameof(typeRegistry));
+
+            if (maxFrameLists <= 0)
+            {
+                throw new ArgumentOutOfRangeException(nameof(maxFrameLists));
+            }
+
+            _maxFrameLists = maxFrameLists;
+        }
+
+        /// <summary>
+        /// Sets up the object lists for a new map
+        /// Discards all frame lists
+        /// </summary>
+        /// <param name="message"></param>
+        public void DeserializeListMetaData(NetworkObjectListListMetaDataList message)
+        {
+            if (message == null)
+            {
+                throw new ArgumentNullException(nameof(message));
+            }
+
+            _receiver = new NetworkObjectListReceiver(_typeRegistry, _maxFrameLists, NullFrameListReceiverListener.Instance);
+            _receiver.DeserializeListMetaData(message);
+
+            _encodedLists.Clear();
+            _encodedSequence = 0;
+        }
+
+        /// <summary>
+        /// Decodes a frame list received from the game server
+        /// </summary>
+        /// <param name="message"></param>
+        /// <returns>Whether the frame list was decoded and should be acknowledged</returns>
+        public bool AddFrameList(NetworkObjectListFrameListUpdate message)
+        {
+            if (message == null)
+            {
+                throw new ArgumentNullException(nameof(message));
+            }
+
+            return _receiver?.DeserializeFrameList(message) == true;
+        }
+
+        /// <summary>
+        /// Gets a frame list encoded for a spectator
+        /// </summary>
+        /// <param name="sequence">Sequence of the frame list to send</param>
+        /// <param name="acknowledgedSequence">Sequence of the newest frame list the spectator has acknowledged, or 0 if none</param>
+        /// <returns>The encoded frame list, or null if it is no longer available
+        /// The message is shared between spectators and must not be modified</returns>
+        public NetworkObjectListFrameListUpdate GetFrameList(uint sequence, uint acknowledgedSequence)
+        {
+            var frameList = _receiver?.FindListBySequence(sequence);
+
+            if (frameList == null)
+            {
+                return null;
+            }
+
+            if (sequence != _encodedSequence)
+            {
+                _encodedLists.Clear();
+                _encodedSequence = sequence;
+            }
+
+            //The spectator falls back to a full update if its baseline has fallen out of the cache
+            var baseline = acknowledgedSequence != 0 && acknowledgedSequence < sequence ? _receiver.FindListBySequence(acknowledgedSequence) : null;
+
+            var baselineSequence = baseline?.Sequence ?? 0;
+
+            if (!_encodedLists.TryGetValue(baselineSequence, out var message))
+            {
+                message = Encode(frameList, baselineSequence, baseline);
+
+                _encodedLists.Add(baselineSequence, message);
+            }
+
+            return message;
+        }
+
+        private NetworkObjectListFrameListUpdate Encode(FrameList frameList, uint baselineSequence, FrameList baseline)
+        {
+            var message = frameList.SerializeFrames(_receiver, baseline, _frameSerializer);
+
+            message.ServerTime = frameList.ServerTime;
+
+            //Destructions are only part of the frame list the object was destroyed in,
+            //so include those of every list the spectator hasn't acknowledged yet
+            //Without a baseline the spectator may still have objects from before it fell behind, so include all of them
+            for (var i = 0; i < _receiver.FrameListCount; ++i)
+            {
+                var previous = _receiver.GetFrameList(i);
+
+                if (previous.Sequence <= baselineSequence || previous.Sequence >= frameList.Sequence)
+                {
+                    continue;
+                }
+
+                foreach (var previousFrame in previous.Frames)
+                {
+                    if (previousFrame.DestroyedObjects.Count == 0)
+                    {
+                        continue;
+                    }
+
+                    foreach (var frameMessage in message.Frames)
+                    {
+                        if (frameMessage.ListId == (uint)previousFrame.ListId)
+                        {
+                            frameMessage.ObjectsDestroyed.AddRange(previousFrame.DestroyedObjects);
+                        }
+                    }
+                }
+            }
+
+            return message;
+        }
+    }
+}
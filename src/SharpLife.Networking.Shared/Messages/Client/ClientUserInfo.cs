@@ -25,12 +25,13 @@ namespace SharpLife.Networking.Shared.Messages.Client {
       byte[] descriptorData = global::System.Convert.FromBase64String(
           string.Concat(
             "ChRDbGllbnRVc2VySW5mby5wcm90bxIrU2hhcnBMaWZlLk5ldHdvcmtpbmcu",
-            "U2hhcmVkLk1lc3NhZ2VzLkNsaWVudCIeCg5DbGllbnRVc2VySW5mbxIMCgRu",
-            "YW1lGAEgASgJYgZwcm90bzM="));
+            "U2hhcmVkLk1lc3NhZ2VzLkNsaWVudCJBCg5DbGllbnRVc2VySW5mbxIMCgRu",
+            "YW1lGAEgASgJEgwKBHJhdGUYAiABKA0SEwoLbG9vcGJhY2tfaWQYAyABKARi",
+            "BnByb3RvMw=="));
       descriptor = pbr::FileDescriptor.FromGeneratedCode(descriptorData,
           new pbr::FileDescriptor[] { },
           new pbr::GeneratedClrTypeInfo(null, new pbr::GeneratedClrTypeInfo[] {
-            new pbr::GeneratedClrTypeInfo(typeof(global::SharpLife.Networking.Shared.Messages.Client.ClientUserInfo), global::SharpLife.Networking.Shared.Messages.Client.ClientUserInfo.Parser, new[]{ "Name" }, null, null, null)
+            new pbr::GeneratedClrTypeInfo(typeof(global::SharpLife.Networking.Shared.Messages.Client.ClientUserInfo), global::SharpLife.Networking.Shared.Messages.Client.ClientUserInfo.Parser, new[]{ "Name", "Rate", "LoopbackId" }, null, null, null)
           }));
     }
     #endregion
@@ -39,6 +40,7 @@ namespace SharpLife.Networking.Shared.Messages.Client {
   #region Messages
   /// <summary>
   ///The initial message sent to the server during client connection
+  ///Sent again when any of it changes while connected
   /// </summary>
   public sealed partial class ClientUserInfo : pb::IMessage<ClientUserInfo> {
     private static readonly pb::MessageParser<ClientUserInfo> _parser = new pb::MessageParser<ClientUserInfo>(() => new ClientUserInfo());
@@ -66,6 +68,8 @@ namespace SharpLife.Networking.Shared.Messages.Client {
     [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
     public ClientUserInfo(ClientUserInfo other) : this() {
       name_ = other.name_;
+      rate_ = other.rate_;
+      loopbackId_ = other.loopbackId_;
       _unknownFields = pb::UnknownFieldSet.Clone(other._unknownFields);
     }
 
@@ -88,6 +92,34 @@ namespace SharpLife.Networking.Shared.Messages.Client {
       }
     }
 
+    /// <summary>Field number for the "rate" field.</summary>
+    public const int RateFieldNumber = 2;
+    private uint rate_;
+    /// <summary>
+    ///Maximum number of bytes per second that the client wants to receive
+    /// </summary>
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public uint Rate {
+      get { return rate_; }
+      set {
+        rate_ = value;
+      }
+    }
+
+    /// <summary>Field number for the "loopback_id" field.</summary>
+    public const int LoopbackIdFieldNumber = 3;
+    private ulong loopbackId_;
+    /// <summary>
+    ///Id of the listen server's loopback channel if this is the local client, 0 otherwise
+    /// </summary>
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public ulong LoopbackId {
+      get { return loopbackId_; }
+      set {
+        loopbackId_ = value;
+      }
+    }
+
     [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
     public override bool Equals(object other) {
       return Equals(other as ClientUserInfo);
@@ -102,6 +134,8 @@ namespace SharpLife.Networking.Shared.Messages.Client {
         return true;
       }
       if (Name != other.Name) return false;
+      if (Rate != other.Rate) return false;
+      if (LoopbackId != other.LoopbackId) return false;
       return Equals(_unknownFields, other._unknownFields);
     }
 
@@ -109,6 +143,8 @@ namespace SharpLife.Networking.Shared.Messages.Client {
     public override int GetHashCode() {
       int hash = 1;
       if (Name.Length != 0) hash ^= Name.GetHashCode();
+      if (Rate != 0) hash ^= Rate.GetHashCode();
+      if (LoopbackId != 0UL) hash ^= LoopbackId.GetHashCode();
       if (_unknownFields != null) {
         hash ^= _unknownFields.GetHashCode();
       }
@@ -126,6 +162,14 @@ namespace SharpLife.Networking.Shared.Messages.Client {
         output.WriteRawTag(10);
         output.WriteString(Name);
       }
+      if (Rate != 0) {
+        output.WriteRawTag(16);
+        output.WriteUInt32(Rate);
+      }
+      if (LoopbackId != 0UL) {
+        output.WriteRawTag(24);
+        output.WriteUInt64(LoopbackId);
+      }
       if (_unknownFields != null) {
         _unknownFields.WriteTo(output);
       }
@@ -137,6 +181,12 @@ namespace SharpLife.Networking.Shared.Messages.Client {
       if (Name.Length != 0) {
         size += 1 + pb::CodedOutputStream.ComputeStringSize(Name);
       }
+      if (Rate != 0) {
+        size += 1 + pb::CodedOutputStream.ComputeUInt32Size(Rate);
+      }
+      if (LoopbackId != 0UL) {
+        size += 1 + pb::CodedOutputStream.ComputeUInt64Size(LoopbackId);
+      }
       if (_unknownFields != null) {
         size += _unknownFields.CalculateSize();
       }
@@ -151,6 +201,12 @@ namespace SharpLife.Networking.Shared.Messages.Client {
       if (other.Name.Length != 0) {
         Name = other.Name;
       }
+      if (other.Rate != 0) {
+        Rate = other.Rate;
+      }
+      if (other.LoopbackId != 0UL) {
+        LoopbackId = other.LoopbackId;
+      }
       _unknownFields = pb::UnknownFieldSet.MergeFrom(_unknownFields, other._unknownFields);
     }
 
@@ -166,6 +222,14 @@ namespace SharpLife.Networking.Shared.Messages.Client {
             Name = input.ReadString();
             break;
           }
+          case 16: {
+            Rate = input.ReadUInt32();
+            break;
+          }
+          case 24: {
+            LoopbackId = input.ReadUInt64();
+            break;
+          }
         }
       }
     }
@@ -26,20 +26,24 @@ namespace SharpLife.Networking.Shared.Messages.NetworkObjectLists {
           string.Concat(
             "Ch9OZXR3b3JrT2JqZWN0TGlzdE1lc3NhZ2VzLnByb3RvEjdTaGFycExpZmUu",
             "TmV0d29ya2luZy5TaGFyZWQuTWVzc2FnZXMuTmV0d29ya09iamVjdExpc3Rz",
-            "IiYKEU9iamVjdERlc3RydWN0aW9uEhEKCW9iamVjdF9pZBgBIAEoDSKeAQoM",
-            "RnJhbWVNZXNzYWdlEg8KB2xpc3RfaWQYASABKA0SZQoRb2JqZWN0c19kZXN0",
-            "cm95ZWQYAiADKAsySi5TaGFycExpZmUuTmV0d29ya2luZy5TaGFyZWQuTWVz",
-            "c2FnZXMuTmV0d29ya09iamVjdExpc3RzLk9iamVjdERlc3RydWN0aW9uEhYK",
-            "Dm9iamVjdF91cGRhdGVzGAMgASgMInkKIE5ldHdvcmtPYmplY3RMaXN0RnJh",
-            "bWVMaXN0VXBkYXRlElUKBmZyYW1lcxgBIAMoCzJFLlNoYXJwTGlmZS5OZXR3",
-            "b3JraW5nLlNoYXJlZC5NZXNzYWdlcy5OZXR3b3JrT2JqZWN0TGlzdHMuRnJh",
-            "bWVNZXNzYWdlYgZwcm90bzM="));
+            "Ij0KEU9iamVjdERlc3RydWN0aW9uEhEKCW9iamVjdF9pZBgBIAEoDRIVCg1z",
+            "ZXJpYWxfbnVtYmVyGAIgASgFIp4BCgxGcmFtZU1lc3NhZ2USDwoHbGlzdF9p",
+            "ZBgBIAEoDRJlChFvYmplY3RzX2Rlc3Ryb3llZBgCIAMoCzJKLlNoYXJwTGlm",
+            "ZS5OZXR3b3JraW5nLlNoYXJlZC5NZXNzYWdlcy5OZXR3b3JrT2JqZWN0TGlz",
+            "dHMuT2JqZWN0RGVzdHJ1Y3Rpb24SFgoOb2JqZWN0X3VwZGF0ZXMYAyABKAwi",
+            "uwEKIE5ldHdvcmtPYmplY3RMaXN0RnJhbWVMaXN0VXBkYXRlElUKBmZyYW1l",
+            "cxgBIAMoCzJFLlNoYXJwTGlmZS5OZXR3b3JraW5nLlNoYXJlZC5NZXNzYWdl",
+            "cy5OZXR3b3JrT2JqZWN0TGlzdHMuRnJhbWVNZXNzYWdlEhMKC3NlcnZlcl90",
+            "aW1lGAIgASgBEhAKCHNlcXVlbmNlGAMgASgNEhkKEWJhc2VsaW5lX3NlcXVl",
+            "bmNlGAQgASgNIjEKHU5ldHdvcmtPYmplY3RMaXN0RnJhbWVMaXN0QWNrEhAK",
+            "CHNlcXVlbmNlGAEgASgNYgZwcm90bzM="));
       descriptor = pbr::FileDescriptor.FromGeneratedCode(descriptorData,
           new pbr::FileDescriptor[] { },
           new pbr::GeneratedClrTypeInfo(null, new pbr::GeneratedClrTypeInfo[] {
-            new pbr::GeneratedClrTypeInfo(typeof(global::SharpLife.Networking.Shared.Messages.NetworkObjectLists.ObjectDestruction), global::SharpLife.Networking.Shared.Messages.NetworkObjectLists.ObjectDestruction.Parser, new[]{ "ObjectId" }, null, null, null),
+            new pbr::GeneratedClrTypeInfo(typeof(global::SharpLife.Networking.Shared.Messages.NetworkObjectLists.ObjectDestruction), global::SharpLife.Networking.Shared.Messages.NetworkObjectLists.ObjectDestruction.Parser, new[]{ "ObjectId", "SerialNumber" }, null, null, null),
             new pbr::GeneratedClrTypeInfo(typeof(global::SharpLife.Networking.Shared.Messages.NetworkObjectLists.FrameMessage), global::SharpLife.Networking.Shared.Messages.NetworkObjectLists.FrameMessage.Parser, new[]{ "ListId", "ObjectsDestroyed", "ObjectUpdates" }, null, null, null),
-            new pbr::GeneratedClrTypeInfo(typeof(global::SharpLife.Networking.Shared.Messages.NetworkObjectLists.NetworkObjectListFrameListUpdate), global::SharpLife.Networking.Shared.Messages.NetworkObjectLists.NetworkObjectListFrameListUpdate.Parser, new[]{ "Frames" }, null, null, null)
+            new pbr::GeneratedClrTypeInfo(typeof(global::SharpLife.Networking.Shared.Messages.NetworkObjectLists.NetworkObjectListFrameListUpdate), global::SharpLife.Networking.Shared.Messages.NetworkObjectLists.NetworkObjectListFrameListUpdate.Parser, new[]{ "Frames", "ServerTime", "Sequence", "BaselineSequence" }, null, null, null),
+            new pbr::GeneratedClrTypeInfo(typeof(global::SharpLife.Networking.Shared.Messages.NetworkObjectLists.NetworkObjectListFrameListAck), global::SharpLife.Networking.Shared.Messages.NetworkObjectLists.NetworkObjectListFrameListAck.Parser, new[]{ "Sequence" }, null, null, null)
           }));
     }
     #endregion
@@ -72,6 +76,7 @@ namespace SharpLife.Networking.Shared.Messages.NetworkObjectLists {
     [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
     public ObjectDestruction(ObjectDestruction other) : this() {
       objectId_ = other.objectId_;
+      serialNumber_ = other.serialNumber_;
       _unknownFields = pb::UnknownFieldSet.Clone(other._unknownFields);
     }
 
@@ -91,6 +96,20 @@ namespace SharpLife.Networking.Shared.Messages.NetworkObjectLists {
       }
     }
 
+    /// <summary>Field number for the "serial_number" field.</summary>
+    public const int SerialNumberFieldNumber = 2;
+    private int serialNumber_;
+    /// <summary>
+    ///Destructions are resent until acknowledged, so the id may have been reused by then
+    /// </summary>
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public int SerialNumber {
+      get { return serialNumber_; }
+      set {
+        serialNumber_ = value;
+      }
+    }
+
     [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
     public override bool Equals(object other) {
       return Equals(other as ObjectDestruction);
@@ -105,6 +124,7 @@ namespace SharpLife.Networking.Shared.Messages.NetworkObjectLists {
         return true;
       }
       if (ObjectId != other.ObjectId) return false;
+      if (SerialNumber != other.SerialNumber) return false;
       return Equals(_unknownFields, other._unknownFields);
     }
 
@@ -112,6 +132,7 @@ namespace SharpLife.Networking.Shared.Messages.NetworkObjectLists {
     public override int GetHashCode() {
       int hash = 1;
       if (ObjectId != 0) hash ^= ObjectId.GetHashCode();
+      if (SerialNumber != 0) hash ^= SerialNumber.GetHashCode();
       if (_unknownFields != null) {
         hash ^= _unknownFields.GetHashCode();
       }
@@ -129,6 +150,10 @@ namespace SharpLife.Networking.Shared.Messages.NetworkObjectLists {
         output.WriteRawTag(8);
         output.WriteUInt32(ObjectId);
       }
+      if (SerialNumber != 0) {
+        output.WriteRawTag(16);
+        output.WriteInt32(SerialNumber);
+      }
       if (_unknownFields != null) {
         _unknownFields.WriteTo(output);
       }
@@ -140,6 +165,9 @@ namespace SharpLife.Networking.Shared.Messages.NetworkObjectLists {
       if (ObjectId != 0) {
         size += 1 + pb::CodedOutputStream.ComputeUInt32Size(ObjectId);
       }
+      if (SerialNumber != 0) {
+        size += 1 + pb::CodedOutputStream.ComputeInt32Size(SerialNumber);
+      }
       if (_unknownFields != null) {
         size += _unknownFields.CalculateSize();
       }
@@ -154,6 +182,9 @@ namespace SharpLife.Networking.Shared.Messages.NetworkObjectLists {
       if (other.ObjectId != 0) {
         ObjectId = other.ObjectId;
       }
+      if (other.SerialNumber != 0) {
+        SerialNumber = other.SerialNumber;
+      }
       _unknownFields = pb::UnknownFieldSet.MergeFrom(_unknownFields, other._unknownFields);
     }
 
@@ -169,6 +200,10 @@ namespace SharpLife.Networking.Shared.Messages.NetworkObjectLists {
             ObjectId = input.ReadUInt32();
             break;
           }
+          case 16: {
+            SerialNumber = input.ReadInt32();
+            break;
+          }
         }
       }
     }
@@ -378,6 +413,9 @@ namespace SharpLife.Networking.Shared.Messages.NetworkObjectLists {
     [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
     public NetworkObjectListFrameListUpdate(NetworkObjectListFrameListUpdate other) : this() {
       frames_ = other.frames_.Clone();
+      serverTime_ = other.serverTime_;
+      sequence_ = other.sequence_;
+      baselineSequence_ = other.baselineSequence_;
       _unknownFields = pb::UnknownFieldSet.Clone(other._unknownFields);
     }
 
@@ -396,6 +434,49 @@ namespace SharpLife.Networking.Shared.Messages.NetworkObjectLists {
       get { return frames_; }
     }
 
+    /// <summary>Field number for the "server_time" field.</summary>
+    public const int ServerTimeFieldNumber = 2;
+    private double serverTime_;
+    /// <summary>
+    ///Server time when the frames were created
+    /// </summary>
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public double ServerTime {
+      get { return serverTime_; }
+      set {
+        serverTime_ = value;
+      }
+    }
+
+    /// <summary>Field number for the "sequence" field.</summary>
+    public const int SequenceFieldNumber = 3;
+    private uint sequence_;
+    /// <summary>
+    ///Starts at 1, increases by one for every frame list
+    /// </summary>
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public uint Sequence {
+      get { return sequence_; }
+      set {
+        sequence_ = value;
+      }
+    }
+
+    /// <summary>Field number for the "baseline_sequence" field.</summary>
+    public const int BaselineSequenceFieldNumber = 4;
+    private uint baselineSequence_;
+    /// <summary>
+    ///Sequence of the acknowledged frame list that the frames are delta encoded against
+    ///0 if this is a full update
+    /// </summary>
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public uint BaselineSequence {
+      get { return baselineSequence_; }
+      set {
+        baselineSequence_ = value;
+      }
+    }
+
     [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
     public override bool Equals(object other) {
       return Equals(other as NetworkObjectListFrameListUpdate);
@@ -410,6 +491,9 @@ namespace SharpLife.Networking.Shared.Messages.NetworkObjectLists {
         return true;
       }
       if(!frames_.Equals(other.frames_)) return false;
+      if (!pbc::ProtobufEqualityComparers.BitwiseDoubleEqualityComparer.Equals(ServerTime, other.ServerTime)) return false;
+      if (Sequence != other.Sequence) return false;
+      if (BaselineSequence != other.BaselineSequence) return false;
       return Equals(_unknownFields, other._unknownFields);
     }
 
@@ -417,6 +501,9 @@ namespace SharpLife.Networking.Shared.Messages.NetworkObjectLists {
     public override int GetHashCode() {
       int hash = 1;
       hash ^= frames_.GetHashCode();
+      if (ServerTime != 0D) hash ^= pbc::ProtobufEqualityComparers.BitwiseDoubleEqualityComparer.GetHashCode(ServerTime);
+      if (Sequence != 0) hash ^= Sequence.GetHashCode();
+      if (BaselineSequence != 0) hash ^= BaselineSequence.GetHashCode();
       if (_unknownFields != null) {
         hash ^= _unknownFields.GetHashCode();
       }
@@ -431,6 +518,18 @@ namespace SharpLife.Networking.Shared.Messages.NetworkObjectLists {
     [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
     public void WriteTo(pb::CodedOutputStream output) {
       frames_.WriteTo(output, _repeated_frames_codec);
+      if (ServerTime != 0D) {
+        output.WriteRawTag(17);
+        output.WriteDouble(ServerTime);
+      }
+      if (Sequence != 0) {
+        output.WriteRawTag(24);
+        output.WriteUInt32(Sequence);
+      }
+      if (BaselineSequence != 0) {
+        output.WriteRawTag(32);
+        output.WriteUInt32(BaselineSequence);
+      }
       if (_unknownFields != null) {
         _unknownFields.WriteTo(output);
       }
@@ -440,6 +539,15 @@ namespace SharpLife.Networking.Shared.Messages.NetworkObjectLists {
     public int CalculateSize() {
       int size = 0;
       size += frames_.CalculateSize(_repeated_frames_codec);
+      if (ServerTime != 0D) {
+        size += 1 + 8;
+      }
+      if (Sequence != 0) {
+        size += 1 + pb::CodedOutputStream.ComputeUInt32Size(Sequence);
+      }
+      if (BaselineSequence != 0) {
+        size += 1 + pb::CodedOutputStream.ComputeUInt32Size(BaselineSequence);
+      }
       if (_unknownFields != null) {
         size += _unknownFields.CalculateSize();
       }
@@ -452,6 +560,15 @@ namespace SharpLife.Networking.Shared.Messages.NetworkObjectLists {
         return;
       }
       frames_.Add(other.frames_);
+      if (other.ServerTime != 0D) {
+        ServerTime = other.ServerTime;
+      }
+      if (other.Sequence != 0) {
+        Sequence = other.Sequence;
+      }
+      if (other.BaselineSequence != 0) {
+        BaselineSequence = other.BaselineSequence;
+      }
       _unknownFields = pb::UnknownFieldSet.MergeFrom(_unknownFields, other._unknownFields);
     }
 
@@ -467,6 +584,150 @@ namespace SharpLife.Networking.Shared.Messages.NetworkObjectLists {
             frames_.AddEntriesFrom(input, _repeated_frames_codec);
             break;
           }
+          case 17: {
+            ServerTime = input.ReadDouble();
+            break;
+          }
+          case 24: {
+            Sequence = input.ReadUInt32();
+            break;
+          }
+          case 32: {
+            BaselineSequence = input.ReadUInt32();
+            break;
+          }
+        }
+      }
+    }
+
+  }
+
+  /// <summary>
+  ///Sent by the client for every frame list it has received and applied
+  /// </summary>
+  public sealed partial class NetworkObjectListFrameListAck : pb::IMessage<NetworkObjectListFrameListAck> {
+    private static readonly pb::MessageParser<NetworkObjectListFrameListAck> _parser = new pb::MessageParser<NetworkObjectListFrameListAck>(() => new NetworkObjectListFrameListAck());
+    private pb::UnknownFieldSet _unknownFields;
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public static pb::MessageParser<NetworkObjectListFrameListAck> Parser { get { return _parser; } }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public static pbr::MessageDescriptor Descriptor {
+      get { return global::SharpLife.Networking.Shared.Messages.NetworkObjectLists.NetworkObjectListMessagesReflection.Descriptor.MessageTypes[3]; }
+    }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    pbr::MessageDescriptor pb::IMessage.Descriptor {
+      get { return Descriptor; }
+    }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public NetworkObjectListFrameListAck() {
+      OnConstruction();
+    }
+
+    partial void OnConstruction();
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public NetworkObjectListFrameListAck(NetworkObjectListFrameListAck other) : this() {
+      sequence_ = other.sequence_;
+      _unknownFields = pb::UnknownFieldSet.Clone(other._unknownFields);
+    }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public NetworkObjectListFrameListAck Clone() {
+      return new NetworkObjectListFrameListAck(this);
+    }
+
+    /// <summary>Field number for the "sequence" field.</summary>
+    public const int SequenceFieldNumber = 1;
+    private uint sequence_;
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public uint Sequence {
+      get { return sequence_; }
+      set {
+        sequence_ = value;
+      }
+    }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public override bool Equals(object other) {
+      return Equals(other as NetworkObjectListFrameListAck);
+    }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public bool Equals(NetworkObjectListFrameListAck other) {
+      if (ReferenceEquals(other, null)) {
+        return false;
+      }
+      if (ReferenceEquals(other, this)) {
+        return true;
+      }
+      if (Sequence != other.Sequence) return false;
+      return Equals(_unknownFields, other._unknownFields);
+    }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public override int GetHashCode() {
+      int hash = 1;
+      if (Sequence != 0) hash ^= Sequence.GetHashCode();
+      if (_unknownFields != null) {
+        hash ^= _unknownFields.GetHashCode();
+      }
+      return hash;
+    }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public override string ToString() {
+      return pb::JsonFormatter.ToDiagnosticString(this);
+    }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public void WriteTo(pb::CodedOutputStream output) {
+      if (Sequence != 0) {
+        output.WriteRawTag(8);
+        output.WriteUInt32(Sequence);
+      }
+      if (_unknownFields != null) {
+        _unknownFields.WriteTo(output);
+      }
+    }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public int CalculateSize() {
+      int size = 0;
+      if (Sequence != 0) {
+        size += 1 + pb::CodedOutputStream.ComputeUInt32Size(Sequence);
+      }
+      if (_unknownFields != null) {
+        size += _unknownFields.CalculateSize();
+      }
+      return size;
+    }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public void MergeFrom(NetworkObjectListFrameListAck other) {
+      if (other == null) {
+        return;
+      }
+      if (other.Sequence != 0) {
+        Sequence = other.Sequence;
+      }
+      _unknownFields = pb::UnknownFieldSet.MergeFrom(_unknownFields, other._unknownFields);
+    }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public void MergeFrom(pb::CodedInputStream input) {
+      uint tag;
+      while ((tag = input.ReadTag()) != 0) {
+        switch(tag) {
+          default:
+            _unknownFields = pb::UnknownFieldSet.MergeFieldFrom(_unknownFields, input);
+            break;
+          case 8: {
+            Sequence = input.ReadUInt32();
+            break;
+          }
         }
       }
     }
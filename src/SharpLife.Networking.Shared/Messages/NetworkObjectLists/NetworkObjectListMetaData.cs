@@ -32,17 +32,21 @@ namespace SharpLife.Networking.Shared.Messages.NetworkObjectLists {
             "Lk1lc3NhZ2VzLk5ldHdvcmtPYmplY3RMaXN0cy5PYmplY3RNZW1iZXIigQEK",
             "I05ldHdvcmtPYmplY3RMaXN0T2JqZWN0TWV0YURhdGFMaXN0EloKCW1ldGFf",
             "ZGF0YRgBIAMoCzJHLlNoYXJwTGlmZS5OZXR3b3JraW5nLlNoYXJlZC5NZXNz",
-            "YWdlcy5OZXR3b3JrT2JqZWN0TGlzdHMuT2JqZWN0TWV0YURhdGEiLQoMTGlz",
-            "dE1ldGFEYXRhEg8KB2xpc3RfaWQYASABKA0SDAoEbmFtZRgCIAEoCSJ9CiFO",
-            "ZXR3b3JrT2JqZWN0TGlzdExpc3RNZXRhRGF0YUxpc3QSWAoJbWV0YV9kYXRh",
-            "GAEgAygLMkUuU2hhcnBMaWZlLk5ldHdvcmtpbmcuU2hhcmVkLk1lc3NhZ2Vz",
-            "Lk5ldHdvcmtPYmplY3RMaXN0cy5MaXN0TWV0YURhdGFiBnByb3RvMw=="));
+            "YWdlcy5OZXR3b3JrT2JqZWN0TGlzdHMuT2JqZWN0TWV0YURhdGEiMwojTmV0",
+            "d29ya09iamVjdExpc3RPYmplY3RNZXRhRGF0YUhhc2gSDAoEaGFzaBgBIAEo",
+            "DCIoCiZOZXR3b3JrT2JqZWN0TGlzdE9iamVjdE1ldGFEYXRhUmVxdWVzdCIt",
+            "CgxMaXN0TWV0YURhdGESDwoHbGlzdF9pZBgBIAEoDRIMCgRuYW1lGAIgASgJ",
+            "In0KIU5ldHdvcmtPYmplY3RMaXN0TGlzdE1ldGFEYXRhTGlzdBJYCgltZXRh",
+            "X2RhdGEYASADKAsyRS5TaGFycExpZmUuTmV0d29ya2luZy5TaGFyZWQuTWVz",
+            "c2FnZXMuTmV0d29ya09iamVjdExpc3RzLkxpc3RNZXRhRGF0YWIGcHJvdG8z"));
       descriptor = pbr::FileDescriptor.FromGeneratedCode(descriptorData,
           new pbr::FileDescriptor[] { },
           new pbr::GeneratedClrTypeInfo(null, new pbr::GeneratedClrTypeInfo[] {
             new pbr::GeneratedClrTypeInfo(typeof(global::SharpLife.Networking.Shared.Messages.NetworkObjectLists.ObjectMember), global::SharpLife.Networking.Shared.Messages.NetworkObjectLists.ObjectMember.Parser, new[]{ "TypeId" }, null, null, null),
             new pbr::GeneratedClrTypeInfo(typeof(global::SharpLife.Networking.Shared.Messages.NetworkObjectLists.ObjectMetaData), global::SharpLife.Networking.Shared.Messages.NetworkObjectLists.ObjectMetaData.Parser, new[]{ "TypeId", "TypeName", "Members" }, null, null, null),
             new pbr::GeneratedClrTypeInfo(typeof(global::SharpLife.Networking.Shared.Messages.NetworkObjectLists.NetworkObjectListObjectMetaDataList), global::SharpLife.Networking.Shared.Messages.NetworkObjectLists.NetworkObjectListObjectMetaDataList.Parser, new[]{ "MetaData" }, null, null, null),
+            new pbr::GeneratedClrTypeInfo(typeof(global::SharpLife.Networking.Shared.Messages.NetworkObjectLists.NetworkObjectListObjectMetaDataHash), global::SharpLife.Networking.Shared.Messages.NetworkObjectLists.NetworkObjectListObjectMetaDataHash.Parser, new[]{ "Hash" }, null, null, null),
+            new pbr::GeneratedClrTypeInfo(typeof(global::SharpLife.Networking.Shared.Messages.NetworkObjectLists.NetworkObjectListObjectMetaDataRequest), global::SharpLife.Networking.Shared.Messages.NetworkObjectLists.NetworkObjectListObjectMetaDataRequest.Parser, null, null, null, null),
             new pbr::GeneratedClrTypeInfo(typeof(global::SharpLife.Networking.Shared.Messages.NetworkObjectLists.ListMetaData), global::SharpLife.Networking.Shared.Messages.NetworkObjectLists.ListMetaData.Parser, new[]{ "ListId", "Name" }, null, null, null),
             new pbr::GeneratedClrTypeInfo(typeof(global::SharpLife.Networking.Shared.Messages.NetworkObjectLists.NetworkObjectListListMetaDataList), global::SharpLife.Networking.Shared.Messages.NetworkObjectLists.NetworkObjectListListMetaDataList.Parser, new[]{ "MetaData" }, null, null, null)
           }));
@@ -478,6 +482,243 @@ namespace SharpLife.Networking.Shared.Messages.NetworkObjectLists {
 
   }
 
+  /// <summary>
+  ///Identifies the server's object metadata list
+  ///Clients that have received the list with this hash before reuse it instead of requesting it
+  /// </summary>
+  public sealed partial class NetworkObjectListObjectMetaDataHash : pb::IMessage<NetworkObjectListObjectMetaDataHash> {
+    private static readonly pb::MessageParser<NetworkObjectListObjectMetaDataHash> _parser = new pb::MessageParser<NetworkObjectListObjectMetaDataHash>(() => new NetworkObjectListObjectMetaDataHash());
+    private pb::UnknownFieldSet _unknownFields;
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public static pb::MessageParser<NetworkObjectListObjectMetaDataHash> Parser { get { return _parser; } }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public static pbr::MessageDescriptor Descriptor {
+      get { return global::SharpLife.Networking.Shared.Messages.NetworkObjectLists.NetworkObjectListMetaDataReflection.Descriptor.MessageTypes[3]; }
+    }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    pbr::MessageDescriptor pb::IMessage.Descriptor {
+      get { return Descriptor; }
+    }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public NetworkObjectListObjectMetaDataHash() {
+      OnConstruction();
+    }
+
+    partial void OnConstruction();
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public NetworkObjectListObjectMetaDataHash(NetworkObjectListObjectMetaDataHash other) : this() {
+      hash_ = other.hash_;
+      _unknownFields = pb::UnknownFieldSet.Clone(other._unknownFields);
+    }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public NetworkObjectListObjectMetaDataHash Clone() {
+      return new NetworkObjectListObjectMetaDataHash(this);
+    }
+
+    /// <summary>Field number for the "hash" field.</summary>
+    public const int HashFieldNumber = 1;
+    private pb::ByteString hash_ = pb::ByteString.Empty;
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public pb::ByteString Hash {
+      get { return hash_; }
+      set {
+        hash_ = pb::ProtoPreconditions.CheckNotNull(value, "value");
+      }
+    }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public override bool Equals(object other) {
+      return Equals(other as NetworkObjectListObjectMetaDataHash);
+    }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public bool Equals(NetworkObjectListObjectMetaDataHash other) {
+      if (ReferenceEquals(other, null)) {
+        return false;
+      }
+      if (ReferenceEquals(other, this)) {
+        return true;
+      }
+      if (Hash != other.Hash) return false;
+      return Equals(_unknownFields, other._unknownFields);
+    }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public override int GetHashCode() {
+      int hash = 1;
+      if (Hash.Length != 0) hash ^= Hash.GetHashCode();
+      if (_unknownFields != null) {
+        hash ^= _unknownFields.GetHashCode();
+      }
+      return hash;
+    }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public override string ToString() {
+      return pb::JsonFormatter.ToDiagnosticString(this);
+    }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public void WriteTo(pb::CodedOutputStream output) {
+      if (Hash.Length != 0) {
+        output.WriteRawTag(10);
+        output.WriteBytes(Hash);
+      }
+      if (_unknownFields != null) {
+        _unknownFields.WriteTo(output);
+      }
+    }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public int CalculateSize() {
+      int size = 0;
+      if (Hash.Length != 0) {
+        size += 1 + pb::CodedOutputStream.ComputeBytesSize(Hash);
+      }
+      if (_unknownFields != null) {
+        size += _unknownFields.CalculateSize();
+      }
+      return size;
+    }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public void MergeFrom(NetworkObjectListObjectMetaDataHash other) {
+      if (other == null) {
+        return;
+      }
+      if (other.Hash.Length != 0) {
+        Hash = other.Hash;
+      }
+      _unknownFields = pb::UnknownFieldSet.MergeFrom(_unknownFields, other._unknownFields);
+    }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public void MergeFrom(pb::CodedInputStream input) {
+      uint tag;
+      while ((tag = input.ReadTag()) != 0) {
+        switch(tag) {
+          default:
+            _unknownFields = pb::UnknownFieldSet.MergeFieldFrom(_unknownFields, input);
+            break;
+          case 10: {
+            Hash = input.ReadBytes();
+            break;
+          }
+        }
+      }
+    }
+
+  }
+
+  /// <summary>
+  ///Sent by clients that don't have the object metadata list with the hash sent by the server
+  /// </summary>
+  public sealed partial class NetworkObjectListObjectMetaDataRequest : pb::IMessage<NetworkObjectListObjectMetaDataRequest> {
+    private static readonly pb::MessageParser<NetworkObjectListObjectMetaDataRequest> _parser = new pb::MessageParser<NetworkObjectListObjectMetaDataRequest>(() => new NetworkObjectListObjectMetaDataRequest());
+    private pb::UnknownFieldSet _unknownFields;
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public static pb::MessageParser<NetworkObjectListObjectMetaDataRequest> Parser { get { return _parser; } }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public static pbr::MessageDescriptor Descriptor {
+      get { return global::SharpLife.Networking.Shared.Messages.NetworkObjectLists.NetworkObjectListMetaDataReflection.Descriptor.MessageTypes[4]; }
+    }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    pbr::MessageDescriptor pb::IMessage.Descriptor {
+      get { return Descriptor; }
+    }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public NetworkObjectListObjectMetaDataRequest() {
+      OnConstruction();
+    }
+
+    partial void OnConstruction();
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public NetworkObjectListObjectMetaDataRequest(NetworkObjectListObjectMetaDataRequest other) : this() {
+      _unknownFields = pb::UnknownFieldSet.Clone(other._unknownFields);
+    }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public NetworkObjectListObjectMetaDataRequest Clone() {
+      return new NetworkObjectListObjectMetaDataRequest(this);
+    }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public override bool Equals(object other) {
+      return Equals(other as NetworkObjectListObjectMetaDataRequest);
+    }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public bool Equals(NetworkObjectListObjectMetaDataRequest other) {
+      if (ReferenceEquals(other, null)) {
+        return false;
+      }
+      if (ReferenceEquals(other, this)) {
+        return true;
+      }
+      return Equals(_unknownFields, other._unknownFields);
+    }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public override int GetHashCode() {
+      int hash = 1;
+      if (_unknownFields != null) {
+        hash ^= _unknownFields.GetHashCode();
+      }
+      return hash;
+    }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public override string ToString() {
+      return pb::JsonFormatter.ToDiagnosticString(this);
+    }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public void WriteTo(pb::CodedOutputStream output) {
+      if (_unknownFields != null) {
+        _unknownFields.WriteTo(output);
+      }
+    }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public int CalculateSize() {
+      int size = 0;
+      if (_unknownFields != null) {
+        size += _unknownFields.CalculateSize();
+      }
+      return size;
+    }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public void MergeFrom(NetworkObjectListObjectMetaDataRequest other) {
+      if (other == null) {
+        return;
+      }
+      _unknownFields = pb::UnknownFieldSet.MergeFrom(_unknownFields, other._unknownFields);
+    }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public void MergeFrom(pb::CodedInputStream input) {
+      uint tag;
+      while ((tag = input.ReadTag()) != 0) {
+        switch(tag) {
+          default:
+            _unknownFields = pb::UnknownFieldSet.MergeFieldFrom(_unknownFields, input);
+            break;
+        }
+      }
+    }
+
+  }
+
   public sealed partial class ListMetaData : pb::IMessage<ListMetaData> {
     private static readonly pb::MessageParser<ListMetaData> _parser = new pb::MessageParser<ListMetaData>(() => new ListMetaData());
     private pb::UnknownFieldSet _unknownFields;
@@ -486,7 +727,7 @@ namespace SharpLife.Networking.Shared.Messages.NetworkObjectLists {
 
     [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
     public static pbr::MessageDescriptor Descriptor {
-      get { return global::SharpLife.Networking.Shared.Messages.NetworkObjectLists.NetworkObjectListMetaDataReflection.Descriptor.MessageTypes[3]; }
+      get { return global::SharpLife.Networking.Shared.Messages.NetworkObjectLists.NetworkObjectListMetaDataReflection.Descriptor.MessageTypes[5]; }
     }
 
     [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
@@ -643,7 +884,7 @@ namespace SharpLife.Networking.Shared.Messages.NetworkObjectLists {
 
     [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
     public static pbr::MessageDescriptor Descriptor {
-      get { return global::SharpLife.Networking.Shared.Messages.NetworkObjectLists.NetworkObjectListMetaDataReflection.Descriptor.MessageTypes[4]; }
+      get { return global::SharpLife.Networking.Shared.Messages.NetworkObjectLists.NetworkObjectListMetaDataReflection.Descriptor.MessageTypes[6]; }
     }
 
     [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
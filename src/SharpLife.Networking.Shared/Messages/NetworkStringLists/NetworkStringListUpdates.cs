@@ -36,13 +36,15 @@ namespace SharpLife.Networking.Shared.Messages.NetworkStringLists {
             "YXRhIpYBChtOZXR3b3JrU3RyaW5nTGlzdEZ1bGxVcGRhdGUSDwoHbGlzdF9p",
             "ZBgBIAEoDRIMCgRuYW1lGAIgASgJElgKB3N0cmluZ3MYAyADKAsyRy5TaGFy",
             "cExpZmUuTmV0d29ya2luZy5TaGFyZWQuTWVzc2FnZXMuTmV0d29ya1N0cmlu",
-            "Z0xpc3RzLkxpc3RTdHJpbmdEYXRhIuQBChdOZXR3b3JrU3RyaW5nTGlzdFVw",
-            "ZGF0ZRIPCgdsaXN0X2lkGAEgASgNElgKB3N0cmluZ3MYAiADKAsyRy5TaGFy",
-            "cExpZmUuTmV0d29ya2luZy5TaGFyZWQuTWVzc2FnZXMuTmV0d29ya1N0cmlu",
-            "Z0xpc3RzLkxpc3RTdHJpbmdEYXRhEl4KB3VwZGF0ZXMYAyADKAsyTS5TaGFy",
-            "cExpZmUuTmV0d29ya2luZy5TaGFyZWQuTWVzc2FnZXMuTmV0d29ya1N0cmlu",
-            "Z0xpc3RzLkxpc3RTdHJpbmdEYXRhVXBkYXRlIiYKJE5ldHdvcmtTdHJpbmdM",
-            "aXN0RnVsbFVwZGF0ZXNDb21wbGV0ZWIGcHJvdG8z"));
+            "Z0xpc3RzLkxpc3RTdHJpbmdEYXRhImUKIE5ldHdvcmtTdHJpbmdMaXN0RnVs",
+            "bFVwZGF0ZUNodW5rEg8KB2xpc3RfaWQYASABKA0SEgoKdG90YWxfc2l6ZRgC",
+            "IAEoDRIOCgZvZmZzZXQYAyABKA0SDAoEZGF0YRgEIAEoDCLkAQoXTmV0d29y",
+            "a1N0cmluZ0xpc3RVcGRhdGUSDwoHbGlzdF9pZBgBIAEoDRJYCgdzdHJpbmdz",
+            "GAIgAygLMkcuU2hhcnBMaWZlLk5ldHdvcmtpbmcuU2hhcmVkLk1lc3NhZ2Vz",
+            "Lk5ldHdvcmtTdHJpbmdMaXN0cy5MaXN0U3RyaW5nRGF0YRJeCgd1cGRhdGVz",
+            "GAMgAygLMk0uU2hhcnBMaWZlLk5ldHdvcmtpbmcuU2hhcmVkLk1lc3NhZ2Vz",
+            "Lk5ldHdvcmtTdHJpbmdMaXN0cy5MaXN0U3RyaW5nRGF0YVVwZGF0ZSImCiRO",
+            "ZXR3b3JrU3RyaW5nTGlzdEZ1bGxVcGRhdGVzQ29tcGxldGViBnByb3RvMw=="));
       descriptor = pbr::FileDescriptor.FromGeneratedCode(descriptorData,
           new pbr::FileDescriptor[] { },
           new pbr::GeneratedClrTypeInfo(null, new pbr::GeneratedClrTypeInfo[] {
@@ -50,6 +52,7 @@ namespace SharpLife.Networking.Shared.Messages.NetworkStringLists {
             new pbr::GeneratedClrTypeInfo(typeof(global::SharpLife.Networking.Shared.Messages.NetworkStringLists.ListStringData), global::SharpLife.Networking.Shared.Messages.NetworkStringLists.ListStringData.Parser, new[]{ "Value", "BinaryData" }, null, null, null),
             new pbr::GeneratedClrTypeInfo(typeof(global::SharpLife.Networking.Shared.Messages.NetworkStringLists.ListStringDataUpdate), global::SharpLife.Networking.Shared.Messages.NetworkStringLists.ListStringDataUpdate.Parser, new[]{ "Index", "BinaryData" }, null, null, null),
             new pbr::GeneratedClrTypeInfo(typeof(global::SharpLife.Networking.Shared.Messages.NetworkStringLists.NetworkStringListFullUpdate), global::SharpLife.Networking.Shared.Messages.NetworkStringLists.NetworkStringListFullUpdate.Parser, new[]{ "ListId", "Name", "Strings" }, null, null, null),
+            new pbr::GeneratedClrTypeInfo(typeof(global::SharpLife.Networking.Shared.Messages.NetworkStringLists.NetworkStringListFullUpdateChunk), global::SharpLife.Networking.Shared.Messages.NetworkStringLists.NetworkStringListFullUpdateChunk.Parser, new[]{ "ListId", "TotalSize", "Offset", "Data" }, null, null, null),
             new pbr::GeneratedClrTypeInfo(typeof(global::SharpLife.Networking.Shared.Messages.NetworkStringLists.NetworkStringListUpdate), global::SharpLife.Networking.Shared.Messages.NetworkStringLists.NetworkStringListUpdate.Parser, new[]{ "ListId", "Strings", "Updates" }, null, null, null),
             new pbr::GeneratedClrTypeInfo(typeof(global::SharpLife.Networking.Shared.Messages.NetworkStringLists.NetworkStringListFullUpdatesComplete), global::SharpLife.Networking.Shared.Messages.NetworkStringLists.NetworkStringListFullUpdatesComplete.Parser, null, null, null, null)
           }));
@@ -730,6 +733,229 @@ namespace SharpLife.Networking.Shared.Messages.NetworkStringLists {
 
   }
 
+  /// <summary>
+  ///Part of a full update that has been compressed and split up to be sent over multiple frames
+  ///The compressed data is a Deflate compressed NetworkStringListFullUpdate
+  /// </summary>
+  public sealed partial class NetworkStringListFullUpdateChunk : pb::IMessage<NetworkStringListFullUpdateChunk> {
+    private static readonly pb::MessageParser<NetworkStringListFullUpdateChunk> _parser = new pb::MessageParser<NetworkStringListFullUpdateChunk>(() => new NetworkStringListFullUpdateChunk());
+    private pb::UnknownFieldSet _unknownFields;
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public static pb::MessageParser<NetworkStringListFullUpdateChunk> Parser { get { return _parser; } }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public static pbr::MessageDescriptor Descriptor {
+      get { return global::SharpLife.Networking.Shared.Messages.NetworkStringLists.NetworkStringListUpdatesReflection.Descriptor.MessageTypes[4]; }
+    }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    pbr::MessageDescriptor pb::IMessage.Descriptor {
+      get { return Descriptor; }
+    }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public NetworkStringListFullUpdateChunk() {
+      OnConstruction();
+    }
+
+    partial void OnConstruction();
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public NetworkStringListFullUpdateChunk(NetworkStringListFullUpdateChunk other) : this() {
+      listId_ = other.listId_;
+      totalSize_ = other.totalSize_;
+      offset_ = other.offset_;
+      data_ = other.data_;
+      _unknownFields = pb::UnknownFieldSet.Clone(other._unknownFields);
+    }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public NetworkStringListFullUpdateChunk Clone() {
+      return new NetworkStringListFullUpdateChunk(this);
+    }
+
+    /// <summary>Field number for the "list_id" field.</summary>
+    public const int ListIdFieldNumber = 1;
+    private uint listId_;
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public uint ListId {
+      get { return listId_; }
+      set {
+        listId_ = value;
+      }
+    }
+
+    /// <summary>Field number for the "total_size" field.</summary>
+    public const int TotalSizeFieldNumber = 2;
+    private uint totalSize_;
+    /// <summary>
+    ///Size of the compressed data
+    /// </summary>
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public uint TotalSize {
+      get { return totalSize_; }
+      set {
+        totalSize_ = value;
+      }
+    }
+
+    /// <summary>Field number for the "offset" field.</summary>
+    public const int OffsetFieldNumber = 3;
+    private uint offset_;
+    /// <summary>
+    ///Offset of this chunk in the compressed data
+    /// </summary>
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public uint Offset {
+      get { return offset_; }
+      set {
+        offset_ = value;
+      }
+    }
+
+    /// <summary>Field number for the "data" field.</summary>
+    public const int DataFieldNumber = 4;
+    private pb::ByteString data_ = pb::ByteString.Empty;
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public pb::ByteString Data {
+      get { return data_; }
+      set {
+        data_ = pb::ProtoPreconditions.CheckNotNull(value, "value");
+      }
+    }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public override bool Equals(object other) {
+      return Equals(other as NetworkStringListFullUpdateChunk);
+    }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public bool Equals(NetworkStringListFullUpdateChunk other) {
+      if (ReferenceEquals(other, null)) {
+        return false;
+      }
+      if (ReferenceEquals(other, this)) {
+        return true;
+      }
+      if (ListId != other.ListId) return false;
+      if (TotalSize != other.TotalSize) return false;
+      if (Offset != other.Offset) return false;
+      if (Data != other.Data) return false;
+      return Equals(_unknownFields, other._unknownFields);
+    }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public override int GetHashCode() {
+      int hash = 1;
+      if (ListId != 0) hash ^= ListId.GetHashCode();
+      if (TotalSize != 0) hash ^= TotalSize.GetHashCode();
+      if (Offset != 0) hash ^= Offset.GetHashCode();
+      if (Data.Length != 0) hash ^= Data.GetHashCode();
+      if (_unknownFields != null) {
+        hash ^= _unknownFields.GetHashCode();
+      }
+      return hash;
+    }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public override string ToString() {
+      return pb::JsonFormatter.ToDiagnosticString(this);
+    }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public void WriteTo(pb::CodedOutputStream output) {
+      if (ListId != 0) {
+        output.WriteRawTag(8);
+        output.WriteUInt32(ListId);
+      }
+      if (TotalSize != 0) {
+        output.WriteRawTag(16);
+        output.WriteUInt32(TotalSize);
+      }
+      if (Offset != 0) {
+        output.WriteRawTag(24);
+        output.WriteUInt32(Offset);
+      }
+      if (Data.Length != 0) {
+        output.WriteRawTag(34);
+        output.WriteBytes(Data);
+      }
+      if (_unknownFields != null) {
+        _unknownFields.WriteTo(output);
+      }
+    }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public int CalculateSize() {
+      int size = 0;
+      if (ListId != 0) {
+        size += 1 + pb::CodedOutputStream.ComputeUInt32Size(ListId);
+      }
+      if (TotalSize != 0) {
+        size += 1 + pb::CodedOutputStream.ComputeUInt32Size(TotalSize);
+      }
+      if (Offset != 0) {
+        size += 1 + pb::CodedOutputStream.ComputeUInt32Size(Offset);
+      }
+      if (Data.Length != 0) {
+        size += 1 + pb::CodedOutputStream.ComputeBytesSize(Data);
+      }
+      if (_unknownFields != null) {
+        size += _unknownFields.CalculateSize();
+      }
+      return size;
+    }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public void MergeFrom(NetworkStringListFullUpdateChunk other) {
+      if (other == null) {
+        return;
+      }
+      if (other.ListId != 0) {
+        ListId = other.ListId;
+      }
+      if (other.TotalSize != 0) {
+        TotalSize = other.TotalSize;
+      }
+      if (other.Offset != 0) {
+        Offset = other.Offset;
+      }
+      if (other.Data.Length != 0) {
+        Data = other.Data;
+      }
+      _unknownFields = pb::UnknownFieldSet.MergeFrom(_unknownFields, other._unknownFields);
+    }
+
+    [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
+    public void MergeFrom(pb::CodedInputStream input) {
+      uint tag;
+      while ((tag = input.ReadTag()) != 0) {
+        switch(tag) {
+          default:
+            _unknownFields = pb::UnknownFieldSet.MergeFieldFrom(_unknownFields, input);
+            break;
+          case 8: {
+            ListId = input.ReadUInt32();
+            break;
+          }
+          case 16: {
+            TotalSize = input.ReadUInt32();
+            break;
+          }
+          case 24: {
+            Offset = input.ReadUInt32();
+            break;
+          }
+          case 34: {
+            Data = input.ReadBytes();
+            break;
+          }
+        }
+      }
+    }
+
+  }
+
   public sealed partial class NetworkStringListUpdate : pb::IMessage<NetworkStringListUpdate> {
     private static readonly pb::MessageParser<NetworkStringListUpdate> _parser = new pb::MessageParser<NetworkStringListUpdate>(() => new NetworkStringListUpdate());
     private pb::UnknownFieldSet _unknownFields;
@@ -738,7 +964,7 @@ namespace SharpLife.Networking.Shared.Messages.NetworkStringLists {
 
     [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
     public static pbr::MessageDescriptor Descriptor {
-      get { return global::SharpLife.Networking.Shared.Messages.NetworkStringLists.NetworkStringListUpdatesReflection.Descriptor.MessageTypes[4]; }
+      get { return global::SharpLife.Networking.Shared.Messages.NetworkStringLists.NetworkStringListUpdatesReflection.Descriptor.MessageTypes[5]; }
     }
 
     [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
@@ -910,7 +1136,7 @@ namespace SharpLife.Networking.Shared.Messages.NetworkStringLists {
 
     [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
     public static pbr::MessageDescriptor Descriptor {
-      get { return global::SharpLife.Networking.Shared.Messages.NetworkStringLists.NetworkStringListUpdatesReflection.Descriptor.MessageTypes[5]; }
+      get { return global::SharpLife.Networking.Shared.Messages.NetworkStringLists.NetworkStringListUpdatesReflection.Descriptor.MessageTypes[6]; }
     }
 
     [global::System.Diagnostics.DebuggerNonUserCodeAttribute]
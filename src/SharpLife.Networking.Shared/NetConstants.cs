@@ -36,6 +36,22 @@ namespace SharpLife.Networking.Shared
 
         public const int DefaultClientPort = 27005;
 
+        /// <summary>
+        /// Port that relays accept spectators on by default
+        /// </summary>
+        public const int DefaultRelayPort = 27020;
+
+        /// <summary>
+        /// Maximum number of spectators that can be connected to a relay
+        /// Spectators don't occupy player slots, so this is not limited by <see cref="MaxClients"/>
+        /// </summary>
+        public const int MaxRelaySpectators = 256;
+
+        /// <summary>
+        /// Number of spectators that can connect to a relay by default
+        /// </summary>
+        public const int DefaultRelaySpectators = 128;
+
         /// <summary>
         /// GoldSource will attempt to retry connecting to a server up to 3 times before aborting
         /// </summary>
@@ -46,8 +62,9 @@ namespace SharpLife.Networking.Shared
         /// <summary>
         /// Used to determine if the network protocol used by the client and server are compatible
         /// Allows connections to be rejected trivially during approval
+        /// When changing this, check whether <see cref="Communication.Capture.TrafficBenchmark.MinProtocolVersion"/> has to change as well
         /// </summary>
-        public const uint ProtocolVersion = 1;
+        public const uint ProtocolVersion = 11;
 
         /// <summary>
         /// The minimum number of clients that can be connected to a server
@@ -58,5 +75,36 @@ namespace SharpLife.Networking.Shared
         /// Maximum number of clients that can be connected to a server
         /// </summary>
         public const int MaxClients = 32;
+
+        /// <summary>
+        /// Bytes reserved in each packet for Lidgren's headers when packing messages
+        /// </summary>
+        public const int PacketHeaderReserve = 16;
+
+        /// <summary>
+        /// Default maximum number of bytes per second that a client wants to receive
+        /// </summary>
+        public const int DefaultRate = 30000;
+
+        /// <summary>
+        /// Size of a single string list full update chunk
+        /// Small enough to fit in a single packet along with the message header
+        /// </summary>
+        public const int StringListChunkSize = 1024;
+
+        /// <summary>
+        /// Maximum number of string list full update chunks to send to a client in a single frame
+        /// </summary>
+        public const int MaxStringListChunksPerFrame = 16;
+
+        /// <summary>
+        /// Maximum size of a compressed string list full update
+        /// </summary>
+        public const int MaxStringListFullUpdateSize = 16 * 1024 * 1024;
+
+        /// <summary>
+        /// Maximum size of a string list full update after decompression
+        /// </summary>
+        public const int MaxStringListDecompressedFullUpdateSize = 64 * 1024 * 1024;
     }
 }
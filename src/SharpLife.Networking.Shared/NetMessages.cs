@@ -54,9 +54,13 @@ namespace SharpLife.Networking.Shared
         /// </summary>
         public static IReadOnlyList<MessageDescriptor> ClientToServerMessages { get; } = new List<MessageDescriptor>
         {
-            //ClientUserInfo message is not included in this since it's the first message that gets sent
+            //The first ClientUserInfo is sent along with the connection request, this is used for changes made while connected
             NewConnection.Descriptor,
             SendResources.Descriptor,
+            NetworkObjectListFrameListAck.Descriptor,
+            NetworkObjectListObjectMetaDataRequest.Descriptor,
+            UserCommands.Descriptor,
+            ClientUserInfo.Descriptor,
         };
 
         /// <summary>
@@ -71,11 +75,14 @@ namespace SharpLife.Networking.Shared
             Print.Descriptor,
             BinaryMetaData.Descriptor,
             NetworkStringListFullUpdate.Descriptor,
+            NetworkStringListFullUpdateChunk.Descriptor,
             NetworkStringListUpdate.Descriptor,
             NetworkStringListFullUpdatesComplete.Descriptor,
             NetworkObjectListFrameListUpdate.Descriptor,
             NetworkObjectListObjectMetaDataList.Descriptor,
             NetworkObjectListListMetaDataList.Descriptor,
+            NetworkObjectListObjectMetaDataHash.Descriptor,
+            UserCommandAck.Descriptor,
         };
 
         /// <summary>
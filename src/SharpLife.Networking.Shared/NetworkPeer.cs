@@ -13,41 +13,215 @@
 *
 ****/
 
+using Google.Protobuf;
 using Lidgren.Network;
+using SharpLife.Networking.Shared.Communication.Capture;
+using SharpLife.Networking.Shared.Communication.Messages;
+using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using System.Runtime.ExceptionServices;
+using System.Threading;
 
 namespace SharpLife.Networking.Shared
 {
     /// <summary>
     /// Base class for network handlers
+    /// Packets are received and parsed on a separate thread, the main thread only dispatches the parsed messages
     /// </summary>
     public abstract class NetworkPeer
     {
+        /// <summary>
+        /// How long the network thread waits for packets before checking if it should stop, in milliseconds
+        /// </summary>
+        private const int ReceiveWaitTime = 100;
+
+        private struct ReceivedPacket
+        {
+            public NetIncomingMessage packet;
+
+            /// <summary>
+            /// If this is a data packet, the messages that were parsed from it
+            /// </summary>
+            public List<IMessage> messages;
+
+            /// <summary>
+            /// If parsing the packet failed, the exception that was thrown
+            /// </summary>
+            public ExceptionDispatchInfo exception;
+        }
+
         protected abstract NetPeer Peer { get; }
 
+        protected abstract MessagesReceiveHandler ReceiveHandler { get; }
+
+        //Only the network thread adds packets and only the main thread removes them
+        private readonly ConcurrentQueue<ReceivedPacket> _receivedPackets = new ConcurrentQueue<ReceivedPacket>();
+
+        //Message lists are handed back to the network thread once dispatched so they can be reused
+        private readonly ConcurrentQueue<List<IMessage>> _messageListPool = new ConcurrentQueue<List<IMessage>>();
+
+        private Thread _receiveThread;
+
+        private volatile bool _stopReceiving;
+
+        private volatile TrafficCaptureWriter _capture;
+
+        /// <summary>
+        /// If not null, all data packets that are sent and received are recorded to this capture
+        /// The peer does not take ownership of the capture
+        /// </summary>
+        public TrafficCaptureWriter Capture
+        {
+            get => _capture;
+            set => _capture = value;
+        }
+
         public void Start()
         {
             Peer.Start();
+
+            _stopReceiving = false;
+
+            _receiveThread = new Thread(ReceivePackets)
+            {
+                Name = $"{GetType().Name} receive thread",
+                IsBackground = true
+            };
+
+            _receiveThread.Start();
         }
 
         public void Shutdown(string bye)
         {
+            if (_receiveThread != null)
+            {
+                _stopReceiving = true;
+                _receiveThread.Join();
+                _receiveThread = null;
+
+                //Handle packets that were received before the thread stopped, otherwise they are never handled or recycled
+                ReadPackets();
+            }
+
             Peer.Shutdown(bye);
         }
 
-        public void ReadPackets()
+        private void ReceivePackets()
         {
-            NetIncomingMessage im;
+            while (!_stopReceiving)
+            {
+                var im = Peer.WaitMessage(ReceiveWaitTime);
+
+                while (im != null)
+                {
+                    if (im.MessageType == NetIncomingMessageType.UnconnectedData && HandleUnconnectedPacket(im))
+                    {
+                        Peer.Recycle(im);
+                        im = Peer.ReadMessage();
+                        continue;
+                    }
+
+                    var received = new ReceivedPacket
+                    {
+                        packet = im
+                    };
+
+                    if (im.MessageType == NetIncomingMessageType.Data)
+                    {
+                        _capture?.Write(PacketDirection.Incoming, im.SenderConnection?.RemoteUniqueIdentifier ?? 0, im.DeliveryMethod, im.Data, im.LengthBytes);
+
+                        if (!_messageListPool.TryDequeue(out received.messages))
+                        {
+                            received.messages = new List<IMessage>();
+                        }
 
-            while ((im = Peer.ReadMessage()) != null)
+                        try
+                        {
+                            ReceiveHandler.ParseMessages(im, received.messages);
+                        }
+                        catch (Exception e)
+                        {
+                            //Rethrown on the main thread so errors are handled the same way as before
+                            received.exception = ExceptionDispatchInfo.Capture(e);
+                        }
+                    }
+
+                    _receivedPackets.Enqueue(received);
+
+                    im = Peer.ReadMessage();
+                }
+            }
+        }
+
+        /// <summary>
+        /// Handles all packets that have been received since the last call
+        /// </summary>
+        public void ReadPackets()
+        {
+            while (_receivedPackets.TryDequeue(out var received))
             {
-                HandlePacket(im);
+                try
+                {
+                    received.exception?.Throw();
+
+                    if (received.messages != null)
+                    {
+                        HandleMessages(received.packet.SenderConnection, received.messages);
+                    }
+                    else
+                    {
+                        HandlePacket(received.packet);
+                    }
+                }
+                finally
+                {
+                    if (received.messages != null)
+                    {
+                        received.messages.Clear();
+                        _messageListPool.Enqueue(received.messages);
+                    }
 
-                Peer.Recycle(im);
+                    Peer.Recycle(received.packet);
+                }
             }
+
+            ReadLoopbackMessages();
         }
 
+        /// <summary>
+        /// Handles packets that don't contain messages
+        /// </summary>
+        /// <param name="message"></param>
         protected abstract void HandlePacket(NetIncomingMessage message);
 
+        /// <summary>
+        /// Handles an unconnected packet on the network thread
+        /// Packets that can be answered without involving the main thread, like server queries, should be handled here
+        /// Implementations must not access anything that the main thread modifies
+        /// </summary>
+        /// <param name="message"></param>
+        /// <returns>Whether the packet was handled. Packets that weren't are passed to <see cref="HandlePacket"/></returns>
+        protected virtual bool HandleUnconnectedPacket(NetIncomingMessage message)
+        {
+            return false;
+        }
+
+        /// <summary>
+        /// Handles the messages contained in a data packet
+        /// </summary>
+        /// <param name="sender"></param>
+        /// <param name="messages"></param>
+        protected abstract void HandleMessages(NetConnection sender, IReadOnlyList<IMessage> messages);
+
+        /// <summary>
+        /// Reads messages sent by a peer in the same process
+        /// These are read after network packets so status changes are processed first
+        /// </summary>
+        protected virtual void ReadLoopbackMessages()
+        {
+        }
+
         public void FlushOutgoingPackets()
         {
             Peer.FlushSendQueue();
@@ -60,6 +234,9 @@ namespace SharpLife.Networking.Shared
 
         public void SendPacket(NetOutgoingMessage message, NetConnection recipient, NetDeliveryMethod method)
         {
+            //Recorded before sending since the message is recycled once it has been sent
+            _capture?.Write(PacketDirection.Outgoing, recipient.RemoteUniqueIdentifier, method, message.Data, message.LengthBytes);
+
             Peer.SendMessage(message, recipient, method);
         }
     }